@@ -0,0 +1,133 @@
+/* broad phase 방식 별 충돌 후보 쌍 개수와 충돌 검출 시간을 측정한다.
+    구와 직육면체를 일정한 밀도로 흩뿌리고 매 프레임 조금씩 움직이면서
+    CollisionDetector::detectCollision 한 번에 걸리는 시간을 잰다 */
+
+#include <physics/detector.h>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+using namespace physics;
+
+namespace
+{
+    typedef std::unordered_map<unsigned int, Collider*> Colliders;
+
+    struct Scene
+    {
+        BodyStore bodyStore;
+        std::vector<RigidBody*> bodies;
+        Colliders colliders;
+
+        ~Scene()
+        {
+            for (auto& collider : colliders)
+                delete collider.second;
+        }
+    };
+
+    /* 한 변이 cbrt(n) * spacing 인 정육면체 안에 구와 직육면체를 반씩 흩뿌린다 */
+    void buildScene(Scene& scene, CollisionDetector& detector, unsigned int bodyCount, std::mt19937& rng)
+    {
+        const float spacing = 2.0f;
+        float side = cbrtf((float)bodyCount) * spacing;
+        std::uniform_real_distribution<float> position(0.0f, side);
+        std::uniform_real_distribution<float> angle(-1.0f, 1.0f);
+
+        for (unsigned int id = 0; id < bodyCount; ++id)
+        {
+            RigidBody* body = scene.bodyStore.createBody();
+            body->setMass(5.0f);
+            body->setPosition(position(rng), position(rng) + 1.0f, position(rng));
+
+            Collider* collider;
+            if (id % 2 == 0)
+            {
+                collider = new SphereCollider(body, 0.5f);
+            }
+            else
+            {
+                Quaternion orientation(1.0f, angle(rng), angle(rng), angle(rng));
+                orientation.normalize();
+                body->setOrientation(orientation);
+                collider = new BoxCollider(body, 0.5f, 0.5f, 0.5f);
+            }
+
+            scene.bodies.push_back(body);
+            scene.colliders[id] = collider;
+            detector.addCollider(collider);
+        }
+    }
+
+    /* 물체들을 조금씩 움직여 프레임 간 일관성이 있는 움직임을 흉내낸다 */
+    void jitterScene(Scene& scene, std::mt19937& rng)
+    {
+        std::uniform_real_distribution<float> delta(-0.05f, 0.05f);
+        for (auto& body : scene.bodies)
+            body->setPosition(body->getPosition() + Vector3(delta(rng), delta(rng), delta(rng)));
+    }
+
+    void runBenchmark(unsigned int bodyCount, BroadPhaseMode mode, const char* modeName)
+    {
+        std::mt19937 rng(12345);
+        CollisionDetector detector;
+        detector.setBroadPhaseMode(mode);
+        Scene scene;
+        buildScene(scene, detector, bodyCount, rng);
+
+        PlaneCollider ground(Vector3(0.0f, 1.0f, 0.0f), 0.0f);
+        std::vector<Contact> contacts;
+
+        /* 첫 프레임은 끝점을 처음 정렬하므로 측정에서 제외한다 */
+        detector.detectCollision(contacts, scene.colliders, ground);
+        contacts.clear();
+
+        /* 최대 frameLimit 프레임 또는 1 초 동안 측정한다 */
+        const int frameLimit = 100;
+        const double timeLimit = 1.0;
+        double elapsed = 0.0;
+        unsigned long long pairSum = 0, contactSum = 0;
+        int frames = 0;
+        while (frames < frameLimit && elapsed < timeLimit)
+        {
+            jitterScene(scene, rng);
+
+            auto start = std::chrono::steady_clock::now();
+            detector.detectCollision(contacts, scene.colliders, ground);
+            auto end = std::chrono::steady_clock::now();
+            elapsed += std::chrono::duration<double>(end - start).count();
+
+            pairSum += detector.getCandidatePairCount();
+            contactSum += contacts.size();
+            contacts.clear();
+            ++frames;
+        }
+
+        printf("%-16s %8u %14llu %10llu %12.3f\n",
+            modeName,
+            bodyCount,
+            pairSum / frames,
+            contactSum / frames,
+            elapsed / frames * 1000.0
+        );
+    }
+}
+
+int main()
+{
+    printf("%-16s %8s %14s %10s %12s\n", "broadphase", "bodies", "pairs/frame", "contacts", "ms/frame");
+
+    const unsigned int bodyCounts[] = {100, 1000, 10000};
+    for (auto bodyCount : bodyCounts)
+    {
+        runBenchmark(bodyCount, BRUTE_FORCE, "brute_force");
+        runBenchmark(bodyCount, SWEEP_AND_PRUNE, "sweep_and_prune");
+        runBenchmark(bodyCount, AABB_TREE, "aabb_tree");
+        runBenchmark(bodyCount, SPATIAL_HASH, "spatial_hash");
+    }
+
+    return 0;
+}
@@ -0,0 +1,182 @@
+/* 한 island 안의 충돌들을 순서대로 해소할 때와 색칠해서 병렬로 해소할 때의
+    초당 충돌 해소 횟수를 비교한다.
+    5000 개의 직육면체를 서로 조금씩 겹치게 쌓아 하나의 큰 island 를 만들고,
+    같은 충돌 정보에서 시작해 CollisionResolver::resolveCollision 을 여러 번 실행한다.
+    결과가 스레드 수와 관계없는지 확인할 수 있도록 해소 후 속도의 체크섬도 출력한다 */
+
+#include <physics/detector.h>
+#include <physics/island.h>
+#include <physics/resolver.h>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace physics;
+
+namespace
+{
+    typedef std::unordered_map<unsigned int, Collider*> Colliders;
+
+    struct Scene
+    {
+        BodyStore bodyStore;
+        std::vector<RigidBody*> bodies;
+        Colliders colliders;
+        PlaneCollider groundCollider;
+
+        std::vector<Contact> contacts;
+        IslandManager islandManager;
+
+        /* 해소 전의 속도 & 각속도 */
+        std::vector<Vector3> velocities;
+        std::vector<Vector3> rotations;
+
+        Scene() : groundCollider(Vector3(0.0f, 1.0f, 0.0f), 0.0f) {}
+        ~Scene()
+        {
+            for (auto& collider : colliders)
+                delete collider.second;
+        }
+    };
+
+    struct Result
+    {
+        double msPerSolve;
+        double contactsPerSecond;
+        unsigned int colorCount;
+        double checksum;
+    };
+
+    /* side x side 개의 기둥을 layerCount 층으로 쌓는다.
+        이웃한 직육면체끼리 조금씩 겹치도록 간격을 한 변보다 조금 작게 둔다 */
+    void buildScene(Scene& scene, unsigned int side, unsigned int layerCount, float deltaTime)
+    {
+        const float spacing = 0.99f;
+
+        CollisionDetector detector;
+        detector.setBroadPhaseMode(SPATIAL_HASH);
+
+        unsigned int id = 0;
+        for (unsigned int layer = 0; layer < layerCount; ++layer)
+        {
+            for (unsigned int i = 0; i < side; ++i)
+            {
+                for (unsigned int j = 0; j < side; ++j)
+                {
+                    RigidBody* body = scene.bodyStore.createBody();
+                    body->setMass(5.0f);
+                    body->setInertiaTensor(Matrix3(5.0f / 6.0f));
+                    body->setPosition(i * spacing, 0.49f + layer * spacing, j * spacing);
+                    body->setAcceleration(0.0f, -9.8f, 0.0f);
+
+                    /* 축이 모두 나란하면 분리축 검사가 퇴화하므로 조금씩 기울인다 */
+                    Quaternion orientation(
+                        1.0f, 0.01f * (id * 7 % 5 - 2.0f), 0.01f * (id * 3 % 5 - 2.0f), 0.01f * (id * 11 % 5 - 2.0f)
+                    );
+                    orientation.normalize();
+                    body->setOrientation(orientation);
+
+                    /* 중력에 의한 속도를 준다 */
+                    body->integrate(deltaTime);
+
+                    Collider* collider = new BoxCollider(body, 0.5f, 0.5f, 0.5f);
+                    scene.bodies.push_back(body);
+                    scene.colliders[id] = collider;
+                    detector.addCollider(collider);
+                    ++id;
+                }
+            }
+        }
+
+        detector.detectCollision(scene.contacts, scene.colliders, scene.groundCollider);
+        scene.islandManager.buildIslands(scene.bodies, scene.contacts);
+
+        for (auto& body : scene.bodies)
+        {
+            scene.velocities.push_back(body->getVelocity());
+            scene.rotations.push_back(body->getRotation());
+        }
+    }
+
+    Result run(Scene& scene, SolverMode mode, unsigned int threadCount, float deltaTime)
+    {
+        CollisionResolver resolver;
+        resolver.setSolverMode(mode);
+        resolver.setThreadCount(threadCount);
+        /* 매번 같은 횟수만큼 반복하도록 수렴 검사와 warm starting 을 끈다 */
+        resolver.setConvergenceTolerance(0.0f);
+        resolver.setWarmStarting(false);
+
+        const int solveCount = 5;
+
+        std::vector<Contact> contacts;
+        long long solvedContactCount = 0;
+        double elapsed = 0.0;
+        for (int i = 0; i < solveCount; ++i)
+        {
+            /* 매번 같은 상태에서 시작한다 */
+            contacts = scene.contacts;
+            for (unsigned int j = 0; j < scene.bodies.size(); ++j)
+            {
+                scene.bodies[j]->setVelocity(scene.velocities[j]);
+                scene.bodies[j]->setRotation(scene.rotations[j]);
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            resolver.resolveCollision(contacts, scene.islandManager.getIslands(), deltaTime);
+            auto end = std::chrono::steady_clock::now();
+            elapsed += std::chrono::duration<double>(end - start).count();
+
+            solvedContactCount += (long long)contacts.size() * resolver.getLastIterationCount();
+        }
+
+        Result result;
+        result.msPerSolve = elapsed / solveCount * 1000.0;
+        result.contactsPerSecond = solvedContactCount / elapsed;
+        result.colorCount = resolver.getLastColorCount();
+        result.checksum = 0.0;
+        for (auto& body : scene.bodies)
+        {
+            Vector3 velocity = body->getVelocity();
+            result.checksum += velocity.x + velocity.y + velocity.z;
+        }
+        return result;
+    }
+}
+
+int main()
+{
+    const float deltaTime = 1.0f / 60.0f;
+    const unsigned int threadCounts[] = {1, 2, 4, 8, 16};
+
+    Scene scene;
+    buildScene(scene, 25, 8, deltaTime);
+
+    unsigned int largestIsland = 0;
+    for (const auto& island : scene.islandManager.getIslands())
+    {
+        if (island.contactIndices.size() > largestIsland)
+            largestIsland = island.contactIndices.size();
+    }
+    printf("%u boxes, %u contacts, %u islands (largest %u contacts), %u hardware threads\n",
+        (unsigned int)scene.bodies.size(), (unsigned int)scene.contacts.size(),
+        (unsigned int)scene.islandManager.getIslands().size(), largestIsland,
+        std::thread::hardware_concurrency());
+    printf("%-8s %8s %8s %12s %16s %16s\n", "solver", "threads", "colors", "ms/solve", "contacts/s", "checksum");
+
+    Result serial = run(scene, SERIAL_SOLVER, 1, deltaTime);
+    printf("%-8s %8u %8s %12.3f %16.0f %16.6f\n",
+        "serial", 1, "-", serial.msPerSolve, serial.contactsPerSecond, serial.checksum);
+
+    for (const auto& threadCount : threadCounts)
+    {
+        Result colored = run(scene, COLORED_SOLVER, threadCount, deltaTime);
+        printf("%-8s %8u %8u %12.3f %16.0f %16.6f\n",
+            "colored", threadCount, colored.colorCount, colored.msPerSolve, colored.contactsPerSecond, colored.checksum);
+    }
+
+    return 0;
+}
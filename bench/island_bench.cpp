@@ -0,0 +1,127 @@
+/* 충돌 해소 스레드 수에 따른 시뮬레이션 시간을 비교한다.
+    서로 떨어진 구 더미들을 격자로 배치해 island 가 더미마다 하나씩 생기게 하고,
+    스레드 수를 1, 2, 4, 8, 16 으로 바꿔가며 한 프레임에 걸리는 시간을 잰다.
+    결과가 스레드 수와 관계없는지 확인할 수 있도록 마지막 위치의 체크섬도 출력한다 */
+
+#include <physics/simulator.h>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+using namespace physics;
+
+namespace
+{
+    struct Result
+    {
+        double msPerStep;
+        double averageIslands;
+        double checksum;
+    };
+
+    /* 한 변에 pileCountPerSide 개씩 구 더미를 늘어놓는다.
+        더미는 2x2 개의 구 위에 구 하나를 올린 사각뿔로 쓰러지지 않고 한 island 를 이룬다 */
+    void loadPiles(Simulator& simulator, std::vector<RigidBody*>& spheres, unsigned int pileCountPerSide)
+    {
+        const float radius = 0.5f;
+        const int baseSize = 2;
+        const float layerHeight = sqrtf(2.0f) * radius;
+        const float spacing = 3.0f;
+
+        unsigned int id = 0;
+        for (unsigned int i = 0; i < pileCountPerSide; ++i)
+        {
+            for (unsigned int j = 0; j < pileCountPerSide; ++j)
+            {
+                for (int layer = 0; layer < baseSize; ++layer)
+                {
+                    int layerSize = baseSize - layer;
+                    float offset = -(layerSize - 1) * radius;
+                    for (int x = 0; x < layerSize; ++x)
+                    {
+                        for (int z = 0; z < layerSize; ++z)
+                        {
+                            RigidBody* sphere = simulator.addRigidBody(
+                                id, SPHERE,
+                                i * spacing + offset + x * 2.0f * radius,
+                                radius + layer * layerHeight,
+                                j * spacing + offset + z * 2.0f * radius
+                            );
+                            simulator.addCollider(id, SPHERE, sphere)->setGeometricData(radius);
+                            spheres.push_back(sphere);
+                            ++id;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    Result run(unsigned int threadCount, unsigned int pileCountPerSide)
+    {
+        Simulator simulator;
+        simulator.setThreadCount(threadCount);
+        simulator.setBroadPhaseMode(SPATIAL_HASH);
+        /* 더미들이 잠들면 해소할 충돌이 없어지므로 끈다 */
+        simulator.setSleepingEnabled(false);
+
+        std::vector<RigidBody*> spheres;
+        loadPiles(simulator, spheres, pileCountPerSide);
+
+        const int stepCount = 300;
+        const float deltaTime = 1.0f / 60.0f;
+
+        std::vector<ContactInfo*> contactInfo;
+        long long islandSum = 0;
+        double elapsed = 0.0;
+        for (int step = 0; step < stepCount; ++step)
+        {
+            auto start = std::chrono::steady_clock::now();
+            simulator.simulate(deltaTime, contactInfo);
+            auto end = std::chrono::steady_clock::now();
+            elapsed += std::chrono::duration<double>(end - start).count();
+
+            islandSum += simulator.getIslandCount();
+            for (auto& info : contactInfo)
+                delete info;
+            contactInfo.clear();
+        }
+
+        Result result;
+        result.msPerStep = elapsed / stepCount * 1000.0;
+        result.averageIslands = (double)islandSum / stepCount;
+        result.checksum = 0.0;
+        for (auto& sphere : spheres)
+        {
+            Vector3 position = sphere->getPosition();
+            result.checksum += position.x + position.y + position.z;
+        }
+        return result;
+    }
+}
+
+int main()
+{
+    const unsigned int pileCountPerSide = 32;
+    const unsigned int threadCounts[] = {1, 2, 4, 8, 16};
+
+    printf("%u spheres in %u piles, %u hardware threads\n",
+        pileCountPerSide * pileCountPerSide * 5, pileCountPerSide * pileCountPerSide,
+        std::thread::hardware_concurrency());
+    printf("%8s %10s %10s %10s %16s\n", "threads", "islands", "ms/step", "speedup", "checksum");
+
+    double serialTime = 0.0;
+    for (const auto& threadCount : threadCounts)
+    {
+        Result result = run(threadCount, pileCountPerSide);
+        if (threadCount == 1)
+            serialTime = result.msPerStep;
+
+        printf("%8u %10.1f %10.3f %10.2f %16.6f\n",
+            threadCount, result.averageIslands, result.msPerStep, serialTime / result.msPerStep, result.checksum);
+    }
+
+    return 0;
+}
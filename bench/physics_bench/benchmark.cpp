@@ -0,0 +1,352 @@
+#include "benchmark.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <regex>
+#include <thread>
+
+using namespace bench;
+
+namespace
+{
+    std::vector<Benchmark*>& getRegistry()
+    {
+        static std::vector<Benchmark*> registry;
+        return registry;
+    }
+
+    /* 인자 없는 벤치마크와 구분하기 위한 값 */
+    const long long NO_ARGUMENT = -1;
+
+    double getUnitMultiplier(const std::string& unit)
+    {
+        if (unit == "s")
+            return 1.0;
+        if (unit == "ms")
+            return 1e3;
+        if (unit == "us")
+            return 1e6;
+        return 1e9;
+    }
+
+    /* JSON 문자열 안에 넣을 수 있도록 이스케이프한다 */
+    std::string escapeJson(const std::string& text)
+    {
+        std::string result;
+        for (const auto& c : text)
+        {
+            if (c == '"' || c == '\\')
+                result += '\\';
+            result += c;
+        }
+        return result;
+    }
+}
+
+namespace bench
+{
+    /* 한 번의 측정 결과 */
+    struct Run
+    {
+        std::string name;
+        unsigned long long iterations;
+        double realTime;    // 한 번 반복에 걸린 시간 (timeUnit 단위)
+        double cpuTime;
+        std::string timeUnit;
+        double itemsPerSecond;
+        std::map<std::string, double> counters;
+        std::string errorMessage;
+    };
+
+    class Runner
+    {
+    private:
+        std::string filter;
+        std::string format;
+        std::string outputFile;
+        double minTime;
+
+        std::vector<Run> runs;
+
+    public:
+        Runner() : format("console"), minTime(0.5) {}
+
+        bool parseArguments(int argc, char** argv);
+        void runAll();
+        void writeJson(FILE* file, const std::map<std::string, std::string>& context) const;
+
+        const std::vector<Run>& getRuns() const { return runs; }
+        const std::string& getFormat() const { return format; }
+        const std::string& getOutputFile() const { return outputFile; }
+
+    private:
+        Run runBenchmark(const Benchmark& benchmark, long long argument, const std::string& name) const;
+        static void printRun(const Run& run);
+    };
+}
+
+void State::pauseTiming()
+{
+    auto endTime = std::chrono::steady_clock::now();
+    std::clock_t endClock = std::clock();
+    realTime += std::chrono::duration<double>(endTime - startTime).count();
+    cpuTime += (double)(endClock - startClock) / CLOCKS_PER_SEC;
+    isTiming = false;
+}
+
+void State::resumeTiming()
+{
+    isTiming = true;
+    startClock = std::clock();
+    startTime = std::chrono::steady_clock::now();
+}
+
+void State::skipWithError(const std::string& message)
+{
+    errorMessage = message;
+    maxIterations = 0;
+    if (isTiming)
+        pauseTiming();
+}
+
+Benchmark* Benchmark::arg(long long value)
+{
+    arguments.push_back(value);
+    return this;
+}
+
+Benchmark* Benchmark::iterations(unsigned long long value)
+{
+    fixedIterations = value;
+    return this;
+}
+
+Benchmark* Benchmark::minimumTime(double seconds)
+{
+    minTime = seconds;
+    return this;
+}
+
+Benchmark* Benchmark::unit(const std::string& value)
+{
+    timeUnit = value;
+    return this;
+}
+
+Benchmark* bench::registerBenchmark(const char* name, BenchmarkFunction function)
+{
+    Benchmark* benchmark = new Benchmark(name, function);
+    getRegistry().push_back(benchmark);
+    return benchmark;
+}
+
+bool Runner::parseArguments(int argc, char** argv)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        std::string::size_type separator = arg.find('=');
+        std::string key = arg.substr(0, separator);
+        std::string value = separator == std::string::npos ? "" : arg.substr(separator + 1);
+
+        if (key == "--benchmark_filter")
+            filter = value;
+        else if (key == "--benchmark_format")
+            format = value;
+        else if (key == "--benchmark_out")
+            outputFile = value;
+        else if (key == "--benchmark_out_format")
+        {
+            /* 파일 출력은 항상 JSON 이다 */
+            if (value != "json")
+            {
+                printf("ERROR::Runner::parseArguments()::only json output is supported\n");
+                return false;
+            }
+        }
+        else if (key == "--benchmark_min_time")
+            minTime = strtod(value.c_str(), nullptr);
+        else
+        {
+            printf("ERROR::Runner::parseArguments()::unknown option %s\n", arg.c_str());
+            return false;
+        }
+    }
+
+    if (format != "console" && format != "json")
+    {
+        printf("ERROR::Runner::parseArguments()::unknown format %s\n", format.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+void Runner::runAll()
+{
+    std::regex filterRegex(filter.empty() ? ".*" : filter);
+
+    if (format == "console")
+        printf("%-44s %14s %14s %12s  %s\n", "Benchmark", "Time", "CPU", "Iterations", "Counters");
+
+    for (const auto& benchmark : getRegistry())
+    {
+        std::vector<long long> arguments = benchmark->arguments;
+        if (arguments.empty())
+            arguments.push_back(NO_ARGUMENT);
+
+        for (const auto& argument : arguments)
+        {
+            std::string name = benchmark->name;
+            if (argument != NO_ARGUMENT)
+                name += "/" + std::to_string(argument);
+            if (!std::regex_search(name, filterRegex))
+                continue;
+
+            Run run = runBenchmark(*benchmark, argument, name);
+            if (format == "console")
+                printRun(run);
+            runs.push_back(run);
+        }
+    }
+}
+
+Run Runner::runBenchmark(const Benchmark& benchmark, long long argument, const std::string& name) const
+{
+    double targetTime = benchmark.minTime > 0.0 ? benchmark.minTime : minTime;
+
+    /* 반복 횟수를 고정하지 않았다면 targetTime 을 넘길 때까지 반복 횟수를 늘려가며 다시 잰다 */
+    unsigned long long iterations = benchmark.fixedIterations > 0 ? benchmark.fixedIterations : 1;
+    State state(iterations, argument);
+    while (true)
+    {
+        state = State(iterations, argument);
+        benchmark.function(state);
+
+        if (!state.errorMessage.empty() || benchmark.fixedIterations > 0)
+            break;
+        if (state.realTime >= targetTime || iterations >= 1000000000ULL)
+            break;
+
+        /* 다음 반복 횟수를 예측한다. 너무 급격히 늘리지 않도록 10 배로 제한한다 */
+        double multiplier = state.realTime > 0.0 ? targetTime * 1.4 / state.realTime : 10.0;
+        multiplier = std::min(std::max(multiplier, 2.0), 10.0);
+        iterations = (unsigned long long)(iterations * multiplier);
+    }
+
+    Run run;
+    run.name = name;
+    run.iterations = state.maxIterations;
+    run.timeUnit = benchmark.timeUnit;
+    run.errorMessage = state.errorMessage;
+    run.counters = state.counters;
+
+    double multiplier = getUnitMultiplier(benchmark.timeUnit);
+    double iterationCount = run.iterations > 0 ? (double)run.iterations : 1.0;
+    run.realTime = state.realTime / iterationCount * multiplier;
+    run.cpuTime = state.cpuTime / iterationCount * multiplier;
+    run.itemsPerSecond = state.itemsProcessed > 0 && state.realTime > 0.0 ? state.itemsProcessed / state.realTime : 0.0;
+
+    return run;
+}
+
+void Runner::printRun(const Run& run)
+{
+    if (!run.errorMessage.empty())
+    {
+        printf("%-44s ERROR: %s\n", run.name.c_str(), run.errorMessage.c_str());
+        return;
+    }
+
+    printf("%-44s %11.3f %-2s %11.3f %-2s %12llu ",
+        run.name.c_str(), run.realTime, run.timeUnit.c_str(), run.cpuTime, run.timeUnit.c_str(), run.iterations);
+    if (run.itemsPerSecond > 0.0)
+        printf(" items/s=%.4g", run.itemsPerSecond);
+    for (const auto& counter : run.counters)
+        printf(" %s=%.4g", counter.first.c_str(), counter.second);
+    printf("\n");
+}
+
+void Runner::writeJson(FILE* file, const std::map<std::string, std::string>& context) const
+{
+    time_t now = time(nullptr);
+    char date[64];
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", localtime(&now));
+
+    fprintf(file, "{\n  \"context\": {\n");
+    fprintf(file, "    \"date\": \"%s\",\n", date);
+    fprintf(file, "    \"num_cpus\": %u,\n", std::thread::hardware_concurrency());
+#ifdef NDEBUG
+    fprintf(file, "    \"library_build_type\": \"release\"");
+#else
+    fprintf(file, "    \"library_build_type\": \"debug\"");
+#endif
+    for (const auto& entry : context)
+        fprintf(file, ",\n    \"%s\": \"%s\"", escapeJson(entry.first).c_str(), escapeJson(entry.second).c_str());
+    fprintf(file, "\n  },\n  \"benchmarks\": [");
+
+    for (unsigned int i = 0; i < runs.size(); ++i)
+    {
+        const Run& run = runs[i];
+        std::string name = escapeJson(run.name);
+
+        fprintf(file, "%s\n    {\n", i == 0 ? "" : ",");
+        fprintf(file, "      \"name\": \"%s\",\n", name.c_str());
+        fprintf(file, "      \"run_name\": \"%s\",\n", name.c_str());
+        fprintf(file, "      \"run_type\": \"iteration\",\n");
+        fprintf(file, "      \"repetitions\": 1,\n");
+        fprintf(file, "      \"repetition_index\": 0,\n");
+        fprintf(file, "      \"threads\": 1,\n");
+        if (!run.errorMessage.empty())
+        {
+            fprintf(file, "      \"error_occurred\": true,\n");
+            fprintf(file, "      \"error_message\": \"%s\",\n", escapeJson(run.errorMessage).c_str());
+        }
+        fprintf(file, "      \"iterations\": %llu,\n", run.iterations);
+        fprintf(file, "      \"real_time\": %.6e,\n", run.realTime);
+        fprintf(file, "      \"cpu_time\": %.6e,\n", run.cpuTime);
+        fprintf(file, "      \"time_unit\": \"%s\"", run.timeUnit.c_str());
+        if (run.itemsPerSecond > 0.0)
+            fprintf(file, ",\n      \"items_per_second\": %.6e", run.itemsPerSecond);
+        for (const auto& counter : run.counters)
+            fprintf(file, ",\n      \"%s\": %.6e", escapeJson(counter.first).c_str(), counter.second);
+        fprintf(file, "\n    }");
+    }
+
+    fprintf(file, "\n  ]\n}\n");
+}
+
+int bench::runBenchmarks(int argc, char** argv, const std::map<std::string, std::string>& context)
+{
+    Runner runner;
+    if (!runner.parseArguments(argc, argv))
+    {
+        printf("usage: %s [--benchmark_filter=<regex>] [--benchmark_format=console|json]\n"
+            "       [--benchmark_out=<file>] [--benchmark_min_time=<seconds>]\n", argv[0]);
+        return 1;
+    }
+
+    runner.runAll();
+
+    if (runner.getFormat() == "json")
+        runner.writeJson(stdout, context);
+
+    if (!runner.getOutputFile().empty())
+    {
+        FILE* file = fopen(runner.getOutputFile().c_str(), "w");
+        if (file == nullptr)
+        {
+            printf("ERROR::runBenchmarks()::can't open %s\n", runner.getOutputFile().c_str());
+            return 1;
+        }
+        runner.writeJson(file, context);
+        fclose(file);
+    }
+
+    for (const auto& run : runner.getRuns())
+        if (!run.errorMessage.empty())
+            return 1;
+
+    return 0;
+}
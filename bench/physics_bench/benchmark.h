@@ -0,0 +1,145 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <chrono>
+#include <ctime>
+#include <map>
+#include <string>
+#include <vector>
+
+/* Google Benchmark 와 비슷한 형태의 작은 벤치마크 도구.
+    벤치마크 함수는 State 를 받아 keepRunning() 이 false 를 반환할 때까지 측정할 코드를 반복한다.
+    JSON 출력은 Google Benchmark 의 형식을 따르므로 compare.py 같은 비교 도구를 그대로 쓸 수 있다 */
+namespace bench
+{
+    class State
+    {
+        friend class Runner;
+
+    private:
+        unsigned long long maxIterations;
+        unsigned long long iterationCount;
+        long long argument;
+
+        /* 측정 중인 구간의 시작 시각 */
+        std::chrono::steady_clock::time_point startTime;
+        std::clock_t startClock;
+        bool isTiming;
+
+        /* 누적 측정 시간 (초) */
+        double realTime;
+        double cpuTime;
+
+        long long itemsProcessed;
+        std::map<std::string, double> counters;
+        std::string errorMessage;
+
+    public:
+        State(unsigned long long _maxIterations, long long _argument)
+            : maxIterations(_maxIterations), iterationCount(0), argument(_argument),
+            startClock(0), isTiming(false), realTime(0.0), cpuTime(0.0), itemsProcessed(0) {}
+
+        /* 반복할 횟수가 남았다면 true 를 반환한다.
+            처음 호출될 때 측정을 시작하고 마지막에 false 를 반환하며 측정을 멈춘다 */
+        bool keepRunning()
+        {
+            if (iterationCount < maxIterations)
+            {
+                if (iterationCount == 0)
+                    resumeTiming();
+                ++iterationCount;
+                return true;
+            }
+
+            if (isTiming)
+                pauseTiming();
+            return false;
+        }
+
+        /* 측정하지 않을 준비 작업 전후로 호출한다 */
+        void pauseTiming();
+        void resumeTiming();
+
+        /* Benchmark::arg 로 등록한 인자 */
+        long long range() const { return argument; }
+        unsigned long long iterations() const { return maxIterations; }
+
+        /* 초당 처리량 (items_per_second) 을 계산할 때 사용한다 */
+        void setItemsProcessed(long long value) { itemsProcessed = value; }
+        /* JSON 과 콘솔에 그대로 출력되는 값 */
+        void setCounter(const std::string& name, double value) { counters[name] = value; }
+
+        /* 측정을 중단하고 오류로 기록한다. 호출 후 함수에서 바로 반환해야 한다 */
+        void skipWithError(const std::string& message);
+    };
+
+    typedef void (*BenchmarkFunction)(State&);
+
+    class Benchmark
+    {
+        friend class Runner;
+
+    private:
+        std::string name;
+        BenchmarkFunction function;
+        std::vector<long long> arguments;
+
+        /* 0 이라면 minTime 을 넘길 때까지 반복 횟수를 늘린다 */
+        unsigned long long fixedIterations;
+        double minTime;
+        /* ns, us, ms, s 중 하나 */
+        std::string timeUnit;
+
+    public:
+        Benchmark(const std::string& _name, BenchmarkFunction _function)
+            : name(_name), function(_function), fixedIterations(0), minTime(0.0), timeUnit("ns") {}
+
+        /* 인자마다 "이름/인자" 로 따로 측정한다 */
+        Benchmark* arg(long long value);
+        /* 반복 횟수를 고정한다. 장면 벤치마크처럼 상태가 이어지는 경우에 사용한다 */
+        Benchmark* iterations(unsigned long long value);
+        Benchmark* minimumTime(double seconds);
+        Benchmark* unit(const std::string& value);
+    };
+
+    /* 벤치마크를 등록한다. PHYSICS_BENCHMARK 매크로가 호출한다 */
+    Benchmark* registerBenchmark(const char* name, BenchmarkFunction function);
+
+    /* 명령행 인자를 읽어 등록된 벤치마크들을 실행한다.
+        context 는 JSON 의 context 에 추가로 기록할 값들이다 */
+    int runBenchmarks(int argc, char** argv, const std::map<std::string, std::string>& context);
+
+    /* 결과를 사용하지 않는 계산이 최적화로 사라지지 않게 한다 */
+    template <typename T>
+    inline void doNotOptimize(const T& value)
+    {
+#if defined(__GNUC__)
+        asm volatile("" : : "m"(value) : "memory");
+#else
+        static volatile const void* sink;
+        sink = &value;
+#endif
+    }
+
+    /* 값이 바뀌었다고 가정하게 하여 반복문 밖으로 계산이 옮겨지지 않게 한다 */
+    template <typename T>
+    inline void doNotOptimize(T& value)
+    {
+#if defined(__GNUC__)
+        asm volatile("" : "+m"(value) : : "memory");
+#else
+        static volatile void* sink;
+        sink = &value;
+#endif
+    }
+} // namespace bench
+
+#define PHYSICS_BENCHMARK_CONCAT2(a, b) a##b
+#define PHYSICS_BENCHMARK_CONCAT(a, b) PHYSICS_BENCHMARK_CONCAT2(a, b)
+
+/* PHYSICS_BENCHMARK("Vector3/cross", vector3Cross)->arg(100); 처럼 사용한다 */
+#define PHYSICS_BENCHMARK(name, function) \
+    static bench::Benchmark* PHYSICS_BENCHMARK_CONCAT(benchmarkRegistration, __LINE__) = \
+        bench::registerBenchmark(name, function)
+
+#endif // BENCHMARK_H
@@ -0,0 +1,15 @@
+/* 물리 엔진의 마이크로 & 매크로 벤치마크.
+    --benchmark_out=<file> 로 Google Benchmark 형식의 JSON 을 저장해 릴리스 간 성능을 비교한다 */
+
+#include "benchmark.h"
+#include <physics/body_store.h>
+#include <string>
+
+int main(int argc, char** argv)
+{
+    std::map<std::string, std::string> context;
+    context["executable"] = argv[0];
+    context["body_store_batch_width"] = std::to_string(physics::BodyStore::getBatchWidth());
+
+    return bench::runBenchmarks(argc, argv, context);
+}
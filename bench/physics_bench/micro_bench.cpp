@@ -0,0 +1,1109 @@
+/* 물리 엔진의 기본 연산들을 하나씩 측정한다.
+    수학 연산, 강체 적분, narrow phase 충돌 검사 함수, 충돌 해소기 */
+
+#include "benchmark.h"
+#include <physics/detector.h>
+#include <physics/island.h>
+#include <physics/resolver.h>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace physics;
+
+namespace physics
+{
+    /* CollisionResolver 의 private 함수를 호출한다 */
+    class ResolverBenchmark
+    {
+    public:
+        static float sequentialImpulse(CollisionResolver& resolver, Contact* contact, float deltaTime)
+        {
+            return resolver.sequentialImpulse(contact, deltaTime);
+        }
+    };
+
+    /* CollisionDetector 의 private 충돌 검사 함수들을 호출한다 */
+    class NarrowPhaseBenchmark
+    {
+    public:
+        static bool sphereAndSphere(CollisionDetector& detector, std::vector<Contact>& contacts,
+            const SphereCollider& sphere1, const SphereCollider& sphere2)
+        {
+            return detector.sphereAndSphere(contacts, sphere1, sphere2);
+        }
+
+        static bool sphereAndBox(CollisionDetector& detector, std::vector<Contact>& contacts,
+            const SphereCollider& sphere, const BoxCollider& box)
+        {
+            return detector.sphereAndBox(contacts, sphere, box);
+        }
+
+        static bool sphereAndPlane(CollisionDetector& detector, std::vector<Contact>& contacts,
+            const SphereCollider& sphere, const PlaneCollider& plane)
+        {
+            return detector.sphereAndPlane(contacts, sphere, plane);
+        }
+
+        static bool boxAndBox(CollisionDetector& detector, std::vector<Contact>& contacts,
+            const BoxCollider& box1, const BoxCollider& box2)
+        {
+            return detector.boxAndBox(contacts, box1, box2);
+        }
+
+        static bool boxAndPlane(CollisionDetector& detector, std::vector<Contact>& contacts,
+            const BoxCollider& box, const PlaneCollider& plane)
+        {
+            return detector.boxAndPlane(contacts, box, plane);
+        }
+
+        static bool capsuleAndSphere(CollisionDetector& detector, std::vector<Contact>& contacts,
+            const CapsuleCollider& capsule, const SphereCollider& sphere)
+        {
+            return detector.capsuleAndSphere(contacts, capsule, sphere);
+        }
+
+        static bool capsuleAndCapsule(CollisionDetector& detector, std::vector<Contact>& contacts,
+            const CapsuleCollider& capsule1, const CapsuleCollider& capsule2)
+        {
+            return detector.capsuleAndCapsule(contacts, capsule1, capsule2);
+        }
+
+        static bool capsuleAndBox(CollisionDetector& detector, std::vector<Contact>& contacts,
+            const CapsuleCollider& capsule, const BoxCollider& box)
+        {
+            return detector.capsuleAndBox(contacts, capsule, box);
+        }
+
+        static bool capsuleAndPlane(CollisionDetector& detector, std::vector<Contact>& contacts,
+            const CapsuleCollider& capsule, const PlaneCollider& plane)
+        {
+            return detector.capsuleAndPlane(contacts, capsule, plane);
+        }
+
+        static bool convexAndConvex(CollisionDetector& detector, std::vector<Contact>& contacts,
+            const Collider& collider1, const Collider& collider2)
+        {
+            return detector.convexAndConvex(contacts, collider1, collider2);
+        }
+
+        static bool sphereAndTriangle(CollisionDetector& detector, std::vector<Contact>& contacts,
+            const SphereCollider& sphere, const TriangleMesh::Triangle& triangle)
+        {
+            return detector.sphereAndTriangle(contacts, sphere, triangle, 8);
+        }
+
+        static bool boxAndTriangle(CollisionDetector& detector, std::vector<Contact>& contacts,
+            const BoxCollider& box, const TriangleMesh::Triangle& triangle)
+        {
+            return detector.boxAndTriangle(contacts, box, triangle, 8);
+        }
+
+        static bool sphereAndHeightfield(CollisionDetector& detector, std::vector<Contact>& contacts,
+            const SphereCollider& sphere, const HeightfieldCollider& heightfield)
+        {
+            return detector.sphereAndHeightfield(contacts, sphere, heightfield);
+        }
+
+        static bool boxAndHeightfield(CollisionDetector& detector, std::vector<Contact>& contacts,
+            const BoxCollider& box, const HeightfieldCollider& heightfield)
+        {
+            return detector.boxAndHeightfield(contacts, box, heightfield);
+        }
+
+        /* 구 - 구 쌍과 구 - 평면 지면의 묶음 검사 */
+        static void addSpherePair(CollisionDetector& detector, const SphereCollider& sphere1, const SphereCollider& sphere2)
+        {
+            detector.spherePairBatch.add(sphere1, sphere2);
+        }
+
+        static void detectSpherePairBatch(CollisionDetector& detector, std::vector<Contact>& contacts)
+        {
+            detector.detectSpherePairBatch(contacts);
+        }
+
+        static void addSpherePlane(CollisionDetector& detector, const SphereCollider& sphere)
+        {
+            detector.spherePlaneBatch.add(sphere);
+        }
+
+        static void detectSpherePlaneBatch(CollisionDetector& detector, std::vector<Contact>& contacts, const PlaneCollider& plane)
+        {
+            detector.detectSpherePlaneBatch(contacts, plane);
+        }
+
+        /* 다음 프레임으로 넘어간 것처럼 만들어 오래된 GJK 캐시를 지운다 */
+        static void clearGJKCaches(CollisionDetector& detector)
+        {
+            detector.gjkCaches.clear();
+        }
+    };
+} // namespace physics
+
+namespace
+{
+    Quaternion makeOrientation(float w, float x, float y, float z)
+    {
+        Quaternion orientation(w, x, y, z);
+        orientation.normalize();
+        return orientation;
+    }
+
+    RigidBody* createBody(BodyStore& store, const Vector3& position, const Quaternion& orientation)
+    {
+        RigidBody* body = store.createBody();
+        body->setMass(5.0f);
+        body->setInertiaTensor(Matrix3(5.0f / 6.0f));
+        body->setPosition(position);
+        body->setOrientation(orientation);
+        return body;
+    }
+
+    /* 수학 연산 */
+
+    void vector3Add(bench::State& state)
+    {
+        Vector3 a(1.0f, 2.0f, 3.0f), b(0.5f, -0.25f, 4.0f);
+        while (state.keepRunning())
+        {
+            bench::doNotOptimize(a);
+            bench::doNotOptimize(a + b);
+        }
+    }
+
+    void vector3Dot(bench::State& state)
+    {
+        Vector3 a(1.0f, 2.0f, 3.0f), b(0.5f, -0.25f, 4.0f);
+        while (state.keepRunning())
+        {
+            bench::doNotOptimize(a);
+            bench::doNotOptimize(a.dot(b));
+        }
+    }
+
+    void vector3Cross(bench::State& state)
+    {
+        Vector3 a(1.0f, 2.0f, 3.0f), b(0.5f, -0.25f, 4.0f);
+        while (state.keepRunning())
+        {
+            bench::doNotOptimize(a);
+            bench::doNotOptimize(a.cross(b));
+        }
+    }
+
+    void vector3Normalize(bench::State& state)
+    {
+        Vector3 a(1.0f, 2.0f, 3.0f);
+        while (state.keepRunning())
+        {
+            Vector3 result = a;
+            bench::doNotOptimize(result);
+            result.normalize();
+            bench::doNotOptimize(result);
+        }
+    }
+
+    Matrix3 makeMatrix3()
+    {
+        Matrix3 result;
+        for (int i = 0; i < 9; ++i)
+            result.entries[i] = (i * 7 % 5) * 0.5f + (i % 4 == 0 ? 2.0f : 0.0f);
+        return result;
+    }
+
+    void matrix3Multiply(bench::State& state)
+    {
+        Matrix3 a = makeMatrix3(), b = makeMatrix3().transpose();
+        while (state.keepRunning())
+        {
+            bench::doNotOptimize(a);
+            bench::doNotOptimize(a * b);
+        }
+    }
+
+    void matrix3MultiplyVector(bench::State& state)
+    {
+        Matrix3 a = makeMatrix3();
+        Vector3 v(1.0f, 2.0f, 3.0f);
+        while (state.keepRunning())
+        {
+            bench::doNotOptimize(v);
+            bench::doNotOptimize(a * v);
+        }
+    }
+
+    void matrix3Transpose(bench::State& state)
+    {
+        Matrix3 a = makeMatrix3();
+        while (state.keepRunning())
+        {
+            bench::doNotOptimize(a);
+            bench::doNotOptimize(a.transpose());
+        }
+    }
+
+    void matrix3Inverse(bench::State& state)
+    {
+        Matrix3 a = makeMatrix3();
+        while (state.keepRunning())
+        {
+            bench::doNotOptimize(a);
+            bench::doNotOptimize(a.inverse());
+        }
+    }
+
+    Matrix4 makeMatrix4()
+    {
+        Matrix4 result;
+        Matrix3 rotation = makeMatrix3();
+        for (int i = 0; i < 3; ++i)
+        {
+            for (int j = 0; j < 3; ++j)
+                result.entries[4*i + j] = rotation.entries[3*i + j];
+            result.entries[4*i + 3] = i + 1.0f;
+        }
+        return result;
+    }
+
+    void matrix4Multiply(bench::State& state)
+    {
+        Matrix4 a = makeMatrix4(), b = makeMatrix4();
+        while (state.keepRunning())
+        {
+            bench::doNotOptimize(a);
+            bench::doNotOptimize(a * b);
+        }
+    }
+
+    void matrix4MultiplyVector(bench::State& state)
+    {
+        Matrix4 a = makeMatrix4();
+        Vector3 v(1.0f, 2.0f, 3.0f);
+        while (state.keepRunning())
+        {
+            bench::doNotOptimize(v);
+            bench::doNotOptimize(a * v);
+        }
+    }
+
+    void matrix4Inverse(bench::State& state)
+    {
+        Matrix4 a = makeMatrix4();
+        while (state.keepRunning())
+        {
+            bench::doNotOptimize(a);
+            bench::doNotOptimize(a.inverse());
+        }
+    }
+
+    void quaternionMultiply(bench::State& state)
+    {
+        Quaternion a = makeOrientation(1.0f, 0.2f, 0.3f, 0.4f), b = makeOrientation(0.5f, -0.1f, 0.7f, 0.2f);
+        while (state.keepRunning())
+        {
+            bench::doNotOptimize(a);
+            bench::doNotOptimize(a * b);
+        }
+    }
+
+    void quaternionNormalize(bench::State& state)
+    {
+        Quaternion a(1.0f, 0.2f, 0.3f, 0.4f);
+        while (state.keepRunning())
+        {
+            Quaternion result = a;
+            bench::doNotOptimize(result);
+            result.normalize();
+            bench::doNotOptimize(result);
+        }
+    }
+
+    void quaternionRotateByScaledVector(bench::State& state)
+    {
+        Quaternion a = makeOrientation(1.0f, 0.2f, 0.3f, 0.4f);
+        Vector3 v(0.1f, 0.2f, 0.3f);
+        while (state.keepRunning())
+        {
+            bench::doNotOptimize(a);
+            bench::doNotOptimize(a.rotateByScaledVector(v, 0.016f));
+        }
+    }
+
+    PHYSICS_BENCHMARK("Vector3/add", vector3Add);
+    PHYSICS_BENCHMARK("Vector3/dot", vector3Dot);
+    PHYSICS_BENCHMARK("Vector3/cross", vector3Cross);
+    PHYSICS_BENCHMARK("Vector3/normalize", vector3Normalize);
+    PHYSICS_BENCHMARK("Matrix3/multiply", matrix3Multiply);
+    PHYSICS_BENCHMARK("Matrix3/multiplyVector", matrix3MultiplyVector);
+    PHYSICS_BENCHMARK("Matrix3/transpose", matrix3Transpose);
+    PHYSICS_BENCHMARK("Matrix3/inverse", matrix3Inverse);
+    PHYSICS_BENCHMARK("Matrix4/multiply", matrix4Multiply);
+    PHYSICS_BENCHMARK("Matrix4/multiplyVector", matrix4MultiplyVector);
+    PHYSICS_BENCHMARK("Matrix4/inverse", matrix4Inverse);
+    PHYSICS_BENCHMARK("Quaternion/multiply", quaternionMultiply);
+    PHYSICS_BENCHMARK("Quaternion/normalize", quaternionNormalize);
+    PHYSICS_BENCHMARK("Quaternion/rotateByScaledVector", quaternionRotateByScaledVector);
+
+    /* 강체 적분 */
+
+    void rigidBodyIntegrate(bench::State& state)
+    {
+        BodyStore store;
+        RigidBody* body = createBody(store, Vector3(0.0f, 10.0f, 0.0f), makeOrientation(1.0f, 0.1f, 0.2f, 0.3f));
+        body->setAcceleration(0.0f, -9.8f, 0.0f);
+        body->setRotation(0.5f, 1.0f, -0.5f);
+
+        while (state.keepRunning())
+        {
+            body->integrate(1.0f / 60.0f);
+            /* 위치가 계속 떨어지면 값이 커지므로 주기적으로 되돌린다 */
+            if (body->getPosition().y < -1000.0f)
+            {
+                body->setPosition(0.0f, 10.0f, 0.0f);
+                body->setVelocity(0.0f, 0.0f, 0.0f);
+            }
+        }
+        state.setItemsProcessed(state.iterations());
+    }
+
+    void bodyStoreIntegrate(bench::State& state)
+    {
+        BodyStore store;
+        for (long long i = 0; i < state.range(); ++i)
+        {
+            RigidBody* body = createBody(store, Vector3(i * 1.0f, 10.0f, 0.0f), makeOrientation(1.0f, 0.1f * i, 0.2f, 0.3f));
+            body->setAcceleration(0.0f, -9.8f, 0.0f);
+            body->setRotation(0.5f, 1.0f, -0.5f);
+        }
+
+        while (state.keepRunning())
+            store.integrate(1.0f / 60.0f);
+        state.setItemsProcessed(state.iterations() * state.range());
+    }
+
+    PHYSICS_BENCHMARK("RigidBody/integrate", rigidBodyIntegrate);
+    PHYSICS_BENCHMARK("BodyStore/integrate", bodyStoreIntegrate)->arg(1000)->arg(10000);
+
+    /* narrow phase.
+        매 반복마다 충돌 정보를 지우고 충돌 검사 함수를 한 번 호출한다.
+        검사가 실제로 충돌을 찾았는지 확인할 수 있도록 찾은 충돌점 수를 contacts 로 남긴다 */
+
+    void narrowPhaseSphereAndSphere(bench::State& state)
+    {
+        BodyStore store;
+        CollisionDetector detector;
+        SphereCollider sphere1(createBody(store, Vector3(0.0f, 1.0f, 0.0f), Quaternion()), 0.5f);
+        SphereCollider sphere2(createBody(store, Vector3(0.6f, 1.5f, 0.2f), Quaternion()), 0.5f);
+
+        std::vector<Contact> contacts;
+        contacts.reserve(8);
+        while (state.keepRunning())
+        {
+            contacts.clear();
+            NarrowPhaseBenchmark::sphereAndSphere(detector, contacts, sphere1, sphere2);
+            bench::doNotOptimize(contacts);
+        }
+        state.setCounter("contacts", contacts.size());
+    }
+
+    void narrowPhaseSphereAndBox(bench::State& state)
+    {
+        BodyStore store;
+        CollisionDetector detector;
+        SphereCollider sphere(createBody(store, Vector3(0.3f, 1.8f, 0.1f), Quaternion()), 0.5f);
+        BoxCollider box(createBody(store, Vector3(0.0f, 1.0f, 0.0f), makeOrientation(1.0f, 0.05f, 0.1f, 0.02f)), 0.5f, 0.5f, 0.5f);
+
+        std::vector<Contact> contacts;
+        contacts.reserve(8);
+        while (state.keepRunning())
+        {
+            contacts.clear();
+            NarrowPhaseBenchmark::sphereAndBox(detector, contacts, sphere, box);
+            bench::doNotOptimize(contacts);
+        }
+        state.setCounter("contacts", contacts.size());
+    }
+
+    void narrowPhaseSphereAndPlane(bench::State& state)
+    {
+        BodyStore store;
+        CollisionDetector detector;
+        SphereCollider sphere(createBody(store, Vector3(0.0f, 0.4f, 0.0f), Quaternion()), 0.5f);
+        PlaneCollider plane(Vector3(0.0f, 1.0f, 0.0f), 0.0f);
+
+        std::vector<Contact> contacts;
+        contacts.reserve(8);
+        while (state.keepRunning())
+        {
+            contacts.clear();
+            NarrowPhaseBenchmark::sphereAndPlane(detector, contacts, sphere, plane);
+            bench::doNotOptimize(contacts);
+        }
+        state.setCounter("contacts", contacts.size());
+    }
+
+    /* 구 1000 개를 무작위 위치에 흩어 놓고 AABB 가 겹치는 쌍을 모두 검사한다.
+        arg 가 0 이면 sphereAndSphere 로 하나씩, 1 이면 중심 좌표를 모아 묶음으로 검사한다 */
+    void narrowPhaseSpherePairs(bench::State& state)
+    {
+        const int sphereCount = 1000;
+        BodyStore store;
+        CollisionDetector detector;
+        std::mt19937 random(7);
+        std::uniform_real_distribution<float> uniform(-1.0f, 1.0f);
+        bool isBatched = state.range() != 0;
+
+        float extent = cbrtf((float)sphereCount) * 0.8f;
+        std::vector<SphereCollider> spheres;
+        spheres.reserve(sphereCount);
+        for (int i = 0; i < sphereCount; ++i)
+        {
+            Vector3 position(uniform(random) * extent, uniform(random) * extent, uniform(random) * extent);
+            spheres.push_back(SphereCollider(createBody(store, position, Quaternion()), 0.3f + 0.2f * fabsf(uniform(random))));
+        }
+
+        std::vector<std::pair<int, int>> pairs;
+        for (int i = 0; i < sphereCount; ++i)
+        {
+            AABB aabb = spheres[i].calcAABB();
+            for (int j = i + 1; j < sphereCount; ++j)
+            {
+                if (aabb.overlaps(spheres[j].calcAABB()))
+                    pairs.push_back(std::make_pair(i, j));
+            }
+        }
+
+        std::vector<Contact> contacts;
+        contacts.reserve(pairs.size());
+        while (state.keepRunning())
+        {
+            contacts.clear();
+            if (isBatched)
+            {
+                for (const auto& pair : pairs)
+                    NarrowPhaseBenchmark::addSpherePair(detector, spheres[pair.first], spheres[pair.second]);
+                NarrowPhaseBenchmark::detectSpherePairBatch(detector, contacts);
+            }
+            else
+            {
+                for (const auto& pair : pairs)
+                    NarrowPhaseBenchmark::sphereAndSphere(detector, contacts, spheres[pair.first], spheres[pair.second]);
+            }
+            bench::doNotOptimize(contacts);
+        }
+        state.setCounter("pairs", pairs.size());
+        state.setCounter("contacts", contacts.size());
+        state.setCounter("width", isBatched ? CollisionDetector::getSphereBatchWidth() : 1);
+    }
+
+    /* 구 1000 개 중 절반 정도가 지면에 닿아 있다. arg 는 narrowPhaseSpherePairs 와 같다 */
+    void narrowPhaseSpherePlanes(bench::State& state)
+    {
+        const int sphereCount = 1000;
+        BodyStore store;
+        CollisionDetector detector;
+        std::mt19937 random(7);
+        std::uniform_real_distribution<float> uniform(-1.0f, 1.0f);
+        bool isBatched = state.range() != 0;
+
+        std::vector<SphereCollider> spheres;
+        spheres.reserve(sphereCount);
+        for (int i = 0; i < sphereCount; ++i)
+        {
+            Vector3 position(uniform(random) * 20.0f, 0.5f + 0.2f * uniform(random), uniform(random) * 20.0f);
+            spheres.push_back(SphereCollider(createBody(store, position, Quaternion()), 0.5f));
+        }
+        PlaneCollider plane(Vector3(0.0f, 1.0f, 0.0f), 0.0f);
+
+        std::vector<Contact> contacts;
+        contacts.reserve(sphereCount);
+        while (state.keepRunning())
+        {
+            contacts.clear();
+            if (isBatched)
+            {
+                for (const SphereCollider& sphere : spheres)
+                    NarrowPhaseBenchmark::addSpherePlane(detector, sphere);
+                NarrowPhaseBenchmark::detectSpherePlaneBatch(detector, contacts, plane);
+            }
+            else
+            {
+                for (const SphereCollider& sphere : spheres)
+                    NarrowPhaseBenchmark::sphereAndPlane(detector, contacts, sphere, plane);
+            }
+            bench::doNotOptimize(contacts);
+        }
+        state.setCounter("contacts", contacts.size());
+        state.setCounter("width", isBatched ? CollisionDetector::getSphereBatchWidth() : 1);
+    }
+
+    /* 면-점 접촉 */
+    void narrowPhaseBoxAndBoxFace(bench::State& state)
+    {
+        BodyStore store;
+        CollisionDetector detector;
+        BoxCollider box1(createBody(store, Vector3(0.0f, 0.5f, 0.0f), makeOrientation(1.0f, 0.01f, 0.02f, 0.01f)), 0.5f, 0.5f, 0.5f);
+        BoxCollider box2(createBody(store, Vector3(0.2f, 1.45f, 0.1f), makeOrientation(1.0f, 0.2f, 0.3f, 0.1f)), 0.5f, 0.5f, 0.5f);
+
+        std::vector<Contact> contacts;
+        contacts.reserve(8);
+        while (state.keepRunning())
+        {
+            contacts.clear();
+            NarrowPhaseBenchmark::boxAndBox(detector, contacts, box1, box2);
+            bench::doNotOptimize(contacts);
+        }
+        state.setCounter("contacts", contacts.size());
+    }
+
+    /* 면-면 접촉. 쌓인 직육면체처럼 위의 직육면체를 y 축으로 조금 돌려 아랫면을 윗면으로 자른다 */
+    void narrowPhaseBoxAndBoxResting(bench::State& state)
+    {
+        BodyStore store;
+        CollisionDetector detector;
+        BoxCollider box1(createBody(store, Vector3(0.0f, 0.5f, 0.0f), makeOrientation(1.0f, 0.002f, 0.0f, 0.001f)), 0.5f, 0.5f, 0.5f);
+        BoxCollider box2(createBody(store, Vector3(0.1f, 1.49f, -0.05f), makeOrientation(1.0f, 0.0f, 0.2f, 0.0f)), 0.5f, 0.5f, 0.5f);
+
+        std::vector<Contact> contacts;
+        contacts.reserve(8);
+        while (state.keepRunning())
+        {
+            contacts.clear();
+            NarrowPhaseBenchmark::boxAndBox(detector, contacts, box1, box2);
+            bench::doNotOptimize(contacts);
+        }
+        state.setCounter("contacts", contacts.size());
+    }
+
+    /* arg 개의 직육면체를 무작위 위치와 방향으로 흩어 놓고 AABB 가 겹치는 쌍을 모두 검사한다.
+        물체가 움직이지 않으므로 두 번째 반복부터는 직전 프레임의 분리축을 다시 쓸 수 있다 */
+    void narrowPhaseBoxAndBoxCloud(bench::State& state)
+    {
+        int boxCount = state.range();
+        BodyStore store;
+        CollisionDetector detector;
+        std::mt19937 random(7);
+        std::uniform_real_distribution<float> uniform(-1.0f, 1.0f);
+
+        /* 직육면체 하나가 평균 서너 개의 AABB 와 겹치는 밀도 */
+        float extent = cbrtf((float)boxCount) * 1.6f;
+        std::vector<BoxCollider> boxes;
+        boxes.reserve(boxCount);
+        for (int i = 0; i < boxCount; ++i)
+        {
+            Vector3 position(uniform(random) * extent, uniform(random) * extent, uniform(random) * extent);
+            Quaternion orientation = makeOrientation(uniform(random), uniform(random), uniform(random), uniform(random));
+            RigidBody* body = createBody(store, position, orientation);
+            boxes.push_back(BoxCollider(body, 0.3f + 0.2f * fabsf(uniform(random)), 0.3f + 0.2f * fabsf(uniform(random)), 0.5f));
+        }
+
+        std::vector<std::pair<int, int>> pairs;
+        for (int i = 0; i < boxCount; ++i)
+        {
+            AABB aabb = boxes[i].calcAABB();
+            for (int j = i + 1; j < boxCount; ++j)
+            {
+                if (aabb.overlaps(boxes[j].calcAABB()))
+                    pairs.push_back(std::make_pair(i, j));
+            }
+        }
+
+        std::vector<Contact> contacts;
+        contacts.reserve(pairs.size() * 4);
+        unsigned int collidingPairCount = 0;
+        while (state.keepRunning())
+        {
+            contacts.clear();
+            collidingPairCount = 0;
+            for (const auto& pair : pairs)
+            {
+                if (NarrowPhaseBenchmark::boxAndBox(detector, contacts, boxes[pair.first], boxes[pair.second]))
+                    ++collidingPairCount;
+            }
+            bench::doNotOptimize(contacts);
+        }
+        state.setCounter("pairs", pairs.size());
+        state.setCounter("colliding", collidingPairCount);
+        state.setCounter("contacts", contacts.size());
+    }
+
+    /* 선-선 접촉. 위의 직육면체를 x 축, 아래 직육면체를 z 축으로 45 도 돌려 모서리끼리 만나게 한다 */
+    void narrowPhaseBoxAndBoxEdge(bench::State& state)
+    {
+        const float halfAngle = 0.3926991f;
+        BodyStore store;
+        CollisionDetector detector;
+        BoxCollider box1(createBody(store, Vector3(0.0f, 0.7f, 0.0f), makeOrientation(cosf(halfAngle), 0.0f, 0.01f, sinf(halfAngle))), 0.5f, 0.5f, 0.5f);
+        BoxCollider box2(createBody(store, Vector3(0.0f, 2.05f, 0.0f), makeOrientation(cosf(halfAngle), sinf(halfAngle), 0.01f, 0.0f)), 0.5f, 0.5f, 0.5f);
+
+        std::vector<Contact> contacts;
+        contacts.reserve(8);
+        while (state.keepRunning())
+        {
+            contacts.clear();
+            NarrowPhaseBenchmark::boxAndBox(detector, contacts, box1, box2);
+            bench::doNotOptimize(contacts);
+        }
+        state.setCounter("contacts", contacts.size());
+    }
+
+    void narrowPhaseBoxAndPlane(bench::State& state)
+    {
+        BodyStore store;
+        CollisionDetector detector;
+        BoxCollider box(createBody(store, Vector3(0.0f, 0.45f, 0.0f), makeOrientation(1.0f, 0.01f, 0.02f, 0.01f)), 0.5f, 0.5f, 0.5f);
+        PlaneCollider plane(Vector3(0.0f, 1.0f, 0.0f), 0.0f);
+
+        std::vector<Contact> contacts;
+        contacts.reserve(8);
+        while (state.keepRunning())
+        {
+            contacts.clear();
+            NarrowPhaseBenchmark::boxAndPlane(detector, contacts, box, plane);
+            bench::doNotOptimize(contacts);
+        }
+        state.setCounter("contacts", contacts.size());
+    }
+
+    /* 엇갈려 놓인 두 캡슐. arg 가 1 이면 같은 쌍을 GJK/EPA 로 검사한다 */
+    void narrowPhaseCapsuleAndCapsule(bench::State& state)
+    {
+        BodyStore store;
+        CollisionDetector detector;
+        CapsuleCollider capsule1(createBody(store, Vector3(0.0f, 0.3f, 0.0f), makeOrientation(1.0f, 0.0f, 0.0f, 1.0f)), 0.3f, 0.8f);
+        CapsuleCollider capsule2(createBody(store, Vector3(0.1f, 0.85f, 0.05f), makeOrientation(1.0f, 1.0f, 0.0f, 0.0f)), 0.3f, 0.8f);
+        bool isGJK = state.range() != 0;
+
+        std::vector<Contact> contacts;
+        contacts.reserve(8);
+        while (state.keepRunning())
+        {
+            contacts.clear();
+            if (isGJK)
+                NarrowPhaseBenchmark::convexAndConvex(detector, contacts, capsule1, capsule2);
+            else
+                NarrowPhaseBenchmark::capsuleAndCapsule(detector, contacts, capsule1, capsule2);
+            bench::doNotOptimize(contacts);
+        }
+        state.setCounter("contacts", contacts.size());
+    }
+
+    void narrowPhaseCapsuleAndSphere(bench::State& state)
+    {
+        BodyStore store;
+        CollisionDetector detector;
+        CapsuleCollider capsule(createBody(store, Vector3(0.0f, 1.0f, 0.0f), makeOrientation(1.0f, 0.1f, 0.0f, 0.8f)), 0.3f, 0.8f);
+        SphereCollider sphere(createBody(store, Vector3(0.2f, 1.7f, 0.1f), Quaternion()), 0.5f);
+
+        std::vector<Contact> contacts;
+        contacts.reserve(8);
+        while (state.keepRunning())
+        {
+            contacts.clear();
+            NarrowPhaseBenchmark::capsuleAndSphere(detector, contacts, capsule, sphere);
+            bench::doNotOptimize(contacts);
+        }
+        state.setCounter("contacts", contacts.size());
+    }
+
+    /* 직육면체 위에 눕힌 캡슐. arg 가 1 이면 같은 쌍을 GJK/EPA 로 검사한다 */
+    void narrowPhaseCapsuleAndBox(bench::State& state)
+    {
+        BodyStore store;
+        CollisionDetector detector;
+        CapsuleCollider capsule(createBody(store, Vector3(0.1f, 1.28f, 0.0f), makeOrientation(1.0f, 0.0f, 0.02f, 1.0f)), 0.3f, 0.6f);
+        BoxCollider box(createBody(store, Vector3(0.0f, 0.5f, 0.0f), makeOrientation(1.0f, 0.01f, 0.02f, 0.01f)), 0.8f, 0.5f, 0.8f);
+        bool isGJK = state.range() != 0;
+
+        std::vector<Contact> contacts;
+        contacts.reserve(8);
+        while (state.keepRunning())
+        {
+            contacts.clear();
+            if (isGJK)
+                NarrowPhaseBenchmark::convexAndConvex(detector, contacts, capsule, box);
+            else
+                NarrowPhaseBenchmark::capsuleAndBox(detector, contacts, capsule, box);
+            bench::doNotOptimize(contacts);
+        }
+        state.setCounter("contacts", contacts.size());
+    }
+
+    void narrowPhaseCapsuleAndPlane(bench::State& state)
+    {
+        BodyStore store;
+        CollisionDetector detector;
+        CapsuleCollider capsule(createBody(store, Vector3(0.0f, 0.28f, 0.0f), makeOrientation(1.0f, 0.0f, 0.01f, 1.0f)), 0.3f, 0.8f);
+        PlaneCollider plane(Vector3(0.0f, 1.0f, 0.0f), 0.0f);
+
+        std::vector<Contact> contacts;
+        contacts.reserve(8);
+        while (state.keepRunning())
+        {
+            contacts.clear();
+            NarrowPhaseBenchmark::capsuleAndPlane(detector, contacts, capsule, plane);
+            bench::doNotOptimize(contacts);
+        }
+        state.setCounter("contacts", contacts.size());
+    }
+
+    /* 위의 면-점 접촉을 GJK/EPA 로 검사한다. arg 가 0 이면 매번 캐시를 지우고 처음부터,
+        1 이면 직전 단체에서 시작한다 */
+    void narrowPhaseGJKBoxAndBox(bench::State& state)
+    {
+        BodyStore store;
+        CollisionDetector detector;
+        BoxCollider box1(createBody(store, Vector3(0.0f, 0.5f, 0.0f), makeOrientation(1.0f, 0.01f, 0.02f, 0.01f)), 0.5f, 0.5f, 0.5f);
+        BoxCollider box2(createBody(store, Vector3(0.2f, 1.45f, 0.1f), makeOrientation(1.0f, 0.2f, 0.3f, 0.1f)), 0.5f, 0.5f, 0.5f);
+        bool isCached = state.range() != 0;
+
+        std::vector<Contact> contacts;
+        contacts.reserve(8);
+        while (state.keepRunning())
+        {
+            contacts.clear();
+            if (!isCached)
+                NarrowPhaseBenchmark::clearGJKCaches(detector);
+            NarrowPhaseBenchmark::convexAndConvex(detector, contacts, box1, box2);
+            bench::doNotOptimize(contacts);
+        }
+        state.setCounter("contacts", contacts.size());
+    }
+
+    /* 떨어져 있는 두 직육면체. 분리축을 찾으면 EPA 없이 끝난다 */
+    void narrowPhaseGJKBoxAndBoxSeparated(bench::State& state)
+    {
+        BodyStore store;
+        CollisionDetector detector;
+        BoxCollider box1(createBody(store, Vector3(0.0f, 0.5f, 0.0f), makeOrientation(1.0f, 0.01f, 0.02f, 0.01f)), 0.5f, 0.5f, 0.5f);
+        BoxCollider box2(createBody(store, Vector3(0.4f, 1.8f, 0.1f), makeOrientation(1.0f, 0.2f, 0.3f, 0.1f)), 0.5f, 0.5f, 0.5f);
+        bool isCached = state.range() != 0;
+
+        std::vector<Contact> contacts;
+        contacts.reserve(8);
+        while (state.keepRunning())
+        {
+            contacts.clear();
+            if (!isCached)
+                NarrowPhaseBenchmark::clearGJKCaches(detector);
+            NarrowPhaseBenchmark::convexAndConvex(detector, contacts, box1, box2);
+            bench::doNotOptimize(contacts);
+        }
+        state.setCounter("contacts", contacts.size());
+    }
+
+    void narrowPhaseGJKSphereAndBox(bench::State& state)
+    {
+        BodyStore store;
+        CollisionDetector detector;
+        SphereCollider sphere(createBody(store, Vector3(0.3f, 1.8f, 0.1f), Quaternion()), 0.5f);
+        BoxCollider box(createBody(store, Vector3(0.0f, 1.0f, 0.0f), makeOrientation(1.0f, 0.05f, 0.1f, 0.02f)), 0.5f, 0.5f, 0.5f);
+
+        std::vector<Contact> contacts;
+        contacts.reserve(8);
+        while (state.keepRunning())
+        {
+            contacts.clear();
+            NarrowPhaseBenchmark::convexAndConvex(detector, contacts, sphere, box);
+            bench::doNotOptimize(contacts);
+        }
+        state.setCounter("contacts", contacts.size());
+    }
+
+    /* side x side 격자를 삼각형 두 개씩으로 나눈 평평한 지형 */
+    void createGridMesh(TriangleMesh& mesh, int side)
+    {
+        float half = side * 0.5f;
+        for (int i = 0; i < side; ++i)
+        {
+            for (int j = 0; j < side; ++j)
+            {
+                Vector3 v00(j - half, 0.0f, i - half);
+                Vector3 v10(j + 1 - half, 0.0f, i - half);
+                Vector3 v01(j - half, 0.0f, i + 1 - half);
+                Vector3 v11(j + 1 - half, 0.0f, i + 1 - half);
+                mesh.addTriangle(v00, v01, v11);
+                mesh.addTriangle(v00, v11, v10);
+            }
+        }
+        mesh.build();
+    }
+
+    void narrowPhaseSphereAndTriangle(bench::State& state)
+    {
+        BodyStore store;
+        CollisionDetector detector;
+        SphereCollider sphere(createBody(store, Vector3(-0.2f, 0.45f, 0.2f), Quaternion()), 0.5f);
+        TriangleMesh mesh;
+        createGridMesh(mesh, 1);
+        const TriangleMesh::Triangle& triangle = mesh.getTriangles()[0];
+
+        std::vector<Contact> contacts;
+        contacts.reserve(8);
+        while (state.keepRunning())
+        {
+            contacts.clear();
+            NarrowPhaseBenchmark::sphereAndTriangle(detector, contacts, sphere, triangle);
+            bench::doNotOptimize(contacts);
+        }
+        state.setCounter("contacts", contacts.size());
+    }
+
+    /* 살짝 기울어진 직육면체의 아랫면이 삼각형에 닿는다 */
+    void narrowPhaseBoxAndTriangle(bench::State& state)
+    {
+        BodyStore store;
+        CollisionDetector detector;
+        BoxCollider box(createBody(store, Vector3(0.1f, 0.45f, -0.1f), makeOrientation(1.0f, 0.01f, 0.3f, 0.02f)), 0.5f, 0.5f, 0.5f);
+        TriangleMesh mesh;
+        createGridMesh(mesh, 1);
+        const TriangleMesh::Triangle& triangle = mesh.getTriangles()[0];
+
+        std::vector<Contact> contacts;
+        contacts.reserve(8);
+        while (state.keepRunning())
+        {
+            contacts.clear();
+            NarrowPhaseBenchmark::boxAndTriangle(detector, contacts, box, triangle);
+            bench::doNotOptimize(contacts);
+        }
+        state.setCounter("contacts", contacts.size());
+    }
+
+    /* mid phase. arg x arg 격자 지형에서 지름 1 인 물체의 AABB 와 겹치는 삼각형을 찾는다 */
+    void midPhaseTriangleMeshQuery(bench::State& state)
+    {
+        int side = state.range();
+        TriangleMesh mesh;
+        createGridMesh(mesh, side);
+
+        struct CountCallback
+        {
+            unsigned int count;
+            bool operator()(const TriangleMesh::Triangle&) { ++count; return true; }
+        } callback = {0};
+
+        unsigned int queryCount = 0;
+        while (state.keepRunning())
+        {
+            float x = (float)(queryCount * 7 % side) - side * 0.5f + 0.3f;
+            float z = (float)(queryCount * 13 % side) - side * 0.5f + 0.6f;
+            AABB aabb(Vector3(x - 0.5f, -0.1f, z - 0.5f), Vector3(x + 0.5f, 0.9f, z + 0.5f));
+            mesh.query(aabb, callback);
+            bench::doNotOptimize(callback.count);
+            ++queryCount;
+        }
+        state.setCounter("triangles", (double)callback.count / queryCount);
+    }
+
+    /* 간격 1 인 side x side 칸의 완만한 물결 지형 */
+    HeightfieldCollider createHeightfield(int side)
+    {
+        std::vector<float> heights((side + 1) * (side + 1));
+        for (int row = 0; row <= side; ++row)
+        {
+            for (int column = 0; column <= side; ++column)
+                heights[row * (side + 1) + column] = 0.1f * sinf(column * 0.7f) * cosf(row * 0.5f);
+        }
+        return HeightfieldCollider(side + 1, side + 1, 1.0f, Vector3(side * -0.5f, 0.0f, side * -0.5f), heights);
+    }
+
+    /* arg x arg 칸의 지형 위를 옮겨 다니는 구. 칸 수와 상관없이 AABB 아래의 칸만 검사한다 */
+    void narrowPhaseSphereAndHeightfield(bench::State& state)
+    {
+        int side = state.range();
+        BodyStore store;
+        CollisionDetector detector;
+        RigidBody* body = createBody(store, Vector3(), Quaternion());
+        SphereCollider sphere(body, 0.5f);
+        HeightfieldCollider heightfield = createHeightfield(side);
+
+        std::vector<Contact> contacts;
+        contacts.reserve(32);
+        unsigned int queryCount = 0;
+        unsigned int contactCount = 0;
+        while (state.keepRunning())
+        {
+            float x = (float)(queryCount * 7 % side) - side * 0.5f + 0.3f;
+            float z = (float)(queryCount * 13 % side) - side * 0.5f + 0.6f;
+            body->setPosition(x, 0.45f, z);
+            contacts.clear();
+            NarrowPhaseBenchmark::sphereAndHeightfield(detector, contacts, sphere, heightfield);
+            bench::doNotOptimize(contacts);
+            contactCount += contacts.size();
+            ++queryCount;
+        }
+        state.setCounter("contacts", (double)contactCount / queryCount);
+    }
+
+    void narrowPhaseBoxAndHeightfield(bench::State& state)
+    {
+        int side = state.range();
+        BodyStore store;
+        CollisionDetector detector;
+        RigidBody* body = createBody(store, Vector3(), makeOrientation(1.0f, 0.01f, 0.3f, 0.02f));
+        BoxCollider box(body, 0.5f, 0.5f, 0.5f);
+        HeightfieldCollider heightfield = createHeightfield(side);
+
+        std::vector<Contact> contacts;
+        contacts.reserve(32);
+        unsigned int queryCount = 0;
+        unsigned int contactCount = 0;
+        while (state.keepRunning())
+        {
+            float x = (float)(queryCount * 7 % side) - side * 0.5f + 0.3f;
+            float z = (float)(queryCount * 13 % side) - side * 0.5f + 0.6f;
+            body->setPosition(x, 0.45f, z);
+            contacts.clear();
+            NarrowPhaseBenchmark::boxAndHeightfield(detector, contacts, box, heightfield);
+            bench::doNotOptimize(contacts);
+            contactCount += contacts.size();
+            ++queryCount;
+        }
+        state.setCounter("contacts", (double)contactCount / queryCount);
+    }
+
+    PHYSICS_BENCHMARK("NarrowPhase/sphereAndSphere", narrowPhaseSphereAndSphere);
+    PHYSICS_BENCHMARK("NarrowPhase/sphereAndBox", narrowPhaseSphereAndBox);
+    PHYSICS_BENCHMARK("NarrowPhase/sphereAndPlane", narrowPhaseSphereAndPlane);
+    PHYSICS_BENCHMARK("NarrowPhase/spherePairs", narrowPhaseSpherePairs)->arg(0)->arg(1)->unit("us");
+    PHYSICS_BENCHMARK("NarrowPhase/spherePlanes", narrowPhaseSpherePlanes)->arg(0)->arg(1)->unit("us");
+    PHYSICS_BENCHMARK("NarrowPhase/boxAndBox/face", narrowPhaseBoxAndBoxFace);
+    PHYSICS_BENCHMARK("NarrowPhase/boxAndBox/resting", narrowPhaseBoxAndBoxResting);
+    PHYSICS_BENCHMARK("NarrowPhase/boxAndBox/edge", narrowPhaseBoxAndBoxEdge);
+    PHYSICS_BENCHMARK("NarrowPhase/boxAndBox/cloud", narrowPhaseBoxAndBoxCloud)->arg(1000)->unit("us");
+    PHYSICS_BENCHMARK("NarrowPhase/boxAndPlane", narrowPhaseBoxAndPlane);
+    PHYSICS_BENCHMARK("NarrowPhase/capsuleAndSphere", narrowPhaseCapsuleAndSphere);
+    PHYSICS_BENCHMARK("NarrowPhase/capsuleAndCapsule", narrowPhaseCapsuleAndCapsule)->arg(0)->arg(1);
+    PHYSICS_BENCHMARK("NarrowPhase/capsuleAndBox", narrowPhaseCapsuleAndBox)->arg(0)->arg(1);
+    PHYSICS_BENCHMARK("NarrowPhase/capsuleAndPlane", narrowPhaseCapsuleAndPlane);
+    PHYSICS_BENCHMARK("NarrowPhase/gjk/boxAndBox", narrowPhaseGJKBoxAndBox)->arg(0)->arg(1);
+    PHYSICS_BENCHMARK("NarrowPhase/gjk/boxAndBox/separated", narrowPhaseGJKBoxAndBoxSeparated)->arg(0)->arg(1);
+    PHYSICS_BENCHMARK("NarrowPhase/gjk/sphereAndBox", narrowPhaseGJKSphereAndBox);
+    PHYSICS_BENCHMARK("NarrowPhase/sphereAndTriangle", narrowPhaseSphereAndTriangle);
+    PHYSICS_BENCHMARK("NarrowPhase/boxAndTriangle", narrowPhaseBoxAndTriangle);
+    PHYSICS_BENCHMARK("MidPhase/triangleMesh/query", midPhaseTriangleMeshQuery)->arg(16)->arg(256);
+    PHYSICS_BENCHMARK("NarrowPhase/sphereAndHeightfield", narrowPhaseSphereAndHeightfield)->arg(16)->arg(256);
+    PHYSICS_BENCHMARK("NarrowPhase/boxAndHeightfield", narrowPhaseBoxAndHeightfield)->arg(16)->arg(256);
+
+    /* side x side 개의 기둥으로 4 층 쌓은 직육면체들과 그 충돌 정보 */
+    struct BoxStack
+    {
+        BodyStore store;
+        std::vector<RigidBody*> bodies;
+        std::unordered_map<unsigned int, Collider*> colliders;
+        std::vector<Contact> contacts;
+
+        ~BoxStack()
+        {
+            for (auto& collider : colliders)
+                delete collider.second;
+        }
+    };
+
+    void buildBoxStack(BoxStack& stack, long long side, float deltaTime)
+    {
+        const float spacing = 0.99f;
+        PlaneCollider groundCollider(Vector3(0.0f, 1.0f, 0.0f), 0.0f);
+        CollisionDetector detector;
+        detector.setBroadPhaseMode(SPATIAL_HASH);
+
+        unsigned int id = 0;
+        for (int layer = 0; layer < 4; ++layer)
+        {
+            for (long long i = 0; i < side; ++i)
+            {
+                for (long long j = 0; j < side; ++j)
+                {
+                    /* 축이 모두 나란하면 분리축 검사가 퇴화하므로 조금씩 기울인다 */
+                    RigidBody* body = createBody(
+                        stack.store,
+                        Vector3(i * spacing, 0.49f + layer * spacing, j * spacing),
+                        makeOrientation(1.0f, 0.01f * (id * 7 % 5 - 2.0f), 0.01f * (id * 3 % 5 - 2.0f), 0.01f * (id * 11 % 5 - 2.0f))
+                    );
+                    body->setAcceleration(0.0f, -9.8f, 0.0f);
+                    body->integrate(deltaTime);
+
+                    Collider* collider = new BoxCollider(body, 0.5f, 0.5f, 0.5f);
+                    stack.bodies.push_back(body);
+                    stack.colliders[id++] = collider;
+                    detector.addCollider(collider);
+                }
+            }
+        }
+
+        detector.detectCollision(stack.contacts, stack.colliders, groundCollider);
+    }
+
+    /* 충돌 해소.
+        직육면체 더미의 충돌 정보를 한 번 구해두고, 매 반복마다 같은 상태에서 resolveCollision 을 호출한다 */
+    void resolverResolveCollision(bench::State& state)
+    {
+        const float deltaTime = 1.0f / 60.0f;
+        BoxStack stack;
+        buildBoxStack(stack, state.range(), deltaTime);
+        const std::vector<RigidBody*>& bodies = stack.bodies;
+        const std::vector<Contact>& initialContacts = stack.contacts;
+
+        IslandManager islandManager;
+        islandManager.buildIslands(bodies, initialContacts);
+
+        std::vector<Vector3> velocities, rotations;
+        for (auto& body : bodies)
+        {
+            velocities.push_back(body->getVelocity());
+            rotations.push_back(body->getRotation());
+        }
+
+        /* 매번 같은 횟수만큼 반복하도록 수렴 검사와 warm starting 을 끈다 */
+        CollisionResolver resolver;
+        resolver.setConvergenceTolerance(0.0f);
+        resolver.setWarmStarting(false);
+
+        std::vector<Contact> contacts;
+        long long solvedContactCount = 0;
+        while (state.keepRunning())
+        {
+            state.pauseTiming();
+            contacts = initialContacts;
+            for (unsigned int i = 0; i < bodies.size(); ++i)
+            {
+                bodies[i]->setVelocity(velocities[i]);
+                bodies[i]->setRotation(rotations[i]);
+            }
+            state.resumeTiming();
+
+            resolver.resolveCollision(contacts, islandManager.getIslands(), deltaTime);
+            solvedContactCount += (long long)contacts.size() * resolver.getLastIterationCount();
+        }
+
+        state.setItemsProcessed(solvedContactCount);
+        state.setCounter("contacts", initialContacts.size());
+        state.setCounter("islands", islandManager.getIslands().size());
+    }
+
+    /* 충돌 하나의 충격량 계산. 직육면체 더미의 충돌들에 sequentialImpulse 를 한 번씩 적용한다.
+        island 분리, 색칠, 수렴 검사 없이 수학 연산과 강체 상태 접근만 측정한다 */
+    void resolverSequentialImpulse(bench::State& state)
+    {
+        const float deltaTime = 1.0f / 60.0f;
+        BoxStack stack;
+        buildBoxStack(stack, state.range(), deltaTime);
+
+        CollisionResolver resolver;
+        std::vector<Contact> contacts = stack.contacts;
+        float impulseSum = 0.0f;
+        while (state.keepRunning())
+        {
+            for (auto& contact : contacts)
+                impulseSum += ResolverBenchmark::sequentialImpulse(resolver, &contact, deltaTime);
+            bench::doNotOptimize(impulseSum);
+        }
+
+        state.setItemsProcessed(state.iterations() * (long long)contacts.size());
+        state.setCounter("contacts", contacts.size());
+    }
+
+    PHYSICS_BENCHMARK("CollisionResolver/resolveCollision", resolverResolveCollision)->arg(4)->arg(8)->unit("us");
+    PHYSICS_BENCHMARK("CollisionResolver/sequentialImpulse", resolverSequentialImpulse)->arg(8)->unit("us");
+}
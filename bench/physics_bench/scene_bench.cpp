@@ -0,0 +1,53 @@
+/* 장면 전체를 시뮬레이션하며 한 스텝에 걸리는 시간을 측정한다.
+    장면은 headless 실행기의 내장 장면을 그대로 사용하며,
+    반복 한 번이 Simulator::simulate 한 번이다 */
+
+#include "benchmark.h"
+#include <headless/scene.h>
+#include <vector>
+
+using namespace physics;
+
+namespace
+{
+    void simulateScene(bench::State& state, const char* presetName)
+    {
+        Simulator simulator;
+        Scene scene(simulator);
+        if (!scene.loadPreset(presetName))
+        {
+            state.skipWithError("can't load the scene");
+            return;
+        }
+
+        std::vector<ContactInfo*> contactInfo;
+        long long contactSum = 0;
+        while (state.keepRunning())
+        {
+            simulator.simulate(1.0f / 60.0f, contactInfo);
+
+            state.pauseTiming();
+            contactSum += contactInfo.size();
+            for (auto& info : contactInfo)
+                delete info;
+            contactInfo.clear();
+            state.resumeTiming();
+        }
+
+        state.setItemsProcessed(state.iterations());
+        state.setCounter("bodies", scene.getBodies().size());
+        state.setCounter("contacts_per_step", (double)contactSum / state.iterations());
+        state.setCounter("sleeping", simulator.getSleepingBodyCount());
+    }
+
+    void sceneSphereRain(bench::State& state) { simulateScene(state, "rain"); }
+    void sceneBoxPyramid(bench::State& state) { simulateScene(state, "preset1"); }
+    void sceneRamp(bench::State& state) { simulateScene(state, "preset2"); }
+    void sceneHeap(bench::State& state) { simulateScene(state, "heap"); }
+
+    /* 장면은 스텝마다 상태가 이어지므로 반복 횟수를 고정한다 */
+    PHYSICS_BENCHMARK("Scene/sphereRain", sceneSphereRain)->iterations(600)->unit("ms");
+    PHYSICS_BENCHMARK("Scene/boxPyramid", sceneBoxPyramid)->iterations(600)->unit("ms");
+    PHYSICS_BENCHMARK("Scene/ramp", sceneRamp)->iterations(600)->unit("ms");
+    PHYSICS_BENCHMARK("Scene/heap10k", sceneHeap)->iterations(120)->unit("ms");
+}
@@ -0,0 +1,121 @@
+/* warm starting 유무에 따른 충돌 해소 반복 횟수를 비교한다.
+    preset1 의 직육면체 피라미드를 그대로 쌓아두거나 구를 던져 무너뜨리면서
+    프레임마다 CollisionResolver 가 수렴할 때까지 사용한 반복 횟수와
+    마지막 1 초 동안 직육면체들이 프레임마다 움직인 평균 거리(떨림)를 잰다 */
+
+#include <physics/simulator.h>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+using namespace physics;
+
+namespace
+{
+    struct Result
+    {
+        double averageIterations;
+        double averageContacts;
+        double restingDrift;
+        double msPerStep;
+    };
+
+    /* Playground::loadPreset1 과 같은 배치 */
+    void loadPreset1(Simulator& simulator, std::vector<RigidBody*>& boxes, bool throwSphere)
+    {
+        unsigned int id = 0;
+        if (throwSphere)
+        {
+            RigidBody* sphere = simulator.addRigidBody(id, SPHERE, 0.0f, 1.0f, 7.0f);
+            simulator.addCollider(id, SPHERE, sphere)->setGeometricData(0.7);
+            sphere->setVelocity(0.0f, 0.0f, -30.0f);
+            ++id;
+        }
+
+        const float positions[6][2] = {
+            {0.0f, 0.5f}, {1.2f, 0.5f}, {-1.2f, 0.5f},
+            {0.7f, 1.5f}, {-0.7f, 1.5f},
+            {0.0f, 2.5f}
+        };
+        for (const auto& position : positions)
+        {
+            RigidBody* box = simulator.addRigidBody(id, BOX, position[0], position[1], 0.0f);
+            simulator.addCollider(id, BOX, box);
+            boxes.push_back(box);
+            ++id;
+        }
+    }
+
+    Result run(bool isWarmStarting, bool throwSphere)
+    {
+        Simulator simulator;
+        simulator.setWarmStarting(isWarmStarting);
+        /* 잠든 강체는 해소에서 빠지므로 반복 횟수를 비교할 수 있도록 끈다 */
+        simulator.setSleepingEnabled(false);
+        std::vector<RigidBody*> boxes;
+        loadPreset1(simulator, boxes, throwSphere);
+
+        const int stepCount = 600;
+        const int restingStepCount = 60;
+        const float deltaTime = 1.0f / 60.0f;
+
+        std::vector<ContactInfo*> contactInfo;
+        long long iterationSum = 0, contactSum = 0;
+        double restingDriftSum = 0.0, elapsed = 0.0;
+        std::vector<Vector3> prevPositions(boxes.size());
+        for (int step = 0; step < stepCount; ++step)
+        {
+            for (unsigned int i = 0; i < boxes.size(); ++i)
+                prevPositions[i] = boxes[i]->getPosition();
+
+            auto start = std::chrono::steady_clock::now();
+            simulator.simulate(deltaTime, contactInfo);
+            auto end = std::chrono::steady_clock::now();
+            elapsed += std::chrono::duration<double>(end - start).count();
+
+            iterationSum += simulator.getSolverIterationCount();
+            contactSum += contactInfo.size();
+            for (auto& info : contactInfo)
+                delete info;
+            contactInfo.clear();
+
+            if (step >= stepCount - restingStepCount)
+            {
+                for (unsigned int i = 0; i < boxes.size(); ++i)
+                    restingDriftSum += (boxes[i]->getPosition() - prevPositions[i]).magnitude();
+            }
+        }
+
+        Result result;
+        result.averageIterations = (double)iterationSum / stepCount;
+        result.averageContacts = (double)contactSum / stepCount;
+        result.restingDrift = restingDriftSum / (restingStepCount * boxes.size());
+        result.msPerStep = elapsed / stepCount * 1000.0;
+        return result;
+    }
+
+    void report(const char* sceneName, bool throwSphere)
+    {
+        Result cold = run(false, throwSphere);
+        Result warm = run(true, throwSphere);
+
+        printf("%-10s %-6s %12.2f %14.1f %14.6f %10.4f\n",
+            sceneName, "cold", cold.averageIterations, cold.averageContacts, cold.restingDrift, cold.msPerStep);
+        printf("%-10s %-6s %12.2f %14.1f %14.6f %10.4f\n",
+            sceneName, "warm", warm.averageIterations, warm.averageContacts, warm.restingDrift, warm.msPerStep);
+        printf("%-10s saved %.1f%% iterations per step\n",
+            sceneName, (1.0 - warm.averageIterations / cold.averageIterations) * 100.0);
+    }
+}
+
+int main()
+{
+    printf("%-10s %-6s %12s %14s %14s %10s\n",
+        "scene", "start", "iter/step", "points/step", "drift/step", "ms/step");
+
+    report("pyramid", false);
+    report("preset1", true);
+
+    return 0;
+}
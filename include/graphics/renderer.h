@@ -60,6 +60,10 @@ namespace graphics
         /* Shape 포인터 저장 */
         Shapes shapes;
 
+        /* 지면 대신 그리는 지형. 없다면 nullptr 이고 그리드를 그린다 */
+        Heightfield* heightfield;
+        glm::vec3 heightfieldOrigin;
+
         /* 배경 VAO 의 ID */
         unsigned int backgroundVAO;
 
@@ -83,6 +87,16 @@ namespace graphics
         Shape* addShape(unsigned int id, Geometry);
         void removeShape(unsigned int id);
 
+        /* 지형을 설정한다. 이미 지형이 있다면 교체한다. heights 는 row * columnCount + column 순서이다 */
+        void setHeightfield(
+            int columnCount,
+            int rowCount,
+            float cellSize,
+            glm::vec3 origin,
+            const std::vector<float>& heights
+        );
+        void removeHeightfield();
+
         void renderObject(
             unsigned int id,
             glm::vec3 color,
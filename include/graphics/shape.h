@@ -57,6 +57,51 @@ namespace graphics
         void generateVertices(double, ...);
         void generateIndices();
     };
+
+    /* 로컬 y 축 방향으로 세운 캡슐. 두 반구 사이를 원기둥 옆면으로 잇는다 */
+    class Capsule : public Shape
+    {
+    public:
+        static const int SECTOR_CNT = 36;
+        /* 반구 하나의 stack 수 */
+        static const int HALF_STACK_CNT = 9;
+
+    public:
+        Capsule();
+        /* 반지름과 두 반구 중심 사이 거리의 절반 */
+        void generateVertices(double, ...);
+        void generateIndices();
+    };
+
+    /* 로컬 y 축 방향으로 세운 원기둥 */
+    class Cylinder : public Shape
+    {
+    public:
+        static const int SECTOR_CNT = 36;
+
+    public:
+        Cylinder();
+        /* 반지름과 높이의 절반 */
+        void generateVertices(double, ...);
+        void generateIndices();
+    };
+
+    /* 일정한 간격의 격자점마다 높이를 가진 지형. 격자 전체를 인덱스 메쉬 하나로 그린다.
+        테두리는 GL_LINES 로 그리는 격자선이다 */
+    class Heightfield : public Shape
+    {
+    private:
+        int columnCount;
+        int rowCount;
+        /* row * columnCount + column 순서의 높이 */
+        std::vector<float> heights;
+
+    public:
+        Heightfield(int columnCount, int rowCount, float cellSize, const std::vector<float>& heights);
+        /* 격자 간격 */
+        void generateVertices(double, ...);
+        void generateIndices();
+    };
 } // namespace graphics
 
 
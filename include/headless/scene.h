@@ -0,0 +1,73 @@
+#ifndef SCENE_H
+#define SCENE_H
+
+#include "physics/simulator.h"
+#include <string>
+#include <vector>
+
+/* 헤드리스 실행기가 시뮬레이터에 올리는 장면.
+
+    장면 파일은 한 줄에 명령 하나를 쓰며 # 뒤는 주석이다.
+        sphere <x> <y> <z> <radius>
+        box <x> <y> <z> <halfX> <halfY> <halfZ>
+        capsule <x> <y> <z> <radius> <halfHeight>
+        cylinder <x> <y> <z> <radius> <halfHeight>
+        velocity <x> <y> <z>        직전에 추가한 물체의 속도
+        orientation <w> <x> <y> <z> 직전에 추가한 물체의 방향
+        fixed                       직전에 추가한 물체를 고정한다
+        mesh <file> [<x> <y> <z>]   OBJ 파일의 고정된 삼각형 메쉬. 상대 경로는 장면 파일 기준이다
+        heightfield <file> <cellSize> [<x> <y> <z>]
+                                    평면 지면 대신 사용할 지형. 파일의 한 줄이 한 행의 높이들이며
+                                    (x, y, z) 는 첫 격자점의 위치이다. 상대 경로는 장면 파일 기준이다
+        gravity <value>
+        restitution <ground> <object>
+*/
+class Scene
+{
+private:
+    physics::Simulator& simulator;
+
+    /* 새로운 물체에 부여될 ID 값 */
+    unsigned int newObjectID;
+
+    /* 추가된 순서대로 저장한 강체들. 체크섬은 이 순서로 계산한다 */
+    std::vector<physics::RigidBody*> bodies;
+
+public:
+    Scene(physics::Simulator& _simulator) : simulator(_simulator), newObjectID(0) {}
+
+    /* 장면 파일을 읽는다. 실패하면 false 를 반환한다 */
+    bool loadFile(const std::string& path);
+
+    /* 내장 장면을 불러온다. 이름이 없다면 false 를 반환한다
+        preset1 : 직육면체 피라미드와 날아오는 구 (Playground 의 F1)
+        preset2 : 기울어진 판 두 개와 구들 (Playground 의 F2)
+        piles   : 서로 떨어진 구 더미 1024 개
+        stack   : 서로 맞닿은 직육면체 500 개
+        rain    : 높이를 달리해 떨어지는 구 1000 개
+        heap    : 한데 모여 떨어져 쌓이는 구 10000 개 */
+    bool loadPreset(const std::string& name);
+
+    const std::vector<physics::RigidBody*>& getBodies() const { return bodies; }
+
+private:
+    physics::RigidBody* addSphere(float x, float y, float z, float radius);
+    physics::RigidBody* addBox(float x, float y, float z, float halfX, float halfY, float halfZ);
+    physics::RigidBody* addCapsule(float x, float y, float z, float radius, float halfHeight);
+    physics::RigidBody* addCylinder(float x, float y, float z, float radius, float halfHeight);
+    void fixBody(physics::RigidBody* body);
+
+    /* 상대 경로인 filePath 를 장면 파일이 있는 디렉터리 기준으로 바꾼다 */
+    std::string resolvePath(const std::string& scenePath, const std::string& filePath) const;
+    /* 높이 파일을 읽는다. 실패하면 false 를 반환한다 */
+    bool loadHeights(const std::string& path, int& columnCount, int& rowCount, std::vector<float>& heights) const;
+
+    void loadPreset1();
+    void loadPreset2();
+    void loadPiles();
+    void loadStack();
+    void loadRain();
+    void loadHeap();
+};
+
+#endif // SCENE_H
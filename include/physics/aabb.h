@@ -0,0 +1,60 @@
+#ifndef AABB_H
+#define AABB_H
+
+#include "vector3.h"
+
+namespace physics
+{
+    /* 축 정렬 경계 상자 (Axis-Aligned Bounding Box).
+        broad phase 에서 충돌 가능성이 있는 쌍을 추려내는 데 사용한다 */
+    struct AABB
+    {
+        Vector3 min;
+        Vector3 max;
+
+        /* 생성자 */
+        AABB() {}
+        AABB(const Vector3& _min, const Vector3& _max) : min(_min), max(_max) {}
+
+        /* 두 AABB 가 겹치는지 검사한다 */
+        bool overlaps(const AABB& other) const
+        {
+            return min.x <= other.max.x && max.x >= other.min.x
+                && min.y <= other.max.y && max.y >= other.min.y
+                && min.z <= other.max.z && max.z >= other.min.z;
+        }
+
+        /* 주어진 AABB 를 완전히 포함하는지 검사한다 */
+        bool contains(const AABB& other) const
+        {
+            return min.x <= other.min.x && min.y <= other.min.y && min.z <= other.min.z
+                && max.x >= other.max.x && max.y >= other.max.y && max.z >= other.max.z;
+        }
+
+        /* 두 AABB 를 모두 감싸는 AABB 를 반환한다 */
+        AABB merge(const AABB& other) const
+        {
+            return AABB(
+                Vector3(
+                    min.x < other.min.x ? min.x : other.min.x,
+                    min.y < other.min.y ? min.y : other.min.y,
+                    min.z < other.min.z ? min.z : other.min.z
+                ),
+                Vector3(
+                    max.x > other.max.x ? max.x : other.max.x,
+                    max.y > other.max.y ? max.y : other.max.y,
+                    max.z > other.max.z ? max.z : other.max.z
+                )
+            );
+        }
+
+        /* 겉넓이를 반환한다. 트리 구성 비용을 비교하는 데 사용한다 */
+        float calcSurfaceArea() const
+        {
+            Vector3 size = max - min;
+            return 2.0f * (size.x*size.y + size.y*size.z + size.z*size.x);
+        }
+    };
+} // namespace physics
+
+#endif // AABB_H
@@ -0,0 +1,188 @@
+#ifndef AABB_TREE_H
+#define AABB_TREE_H
+
+#include "collider.h"
+#include "aabb.h"
+#include "broadphase.h"
+#include <vector>
+
+namespace physics
+{
+    /* 동적 AABB 트리 (bounding volume hierarchy).
+        리프 노드는 충돌체를 여유 공간(margin)만큼 부풀린 fat AABB 로 감싸고,
+        내부 노드는 두 자식을 감싸는 AABB 를 가진다.
+        물체가 fat AABB 밖으로 벗어날 때만 리프를 다시 삽입하므로
+        대부분의 프레임에서 트리는 거의 바뀌지 않는다 */
+    class DynamicAABBTree
+    {
+    private:
+        static const int NULL_NODE = -1;
+
+        struct Node
+        {
+            AABB aabb;
+            /* 리프 노드일 때만 유효하다.
+                부풀리기 전의 AABB 와 충돌체를 저장한다 */
+            AABB tightAABB;
+            Collider* collider;
+            /* 사용 중이 아닌 노드는 이 값으로 다음 빈 노드를 가리킨다 */
+            int parent;
+            int child1;
+            int child2;
+            /* 리프는 0, 빈 노드는 -1 */
+            int height;
+
+            bool isLeaf() const { return child1 == NULL_NODE; }
+        };
+
+        std::vector<Node> nodes;
+        int root;
+        /* 빈 노드 목록의 첫 번째 노드 */
+        int freeList;
+
+        /* fat AABB 의 여유 공간 */
+        float margin;
+
+        /* query 와 rayCast 의 순회에 사용하는 스택. 매 질의마다 할당하지 않도록 재사용한다 */
+        std::vector<int> stack;
+
+    public:
+        DynamicAABBTree() : root(NULL_NODE), freeList(NULL_NODE), margin(0.1f) {}
+
+        /* 충돌체를 트리에 추가하고 proxy ID 를 반환한다 */
+        int createProxy(const AABB& aabb, Collider* collider);
+        void destroyProxy(int proxyID);
+
+        /* proxy 의 AABB 를 갱신한다.
+            AABB 가 fat AABB 밖으로 벗어나 리프를 다시 삽입했다면 true 를 반환한다 */
+        bool moveProxy(int proxyID, const AABB& aabb);
+
+        /* AABB 가 겹치는 충돌체 쌍을 pairs 에 저장한다 */
+        void findPairs(std::vector<ColliderPair>& pairs);
+
+        /* 반직선과 fat AABB 가 만나는 충돌체들을 가까운 노드부터 callback 에 넘긴다.
+            callback(Collider*, maxDistance) 는 새로운 최대 거리를 반환하며,
+            그보다 먼 노드들은 더 이상 방문하지 않는다 */
+        template <typename RayCastCallback>
+        void rayCast(
+            const Vector3& origin,
+            const Vector3& direction,
+            float maxDistance,
+            RayCastCallback& callback
+        );
+
+        /* fat AABB 가 주어진 AABB 와 겹치는 충돌체들을 callback 에 넘긴다.
+            callback(Collider*) 가 false 를 반환하면 탐색을 멈춘다 */
+        template <typename QueryCallback>
+        void query(const AABB& aabb, QueryCallback& callback);
+
+        int getHeight() const { return root == NULL_NODE ? 0 : nodes[root].height; }
+
+    private:
+        int allocateNode();
+        void freeNode(int nodeID);
+
+        void insertLeaf(int leaf);
+        void removeLeaf(int leaf);
+
+        /* nodeID 를 루트로 하는 서브트리가 한쪽으로 치우쳐 있다면 회전시킨다.
+            회전 후 서브트리의 새 루트를 반환한다 */
+        int balance(int nodeID);
+
+        /* 반직선이 AABB 와 만나는 지점까지의 거리를 구한다.
+            만나지 않거나 maxDistance 보다 멀다면 false 를 반환한다 */
+        static bool rayAndAABB(
+            const Vector3& origin,
+            const Vector3& direction,
+            const AABB& aabb,
+            float maxDistance,
+            float& distance
+        );
+    };
+
+    template <typename RayCastCallback>
+    void DynamicAABBTree::rayCast(
+        const Vector3& origin,
+        const Vector3& direction,
+        float maxDistance,
+        RayCastCallback& callback
+    )
+    {
+        if (root == NULL_NODE)
+            return;
+
+        stack.clear();
+        stack.push_back(root);
+        while (!stack.empty())
+        {
+            int nodeID = stack.back();
+            stack.pop_back();
+
+            const Node& node = nodes[nodeID];
+            float distance;
+            if (!rayAndAABB(origin, direction, node.aabb, maxDistance, distance))
+                continue;
+
+            if (node.isLeaf())
+            {
+                maxDistance = callback(node.collider, maxDistance);
+            }
+            else
+            {
+                /* 가까운 자식을 나중에 넣어 먼저 방문한다 */
+                float distance1, distance2;
+                bool hit1 = rayAndAABB(origin, direction, nodes[node.child1].aabb, maxDistance, distance1);
+                bool hit2 = rayAndAABB(origin, direction, nodes[node.child2].aabb, maxDistance, distance2);
+                if (hit1 && hit2)
+                {
+                    if (distance1 < distance2)
+                    {
+                        stack.push_back(node.child2);
+                        stack.push_back(node.child1);
+                    }
+                    else
+                    {
+                        stack.push_back(node.child1);
+                        stack.push_back(node.child2);
+                    }
+                }
+                else if (hit1)
+                    stack.push_back(node.child1);
+                else if (hit2)
+                    stack.push_back(node.child2);
+            }
+        }
+    }
+
+    template <typename QueryCallback>
+    void DynamicAABBTree::query(const AABB& aabb, QueryCallback& callback)
+    {
+        if (root == NULL_NODE)
+            return;
+
+        stack.clear();
+        stack.push_back(root);
+        while (!stack.empty())
+        {
+            int nodeID = stack.back();
+            stack.pop_back();
+
+            const Node& node = nodes[nodeID];
+            if (!node.aabb.overlaps(aabb))
+                continue;
+
+            if (node.isLeaf())
+            {
+                if (!callback(node.collider))
+                    return;
+            }
+            else
+            {
+                stack.push_back(node.child1);
+                stack.push_back(node.child2);
+            }
+        }
+    }
+} // namespace physics
+
+#endif // AABB_TREE_H
@@ -5,57 +5,42 @@
 #include "matrix3.h"
 #include "matrix4.h"
 #include "quaternion.h"
+#include "body_store.h"
 
 namespace physics
 {
+    /* 강체의 상태는 BodyStore 의 성분별 배열에 저장되고,
+        RigidBody 는 그 인덱스를 가리키는 핸들이다.
+        핸들은 BodyStore 만 생성 & 해제하며, 강체가 제거되기 전까지 주소가 바뀌지 않는다 */
     class RigidBody
     {
-    protected:        
-        /* 질량의 역수.
-            적분식에 활용하기 좋고,
-            무한대의 질량(ex. 배경)을 표현하기 편하다 */
-        float inverseMass;
+        friend class BodyStore;
+        friend class IslandManager;
+        friend class CollisionResolver;
+        friend class Simulator;
+        friend class CollisionDetector;
+        friend class Collider;
+
+    private:
+        BodyStore* store;
+        unsigned int index;
+
+    protected:
+        /* 속력이 문턱값 아래로 유지된 시간 */
+        float sleepTime;
+
+        /* IslandManager 가 사용하는 값들.
+            이번 프레임의 union-find 인덱스와 잠든 island 의 ID 를 저장한다 */
+        int islandIndex;
+        int sleepingIslandID;
 
-        /* 관성 모멘트 역텐서 */
-        Matrix3 inverseInertiaTensor;      // 로컬 좌표계 기준
-        Matrix3 inverseInertiaTensorWorld; // 월드 좌표계 기준
-
-        /* 강체의 위치 */
-        Vector3 position;
-
-        /* 강체가 바라보는 방향 */
-        Quaternion orientation;
-
-        /* 강체의 속도 */
-        Vector3 velocity;
-
-        /* 강체의 각속도 */
-        Vector3 rotation;
-
-        /* 강체의 가속도.
-            보통 중력 가속도만을 저장한다 */
-        Vector3 acceleration;
-
-        /* 직전 프레임에서 강체의 가속도.
-            중력 가속도 + 외부 힘에 의한 가속도를 저장한다 */
-        Vector3 prevAcceleration;
-
-        /* 선속도 댐핑 */
-        float linearDamping;
-
-        /* 각속도 댐핑 */
-        float angularDamping;
-
-        /* 로컬 -> 월드 변환 행렬 */
-        Matrix4 transformMatrix;
-
-        /* 강체에 가해진 힘 & 토크 */
-        Vector3 force;
-        Vector3 torque;
+        /* 생성자 */
+        RigidBody(BodyStore* _store, unsigned int _index)
+            : store(_store), index(_index), sleepTime(0.0f), islandIndex(-1), sleepingIslandID(-1) {}
 
     public:
-        /* 생성자 */
-        RigidBody() : linearDamping(0.99f), angularDamping(0.99f) {}
+        RigidBody(const RigidBody&) = delete;
+        RigidBody& operator=(const RigidBody&) = delete;
 
         /* 주어진 시간이 흘렀을 때, 강체의 상태를 계산 및 갱신한다 */
         void integrate(float duration);
@@ -71,15 +56,27 @@ namespace physics
         /* 주어진 사원수만큼 강체의 방향을 변경한다 */
         void rotateByQuat(const Quaternion&);
 
-        bool isFixed() {return inverseMass == 0.0f ? true : false;}
+        /* 질량이 무한대인 강체인지 여부 */
+        bool isFixed() const;
+
+        /* 강체를 재우거나 깨운다. 재울 때는 속도와 각속도를 0 으로 만든다.
+            잠든 강체는 적분, 충돌 검출, 충돌 해소에서 제외되고, setter 로 상태를 바꾸면 깨어난다 */
+        void setAwake(bool value);
+        bool isAwake() const;
 
-    private:    
+    private:
         /* 현재 상태를 참고하여 변환 행렬을 업데이트한다 */
         void updateTransformMatrix();
 
         /* 관성 모멘트 텐서를 로컬 -> 월드 좌표계 기준으로 변환한다 */
         void transformInertiaTensor();
 
+        /* 잠든 강체라면 깨운다. 상태를 바꾸는 setter 들이 호출한다 */
+        void wakeUp() { if (!isAwake()) setAwake(true); }
+
+        /* 변환 행렬 중 회전 변환 행렬을 반환한다 */
+        Matrix3 getRotationMatrix() const;
+
     public:
         /* setter */
         void setMass(float value); // 함수 내부에서 질량의 역수로 바꿔 저장한다
@@ -92,7 +89,7 @@ namespace physics
         void setPosition(float x, float y, float z);
 
         void setOrientation(const Quaternion&);
-        
+
         void setVelocity(const Vector3& vec);
         void setVelocity(float x, float y, float z);
 
@@ -110,7 +107,7 @@ namespace physics
         Matrix3 getInverseInertiaTensor() const;
         Matrix3 getInverseInertiaTensorWorld() const;
         Vector3 getPosition() const;
-        Quaternion getOrientation() const { return orientation; }
+        Quaternion getOrientation() const;
         Vector3 getVelocity() const;
         Vector3 getRotation() const;
         Vector3 getAcceleration() const;
@@ -118,7 +115,10 @@ namespace physics
 
         void getTransformMatrix(float matrix[16]) const;
         Matrix4 getTransformMatrix() const;
-    }; 
+
+        /* 월드 -> 로컬 변환 행렬. 적분하거나 위치 & 방향을 바꿀 때 미리 구해 두므로 역행렬을 계산하지 않는다 */
+        Matrix4 getInverseTransformMatrix() const;
+    };
 } // namespace physics
 
 #endif // RIGID_BODY_H
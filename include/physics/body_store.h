@@ -0,0 +1,106 @@
+#ifndef BODY_STORE_H
+#define BODY_STORE_H
+
+#include <vector>
+
+namespace physics
+{
+    class RigidBody;
+    class Collider;
+
+    /* 강체들의 상태를 성분별 배열 (structure of arrays) 로 저장한다.
+        같은 성분이 메모리에 연속해 있으므로 적분을 SIMD 로 여러 강체씩 처리할 수 있다.
+        RigidBody 는 이 저장소의 인덱스를 가리키는 핸들이며, 강체가 제거되어
+        인덱스가 바뀌더라도 핸들의 주소는 그대로 유지된다 */
+    class BodyStore
+    {
+        friend class RigidBody;
+        friend class Collider;
+        /* 구의 묶음 충돌 검사가 위치 배열에서 중심 좌표를 바로 모은다 */
+        friend class CollisionDetector;
+
+    private:
+        /* 선형 상태 */
+        std::vector<float> position[3];
+        std::vector<float> velocity[3];
+        std::vector<float> acceleration[3];
+        std::vector<float> prevAcceleration[3];
+        std::vector<float> force[3];
+        std::vector<float> inverseMass;
+        std::vector<float> linearDamping;
+
+        /* 회전 상태. orientation 은 w, x, y, z 순서이다 */
+        std::vector<float> orientation[4];
+        std::vector<float> rotation[3];
+        std::vector<float> torque[3];
+        std::vector<float> angularDamping;
+
+        /* 관성 모멘트 역텐서 (로컬 & 월드 좌표계 기준) */
+        std::vector<float> inverseInertiaTensor[9];
+        std::vector<float> inverseInertiaTensorWorld[9];
+
+        /* 로컬 -> 월드 변환 행렬의 위쪽 세 행. 마지막 행은 항상 (0, 0, 0, 1) 이다 */
+        std::vector<float> transform[12];
+
+        /* 월드 -> 로컬 변환 행렬의 위쪽 세 행. transform 을 갱신할 때 함께 갱신한다.
+            회전 부분은 transform 의 전치이고 이동 성분은 -R^T p 이다 */
+        std::vector<float> inverseTransform[12];
+
+        /* 깨어 있다면 1, 잠들었다면 0 */
+        std::vector<float> awake;
+
+        /* damping^duration 의 캐시.
+            duration 이 바뀌거나 damping 이 바뀔 때만 powf 를 다시 계산한다 */
+        std::vector<float> linearDampingFactor;
+        std::vector<float> angularDampingFactor;
+        float dampingDuration;
+
+        /* 적분 밖에서 강체의 위치나 방향, 충돌체의 크기가 바뀔 때마다 증가한다.
+            Simulator 가 마지막 스텝 이후 충돌체 트리를 다시 갱신해야 하는지 판단하는 데 쓴다 */
+        unsigned int editCount;
+
+        /* 인덱스마다의 핸들 */
+        std::vector<RigidBody*> handles;
+
+        /* 모든 성분 배열. 추가 & 제거 시 한꺼번에 다룬다 */
+        std::vector<std::vector<float>*> arrays;
+
+    public:
+        BodyStore();
+        ~BodyStore();
+
+        BodyStore(const BodyStore&) = delete;
+        BodyStore& operator=(const BodyStore&) = delete;
+
+        /* 새 강체를 추가하고 핸들을 반환한다 */
+        RigidBody* createBody();
+
+        /* 강체를 제거하고 핸들을 해제한다.
+            마지막 강체를 빈 자리로 옮기므로 다른 핸들의 인덱스가 바뀔 수 있다 */
+        void destroyBody(RigidBody* body);
+
+        /* 깨어 있고 움직일 수 있는 모든 강체를 적분한다.
+            SIMD 폭만큼씩 묶어서 처리하고 남는 강체는 하나씩 처리한다 */
+        void integrate(float duration);
+
+        /* 강체 하나를 적분한다 */
+        void integrateBody(unsigned int index, float duration);
+
+        unsigned int getBodyCount() const { return handles.size(); }
+        unsigned int getEditCount() const { return editCount; }
+
+        /* 적분에 사용하는 SIMD 폭 (한 번에 처리하는 강체의 수) */
+        static unsigned int getBatchWidth();
+
+    private:
+        /* duration 이 바뀌었다면 damping^duration 캐시를 다시 계산한다 */
+        void updateDampingFactors(float duration);
+
+        /* index 부터 Lanes::width 개의 강체를 적분한다.
+            Lanes 는 lanes.h 의 스칼라, SSE, AVX 묶음 타입 중 하나이다 */
+        template <typename Lanes>
+        void integrateLanes(unsigned int index, float duration);
+    };
+} // namespace physics
+
+#endif // BODY_STORE_H
@@ -0,0 +1,76 @@
+#ifndef BROADPHASE_H
+#define BROADPHASE_H
+
+#include "collider.h"
+#include "aabb.h"
+#include <vector>
+#include <utility>
+
+namespace physics
+{
+    /* broad phase 가 narrow phase 로 넘겨주는 충돌 후보 쌍 */
+    typedef std::pair<Collider*, Collider*> ColliderPair;
+
+    /* broad phase 방식 */
+    enum BroadPhaseMode
+    {
+        BRUTE_FORCE,    // 모든 충돌체 쌍을 검사한다
+        SWEEP_AND_PRUNE,
+        AABB_TREE,
+        SPATIAL_HASH    // 크기가 비슷한 물체가 많을 때 알맞다
+    };
+
+    /* Sweep and Prune.
+        한 축에 대해 AABB 의 양 끝점을 정렬된 상태로 유지하고,
+        끝점들을 훑으면서 구간이 겹치는 쌍만을 충돌 후보로 찾는다.
+        물체들은 프레임 사이에 조금씩만 움직이므로 직전 프레임의 정렬 순서를
+        그대로 재사용하고 삽입 정렬로 갱신한다 (거의 정렬된 배열에서 O(n)) */
+    class SweepAndPrune
+    {
+    private:
+        struct Proxy
+        {
+            Collider* collider;
+            AABB aabb;
+        };
+
+        /* AABB 의 끝점. 정렬 축 위의 좌표를 저장한다 */
+        struct Endpoint
+        {
+            float value;
+            unsigned int proxyIdx;
+            bool isMin;
+        };
+
+        std::vector<Proxy> proxies;
+        std::vector<Endpoint> endpoints;
+
+        /* 끝점을 정렬하는 축 (0: x, 1: y, 2: z) */
+        int sweepAxis;
+
+        /* 훑는 동안 구간이 열려 있는 proxy 들의 인덱스 */
+        std::vector<unsigned int> activeProxies;
+
+    public:
+        SweepAndPrune() : sweepAxis(0) {}
+
+        void addCollider(Collider*);
+        void removeCollider(Collider*);
+
+        /* 끝점들을 갱신하고 AABB 가 겹치는 충돌체 쌍을 pairs 에 저장한다 */
+        void findPairs(std::vector<ColliderPair>& pairs);
+
+    private:
+        /* AABB 를 다시 계산하고 끝점의 좌표를 갱신한다 */
+        void updateEndpoints();
+
+        /* 물체들이 가장 넓게 퍼져 있는 축을 정렬 축으로 고른다.
+            축이 바뀌었다면 true 를 반환한다 */
+        bool chooseSweepAxis();
+
+        /* 직전 프레임의 순서를 시작점으로 끝점들을 삽입 정렬한다 */
+        void insertionSort();
+    };
+} // namespace physics
+
+#endif // BROADPHASE_H
@@ -3,6 +3,8 @@
 
 #include "body.h"
 #include "contact.h"
+#include "aabb.h"
+#include "triangle_mesh.h"
 #include "../playground/geometry.h"
 #include <vector>
 
@@ -20,10 +22,33 @@ namespace physics
     protected:
         RigidBody* body;
 
+        /* 충돌체의 도형 */
+        Geometry geometry;
+
+        /* 충돌체를 가진 오브젝트의 ID */
+        unsigned int id;
+
+        /* broad phase AABB 트리에서의 proxy ID */
+        int proxyID;
+
     public:
-        Collider() {}
+        Collider() : id(0), proxyID(-1) {}
         virtual ~Collider() {}
         virtual void setGeometricData(double, ...) = 0;
+
+        /* 충돌체를 감싸는 월드 좌표계 기준의 AABB 를 계산한다 */
+        virtual AABB calcAABB() const = 0;
+
+        /* 주어진 방향으로 가장 멀리 있는 충돌체 위의 점을 월드 좌표계로 반환한다 (support function).
+            GJK 와 EPA 는 이 함수만으로 임의의 볼록 도형 쌍의 충돌을 검사한다 */
+        virtual Vector3 support(const Vector3& direction) const = 0;
+
+        Geometry getGeometry() const { return geometry; }
+        unsigned int getID() const { return id; }
+
+    protected:
+        /* 크기가 바뀌었음을 강체 저장소에 알린다. setGeometricData 들이 호출한다 */
+        void markEdited() { ++body->store->editCount; }
     };
 
     class SphereCollider : public Collider
@@ -37,6 +62,8 @@ namespace physics
     public:
         SphereCollider(RigidBody* _body, float _radius);
         void setGeometricData(double, ...);
+        AABB calcAABB() const;
+        Vector3 support(const Vector3& direction) const;
     };
 
     class BoxCollider : public Collider
@@ -47,9 +74,61 @@ namespace physics
     protected:
         Vector3 halfSize;
 
+        /* 월드 좌표계 기준의 세 축. 직육면체끼리의 충돌 검사에서 쓰며
+            CollisionDetector 가 스텝마다 한 번 updateAxes 로 갱신한다 */
+        Vector3 axes[3];
+
     public:
         BoxCollider(RigidBody* body, float halfX, float halfY, float halfZ);
         void setGeometricData(double, ...);
+        AABB calcAABB() const;
+        Vector3 support(const Vector3& direction) const;
+
+        /* 강체의 방향으로 axes 를 다시 구한다 */
+        void updateAxes();
+    };
+
+    /* 로컬 y 축 위의 선분 (-halfHeight ~ halfHeight) 을 radius 만큼 부풀린 캡슐 */
+    class CapsuleCollider : public Collider
+    {
+        friend class CollisionDetector;
+        friend class Simulator;
+
+    protected:
+        float radius;
+        float halfHeight;
+
+    public:
+        CapsuleCollider(RigidBody* _body, float _radius, float _halfHeight);
+        void setGeometricData(double, ...);
+        AABB calcAABB() const;
+        Vector3 support(const Vector3& direction) const;
+
+        /* 캡슐 중심 선분의 양 끝점을 월드 좌표계로 구한다 */
+        void calcSegment(Vector3& start, Vector3& end) const;
+
+        /* 질량이 mass 인 캡슐의 로컬 좌표계 기준 관성 모멘트 텐서 */
+        static Matrix3 calcInertiaTensor(float mass, float radius, float halfHeight);
+    };
+
+    /* 로컬 y 축 방향으로 세운, 높이가 2 * halfHeight 인 원기둥 */
+    class CylinderCollider : public Collider
+    {
+        friend class CollisionDetector;
+        friend class Simulator;
+
+    protected:
+        float radius;
+        float halfHeight;
+
+    public:
+        CylinderCollider(RigidBody* _body, float _radius, float _halfHeight);
+        void setGeometricData(double, ...);
+        AABB calcAABB() const;
+        Vector3 support(const Vector3& direction) const;
+
+        /* 질량이 mass 인 원기둥의 로컬 좌표계 기준 관성 모멘트 텐서 */
+        static Matrix3 calcInertiaTensor(float mass, float radius, float halfHeight);
     };
 
     /* 바닥, 벽을 표현하기 위한 반무한체.
@@ -70,6 +149,66 @@ namespace physics
         PlaneCollider(Vector3 normal, float offset);
     };
 
+    /* 일정한 간격의 격자점마다 높이를 저장한 지형. 평면처럼 움직이지 않으며 지면 대신 사용할 수 있다.
+        칸 (column, row) 는 격자점 (column, row) 에서 (column + 1, row + 1) 로 가는 대각선으로 나눈 삼각형 두 개이다.
+        물체의 AABB 아래에 있는 칸만 좌표 계산으로 바로 찾는다 */
+    class HeightfieldCollider
+    {
+        friend class CollisionDetector;
+
+    protected:
+        /* x 축 방향과 z 축 방향의 격자점 수. 둘 다 2 이상이다 */
+        int columnCount;
+        int rowCount;
+        float cellSize;
+
+        /* 격자점 (0, 0) 의 위치. 격자점의 높이는 origin.y 에 더해진다 */
+        Vector3 origin;
+
+        /* row * columnCount + column 순서로 저장한 격자점의 높이 */
+        std::vector<float> heights;
+        float minHeight;
+        float maxHeight;
+
+    public:
+        HeightfieldCollider(
+            int columnCount,
+            int rowCount,
+            float cellSize,
+            const Vector3& origin,
+            const std::vector<float>& heights
+        );
+
+        int getColumnCount() const { return columnCount; }
+        int getRowCount() const { return rowCount; }
+        float getCellSize() const { return cellSize; }
+        const Vector3& getOrigin() const { return origin; }
+        const std::vector<float>& getHeights() const { return heights; }
+
+        /* 격자점의 월드 좌표 */
+        Vector3 getVertex(int column, int row) const
+        {
+            return Vector3(
+                origin.x + column * cellSize,
+                origin.y + heights[row * columnCount + column],
+                origin.z + row * cellSize
+            );
+        }
+
+        /* aabb 아래에 있는 칸들의 범위를 구한다. 겹치는 칸이 없다면 false 를 반환한다 */
+        bool calcCellRange(const AABB& aabb, int& minColumn, int& minRow, int& maxColumn, int& maxRow) const;
+
+        /* 칸의 삼각형 half (0 또는 1) 를 이웃 삼각형의 방향까지 채워 만든다.
+            0 은 대각선의 -x 쪽, 1 은 +x 쪽 삼각형이며 법선은 위를 향한다 */
+        void getTriangle(int column, int row, int half, TriangleMesh::Triangle& triangle) const;
+        /* getTriangle 을 두 단계로 나눈 것. 정점과 법선만으로 걸러낼 수 있다면 이웃의 방향은 구하지 않아도 된다 */
+        void calcTriangleFace(int column, int row, int half, TriangleMesh::Triangle& triangle) const;
+        void calcNeighborDirections(int column, int row, int half, TriangleMesh::Triangle& triangle) const;
+
+        /* (x, z) 에서 지형의 높이와 법선을 구한다. 격자 밖이라면 false 를 반환한다 */
+        bool calcHeightAt(float x, float z, float& height, Vector3& normal) const;
+    };
+
 } // namespace physics
 
 
@@ -2,15 +2,24 @@
 #define CONTACT_H
 
 #include "body.h"
+#include <cmath>
 
 namespace physics
 {
-    /* 충돌 정보를 저장하는 구조체 */
+    class Collider;
+
+    /* 충돌 정보를 저장하는 구조체.
+        매 프레임 재사용되는 배열에 값으로 저장되므로 동적 할당하지 않는다 */
     struct Contact
     {
+        /* 지면과의 충돌이라면 bodies[1] 은 nullptr 이다 */
         RigidBody* bodies[2];
         Vector3 normal;
-        Vector3* contactPoint[2];
+        /* bodies[1] 이 nullptr 라면 contactPoint[1] 은 사용하지 않는다 */
+        Vector3 contactPoint[2];
+        /* 두 물체 사이에서 이 충돌점을 만든 특징(정점, 변, 면)의 식별자.
+            프레임이 바뀌어도 같은 특징의 충돌점이라면 같은 값을 가진다 */
+        unsigned int featureID;
         float penetration;
         float restitution;
         float friction;
@@ -18,6 +27,32 @@ namespace physics
         float normalImpulseSum;
         float tangentImpulseSum1;
         float tangentImpulseSum2;
+
+        /* 충돌 법선에 수직하는 두 벡터를 찾는다 (erin catto 방법).
+            두 벡터는 서로 수직이고 길이가 같지만 단위 벡터는 아니다 */
+        void calcTangents(Vector3& tangent1, Vector3& tangent2) const
+        {
+            if (fabsf(normal.x) >= 0.57735f)
+                tangent1 = Vector3(normal.y, -normal.x, 0.0f);
+            else
+                tangent1 = Vector3(0.0f, normal.z, -normal.y);
+            tangent2 = normal.cross(tangent1);
+        }
+    };
+
+    /* 연속 충돌 검사 (CCD) 로 찾은 충돌 시각 (time of impact).
+        빠르게 움직이는 구가 스텝 도중 처음 부딪힌 순간을 기록한다 */
+    struct TOIEvent
+    {
+        /* colliders[0] 은 빠르게 움직인 구, colliders[1] 은 부딪힌 충돌체이다.
+            지면과 부딪혔다면 colliders[1] 은 nullptr 이다 */
+        Collider* colliders[2];
+        /* 부딪힌 순간의 충돌점과 colliders[1] 에서 colliders[0] 을 향하는 법선 */
+        Vector3 point;
+        Vector3 normal;
+        /* 스텝 중 부딪힌 시각의 비율 (0 ~ 1) 과 그 뒤로 남은 시간 (초) */
+        float fraction;
+        float remainingTime;
     };
 } // namespace physics
 
@@ -2,62 +2,449 @@
 #define DETECTOR_H
 
 #include "collider.h"
+#include "broadphase.h"
+#include "aabb_tree.h"
+#include "spatial_hash.h"
+#include "gjk.h"
+#include "triangle_mesh.h"
 #include <vector>
 #include <unordered_map>
+#include <functional>
+#include <utility>
+#include <cstddef>
 
 namespace physics
 {
     class CollisionDetector
     {
         friend class Simulator;
+        /* physics_bench 가 충돌 검사 함수들을 직접 호출해 측정한다 */
+        friend class NarrowPhaseBenchmark;
         
     private:
         float friction;
         float objectRestitution;
         float groundRestitution;
+
+        /* 충돌 후보 쌍을 찾는 방식 */
+        BroadPhaseMode broadPhaseMode;
+        SweepAndPrune sweepAndPrune;
+        SpatialHashGrid spatialHash;
+
+        /* 충돌체들의 AABB 트리.
+            broad phase 방식과 상관없이 반직선 검사를 위해 항상 유지한다 */
+        DynamicAABBTree colliderTree;
+
+        /* broad phase 가 찾은 충돌 후보 쌍 */
+        std::vector<ColliderPair> candidatePairs;
+        /* 직전 프레임에 narrow phase 로 넘겨진 충돌 후보 쌍의 개수 */
+        unsigned int candidatePairCount;
+
+        /* 연속 충돌 검사 설정.
+            한 스텝에 반지름의 ccdMotionThreshold 배보다 멀리 움직인 구만 검사한다.
+            부딪힌 구는 ccdSlop 만큼 파고든 위치로 되돌려 이산 충돌 검출이 충돌을 찾도록 한다 */
+        bool isCCDEnabled;
+        float ccdMotionThreshold;
+        float ccdSlop;
+        /* 이번 스텝에 연속 충돌 검사를 할 구들. 매 스텝 재사용한다 */
+        std::vector<SphereCollider*> ccdSpheres;
+
+        /* 전용 충돌 검사 함수가 없는 도형 쌍은 GJK & EPA 로 검사한다.
+            충돌체 쌍마다 GJK 단체를 저장해 두고 다음 프레임에 이어서 사용한다 */
+        GJKSolver gjkSolver;
+        std::unordered_map<unsigned long long, GJKCache> gjkCaches;
+        /* detectCollision 을 호출한 횟수. 쓰이지 않은 GJK 캐시와 분리축 캐시를 지우는 데 사용한다 */
+        unsigned int frameCount;
+
+        /* 직육면체 쌍마다 직전 프레임에 찾은 분리축. 물체는 한 스텝에 조금만 움직이므로
+            다음 프레임에도 대개 분리축이다. 가장 먼저 검사해 나머지 축의 검사를 건너뛴다 */
+        struct SeparatingAxisCache
+        {
+            /* 분리축 후보의 인덱스 (0 ~ 14). 직전 프레임에 충돌했다면 -1 이다 */
+            int axisIdx;
+            /* 직전 프레임에 충돌했을 때 충돌 법선으로 고른 축의 인덱스. 충돌하지 않았다면 -1 이다 */
+            int contactAxisIdx;
+            unsigned int lastFrame;
+
+            SeparatingAxisCache() : axisIdx(-1), contactAxisIdx(-1), lastFrame(0) {}
+        };
+        typedef std::pair<const BoxCollider*, const BoxCollider*> BoxPair;
+        struct BoxPairHash
+        {
+            std::size_t operator()(const BoxPair& pair) const
+            {
+                std::size_t hash1 = std::hash<const BoxCollider*>()(pair.first);
+                std::size_t hash2 = std::hash<const BoxCollider*>()(pair.second);
+                return hash1 ^ (hash2 + 0x9e3779b9 + (hash1 << 6) + (hash1 >> 2));
+            }
+        };
+        std::unordered_map<BoxPair, SeparatingAxisCache, BoxPairHash> separatingAxisCaches;
+
+        /* 직육면체 쌍의 분리축 검사에 쓰는 값들. 쌍마다 한 번 구해 15 개의 축에 다시 쓴다 */
+        struct BoxPairProjection
+        {
+            float halfSize1[3];
+            float halfSize2[3];
+            /* rotation[i][j] 는 box1 의 i 축과 box2 의 j 축의 내적이다 */
+            float rotation[3][3];
+            float absRotation[3][3];
+            /* 중심 사이 벡터를 box1 과 box2 의 축에 사영한 값 */
+            float distance1[3];
+            float distance2[3];
+        };
+
+        /* 구 - 구 쌍과 구 - 평면 지면 검사는 하나씩 하지 않고 모아 두었다가 묶음으로 검사한다.
+            쌍마다 두 강체의 BodyStore 인덱스와 반지름의 합을 성분별 배열에 모아 두고,
+            검사할 때 BodyStore 의 위치 배열에서 중심 좌표를 묶음으로 모아 (AVX2 의 gather) 여러 쌍을 한 번에 검사한다.
+            충돌한 쌍의 충돌 정보만 contacts 에 추가한다 */
+        bool isSphereBatchEnabled;
+        /* 배열들은 크기를 줄이지 않고 count 개까지만 사용하며 매 스텝 재사용한다.
+            모든 강체가 같은 BodyStore 에 있어야 하므로 다른 저장소의 강체는 받지 않는다 */
+        struct SpherePairBatch
+        {
+            unsigned int count;
+            const BodyStore* store;
+            std::vector<const SphereCollider*> spheres1;
+            std::vector<const SphereCollider*> spheres2;
+            std::vector<int> bodyIndices1;
+            std::vector<int> bodyIndices2;
+            std::vector<float> radiusSums;
+
+            SpherePairBatch() : count(0), store(nullptr) {}
+            void clear() { count = 0; store = nullptr; }
+            /* 쌍을 추가한다. 다른 BodyStore 의 강체라면 추가하지 않고 false 를 반환한다 */
+            bool add(const SphereCollider& sphere1, const SphereCollider& sphere2)
+            {
+                if (store == nullptr)
+                    store = sphere1.body->store;
+                if (sphere1.body->store != store || sphere2.body->store != store)
+                    return false;
+
+                if (count == radiusSums.size())
+                    grow();
+                spheres1[count] = &sphere1;
+                spheres2[count] = &sphere2;
+                bodyIndices1[count] = sphere1.body->index;
+                bodyIndices2[count] = sphere2.body->index;
+                radiusSums[count] = sphere1.radius + sphere2.radius;
+                ++count;
+                return true;
+            }
+            /* 배열들의 크기를 두 배로 늘린다 */
+            void grow();
+        };
+        SpherePairBatch spherePairBatch;
+        struct SpherePlaneBatch
+        {
+            unsigned int count;
+            const BodyStore* store;
+            std::vector<const SphereCollider*> spheres;
+            std::vector<int> bodyIndices;
+            std::vector<float> radii;
+
+            SpherePlaneBatch() : count(0), store(nullptr) {}
+            void clear() { count = 0; store = nullptr; }
+            bool add(const SphereCollider& sphere)
+            {
+                if (store == nullptr)
+                    store = sphere.body->store;
+                if (sphere.body->store != store)
+                    return false;
+
+                if (count == radii.size())
+                    grow();
+                spheres[count] = &sphere;
+                bodyIndices[count] = sphere.body->index;
+                radii[count] = sphere.radius;
+                ++count;
+                return true;
+            }
+            void grow();
+        };
+        SpherePlaneBatch spherePlaneBatch;
+
+        /* 지면처럼 움직이지 않는 삼각형 메쉬들. Simulator 가 소유한다 */
+        std::vector<TriangleMesh*> triangleMeshes;
+
+        /* 지면 대신 사용하는 지형. 없다면 nullptr 이고 평면 지면을 사용한다. Simulator 가 소유한다 */
+        HeightfieldCollider* heightfield;
     
     public:
         CollisionDetector()
-            : friction(0.6f), objectRestitution(0.3f), groundRestitution(0.2f) {}
+            : friction(0.6f), objectRestitution(0.3f), groundRestitution(0.2f),
+            broadPhaseMode(SWEEP_AND_PRUNE), candidatePairCount(0),
+            isCCDEnabled(true), ccdMotionThreshold(0.5f), ccdSlop(0.01f), frameCount(0),
+            isSphereBatchEnabled(true), heightfield(nullptr) {}
     
         /* 충돌을 검출하고 충돌 정보를 contacts 에 저장한다 */
         void detectCollision(
-            std::vector<Contact*>& contacts,
+            std::vector<Contact>& contacts,
             std::unordered_map<unsigned int, Collider*>& colliders,
             PlaneCollider& groundCollider
         );
+
+        /* 이번 스텝에 빠르게 움직인 구들이 지나온 경로를 검사한다.
+            스텝 도중 부딪힌 구는 처음 부딪힌 시각의 위치로 되돌리고 events 에 기록한다.
+            적분 직후, 이산 충돌 검출 전에 호출해야 한다 */
+        void detectTimeOfImpact(
+            std::vector<TOIEvent>& events,
+            std::unordered_map<unsigned int, Collider*>& colliders,
+            PlaneCollider& groundCollider,
+            float duration
+        );
+
+        /* 충돌 시각으로 되돌린 구들을 해소된 속도로 남은 시간만큼 움직인다.
+            그 사이에 다시 부딪힌다면 부딪힌 위치에서 멈춘다 */
+        void advanceTimeOfImpact(const std::vector<TOIEvent>& events, PlaneCollider& groundCollider);
+
+        /* broad phase 에 충돌체를 등록 또는 해제한다.
+            colliders 에 충돌체를 추가하거나 제거할 때 함께 호출해야 한다 */
+        void addCollider(Collider*);
+        void removeCollider(Collider*);
+
+        /* 고정된 삼각형 메쉬를 등록한다. 메쉬의 BVH 는 미리 만들어져 있어야 한다 */
+        void addTriangleMesh(TriangleMesh* mesh) { triangleMeshes.push_back(mesh); }
+
+        /* 평면 지면 대신 사용할 지형을 정한다. nullptr 이면 평면 지면으로 돌아간다 */
+        void setHeightfield(HeightfieldCollider* value) { heightfield = value; }
+
+        /* 반직선과 가장 먼저 만나는 충돌체를 찾는다.
+            만나는 충돌체가 없다면 false 를 반환한다 */
+        bool castRay(
+            const Vector3& origin,
+            const Vector3& direction,
+            Collider*& hitCollider,
+            float& hitDistance
+        );
+
+        void setBroadPhaseMode(BroadPhaseMode mode) { broadPhaseMode = mode; }
+        BroadPhaseMode getBroadPhaseMode() const { return broadPhaseMode; }
+        /* SPATIAL_HASH 방식의 셀 크기. 물체들의 지름 정도가 알맞다 */
+        void setSpatialHashCellSize(float value) { spatialHash.setCellSize(value); }
+        float getSpatialHashCellSize() const { return spatialHash.getCellSize(); }
+        unsigned int getCandidatePairCount() const { return candidatePairCount; }
+
+        /* false 라면 구 - 구 쌍과 구 - 평면 지면도 다른 도형처럼 하나씩 검사한다 */
+        void setSphereBatchEnabled(bool value) { isSphereBatchEnabled = value; }
+        bool getSphereBatchEnabled() const { return isSphereBatchEnabled; }
+        /* 묶음 검사가 한 번에 검사하는 쌍의 수. 빌드 설정에 따라 8 (AVX), 4 (SSE), 1 이다 */
+        static unsigned int getSphereBatchWidth();
+
+        void setCCDEnabled(bool value) { isCCDEnabled = value; }
+        void setCCDMotionThreshold(float value) { ccdMotionThreshold = value; }
     
     private:
+        /* castRay 에서 트리가 넘겨주는 충돌체에 대해 반직선 검사를 한다 */
+        struct RayCastCallback;
+
+        /* 연속 충돌 검사에서 트리가 넘겨주는 충돌체에 대해 충돌 시각을 구한다 */
+        struct SweepCallback;
+
+        /* 메쉬의 BVH 가 넘겨주는 삼각형과 충돌체를 검사한다 */
+        struct TriangleMeshCallback;
+
+        /* 움직인 충돌체들의 AABB 를 트리에 반영한다 */
+        void updateColliderTree(std::unordered_map<unsigned int, Collider*>& colliders);
+
+        /* 깨어 있고 고정되지 않은 강체만 충돌 검출의 대상이 된다 */
+        static bool isBodyActive(RigidBody* body) { return body->isAwake() && !body->isFixed(); }
+
+        /* 두 충돌체의 도형에 맞는 충돌 검사 함수를 호출한다.
+            두 강체 모두 잠들었거나 고정되어 있다면 검사하지 않는다 */
+        void detectCollisionPair(
+            std::vector<Contact>& contacts,
+            Collider* collider1,
+            Collider* collider2
+        );
+
+        /* 모아 둔 구 - 구 쌍과 구 - 평면 지면을 묶음으로 검사하고 비운다 */
+        void detectSpherePairBatch(std::vector<Contact>& contacts);
+        void detectSpherePlaneBatch(std::vector<Contact>& contacts, const PlaneCollider& plane);
+        /* index 부터 Lanes::width 개를 검사한다 */
+        template <typename Lanes>
+        void detectSpherePairLanes(std::vector<Contact>& contacts, unsigned int index);
+        template <typename Lanes>
+        void detectSpherePlaneLanes(std::vector<Contact>& contacts, unsigned int index, const PlaneCollider& plane);
+
         /* 충돌 검사 함수들.
-            충돌이 있다면 충돌 정보 구조체를 생성하고 contacts 에 푸쉬하고 true 를 반환한다.
+            충돌이 있다면 contacts 끝에 충돌 정보를 추가하고 true 를 반환한다.
             총돌이 없다면 false 를 반환한다 */
         bool sphereAndBox(
-            std::vector<Contact*>& contacts,
+            std::vector<Contact>& contacts,
             const SphereCollider&,
             const BoxCollider&
         );
         bool sphereAndSphere(
-            std::vector<Contact*>& contacts,
+            std::vector<Contact>& contacts,
             const SphereCollider&,
             const SphereCollider&
         );
         bool sphereAndPlane(
-            std::vector<Contact*>& contacts,
+            std::vector<Contact>& contacts,
             const SphereCollider&,
             const PlaneCollider&
         );
         /* Seperating Axis Theorem 사용 */
         bool boxAndBox(
-            std::vector<Contact*>& contacts,
+            std::vector<Contact>& contacts,
             const BoxCollider&,
             const BoxCollider&
         );
         bool boxAndPlane(
-            std::vector<Contact*>& contacts,
+            std::vector<Contact>& contacts,
+            const BoxCollider&,
+            const PlaneCollider&
+        );
+
+        /* 구가 start 에서 motion 만큼 움직이는 동안 가장 먼저 부딪히는 충돌체를 찾는다.
+            부딪힌다면 event 의 충돌체, 충돌점, 법선, 비율을 채우고 true 를 반환한다 */
+        bool sweepSphere(
+            SphereCollider& sphere,
+            const Vector3& start,
+            const Vector3& motion,
+            PlaneCollider& groundCollider,
+            TOIEvent& event
+        );
+
+        /* 반지름이 radius 인 구가 start 에서 motion 만큼 움직일 때 도형과 처음 닿는 비율 (0 ~ 1) 을 반환한다.
+            상대 도형은 멈춰 있다고 본다. 닿지 않거나 처음부터 겹쳐 있다면 음수를 반환한다 */
+        float sweptSphereAndPlane(
+            const Vector3& start,
+            const Vector3& motion,
+            float radius,
+            const PlaneCollider&,
+            Vector3& normal
+        );
+        float sweptSphereAndSphere(
+            const Vector3& start,
+            const Vector3& motion,
+            float radius,
+            const SphereCollider&,
+            Vector3& normal
+        );
+        /* 반지름만큼 부풀린 박스와 선분의 교차로 하한을 구한 뒤
+            모서리 근처는 conservative advancement 로 정확한 시각을 찾는다 */
+        float sweptSphereAndBox(
+            const Vector3& start,
+            const Vector3& motion,
+            float radius,
             const BoxCollider&,
+            Vector3& normal,
+            Vector3& point
+        );
+
+        /* 캡슐은 중심 선분 위의 가장 가까운 점을 중심으로 하는 구로 보고 검사한다 */
+        bool capsuleAndSphere(
+            std::vector<Contact>& contacts,
+            const CapsuleCollider&,
+            const SphereCollider&
+        );
+        /* 두 선분이 나란하다면 겹치는 구간의 양 끝에 충돌점을 하나씩 만든다 */
+        bool capsuleAndCapsule(
+            std::vector<Contact>& contacts,
+            const CapsuleCollider&,
+            const CapsuleCollider&
+        );
+        /* 직육면체의 로컬 좌표계에서 선분의 양 끝점과 직육면체의 12 개 모서리 중
+            가장 가까운 쌍을 찾는다. 선분이 직육면체를 뚫고 들어갔다면 GJK & EPA 로 검사한다 */
+        bool capsuleAndBox(
+            std::vector<Contact>& contacts,
+            const CapsuleCollider&,
+            const BoxCollider&
+        );
+        bool capsuleAndPlane(
+            std::vector<Contact>& contacts,
+            const CapsuleCollider&,
             const PlaneCollider&
         );
 
+        /* 반지름을 radius 와 캡슐의 반지름의 합으로 늘린 캡슐과 선분의 교차로 구한다 */
+        float sweptSphereAndCapsule(
+            const Vector3& start,
+            const Vector3& motion,
+            float radius,
+            const CapsuleCollider&,
+            Vector3& normal,
+            Vector3& point
+        );
+
+        /* 임의의 볼록 충돌체 쌍. GJK 로 겹침을 검사하고 EPA 로 충돌점 하나를 만든다 */
+        bool convexAndConvex(
+            std::vector<Contact>& contacts,
+            const Collider&,
+            const Collider&
+        );
+        /* 임의의 볼록 충돌체와 평면. 평면 쪽으로 가장 깊은 점과 그 주변을 support function 으로 찾는다 */
+        bool convexAndPlane(
+            std::vector<Contact>& contacts,
+            const Collider&,
+            const PlaneCollider&
+        );
+
+        /* 고정된 삼각형과의 충돌 검사 함수들. 충돌 정보의 bodies[1] 은 nullptr 이다.
+            삼각형은 양면이며 법선은 삼각형에서 물체 쪽을 향한다.
+            featureBase 는 calcStaticFeatureBase 로 구한 삼각형마다 다른 값으로, 충돌점의 featureID 에 더해진다 */
+        bool sphereAndTriangle(
+            std::vector<Contact>& contacts,
+            const SphereCollider&,
+            const TriangleMesh::Triangle&,
+            unsigned int featureBase
+        );
+        /* 직육면체의 로컬 좌표계에서 13 개의 축으로 SAT 검사를 한다.
+            면이 닿았다면 닿은 면끼리 잘라내어 충돌점을 여러 개 만든다 */
+        bool boxAndTriangle(
+            std::vector<Contact>& contacts,
+            const BoxCollider&,
+            const TriangleMesh::Triangle&,
+            unsigned int featureBase
+        );
+        /* 선분의 양 끝점, 또는 삼각형의 모서리와 가장 가까운 선분의 중간 점에서 충돌점을 만든다 */
+        bool capsuleAndTriangle(
+            std::vector<Contact>& contacts,
+            const CapsuleCollider&,
+            const TriangleMesh::Triangle&,
+            unsigned int featureBase
+        );
+        /* convexAndPlane 처럼 삼각형 안쪽으로 가장 깊은 점들을 support function 으로 찾는다.
+            찾은 점이 삼각형 위에 있어야 충돌로 본다. 모서리에만 걸친 경우는 놓칠 수 있다 */
+        bool convexAndTriangle(
+            std::vector<Contact>& contacts,
+            const Collider&,
+            const TriangleMesh::Triangle&,
+            unsigned int featureBase
+        );
+
+        /* 지형과의 충돌 검사 함수들. 물체의 AABB 아래에 있는 칸만 검사한다 */
+        /* 칸의 삼각형마다 sphereAndTriangle 을 호출한다 */
+        bool sphereAndHeightfield(
+            std::vector<Contact>& contacts,
+            const SphereCollider&,
+            const HeightfieldCollider&
+        );
+        /* boxAndPlane 처럼 지형 아래로 내려간 꼭짓점마다 그 자리의 법선으로 충돌점을 만든다.
+            직육면체 안으로 파고든 격자점은 가장 가까운 면으로 밀어낸다 */
+        bool boxAndHeightfield(
+            std::vector<Contact>& contacts,
+            const BoxCollider&,
+            const HeightfieldCollider&
+        );
+        /* 캡슐과 그 밖의 볼록 충돌체. 칸의 삼각형마다 삼각형과의 충돌 검사 함수를 호출한다 */
+        bool convexAndHeightfield(
+            std::vector<Contact>& contacts,
+            const Collider&,
+            const HeightfieldCollider&
+        );
+
+        /* 경로를 따라 중심 아래 지형과의 거리를 살펴 처음으로 반지름보다 가까워지는 비율을 찾는다.
+            경로 밖으로 솟은 봉우리의 옆면에 스치는 경우는 놓칠 수 있다 */
+        float sweptSphereAndHeightfield(
+            const Vector3& start,
+            const Vector3& motion,
+            float radius,
+            const HeightfieldCollider&,
+            Vector3& normal
+        );
+
         /* 선이 도형을 통과하는지 검사한다 
             카메라로부터 hit point 까지의 거리를 반환한다
             hit 하지 않는다면 음수를 반환한다 */
@@ -72,15 +459,37 @@ namespace physics
             const Vector3& direction,
             const BoxCollider&
         );
+
+        float rayAndCapsule(
+            const Vector3& origin,
+            const Vector3& direction,
+            const CapsuleCollider&
+        );
+
+        float rayAndCylinder(
+            const Vector3& origin,
+            const Vector3& direction,
+            const CylinderCollider&
+        );
     
     private:
-        /* 두 박스가 주어진 축에 대해 어느정도 겹치는지 반환한다 */
-        float calcPenetration(
+        /* 두 박스가 분리축 후보 axisIdx 에 대해 어느정도 겹치는지 반환한다.
+            0 ~ 2 는 box1 의 축, 3 ~ 5 는 box2 의 축, 6 ~ 14 는 box1 의 (axisIdx - 6) / 3 축과 box2 의 (axisIdx - 6) % 3 축의 외적이다.
+            평행한 두 모서리의 외적처럼 방향을 정할 수 없는 축이라면 FLT_MAX 를 반환한다 */
+        static float calcPenetration(const BoxPairProjection& projection, int axisIdx);
+        
+        /* 직육면체의 면-면 접촉일 때 기준 면에 가장 마주 보는 상대 직육면체의 면 (incident face) 을
+            기준 면의 네 옆면으로 잘라 (Sutherland-Hodgman) 기준 면 아래에 남은 점들을 충돌점으로 만든다.
+            5 개 이상이라면 기준 면의 네 대각선 방향으로 가장 먼 4 개만 남긴다.
+            충돌점을 만들지 못했다면 0 을 반환한다 */
+        int clipBoxFaces(
+            std::vector<Contact>& contacts,
             const BoxCollider& box1,
             const BoxCollider& box2,
-            const Vector3& axis
+            int minPenetrationAxisIdx,
+            const Vector3& normal
         );
-        
+
         /* 직육면체의 면-점 접촉일 때 충돌점을 찾는다 */
         void calcContactPointOnPlane(
             const BoxCollider& box1,
@@ -96,6 +505,95 @@ namespace physics
             int minPenetrationAxisIdx,
             Contact* contact
         );
+
+        /* 움직이지 않는 도형과의 충돌점은 bodies[1] 이 모두 nullptr 이라 물체 쌍만으로는 도형을 구분할 수 없다.
+            featureID 의 위 8 비트에 도형의 종류와 번호를 담아 서로 다른 도형의 충돌점이 같은 값을 갖지 않게 한다.
+            평면 지면은 0 을 쓰고, 메쉬는 등록된 순서대로 triangleMeshTag 부터 번호를 받는다 */
+        static const unsigned int heightfieldCellTag = 1;
+        static const unsigned int heightfieldPointTag = 2;
+        static const unsigned int triangleMeshTag = 3;
+
+        /* 도형 안의 primitiveIndex 번째 특징 (삼각형, 격자점) 에 충돌점 8 개 분량의 featureID 를 준다.
+            0 번 구간은 특징에 속하지 않는 충돌점을 위해 비워 둔다.
+            아래 24 비트에 담지 못하는 큰 번호는 같은 도형 안에서만 되풀이된다 */
+        static unsigned int calcStaticFeatureBase(unsigned int shapeTag, unsigned int primitiveIndex)
+        {
+            return (shapeTag << 24) | (((primitiveIndex + 1) & 0x1FFFFFu) << 3);
+        }
+
+        /* 직육면체의 로컬 좌표계 기준 정점이 어느 팔분면에 있는지 3 비트로 나타낸다.
+            충돌점의 featureID 를 만드는 데 사용한다 */
+        static unsigned int calcVertexSignBits(const Vector3& vertex);
+
+        /* 로컬 좌표계의 점과 가장 가까운 직육면체 위의 점을 반환한다 */
+        static Vector3 calcClosestPointOnBox(const Vector3& pointInBoxLocal, const Vector3& halfSize);
+
+        /* 점과 가장 가까운 삼각형 위의 점을 반환한다 */
+        static Vector3 calcClosestPointOnTriangle(const Vector3& point, const Vector3 (&vertices)[3]);
+
+        /* 충돌 법선이 삼각형의 변 바깥으로 기울어 이웃 삼각형의 면 쪽을 향하는지 검사한다.
+            그렇다면 이웃 삼각형이 충돌을 처리하므로 이 삼각형의 충돌점은 버린다.
+            평평하게 이어진 삼각형들의 경계에 물체가 걸리지 않는다 */
+        static bool isCoveredByNeighbor(const TriangleMesh::Triangle& triangle, const Vector3& normal);
+
+        /* 볼록 다각형 중 planeNormal · p <= planeOffset 인 부분만 남겨 out 에 저장하고 정점 수를 반환한다.
+            out 에는 count + 1 개의 공간이 있어야 한다 (Sutherland-Hodgman) */
+        static int clipPolygon(
+            const Vector3* polygon,
+            int count,
+            const Vector3& planeNormal,
+            float planeOffset,
+            Vector3* out
+        );
+
+        /* clipPolygon 과 같지만 정점마다 특징 번호를 함께 옮긴다.
+            평면 밖으로 나가는 변의 교차점은 잘려 나간 첫 정점의 번호를 이어받아, 정점이 평면을 살짝 넘어도 번호가 유지된다.
+            평면 안으로 들어오는 변의 교차점은 planeFeature 를 받는다 */
+        static int clipPolygon(
+            const Vector3* polygon,
+            const unsigned int* features,
+            int count,
+            const Vector3& planeNormal,
+            float planeOffset,
+            unsigned int planeFeature,
+            Vector3* out,
+            unsigned int* outFeatures
+        );
+
+        /* count 개의 점 중 axis1 ± axis2 의 네 대각선 방향으로 각각 가장 먼 점을 골라
+            selected 에 인덱스를 저장하고 개수를 반환한다. 깊이처럼 프레임마다 흔들리는 값을 쓰지 않으므로
+            같은 접촉에서는 매 프레임 같은 점들이 골라진다 */
+        static int reduceContactPoints(
+            const Vector3* points,
+            int count,
+            const Vector3& axis1,
+            const Vector3& axis2,
+            int (&selected)[4]
+        );
+
+        /* 점과 가장 가까운 선분 위의 점의 매개변수 (0 ~ 1) 를 반환한다 */
+        static float calcClosestPointOnSegment(const Vector3& point, const Vector3& start, const Vector3& end);
+
+        /* 두 선분 위에서 서로 가장 가까운 점의 매개변수 s, t (0 ~ 1) 를 구한다.
+            가장 가까운 두 점 사이 거리의 제곱을 반환한다 */
+        static float calcClosestPointsOfSegments(
+            const Vector3& start1,
+            const Vector3& end1,
+            const Vector3& start2,
+            const Vector3& end2,
+            float& s,
+            float& t
+        );
+
+        /* 반직선 origin + direction * t 가 선분 start-end 를 radius 만큼 부풀린 캡슐과 처음 만나는 t 를 반환한다.
+            만나지 않거나 origin 이 이미 캡슐 안에 있다면 음수를 반환한다 */
+        static float calcRayAndCapsule(
+            const Vector3& origin,
+            const Vector3& direction,
+            const Vector3& start,
+            const Vector3& end,
+            float radius
+        );
     };
 } // namespace physics
 
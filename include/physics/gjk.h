@@ -0,0 +1,121 @@
+#ifndef GJK_H
+#define GJK_H
+
+#include "collider.h"
+#include <vector>
+
+namespace physics
+{
+    /* 충돌체 쌍마다 다음 프레임까지 남겨두는 GJK 단체(simplex).
+        단체의 꼭짓점 대신 꼭짓점을 얻은 탐색 방향을 저장하고,
+        다음 프레임에 그 방향들로 support 점을 다시 구해 단체를 복원한다.
+        물체는 한 프레임 동안 조금만 움직이므로 대부분 한두 번 반복으로 끝난다 */
+    struct GJKCache
+    {
+        Vector3 directions[4];
+        int count;
+        /* 마지막으로 사용한 프레임. 오래 쓰이지 않은 캐시는 지운다 */
+        unsigned int lastFrame;
+
+        GJKCache() : count(0), lastFrame(0) {}
+    };
+
+    /* support function 만으로 두 볼록 충돌체의 충돌을 검사한다.
+        GJK 로 Minkowski 차 A - B 가 원점을 포함하는지 검사하고,
+        포함한다면 EPA 로 침투 깊이와 방향, 충돌점을 구한다 */
+    class GJKSolver
+    {
+    private:
+        /* Minkowski 차 위의 점과 그 점을 만든 두 충돌체 위의 점 */
+        struct SupportPoint
+        {
+            Vector3 point;
+            Vector3 pointA;
+            Vector3 pointB;
+            Vector3 direction;
+        };
+
+        /* EPA 다면체의 면. 법선은 다면체 바깥을 향한다 */
+        struct Face
+        {
+            int vertices[3];
+            Vector3 normal;
+            float distance;
+            bool isObsolete;
+        };
+
+        struct Edge
+        {
+            int vertices[2];
+        };
+
+        SupportPoint simplex[4];
+        int simplexCount;
+
+        /* EPA 에서 사용하는 배열들. 매 호출마다 할당하지 않도록 재사용한다 */
+        std::vector<SupportPoint> polytope;
+        std::vector<Face> faces;
+        std::vector<Edge> horizon;
+
+        int gjkIterationLimit;
+        int epaIterationLimit;
+        float epaTolerance;
+
+        /* 직전 intersect 에서 반복한 횟수 */
+        int lastIterationCount;
+
+    public:
+        GJKSolver() : simplexCount(0), gjkIterationLimit(32), epaIterationLimit(64),
+            epaTolerance(1e-4f), lastIterationCount(0) {}
+
+        /* 두 볼록 충돌체가 겹치는지 검사한다.
+            cache 의 단체에서 시작하고, 끝난 뒤의 단체를 cache 에 저장한다 */
+        bool intersect(const Collider& a, const Collider& b, GJKCache& cache);
+
+        /* intersect 가 true 를 반환한 직후에 호출한다.
+            EPA 로 침투 깊이와 두 충돌체 위의 충돌점을 구한다. normal 은 b 에서 a 를 향한다.
+            두 충돌체가 닿아만 있어 깊이를 구할 수 없다면 false 를 반환한다 */
+        bool calcPenetration(
+            const Collider& a,
+            const Collider& b,
+            Vector3& normal,
+            float& depth,
+            Vector3& pointA,
+            Vector3& pointB
+        );
+
+        int getLastIterationCount() const { return lastIterationCount; }
+
+    private:
+        /* Minkowski 차 A - B 의 support 점 */
+        static SupportPoint calcSupport(const Collider& a, const Collider& b, const Vector3& direction);
+
+        /* 단체에 점을 추가한다. 이미 있는 점과 같다면 추가하지 않고 false 를 반환한다 */
+        bool addSupportPoint(const SupportPoint& supportPoint);
+
+        /* 단체에서 원점과 가장 가까운 점을 구하고, 그 점을 표현하는 데 필요한 꼭짓점만 남긴다.
+            원점이 사면체 안에 있다면 true 를 반환한다 */
+        bool reduceSimplex(Vector3& closestPoint);
+        void reduceSegment(Vector3& closestPoint);
+        void reduceTriangle(Vector3& closestPoint);
+        bool reduceTetrahedron(Vector3& closestPoint);
+
+        /* 원점과 가장 가까운 삼각형 위의 점을 구하고, 필요한 꼭짓점의 인덱스를 indices 에 저장한다 */
+        static Vector3 calcClosestPointOnTriangle(
+            const SupportPoint* points[3],
+            int indices[3],
+            int& indexCount
+        );
+
+        /* EPA 를 시작할 수 있도록 단체를 원점을 감싸는 사면체로 키운다 */
+        bool expandSimplex(const Collider& a, const Collider& b);
+
+        /* 다면체에 면을 추가한다. 법선을 구할 수 없는 면이라면 false 를 반환한다 */
+        bool addFace(int index1, int index2, int index3);
+
+        /* 경계 변 목록에 변을 추가한다. 반대 방향의 변이 이미 있다면 둘 다 경계가 아니므로 지운다 */
+        void addHorizonEdge(int index1, int index2);
+    };
+} // namespace physics
+
+#endif // GJK_H
@@ -0,0 +1,85 @@
+#ifndef ISLAND_H
+#define ISLAND_H
+
+#include "body.h"
+#include "contact.h"
+#include <vector>
+#include <unordered_map>
+
+namespace physics
+{
+    /* 충돌로 서로 이어진 강체들의 묶음.
+        고정된 강체와 지면은 island 를 잇지 않는다 */
+    struct Island
+    {
+        std::vector<RigidBody*> bodies;
+        /* island 에 속한 충돌 정보들의 contacts 배열 상 인덱스 */
+        std::vector<unsigned int> contactIndices;
+    };
+
+    /* 매 프레임 union-find 로 충돌 그래프의 island 들을 구하고,
+        충분히 오래 멈춰 있던 island 를 재운다.
+        잠든 island 는 멤버 중 하나라도 깨어나면 통째로 깨어난다 */
+    class IslandManager
+    {
+    private:
+        /* 이 속력과 각속력보다 느린 강체는 멈춘 것으로 본다 */
+        float linearSleepThreshold;
+        float angularSleepThreshold;
+        /* island 의 모든 강체가 이 시간 이상 멈춰 있다면 잠든다 */
+        float timeToSleep;
+        bool isSleepingEnabled;
+
+        /* union-find 의 부모 인덱스. 인덱스는 RigidBody::islandIndex 와 같다 */
+        std::vector<int> parents;
+        std::vector<RigidBody*> islandBodies;
+        std::vector<Island> islands;
+
+        /* 잠든 island 의 강체들 */
+        std::unordered_map<int, std::vector<RigidBody*>> sleepingIslands;
+        int nextSleepingIslandID;
+        unsigned int sleepingBodyCount;
+
+    public:
+        IslandManager()
+            : linearSleepThreshold(0.05f), angularSleepThreshold(0.05f), timeToSleep(0.5f),
+            isSleepingEnabled(true), nextSleepingIslandID(0), sleepingBodyCount(0) {}
+
+        /* 적분이 끝난 강체의 속력을 보고 멈춰 있던 시간을 갱신한다 */
+        void updateSleepTime(RigidBody* body, float duration) const;
+
+        /* 깨어 있는 강체들과 이번 프레임의 충돌 정보로 island 들을 구한다.
+            충돌 해소 전에 호출해야 하며, 잠든 강체와의 충돌이 있다면 그 강체의 island 를 깨운다 */
+        void buildIslands(const std::vector<RigidBody*>& awakeBodies, const std::vector<Contact>& contacts);
+
+        /* 멈춰 있던 시간이 timeToSleep 을 넘긴 island 들을 재운다 */
+        void updateSleeping();
+
+        /* 이벤트나 충돌로 깨어난 강체가 속한 잠든 island 를 모두 깨운다 */
+        void wakeIsland(RigidBody* body);
+
+        /* 강체가 제거될 때 호출한다. 그 강체에 기대고 있던 강체들이 떨어질 수 있도록
+            강체가 속한 잠든 island 를 깨운다 */
+        void removeBody(RigidBody* body);
+
+        /* 잠든 island 를 모두 깨운다 */
+        void wakeAll();
+
+        void setSleepingEnabled(bool value);
+        void setSleepThresholds(float linear, float angular);
+        void setTimeToSleep(float value) { timeToSleep = value; }
+
+        const std::vector<Island>& getIslands() const { return islands; }
+        unsigned int getSleepingBodyCount() const { return sleepingBodyCount; }
+
+    private:
+        /* 이번 프레임의 union-find 인덱스를 반환한다.
+            적분 이후에 깨어났거나 고정된 강체처럼 인덱스가 없다면 -1 을 반환한다 */
+        int getIslandIndex(const RigidBody* body) const;
+
+        int findRoot(int index);
+        void unite(int index1, int index2);
+    };
+} // namespace physics
+
+#endif // ISLAND_H
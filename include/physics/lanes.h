@@ -0,0 +1,137 @@
+#ifndef LANES_H
+#define LANES_H
+
+#include <cmath>
+
+#if defined(__AVX__) || defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+/* 라이브러리 내부의 묶음 커널이 사용하는 실수 묶음 타입들.
+    커널은 한 번만 작성하고 묶음 타입만 바꿔 1, 4, 8 개의 값을 동시에 처리한다.
+    sqrt 같은 이름이 physics 의 다른 코드를 가리지 않도록 따로 이름공간을 둔다 */
+namespace physics
+{
+namespace simd
+{
+    /* 값 하나 */
+    struct ScalarLanes
+    {
+        static const unsigned int width = 1;
+        typedef bool Mask;
+
+        float value;
+
+        ScalarLanes() {}
+        explicit ScalarLanes(float _value) : value(_value) {}
+
+        static ScalarLanes load(const float* source) { return ScalarLanes(*source); }
+        /* base[indices[i]] 들을 모은다 */
+        static ScalarLanes gather(const float* base, const int* indices) { return ScalarLanes(base[indices[0]]); }
+        void store(float* destination) const { *destination = value; }
+    };
+
+    inline ScalarLanes operator+(ScalarLanes a, ScalarLanes b) { return ScalarLanes(a.value + b.value); }
+    inline ScalarLanes operator-(ScalarLanes a, ScalarLanes b) { return ScalarLanes(a.value - b.value); }
+    inline ScalarLanes operator*(ScalarLanes a, ScalarLanes b) { return ScalarLanes(a.value * b.value); }
+    inline ScalarLanes operator/(ScalarLanes a, ScalarLanes b) { return ScalarLanes(a.value / b.value); }
+    inline ScalarLanes sqrt(ScalarLanes a) { return ScalarLanes(sqrtf(a.value)); }
+    inline bool operator==(ScalarLanes a, ScalarLanes b) { return a.value == b.value; }
+    inline bool operator!=(ScalarLanes a, ScalarLanes b) { return a.value != b.value; }
+    inline bool operator<(ScalarLanes a, ScalarLanes b) { return a.value < b.value; }
+    inline bool maskAnd(bool a, bool b) { return a && b; }
+    inline ScalarLanes select(bool mask, ScalarLanes a, ScalarLanes b) { return mask ? a : b; }
+    /* 참인 칸의 비트가 켜진 정수 */
+    inline unsigned int maskBits(bool mask) { return mask ? 1u : 0u; }
+
+#if defined(__SSE2__) || defined(_M_X64)
+    /* SSE 로 값 4 개 */
+    struct SSELanes
+    {
+        static const unsigned int width = 4;
+        struct Mask { __m128 value; };
+
+        __m128 value;
+
+        SSELanes() {}
+        SSELanes(__m128 _value) : value(_value) {}
+        explicit SSELanes(float _value) : value(_mm_set1_ps(_value)) {}
+
+        static SSELanes load(const float* source) { return SSELanes(_mm_loadu_ps(source)); }
+        static SSELanes gather(const float* base, const int* indices)
+        {
+            return _mm_setr_ps(base[indices[0]], base[indices[1]], base[indices[2]], base[indices[3]]);
+        }
+        void store(float* destination) const { _mm_storeu_ps(destination, value); }
+    };
+
+    inline SSELanes operator+(SSELanes a, SSELanes b) { return _mm_add_ps(a.value, b.value); }
+    inline SSELanes operator-(SSELanes a, SSELanes b) { return _mm_sub_ps(a.value, b.value); }
+    inline SSELanes operator*(SSELanes a, SSELanes b) { return _mm_mul_ps(a.value, b.value); }
+    inline SSELanes operator/(SSELanes a, SSELanes b) { return _mm_div_ps(a.value, b.value); }
+    inline SSELanes sqrt(SSELanes a) { return _mm_sqrt_ps(a.value); }
+    inline SSELanes::Mask operator==(SSELanes a, SSELanes b) { SSELanes::Mask m = {_mm_cmpeq_ps(a.value, b.value)}; return m; }
+    inline SSELanes::Mask operator!=(SSELanes a, SSELanes b) { SSELanes::Mask m = {_mm_cmpneq_ps(a.value, b.value)}; return m; }
+    inline SSELanes::Mask operator<(SSELanes a, SSELanes b) { SSELanes::Mask m = {_mm_cmplt_ps(a.value, b.value)}; return m; }
+    inline SSELanes::Mask maskAnd(SSELanes::Mask a, SSELanes::Mask b) { SSELanes::Mask m = {_mm_and_ps(a.value, b.value)}; return m; }
+    inline SSELanes select(SSELanes::Mask mask, SSELanes a, SSELanes b)
+    {
+        return _mm_or_ps(_mm_and_ps(mask.value, a.value), _mm_andnot_ps(mask.value, b.value));
+    }
+    inline unsigned int maskBits(SSELanes::Mask mask) { return _mm_movemask_ps(mask.value); }
+#endif
+
+#if defined(__AVX__)
+    /* AVX 로 값 8 개 */
+    struct AVXLanes
+    {
+        static const unsigned int width = 8;
+        struct Mask { __m256 value; };
+
+        __m256 value;
+
+        AVXLanes() {}
+        AVXLanes(__m256 _value) : value(_value) {}
+        explicit AVXLanes(float _value) : value(_mm256_set1_ps(_value)) {}
+
+        static AVXLanes load(const float* source) { return AVXLanes(_mm256_loadu_ps(source)); }
+        /* AVX2 가 있다면 한 번의 gather 명령으로 모은다 */
+        static AVXLanes gather(const float* base, const int* indices)
+        {
+#if defined(__AVX2__)
+            return _mm256_i32gather_ps(base, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices)), 4);
+#else
+            return _mm256_setr_ps(
+                base[indices[0]], base[indices[1]], base[indices[2]], base[indices[3]],
+                base[indices[4]], base[indices[5]], base[indices[6]], base[indices[7]]
+            );
+#endif
+        }
+        void store(float* destination) const { _mm256_storeu_ps(destination, value); }
+    };
+
+    inline AVXLanes operator+(AVXLanes a, AVXLanes b) { return _mm256_add_ps(a.value, b.value); }
+    inline AVXLanes operator-(AVXLanes a, AVXLanes b) { return _mm256_sub_ps(a.value, b.value); }
+    inline AVXLanes operator*(AVXLanes a, AVXLanes b) { return _mm256_mul_ps(a.value, b.value); }
+    inline AVXLanes operator/(AVXLanes a, AVXLanes b) { return _mm256_div_ps(a.value, b.value); }
+    inline AVXLanes sqrt(AVXLanes a) { return _mm256_sqrt_ps(a.value); }
+    inline AVXLanes::Mask operator==(AVXLanes a, AVXLanes b) { AVXLanes::Mask m = {_mm256_cmp_ps(a.value, b.value, _CMP_EQ_OQ)}; return m; }
+    inline AVXLanes::Mask operator!=(AVXLanes a, AVXLanes b) { AVXLanes::Mask m = {_mm256_cmp_ps(a.value, b.value, _CMP_NEQ_UQ)}; return m; }
+    inline AVXLanes::Mask operator<(AVXLanes a, AVXLanes b) { AVXLanes::Mask m = {_mm256_cmp_ps(a.value, b.value, _CMP_LT_OQ)}; return m; }
+    inline AVXLanes::Mask maskAnd(AVXLanes::Mask a, AVXLanes::Mask b) { AVXLanes::Mask m = {_mm256_and_ps(a.value, b.value)}; return m; }
+    inline AVXLanes select(AVXLanes::Mask mask, AVXLanes a, AVXLanes b) { return _mm256_blendv_ps(b.value, a.value, mask.value); }
+    inline unsigned int maskBits(AVXLanes::Mask mask) { return _mm256_movemask_ps(mask.value); }
+#endif
+
+    /* 빌드 설정에서 쓸 수 있는 가장 넓은 묶음 */
+#if defined(__AVX__)
+    typedef AVXLanes BatchLanes;
+#elif defined(__SSE2__) || defined(_M_X64)
+    typedef SSELanes BatchLanes;
+#else
+    typedef ScalarLanes BatchLanes;
+#endif
+} // namespace simd
+} // namespace physics
+
+#endif // LANES_H
@@ -0,0 +1,86 @@
+#ifndef MANIFOLD_H
+#define MANIFOLD_H
+
+#include "contact.h"
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <cstddef>
+
+namespace physics
+{
+    /* 직전 프레임에 해소한 충돌점 하나의 누적 충격량 */
+    struct ManifoldPoint
+    {
+        unsigned int featureID;
+        Vector3 normal;
+        float normalImpulseSum;
+        /* 접선 방향 누적 충격량.
+            접선 벡터는 법선에 따라 달라지므로 월드 좌표계 벡터로 저장한다 */
+        Vector3 tangentImpulse;
+    };
+
+    /* 두 물체 사이의 충돌점들. 프레임이 바뀌어도 유지된다 */
+    struct ContactManifold
+    {
+        std::vector<ManifoldPoint> points;
+        /* 마지막으로 갱신된 프레임 */
+        unsigned int frame;
+
+        ContactManifold() : frame(0) {}
+    };
+
+    /* 물체 쌍과 featureID 로 프레임 사이의 충돌점들을 짝지어
+        직전 프레임의 누적 충격량을 이어받게 한다 (warm starting) */
+    class ManifoldCache
+    {
+    private:
+        /* 충돌 정보의 bodies[0], bodies[1] 순서 그대로 사용한다.
+            순서가 바뀐 쌍은 다른 쌍으로 취급한다 */
+        struct BodyPair
+        {
+            const RigidBody* body1;
+            const RigidBody* body2;
+
+            bool operator==(const BodyPair& other) const
+            {
+                return body1 == other.body1 && body2 == other.body2;
+            }
+        };
+
+        struct BodyPairHash
+        {
+            std::size_t operator()(const BodyPair& pair) const
+            {
+                std::size_t hash1 = std::hash<const RigidBody*>()(pair.body1);
+                std::size_t hash2 = std::hash<const RigidBody*>()(pair.body2);
+                return hash1 ^ (hash2 + 0x9e3779b9 + (hash1 << 6) + (hash1 >> 2));
+            }
+        };
+
+        std::unordered_map<BodyPair, ContactManifold, BodyPairHash> manifolds;
+        unsigned int frame;
+
+        /* 법선 방향이 이 값(코사인) 이상 비슷해야 같은 충돌점으로 본다 */
+        float normalTolerance;
+
+    public:
+        ManifoldCache() : frame(0), normalTolerance(0.95f) {}
+
+        /* 직전 프레임의 충돌점과 짝지어지는 충돌 정보에 누적 충격량을 복사한다.
+            짝지어진 충돌 정보의 개수를 반환한다 */
+        unsigned int restore(std::vector<Contact>& contacts) const;
+
+        /* 해소가 끝난 충돌 정보들의 누적 충격량을 저장한다.
+            이번 프레임에 충돌하지 않은 쌍은 제거한다 */
+        void store(const std::vector<Contact>& contacts);
+
+        /* 주어진 강체가 포함된 쌍을 모두 제거한다 */
+        void removeBody(const RigidBody* body);
+
+        void clear() { manifolds.clear(); }
+        unsigned int getManifoldCount() const { return manifolds.size(); }
+    };
+} // namespace physics
+
+#endif // MANIFOLD_H
@@ -13,6 +13,7 @@ namespace physics
         Matrix4();            // 단위행렬로 초기화
         Matrix4(float value); // 행렬의 대각성분 (diagonal entry) 을 주어진 값으로 초기화
         Matrix4(float v1, float v2, float v3, float v4);
+        Matrix4(const Matrix4& other) = default;
 
         /* 행렬의 대각성분을 주어진 값으로 설정한다
             나머지 성분은 0으로 설정한다 */
@@ -2,6 +2,7 @@
 #define QUATERNION_H
 
 #include "vector3.h"
+#include <cmath>
 
 namespace physics
 {
@@ -17,13 +18,17 @@ namespace physics
         Quaternion() : w(1.0f), x(0.0f), y(0.0f), z(0.0f) {}
         Quaternion(float _w, float _x, float _y, float _z)
             : w(_w), x(_x), y(_y), z(_z) {}
-    
+
         /* 사원수의 크기를 1 로 만든다 */
         void normalize();
 
         /* 주어진 벡터만큼 회전한 사원수를 반환한다 */
         Quaternion rotateByScaledVector(const Vector3& vec, const float scale) const;
 
+        /* 두 사원수 사이를 t 만큼 선형 보간하고 정규화한다 (nlerp).
+            짧은 쪽으로 회전하도록 내적이 음수라면 to 의 부호를 뒤집는다 */
+        static Quaternion nlerp(const Quaternion& from, const Quaternion& to, float t);
+
         /*****************
          * 연산자 오버로딩 *
          *****************/
@@ -40,6 +45,107 @@ namespace physics
         Quaternion operator*(const float value) const;
         void operator*=(const float value);
     };
+
+    inline void Quaternion::normalize()
+    {
+        float magnitude = w*w + x*x + y*y + z*z;
+        /* 크기가 0 이면 회전각 0 으로 설정한다 */
+        if (magnitude == 0.0f)
+        {
+            w = 1.0f;
+            return;
+        }
+        magnitude = 1.0f / sqrtf(magnitude);
+
+        w *= magnitude;
+        x *= magnitude;
+        y *= magnitude;
+        z *= magnitude;
+    }
+
+    inline Quaternion Quaternion::rotateByScaledVector(const Vector3& vec, const float scale) const
+    {
+        return *this * Quaternion(0.0f, vec.x * scale, vec.y * scale, vec.z * scale);
+    }
+
+    inline Quaternion Quaternion::nlerp(const Quaternion& from, const Quaternion& to, float t)
+    {
+        float sign = from.w*to.w + from.x*to.x + from.y*to.y + from.z*to.z < 0.0f ? -1.0f : 1.0f;
+
+        Quaternion result(
+            from.w + (sign * to.w - from.w) * t,
+            from.x + (sign * to.x - from.x) * t,
+            from.y + (sign * to.y - from.y) * t,
+            from.z + (sign * to.z - from.z) * t
+        );
+        result.normalize();
+
+        return result;
+    }
+
+    inline Quaternion Quaternion::operator+(const Quaternion& other) const
+    {
+        Quaternion result;
+
+        result.w = w + other.w;
+        result.x = x + other.x;
+        result.y = y + other.y;
+        result.z = z + other.z;
+
+        return result;
+    }
+
+    inline void Quaternion::operator+=(const Quaternion& other)
+    {
+        w += other.w;
+        x += other.x;
+        y += other.y;
+        z += other.z;
+    }
+
+    inline Quaternion Quaternion::operator*(const Quaternion& other) const
+    {
+        Quaternion result;
+
+        result.w = w*other.w - x*other.x - y*other.y - z*other.z;
+        result.x = w*other.x + x*other.w + y*other.z - z*other.y;
+        result.y = w*other.y - x*other.z + y*other.w + z*other.x;
+        result.z = w*other.z + x*other.y - y*other.x + z*other.w;
+
+        return result;
+    }
+
+    inline void Quaternion::operator*=(const Quaternion& other)
+    {
+        Quaternion result;
+
+        result.w = w*other.w - x*other.x - y*other.y - z*other.z;
+        result.x = w*other.x + x*other.w + y*other.z - z*other.y;
+        result.y = w*other.y - x*other.z + y*other.w + z*other.x;
+        result.z = w*other.z + x*other.y - y*other.x + z*other.w;
+
+        *this = result;
+    }
+
+    inline Quaternion Quaternion::operator*(const float value) const
+    {
+        Quaternion result;
+
+        result.w = w * value;
+        result.x = x * value;
+        result.y = y * value;
+        result.z = z * value;
+
+        return result;
+    }
+
+    inline void Quaternion::operator*=(const float value)
+    {
+        w *= value;
+        x *= value;
+        y *= value;
+        z *= value;
+    }
 } // namespace physics
 
 #endif // QUATERNION_H
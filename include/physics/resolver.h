@@ -2,25 +2,113 @@
 #define RESOLVER_H
 
 #include "contact.h"
+#include "manifold.h"
+#include "island.h"
+#include "thread_pool.h"
 #include <vector>
+#include <cstdint>
 
 namespace physics
 {
+    /* island 하나의 충돌들을 해소하는 방식 */
+    enum SolverMode
+    {
+        SERIAL_SOLVER,  // 충돌들을 순서대로 하나씩 해소한다
+        COLORED_SOLVER  // 강체를 공유하지 않는 충돌들끼리 같은 색을 칠하고, 같은 색의 충돌들을 병렬로 해소한다
+    };
+
     class CollisionResolver
     {
+        friend class ResolverBenchmark;
+
     private:
         int iterationLimit;
         float penetrationTolerance;
         float closingSpeedTolerance;
 
+        /* 한 번의 반복에서 변한 법선 & 마찰 충격량이 모두 이 값보다 작다면
+            수렴한 것으로 보고 반복을 멈춘다 */
+        float convergenceTolerance;
+
+        /* 직전 프레임의 누적 충격량으로 반복을 시작할지 여부 */
+        bool isWarmStarting;
+        ManifoldCache manifolds;
+
+        /* island 들은 강체를 공유하지 않으므로 서로 다른 스레드에서 해소한다 */
+        ThreadPool threadPool;
+        /* island 별로 사용한 반복 횟수 */
+        std::vector<int> islandIterationCounts;
+
+        /* COLORED_SOLVER 라면 충돌이 coloringThreshold 개 이상인 island 는
+            색칠해서 색마다 병렬로 해소하고, 나머지 island 들은 island 단위로 병렬로 해소한다 */
+        SolverMode solverMode;
+        unsigned int coloringThreshold;
+        std::vector<unsigned int> parallelIslandIndices;
+        std::vector<unsigned int> coloredIslandIndices;
+
+        /* 색칠에 사용하는 버퍼들.
+            bodyColorMasks 는 RigidBody::islandIndex 로 접근하며 강체가 이미 사용한 색들을 비트로 저장한다 */
+        std::vector<uint64_t> bodyColorMasks;
+        std::vector<unsigned char> contactColors;
+        /* 색 순서로 정렬한 충돌 인덱스와 색마다의 시작 위치 */
+        std::vector<unsigned int> coloredContactIndices;
+        std::vector<unsigned int> colorOffsets;
+        /* 색 하나를 나눈 작업 묶음별 최대 법선 충격량 */
+        std::vector<float> batchMaxImpulses;
+
+        /* 직전 resolveCollision 의 통계 */
+        int lastIterationCount;
+        unsigned int lastWarmStartedCount;
+        unsigned int lastColorCount;
+
     public:
         CollisionResolver()
-            : iterationLimit(30), penetrationTolerance(0.0005f), closingSpeedTolerance(0.005f) {}
+            : iterationLimit(30), penetrationTolerance(0.0005f), closingSpeedTolerance(0.005f),
+            convergenceTolerance(0.0005f), isWarmStarting(true),
+            solverMode(SERIAL_SOLVER), coloringThreshold(256),
+            lastIterationCount(0), lastWarmStartedCount(0), lastColorCount(0) {}
     
-        void resolveCollision(std::vector<Contact*>&, float deltaTime);
+        /* island 마다 충돌들을 해소한다.
+            island 는 각자 수렴할 때까지 반복하므로 결과는 스레드 수와 관계없이 같다 */
+        void resolveCollision(std::vector<Contact>&, const std::vector<Island>& islands, float deltaTime);
+
+        /* 강체가 제거될 때 호출해 그 강체의 누적 충격량을 버린다 */
+        void removeBody(const RigidBody* body) { manifolds.removeBody(body); }
+
+        void setWarmStarting(bool value);
+        void setConvergenceTolerance(float value) { convergenceTolerance = value; }
+        /* 호출한 스레드를 포함해 충돌 해소에 사용할 스레드의 수 */
+        void setThreadCount(unsigned int count) { threadPool.setThreadCount(count); }
+        unsigned int getThreadCount() const { return threadPool.getThreadCount(); }
+
+        void setSolverMode(SolverMode mode) { solverMode = mode; }
+        SolverMode getSolverMode() const { return solverMode; }
+        void setColoringThreshold(unsigned int value) { coloringThreshold = value; }
+
+        /* island 들 중 가장 많이 반복한 횟수 */
+        int getLastIterationCount() const { return lastIterationCount; }
+        unsigned int getLastWarmStartedCount() const { return lastWarmStartedCount; }
+        /* 색칠한 island 들 중 가장 많이 사용한 색의 수 */
+        unsigned int getLastColorCount() const { return lastColorCount; }
 
     private:
-        void sequentialImpulse(Contact*, float deltaTime);
+        /* island 하나의 충돌들을 해소하고 반복 횟수를 반환한다 */
+        int resolveIsland(std::vector<Contact>&, const Island& island, float deltaTime);
+
+        /* island 하나를 색칠한 뒤 색마다 병렬로 해소하고 반복 횟수를 반환한다 */
+        int resolveColoredIsland(std::vector<Contact>&, const Island& island, float deltaTime);
+
+        /* 강체를 공유하지 않는 충돌들이 같은 색이 되도록 탐욕적으로 색칠한다.
+            고정된 강체와 지면은 여러 충돌이 공유해도 된다.
+            색이 모자라면 남은 충돌들은 마지막 색에 모아 순서대로 해소한다 */
+        void colorIsland(const std::vector<Contact>&, const Island& island);
+
+        /* 충격량 하나를 계산하고 적용한다.
+            적용한 법선 충격량과 두 마찰 충격량 중 가장 큰 크기를 반환한다 */
+        float sequentialImpulse(Contact*, float deltaTime);
+
+        /* 직전 프레임에서 이어받은 누적 충격량을 두 물체에 미리 적용한다 */
+        void warmStart(Contact*);
     };
 } // namespace physics
 
@@ -4,9 +4,11 @@
 #include "body.h"
 #include "detector.h"
 #include "resolver.h"
+#include "island.h"
 #include "../playground/geometry.h"
 #include "../playground/contact_info.h"
 #include <vector>
+#include <string>
 #include <unordered_map>
 
 namespace physics
@@ -16,21 +18,39 @@ namespace physics
     public:
         typedef std::unordered_map<unsigned int, RigidBody*> RigidBodies;
         typedef std::unordered_map<unsigned int, Collider*> Colliders;
-        typedef std::vector<Contact*> Contacts;
+        typedef std::vector<Contact> Contacts;
+        typedef std::vector<TOIEvent> TOIEvents;
 
     private:
+        /* 강체들의 상태를 성분별 배열로 저장한다. bodies 의 강체들은 이 저장소의 핸들이다 */
+        BodyStore bodyStore;
         RigidBodies bodies;
         Colliders colliders;
         PlaneCollider groundCollider;
+        /* 지면 외의 고정된 환경 */
+        std::vector<TriangleMesh*> triangleMeshes;
+        /* 지면 대신 사용하는 지형. 없다면 nullptr 이다 */
+        HeightfieldCollider* heightfield;
         Contacts contacts;
+        /* 이번 스텝에 연속 충돌 검사로 찾은 충돌 시각들 */
+        TOIEvents toiEvents;
         
         CollisionDetector detector;
         CollisionResolver resolver;
+        IslandManager islandManager;
+
+        /* 이번 프레임에 적분한 강체들 */
+        std::vector<RigidBody*> awakeBodies;
+
+        /* 충돌체 트리를 마지막으로 갱신했을 때 bodyStore 의 editCount */
+        unsigned int colliderTreeEditCount;
 
         float gravity;
 
     public:
-        Simulator() : groundCollider(Vector3(0.0f, 1.0f, 0.0f), 0.0f), gravity(9.8f) {}
+        Simulator()
+            : groundCollider(Vector3(0.0f, 1.0f, 0.0f), 0.0f), heightfield(nullptr),
+            colliderTreeEditCount(0), gravity(9.8f) {}
         ~Simulator();
 
         /* 주어진 시간 동안의 물리 현상을 시뮬레이팅한다 */
@@ -42,20 +62,81 @@ namespace physics
         /* 주어진 강체를 감싸는 충돌체를 시뮬레이션에 추가하고 추가된 충돌체의 주소를 반환한다 */
         Collider* addCollider(unsigned int id, Geometry, RigidBody*);
 
+        /* OBJ 파일을 읽어 offset 만큼 옮긴 고정된 삼각형 메쉬를 추가하고 그 주소를 반환한다.
+            읽지 못했다면 nullptr 를 반환한다 */
+        TriangleMesh* addTriangleMesh(const std::string& path, const Vector3& offset);
+        const std::vector<TriangleMesh*>& getTriangleMeshes() const { return triangleMeshes; }
+
+        /* 평면 지면을 지형으로 바꾼다. 이미 지형이 있다면 새 지형으로 교체한다.
+            heights 는 row * columnCount + column 순서이다 */
+        HeightfieldCollider* setHeightfield(
+            int columnCount,
+            int rowCount,
+            float cellSize,
+            const Vector3& origin,
+            const std::vector<float>& heights
+        );
+        /* 지형을 없애고 평면 지면으로 돌아간다 */
+        void removeHeightfield();
+        HeightfieldCollider* getHeightfield() const { return heightfield; }
+
         /* 충돌체와 강체를 제거한다 */
         void removePhysicsObject(unsigned int id);
 
+        /* 주어진 ID 의 강체 또는 충돌체를 반환한다. 없다면 nullptr 를 반환한다 */
+        RigidBody* getRigidBody(unsigned int id) const;
+        Collider* getCollider(unsigned int id) const;
+        const RigidBodies& getRigidBodies() const { return bodies; }
+
         float calcDistanceBetweenRayAndObject(
             const Vector3& rayOrigin,
             const Vector3& rayDirection,
             const unsigned int id
         );
 
+        /* 반직선과 가장 먼저 만나는 오브젝트를 AABB 트리로 찾는다.
+            만나는 오브젝트가 없다면 false 를 반환한다 */
+        bool castRay(
+            const Vector3& rayOrigin,
+            const Vector3& rayDirection,
+            unsigned int& hitID,
+            float& hitDistance
+        );
+
         void getContactInfo(std::vector<ContactInfo*>&) const;
 
         void setGroundRestitution(float value);
         void setObjectRestitution(float value);
         void setGravity(float value);
+        void setBroadPhaseMode(BroadPhaseMode);
+        void setSpatialHashCellSize(float);
+        void setWarmStarting(bool);
+        /* 빠르게 움직이는 구의 연속 충돌 검사 설정.
+            한 스텝에 반지름의 threshold 배보다 멀리 움직이는 구만 검사한다. 기본값은 켜짐, 0.5 이다 */
+        void setCCDEnabled(bool);
+        void setCCDMotionThreshold(float threshold);
+        /* 구 - 구 쌍과 구 - 평면 지면을 묶음으로 검사할지 정한다. 기본값은 켜짐이다 */
+        void setSphereBatchEnabled(bool);
+        /* 직전 스텝에 연속 충돌 검사로 찾은 충돌 시각들 */
+        const TOIEvents& getTOIEvents() const { return toiEvents; }
+
+        /* 충돌 해소에 사용할 스레드의 수. 기본값은 1 이다 */
+        void setThreadCount(unsigned int);
+        /* 충돌이 많은 island 를 색칠해서 병렬로 해소할지 정한다. 기본값은 SERIAL_SOLVER 이다 */
+        void setSolverMode(SolverMode);
+
+        /* 잠들기 설정.
+            속력과 각속력이 문턱값 아래로 timeToSleep 초 동안 유지된 island 는 잠든다 */
+        void setSleepingEnabled(bool);
+        void setSleepThresholds(float linear, float angular);
+        void setTimeToSleep(float);
+        unsigned int getSleepingBodyCount() const { return islandManager.getSleepingBodyCount(); }
+
+        /* 직전 프레임의 island 개수 */
+        unsigned int getIslandCount() const { return islandManager.getIslands().size(); }
+
+        /* 직전 프레임에 충돌 해소에 사용한 반복 횟수 */
+        int getSolverIterationCount() const { return resolver.getLastIterationCount(); }
     };
 } // namespace physics
 
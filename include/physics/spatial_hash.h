@@ -0,0 +1,75 @@
+#ifndef SPATIAL_HASH_H
+#define SPATIAL_HASH_H
+
+#include "collider.h"
+#include "aabb.h"
+#include "broadphase.h"
+#include <vector>
+#include <unordered_map>
+
+namespace physics
+{
+    /* 균일 격자 공간 해시.
+        공간을 한 변이 cellSize 인 정육면체 셀로 나누고 AABB 가 걸치는 셀마다
+        충돌체를 등록한 뒤, 같은 셀을 공유하는 충돌체끼리만 겹침 검사를 한다.
+        크기가 비슷한 물체가 많을 때 트리보다 빠르다.
+        매 프레임 새로 채우므로 충돌체를 따로 등록할 필요가 없다 */
+    class SpatialHashGrid
+    {
+    private:
+        struct Proxy
+        {
+            Collider* collider;
+            AABB aabb;
+        };
+
+        /* 셀에 등록된 충돌체 하나.
+            같은 해시 버킷에 들어온 항목끼리 연결 리스트를 이룬다 */
+        struct CellEntry
+        {
+            int cellX, cellY, cellZ;
+            unsigned int proxyIdx;
+            int next;
+        };
+
+        float cellSize;
+
+        /* 충돌체 하나가 등록될 수 있는 최대 셀 수 */
+        static const int maxCellsPerProxy = 64;
+
+        std::vector<Proxy> proxies;
+        /* 셀 수가 maxCellsPerProxy 를 넘거나 좌표가 유한하지 않아 격자에 등록하지 않은 충돌체들.
+            다른 모든 충돌체와 직접 비교한다 */
+        std::vector<unsigned int> largeProxies;
+        std::vector<CellEntry> entries;
+        /* 해시 버킷마다 첫 번째 항목의 인덱스. 비어 있다면 -1 */
+        std::vector<int> buckets;
+
+    public:
+        SpatialHashGrid() : cellSize(2.0f) {}
+
+        /* 양의 유한한 값만 받는다. 그 밖의 값은 무시하고 이전 크기를 유지한다 */
+        void setCellSize(float value);
+        float getCellSize() const { return cellSize; }
+
+        /* 셀을 공유하고 AABB 가 겹치는 충돌체 쌍을 pairs 에 저장한다.
+            두 충돌체가 여러 셀을 공유하더라도 쌍은 한 번만 저장된다 */
+        void findPairs(
+            std::unordered_map<unsigned int, Collider*>& colliders,
+            std::vector<ColliderPair>& pairs
+        );
+
+    private:
+        /* 좌표가 속한 셀의 인덱스를 구한다 */
+        int calcCellIndex(float value) const;
+
+        /* 한 축에서 [minValue, maxValue] 가 걸치는 셀의 범위를 구한다.
+            범위가 maxCellsPerProxy 를 넘거나 셀 인덱스를 int 로 나타낼 수 없다면 false 를 반환한다 */
+        bool calcCellRange(float minValue, float maxValue, int& minCell, int& maxCell) const;
+
+        /* 셀 좌표를 해시 버킷 인덱스로 변환한다 */
+        unsigned int calcBucketIndex(int cellX, int cellY, int cellZ) const;
+    };
+} // namespace physics
+
+#endif // SPATIAL_HASH_H
@@ -0,0 +1,63 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+
+namespace physics
+{
+    /* 서로 독립적인 작업들을 여러 스레드에 나눠 실행하는 스레드 풀.
+        호출한 스레드도 작업에 참여하므로 threadCount 가 1 이면 스레드를 만들지 않는다 */
+    class ThreadPool
+    {
+    private:
+        std::vector<std::thread> workers;
+
+        std::mutex mutex;
+        std::condition_variable taskCondition;
+        std::condition_variable doneCondition;
+
+        /* 현재 실행 중인 작업과 작업 개수 */
+        const std::function<void(unsigned int)>* task;
+        unsigned int taskCount;
+        /* 다음에 가져갈 작업의 인덱스 */
+        std::atomic<unsigned int> nextTaskIndex;
+
+        /* 아직 현재 작업을 끝내지 못한 worker 스레드의 수 */
+        unsigned int busyWorkerCount;
+        /* parallelFor 가 호출될 때마다 증가한다.
+            worker 는 이 값이 바뀌면 새 작업이 들어온 것으로 본다 */
+        unsigned int generation;
+        bool isStopping;
+
+    public:
+        ThreadPool()
+            : task(nullptr), taskCount(0), nextTaskIndex(0),
+            busyWorkerCount(0), generation(0), isStopping(false) {}
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /* 호출한 스레드를 포함한 스레드의 수를 정한다 */
+        void setThreadCount(unsigned int count);
+        unsigned int getThreadCount() const { return workers.size() + 1; }
+
+        /* task(0) ~ task(count - 1) 을 실행하고 모두 끝날 때까지 기다린다.
+            작업이 실행되는 스레드와 순서는 정해져 있지 않다 */
+        void parallelFor(unsigned int count, const std::function<void(unsigned int)>& task);
+
+    private:
+        void stopWorkers();
+        /* 스레드가 시작되기 전에 들어온 작업을 놓치지 않도록
+            생성 시점의 generation 을 받는다 */
+        void workerLoop(unsigned int localGeneration);
+        void runTasks();
+    };
+} // namespace physics
+
+#endif // THREAD_POOL_H
@@ -0,0 +1,117 @@
+#ifndef TRIANGLE_MESH_H
+#define TRIANGLE_MESH_H
+
+#include "vector3.h"
+#include "aabb.h"
+#include <vector>
+#include <string>
+
+namespace physics
+{
+    /* 움직이지 않는 삼각형 메쉬. 지형처럼 고정된 환경을 나타낸다.
+        삼각형들을 BVH 로 묶어 두고 물체의 AABB 와 겹치는 삼각형만 narrow phase 로 넘긴다 */
+    class TriangleMesh
+    {
+        friend class CollisionDetector;
+
+    public:
+        struct Triangle
+        {
+            Vector3 vertices[3];
+            /* 정점이 반시계 방향으로 보이는 쪽을 향하는 단위 법선 */
+            Vector3 normal;
+            /* 변 i 는 vertices[i] 에서 vertices[(i + 1) % 3] 까지이다.
+                변을 공유하는 이웃 삼각형이 있다면 이웃의 면 위에서 변과 수직으로 이웃 안쪽을 향하는 단위 벡터,
+                없다면 영벡터이다. 이웃 삼각형이 처리할 충돌을 걸러내는 데 사용한다 */
+            Vector3 neighborDirections[3];
+        };
+
+    private:
+        /* 트리의 노드. 왼쪽 자식은 항상 바로 다음 노드이다 */
+        struct Node
+        {
+            AABB aabb;
+            /* 오른쪽 자식의 인덱스. 리프 노드라면 -1 이다 */
+            int child2;
+            /* 리프 노드가 가진 삼각형들의 구간 */
+            int firstTriangle;
+            int triangleCount;
+
+            bool isLeaf() const { return child2 == -1; }
+        };
+
+        /* 리프 노드 하나가 가지는 삼각형의 최대 개수 */
+        static const int maxLeafSize = 4;
+
+        std::vector<Triangle> triangles;
+        std::vector<Node> nodes;
+
+        /* 트리 순회에 사용하는 스택 */
+        std::vector<int> stack;
+
+    public:
+        /* OBJ 파일의 v 와 f 를 읽어 삼각형을 추가하고 트리를 만든다.
+            사각형 이상의 면은 부채꼴로 나눈다. 실패하면 false 를 반환한다 */
+        bool loadOBJ(const std::string& path, const Vector3& offset);
+
+        /* 삼각형을 추가한다. 추가를 마친 뒤 build 를 호출해야 한다 */
+        void addTriangle(const Vector3& v0, const Vector3& v1, const Vector3& v2);
+
+        /* 삼각형들로 BVH 를 만들고 이웃 삼각형을 찾는다. 중심이 퍼진 축의 중앙값으로 반씩 나눈다 */
+        void build();
+
+        /* aabb 와 겹치는 리프의 삼각형마다 callback(const Triangle&) 을 호출한다.
+            callback 이 false 를 반환하면 순회를 멈춘다 */
+        template <typename QueryCallback>
+        void query(const AABB& aabb, QueryCallback& callback);
+
+        const std::vector<Triangle>& getTriangles() const { return triangles; }
+        unsigned int getNodeCount() const { return nodes.size(); }
+
+        /* 전체를 감싸는 AABB. 삼각형이 없다면 의미 없는 값이다 */
+        AABB getBounds() const { return nodes.empty() ? AABB() : nodes[0].aabb; }
+
+    private:
+        /* triangles 의 [first, first + count) 구간으로 노드를 만들고 인덱스를 반환한다 */
+        int buildNode(int first, int count);
+
+        /* 좌표가 같은 두 정점을 잇는 변을 찾아 neighborDirections 를 채운다.
+            세 개 이상의 삼각형이 공유하는 변은 이웃이 없는 것으로 본다 */
+        void findNeighbors();
+    };
+
+    template <typename QueryCallback>
+    void TriangleMesh::query(const AABB& aabb, QueryCallback& callback)
+    {
+        if (nodes.empty())
+            return;
+
+        stack.clear();
+        stack.push_back(0);
+        while (!stack.empty())
+        {
+            int nodeID = stack.back();
+            stack.pop_back();
+
+            const Node& node = nodes[nodeID];
+            if (!node.aabb.overlaps(aabb))
+                continue;
+
+            if (node.isLeaf())
+            {
+                for (int i = 0; i < node.triangleCount; ++i)
+                {
+                    if (!callback(triangles[node.firstTriangle + i]))
+                        return;
+                }
+            }
+            else
+            {
+                stack.push_back(node.child2);
+                stack.push_back(nodeID + 1);
+            }
+        }
+    }
+} // namespace physics
+
+#endif // TRIANGLE_MESH_H
@@ -1,10 +1,45 @@
 #ifndef VECTOR3_H
 #define VECTOR3_H
 
+#include <cmath>
+#include <cfloat>
+#include <iostream>
+
+/* PHYSICS_SIMD_MATH 를 정의하고 SSE4.1 로 빌드하면 Vector3 의 연산을 SSE 로 처리한다.
+    Vector3 의 크기가 16 바이트로 바뀌므로 라이브러리와 사용하는 쪽 모두 같은 설정으로 빌드해야 한다.
+    SSE4.1 을 쓸 수 없다면 정의되어 있더라도 스칼라 구현을 사용한다 */
+#if defined(PHYSICS_SIMD_MATH) && defined(__SSE4_1__)
+#define PHYSICS_SIMD_MATH_SSE
+#include <immintrin.h>
+#endif
+
 namespace physics
 {
+    /* 모든 연산을 헤더에 inline 으로 두어 충돌 해소처럼 연산이 많은 반복문에서 호출 비용이 없게 한다 */
     struct Vector3
     {
+#ifdef PHYSICS_SIMD_MATH_SSE
+        /* 성분을 따로 저장하면 연산마다 메모리를 거쳐 레지스터로 옮겨야 하므로 __m128 과 겹쳐 둔다.
+            네 번째 성분은 항상 0 이다 */
+        union
+        {
+            __m128 data;
+            struct
+            {
+                float x;
+                float y;
+                float z;
+                float padding;
+            };
+        };
+
+        /* 생성자 */
+        Vector3() : data(_mm_setzero_ps()) {}
+        Vector3(float _x, float _y, float _z) : data(_mm_setr_ps(_x, _y, _z, 0.0f)) {}
+        explicit Vector3(__m128 value) : data(value) {}
+
+        __m128 load() const { return data; }
+#else
         float x;
         float y;
         float z;
@@ -12,6 +47,7 @@ namespace physics
         /* 생성자 */
         Vector3() : x(0.0f), y(0.0f), z(0.0f) {}
         Vector3(float _x, float _y, float _z) : x(_x), y(_y), z(_z) {}
+#endif
 
         /* 벡터를 정규화한다 */
         void normalize();
@@ -47,8 +83,174 @@ namespace physics
         void operator*=(const float value);
 
         /* 인덱스로 접근하기 */
-        const float operator[](unsigned int idx) const;
+        float operator[](unsigned int idx) const;
     };
+
+#ifdef PHYSICS_SIMD_MATH_SSE
+    /* 내적의 결과를 모든 성분에 채운다. 네 번째 성분끼리의 곱은 더하지 않는다 */
+    inline __m128 dotSSE(__m128 a, __m128 b) { return _mm_dp_ps(a, b, 0x7F); }
+
+    inline void Vector3::normalize()
+    {
+        *this = Vector3(_mm_div_ps(load(), _mm_sqrt_ps(dotSSE(load(), load()))));
+    }
+
+    inline float Vector3::magnitude() const
+    {
+        return _mm_cvtss_f32(_mm_sqrt_ss(dotSSE(load(), load())));
+    }
+
+    inline float Vector3::magnitudeSquared() const
+    {
+        return _mm_cvtss_f32(dotSSE(load(), load()));
+    }
+
+    inline float Vector3::dot(const Vector3& other) const
+    {
+        return _mm_cvtss_f32(dotSSE(load(), other.load()));
+    }
+
+    inline Vector3 Vector3::cross(const Vector3& other) const
+    {
+        /* (a * b.yzx - a.yzx * b).yzx. 네 번째 성분은 0 * 0 - 0 * 0 이다 */
+        __m128 a = load();
+        __m128 b = other.load();
+        __m128 aYZX = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+        __m128 bYZX = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+        __m128 result = _mm_sub_ps(_mm_mul_ps(a, bYZX), _mm_mul_ps(aYZX, b));
+        return Vector3(_mm_shuffle_ps(result, result, _MM_SHUFFLE(3, 0, 2, 1)));
+    }
+
+    inline void Vector3::clear()
+    {
+        *this = Vector3(_mm_setzero_ps());
+    }
+
+    inline Vector3 Vector3::operator+(const Vector3& other) const
+    {
+        return Vector3(_mm_add_ps(load(), other.load()));
+    }
+
+    inline void Vector3::operator+=(const Vector3& other)
+    {
+        *this = *this + other;
+    }
+
+    inline Vector3 Vector3::operator-(const Vector3& other) const
+    {
+        return Vector3(_mm_sub_ps(load(), other.load()));
+    }
+
+    inline void Vector3::operator-=(const Vector3& other)
+    {
+        *this = *this - other;
+    }
+
+    inline Vector3 Vector3::operator*(const float value) const
+    {
+        return Vector3(_mm_mul_ps(load(), _mm_set1_ps(value)));
+    }
+
+    inline void Vector3::operator*=(const float value)
+    {
+        *this = *this * value;
+    }
+#else
+    inline void Vector3::normalize()
+    {
+        float magnitudeInverse = 1.0f / magnitude();
+        x *= magnitudeInverse;
+        y *= magnitudeInverse;
+        z *= magnitudeInverse;
+    }
+
+    inline float Vector3::magnitude() const
+    {
+        float sum = x*x + y*y + z*z;
+        return sqrtf(sum);
+    }
+
+    inline float Vector3::magnitudeSquared() const
+    {
+        return x*x + y*y + z*z;
+    }
+
+    inline float Vector3::dot(const Vector3& other) const
+    {
+        return x*other.x + y*other.y + z*other.z;
+    }
+
+    inline Vector3 Vector3::cross(const Vector3& other) const
+    {
+        return Vector3(
+            y*other.z - z*other.y,
+            -x*other.z + z*other.x,
+            x*other.y - y*other.x
+        );
+    }
+
+    inline void Vector3::clear()
+    {
+        x = 0.0f;
+        y = 0.0f;
+        z = 0.0f;
+    }
+
+    inline Vector3 Vector3::operator+(const Vector3& other) const
+    {
+        return Vector3(x + other.x, y + other.y, z + other.z);
+    }
+
+    inline void Vector3::operator+=(const Vector3& other)
+    {
+        x += other.x;
+        y += other.y;
+        z += other.z;
+    }
+
+    inline Vector3 Vector3::operator-(const Vector3& other) const
+    {
+        return Vector3(x - other.x, y - other.y, z - other.z);
+    }
+
+    inline void Vector3::operator-=(const Vector3& other)
+    {
+        x -= other.x;
+        y -= other.y;
+        z -= other.z;
+    }
+
+    inline Vector3 Vector3::operator*(const float value) const
+    {
+        return Vector3(x * value, y * value, z * value);
+    }
+
+    inline void Vector3::operator*=(const float value)
+    {
+        x *= value;
+        y *= value;
+        z *= value;
+    }
+#endif
+
+    inline float Vector3::operator[](unsigned int idx) const
+    {
+        switch (idx)
+        {
+        case 0:
+            return x;
+
+        case 1:
+            return y;
+
+        case 2:
+            return z;
+
+        default:
+            std::cout << "Vector3::operator[]::Out of index" << std::endl;
+            return FLT_MAX;
+        }
+    }
 } // namespace physics
 
 #endif // VECTOR3_H
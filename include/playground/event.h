@@ -3,14 +3,7 @@
 
 #include "geometry.h"
 
-class Event
-{
-public:
-    Event() {}
-    virtual ~Event() {}
-};
-
-class ObjectAddedEvent : public Event
+class ObjectAddedEvent
 {
 public:
     Geometry geometry;
@@ -19,7 +12,7 @@ public:
         : geometry(_geometry) {}
 };
 
-class ObjectSelectedEvent : public Event
+class ObjectSelectedEvent
 {
 public:
     unsigned int id;
@@ -29,11 +22,11 @@ public:
         : id(_id), isCtrlPressed(ctrl) {}
 };
 
-class ObjectRemovedEvent : public Event {};
+class ObjectRemovedEvent {};
 
-class SimulationStatusChangedEvent : public Event {};
+class SimulationStatusChangedEvent {};
 
-class ObjectPositionChangedEvent : public Event
+class ObjectPositionChangedEvent
 {
 public:
     unsigned int id;
@@ -48,7 +41,7 @@ public:
     }
 };
 
-class ObjectVelocityChangedEvent : public Event
+class ObjectVelocityChangedEvent
 {
 public:
     unsigned int id;
@@ -63,7 +56,7 @@ public:
     }
 };
 
-class ObjectGeometricDataChangedEvent : public Event
+class ObjectGeometricDataChangedEvent
 {
 public:
     unsigned int id;
@@ -78,7 +71,7 @@ public:
     }
 };
 
-class ObjectMassChangedEvent : public Event
+class ObjectMassChangedEvent
 {
 public:
     unsigned int id;
@@ -88,7 +81,7 @@ public:
         : id(_id), value(_value) {}
 };
 
-class LeftMouseDraggedOnSceneEvent : public Event
+class LeftMouseDraggedOnSceneEvent
 {
 public:
     float xOffset, yOffset;
@@ -97,7 +90,7 @@ public:
         : xOffset(_xOffset), yOffset(_yOffset) {}
 };
 
-class RightMouseDraggedOnSceneEvent : public Event
+class RightMouseDraggedOnSceneEvent
 {
 public:
     float curX, curY;
@@ -107,7 +100,7 @@ public:
         : curX(_curX), curY(_curY), prevX(_prevX), prevY(_prevY) {}
 };
 
-class MouseWheelOnSceneEvent : public Event
+class MouseWheelOnSceneEvent
 {
 public:
     float value;
@@ -116,7 +109,7 @@ public:
         : value(_value) {}
 };
 
-class LeftMouseClickedOnSceneEvent : public Event
+class LeftMouseClickedOnSceneEvent
 {
 public:
     float screenX, screenY;
@@ -126,7 +119,7 @@ public:
         : screenX(_x), screenY(_y), isCtrlPressed(_isCtrlPressed) {}
 };
 
-class ObjectPositionFixedEvent : public Event
+class ObjectPositionFixedEvent
 {
 public:
     unsigned int id;
@@ -136,7 +129,7 @@ public:
         : id(_id), shouldBeFixed(_shouldBeFixed) {}
 };
 
-class RenderContactInfoFlagChangedEvent : public Event
+class RenderContactInfoFlagChangedEvent
 {
 public:
     bool flag;
@@ -145,9 +138,9 @@ public:
         : flag(_flag) {}
 };
 
-class AllObjectRemovedEvent : public Event {};
+class AllObjectRemovedEvent {};
 
-class GroundRestitutionChangedEvent : public Event
+class GroundRestitutionChangedEvent
 {
 public:
     float value;
@@ -156,7 +149,7 @@ public:
         : value(_value) {}
 };
 
-class ObjectRestitutionChangedEvent : public Event
+class ObjectRestitutionChangedEvent
 {
 public:
     float value;
@@ -165,7 +158,7 @@ public:
         : value(_value) {}
 };
 
-class GravityChangedEvent : public Event
+class GravityChangedEvent
 {
 public:
     float value;
@@ -174,7 +167,7 @@ public:
         : value(_value) {}
 };
 
-class ObjectRotatedEvent : public Event
+class ObjectRotatedEvent
 {
 public:
     unsigned int id;
@@ -187,7 +180,7 @@ public:
         : id(_id), axisX(x), axisY(y), axisZ(z), degree(_degree) {}
 };
 
-class OrientationResetEvent : public Event
+class OrientationResetEvent
 {
 public:
     unsigned int id;
@@ -196,7 +189,7 @@ public:
         : id(_id) {}
 };
 
-class ShouldRenderWorldAxis : public Event
+class ShouldRenderWorldAxis
 {
 public:
     unsigned int id;
@@ -206,9 +199,9 @@ public:
         : id(_id), axisIdx(_axisIdx) {}
 };
 
-class RemoveUnfixedObjectsEvent : public Event {};
+class RemoveUnfixedObjectsEvent {};
 
-class TimeStepChangedEvent : public Event
+class TimeStepChangedEvent
 {
 public:
     float value;
@@ -217,4 +210,93 @@ public:
         : value(_value) {}
 };
 
+/* 이벤트의 종류. Event::type 으로 union 의 어느 멤버가 유효한지 나타낸다 */
+enum EventType
+{
+    EMPTY_EVENT,
+    OBJECT_ADDED,
+    OBJECT_SELECTED,
+    OBJECT_REMOVED,
+    SIMULATION_STATUS_CHANGED,
+    OBJECT_POSITION_CHANGED,
+    OBJECT_VELOCITY_CHANGED,
+    OBJECT_GEOMETRIC_DATA_CHANGED,
+    OBJECT_MASS_CHANGED,
+    LEFT_MOUSE_DRAGGED_ON_SCENE,
+    RIGHT_MOUSE_DRAGGED_ON_SCENE,
+    MOUSE_WHEEL_ON_SCENE,
+    LEFT_MOUSE_CLICKED_ON_SCENE,
+    OBJECT_POSITION_FIXED,
+    RENDER_CONTACT_INFO_FLAG_CHANGED,
+    ALL_OBJECT_REMOVED,
+    GROUND_RESTITUTION_CHANGED,
+    OBJECT_RESTITUTION_CHANGED,
+    GRAVITY_CHANGED,
+    OBJECT_ROTATED,
+    ORIENTATION_RESET,
+    SHOULD_RENDER_WORLD_AXIS,
+    REMOVE_UNFIXED_OBJECTS,
+    TIME_STEP_CHANGED
+};
+
+/* 모든 이벤트를 값으로 담는 태그된 union.
+    힙 할당 없이 큐에 그대로 복사되며, 받는 쪽은 type 으로 switch 해 처리한다 */
+class Event
+{
+public:
+    EventType type;
+
+    union
+    {
+        ObjectAddedEvent objectAdded;
+        ObjectSelectedEvent objectSelected;
+        ObjectRemovedEvent objectRemoved;
+        SimulationStatusChangedEvent simulationStatusChanged;
+        ObjectPositionChangedEvent objectPositionChanged;
+        ObjectVelocityChangedEvent objectVelocityChanged;
+        ObjectGeometricDataChangedEvent objectGeometricDataChanged;
+        ObjectMassChangedEvent objectMassChanged;
+        LeftMouseDraggedOnSceneEvent leftMouseDraggedOnScene;
+        RightMouseDraggedOnSceneEvent rightMouseDraggedOnScene;
+        MouseWheelOnSceneEvent mouseWheelOnScene;
+        LeftMouseClickedOnSceneEvent leftMouseClickedOnScene;
+        ObjectPositionFixedEvent objectPositionFixed;
+        RenderContactInfoFlagChangedEvent renderContactInfoFlagChanged;
+        AllObjectRemovedEvent allObjectRemoved;
+        GroundRestitutionChangedEvent groundRestitutionChanged;
+        ObjectRestitutionChangedEvent objectRestitutionChanged;
+        GravityChangedEvent gravityChanged;
+        ObjectRotatedEvent objectRotated;
+        OrientationResetEvent orientationReset;
+        ShouldRenderWorldAxis shouldRenderWorldAxis;
+        RemoveUnfixedObjectsEvent removeUnfixedObjects;
+        TimeStepChangedEvent timeStepChanged;
+    };
+
+    Event() : type(EMPTY_EVENT) {}
+    Event(const ObjectAddedEvent& event) : type(OBJECT_ADDED), objectAdded(event) {}
+    Event(const ObjectSelectedEvent& event) : type(OBJECT_SELECTED), objectSelected(event) {}
+    Event(const ObjectRemovedEvent& event) : type(OBJECT_REMOVED), objectRemoved(event) {}
+    Event(const SimulationStatusChangedEvent& event) : type(SIMULATION_STATUS_CHANGED), simulationStatusChanged(event) {}
+    Event(const ObjectPositionChangedEvent& event) : type(OBJECT_POSITION_CHANGED), objectPositionChanged(event) {}
+    Event(const ObjectVelocityChangedEvent& event) : type(OBJECT_VELOCITY_CHANGED), objectVelocityChanged(event) {}
+    Event(const ObjectGeometricDataChangedEvent& event) : type(OBJECT_GEOMETRIC_DATA_CHANGED), objectGeometricDataChanged(event) {}
+    Event(const ObjectMassChangedEvent& event) : type(OBJECT_MASS_CHANGED), objectMassChanged(event) {}
+    Event(const LeftMouseDraggedOnSceneEvent& event) : type(LEFT_MOUSE_DRAGGED_ON_SCENE), leftMouseDraggedOnScene(event) {}
+    Event(const RightMouseDraggedOnSceneEvent& event) : type(RIGHT_MOUSE_DRAGGED_ON_SCENE), rightMouseDraggedOnScene(event) {}
+    Event(const MouseWheelOnSceneEvent& event) : type(MOUSE_WHEEL_ON_SCENE), mouseWheelOnScene(event) {}
+    Event(const LeftMouseClickedOnSceneEvent& event) : type(LEFT_MOUSE_CLICKED_ON_SCENE), leftMouseClickedOnScene(event) {}
+    Event(const ObjectPositionFixedEvent& event) : type(OBJECT_POSITION_FIXED), objectPositionFixed(event) {}
+    Event(const RenderContactInfoFlagChangedEvent& event) : type(RENDER_CONTACT_INFO_FLAG_CHANGED), renderContactInfoFlagChanged(event) {}
+    Event(const AllObjectRemovedEvent& event) : type(ALL_OBJECT_REMOVED), allObjectRemoved(event) {}
+    Event(const GroundRestitutionChangedEvent& event) : type(GROUND_RESTITUTION_CHANGED), groundRestitutionChanged(event) {}
+    Event(const ObjectRestitutionChangedEvent& event) : type(OBJECT_RESTITUTION_CHANGED), objectRestitutionChanged(event) {}
+    Event(const GravityChangedEvent& event) : type(GRAVITY_CHANGED), gravityChanged(event) {}
+    Event(const ObjectRotatedEvent& event) : type(OBJECT_ROTATED), objectRotated(event) {}
+    Event(const OrientationResetEvent& event) : type(ORIENTATION_RESET), orientationReset(event) {}
+    Event(const ShouldRenderWorldAxis& event) : type(SHOULD_RENDER_WORLD_AXIS), shouldRenderWorldAxis(event) {}
+    Event(const RemoveUnfixedObjectsEvent& event) : type(REMOVE_UNFIXED_OBJECTS), removeUnfixedObjects(event) {}
+    Event(const TimeStepChangedEvent& event) : type(TIME_STEP_CHANGED), timeStepChanged(event) {}
+};
+
 #endif // EVENT_H
@@ -2,28 +2,60 @@
 #define EVENT_QUEUE_H
 
 #include "event.h"
-#include <iostream>
+#include "spsc_queue.h"
+#include <atomic>
+#include <vector>
 
+/* GUI 가 보낸 이벤트를 값으로 담아 두는 큐.
+    생산자 하나와 소비자 하나가 락 없이 사용할 수 있어 스레드를 건너 이벤트를 보낼 수 있다.
+    고정 크기 블록 (SPSCQueue) 들을 원형으로 이어 두고, 생산자의 블록이 가득 차면
+    소비자가 비워 둔 다음 블록으로 넘어간다. 다음 블록을 아직 소비자가 읽고 있다면
+    새 블록을 끼워 넣어 큐를 늘린다. 한 번 늘어난 블록은 계속 재사용하므로
+    큐가 충분히 커진 뒤에는 이벤트를 넣고 꺼낼 때 메모리를 할당하지 않는다 */
 class EventQueue
 {
-protected:
-    /* 큐가 꽉 찬 상태와 텅 빈 상태를 구분하기 위해 하나는 비워둔다 */
-    Event** elements;
-    int size;
-    /* 가장 먼저 들어온 원소의 인덱스 */
-    int front;
-    /* 다음에 들어올 원소의 자리를 가리키는 인덱스 */
-    int rear;
+private:
+    struct Block
+    {
+        SPSCQueue<Event> events;
+        std::atomic<Block*> next;
+
+        Block(int capacity) : events(capacity), next(nullptr) {}
+    };
+
+    int blockCapacity;
+
+    /* 소비자가 읽고 있는 블록과 생산자가 쓰고 있는 블록 */
+    alignas(64) std::atomic<Block*> headBlock;
+    alignas(64) std::atomic<Block*> tailBlock;
 
 public:
-    EventQueue() {}
-    EventQueue(int size);
+    EventQueue(int blockCapacity);
     ~EventQueue();
 
+    EventQueue(const EventQueue&) = delete;
+    EventQueue& operator=(const EventQueue&) = delete;
+
+    /* 생산자 스레드에서 호출한다. 가득 차는 일 없이 항상 들어간다 */
+    void push(const Event& event);
+
+    /* 소비자 스레드에서 호출한다. 비어 있다면 false 를 반환한다 */
+    bool pop(Event& event);
     bool isEmpty() const;
-    bool isFull() const;
-    void push(Event*);
-    Event* pop();
+
+    /* 쌓인 이벤트를 모두 꺼내 events 에 담고, 중복된 이벤트를 하나로 합친다.
+        events 는 호출할 때마다 비우고 다시 채우므로 재사용하면 할당이 일어나지 않는다 */
+    void popAll(std::vector<Event>& events);
+
+private:
+    /* 같은 대상의 값을 덮어쓰는 이벤트들은 마지막 것만 남기고,
+        카메라 이동처럼 누적되는 이벤트들은 값을 더해 하나로 합친다.
+        그 밖의 이벤트는 앞뒤 이벤트의 결과에 영향을 줄 수 있으므로 합치지 않고 경계로 삼는다 */
+    static void coalesce(std::vector<Event>& events);
+    static bool isBarrier(const Event& event);
+    static bool hasSameTarget(const Event& a, const Event& b);
+    static bool isAccumulative(const Event& event);
+    static void accumulate(Event& to, const Event& from);
 };
 
 #endif // EVENT_QUEUE_H
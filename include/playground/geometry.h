@@ -6,7 +6,11 @@
 enum Geometry
 {
     SPHERE,
-    BOX
+    BOX,
+    /* 로컬 y 축 방향의 선분을 반지름만큼 부풀린 도형 */
+    CAPSULE,
+    /* 로컬 y 축 방향으로 세운 원기둥 */
+    CYLINDER
 };
 
 #endif // GEOMETRY_H
@@ -4,6 +4,7 @@
 #include "geometry.h"
 #include "physics/body.h"
 #include "physics/collider.h"
+#include "physics_thread.h"
 #include "graphics/opengl/glm/glm.hpp"
 #include "graphics/shape.h"
 
@@ -18,16 +19,25 @@ public:
 protected:
     unsigned int id;
     Geometry geometry;
-    physics::RigidBody* body;
-    physics::Collider* collider;
     glm::vec3 color;
     graphics::Shape* shape;
 
     bool isSelected;
     bool isFixed;
 
+    /* 물리 스레드가 발행한 강체의 상태.
+        강체는 물리 스레드만 다루므로 메인 스레드는 이 값들만 읽는다 */
+    physics::Vector3 prevPosition;
+    physics::Vector3 curPosition;
+    physics::Quaternion prevOrientation;
+    physics::Quaternion curOrientation;
+    physics::Vector3 velocity;
+    physics::Vector3 rotation;
+    physics::Vector3 acceleration;
+    float mass;
+
 public:
-    Object() : isSelected(false), isFixed(false) {}
+    Object() : isSelected(false), isFixed(false), mass(5.0f) {}
     virtual ~Object() {};
 
     unsigned int getID() const { return id; }
@@ -42,10 +52,18 @@ public:
     void getMassInArray(float (&array)[3]) const;
     virtual void getGeometricDataInArray(float (&array)[3]) const = 0;
 
-    /* 구의 반지름 또는 직육면체의 half-size 를 설정한다 */
+    physics::Vector3 getPosition() const { return curPosition; }
+
+    /* 스냅샷의 상태로 갱신한다 */
+    void updateState(const BodySnapshot& snapshot);
+
+    /* 직전 상태와 현재 상태를 alpha 만큼 보간한 변환 행렬을 구한다 (column major) */
+    void getInterpolatedTransformMatrix(float alpha, float matrix[16]) const;
+
+    /* 구의 반지름, 직육면체의 half-size 또는 캡슐과 원기둥의 반지름과 높이의 절반을 설정한다 */
     virtual void setGeometricData(double, ...) = 0;
 
-    /* 도형의 속성값에 따라 강체, 충돌체, Shape 의 데이터를 갱신한다 */
+    /* 도형의 속성값에 따라 Shape 의 데이터를 갱신한다. 메인 스레드에서 호출한다 */
     virtual void updateDerivedData() = 0;
 };
 
@@ -77,4 +95,33 @@ public:
     void updateDerivedData();
 };
 
+class CapsuleObject : public Object
+{
+protected:
+    float radius;
+    /* 양 끝 반구의 중심 사이 거리의 절반 */
+    float halfHeight;
+
+public:
+    CapsuleObject() : radius(0.5f), halfHeight(0.5f) {}
+
+    void getGeometricDataInArray(float (&array)[3]) const;
+    void setGeometricData(double, ...);
+    void updateDerivedData();
+};
+
+class CylinderObject : public Object
+{
+protected:
+    float radius;
+    float halfHeight;
+
+public:
+    CylinderObject() : radius(0.5f), halfHeight(0.5f) {}
+
+    void getGeometricDataInArray(float (&array)[3]) const;
+    void setGeometricData(double, ...);
+    void updateDerivedData();
+};
+
 #endif // OBJECT_H
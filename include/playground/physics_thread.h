@@ -0,0 +1,213 @@
+#ifndef PHYSICS_THREAD_H
+#define PHYSICS_THREAD_H
+
+#include "physics/simulator.h"
+#include "geometry.h"
+#include "spsc_queue.h"
+#include "triple_buffer.h"
+#include "contact_info.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/* 렌더링과 GUI 에 필요한 강체 하나의 상태.
+    보간 렌더링을 위해 직전 물리 스텝 전후의 위치와 방향을 함께 담는다 */
+struct BodySnapshot
+{
+    unsigned int id;
+    physics::Vector3 prevPosition;
+    physics::Vector3 position;
+    physics::Quaternion prevOrientation;
+    physics::Quaternion orientation;
+    physics::Vector3 velocity;
+    physics::Vector3 rotation;
+    physics::Vector3 acceleration;
+    float mass;
+};
+
+/* 물리 스레드가 발행하는 시뮬레이션 상태 */
+struct PhysicsSnapshot
+{
+    std::vector<BodySnapshot> bodies;
+    /* 마지막 물리 스텝의 충돌 정보 */
+    std::vector<ContactInfo> contacts;
+
+    /* 발행 시각과 그때 남아 있던 누적 시간 (초).
+        렌더 스레드는 이 값으로 다음 스텝까지 얼마나 진행했는지 계산해 보간한다 */
+    std::chrono::steady_clock::time_point publishTime;
+    double accumulator;
+};
+
+/* 물리 스레드에 보내는 명령의 종류. PhysicsCommand::type 으로 union 의 어느 멤버가 유효한지 나타낸다 */
+enum PhysicsCommandType
+{
+    EMPTY_COMMAND,
+    ADD_OBJECT_COMMAND,
+    REMOVE_OBJECT_COMMAND,
+    SET_GEOMETRIC_DATA_COMMAND,
+    SET_MASS_COMMAND,
+    SET_POSITION_COMMAND,
+    SET_VELOCITY_COMMAND,
+    SET_ORIENTATION_COMMAND,
+    ROTATE_OBJECT_COMMAND,
+    FIX_OBJECT_COMMAND,
+    SET_HEIGHTFIELD_COMMAND,
+    REMOVE_HEIGHTFIELD_COMMAND,
+    SET_GROUND_RESTITUTION_COMMAND,
+    SET_OBJECT_RESTITUTION_COMMAND,
+    SET_GRAVITY_COMMAND,
+    CAST_RAY_COMMAND
+};
+
+/* 지형을 만드는 데 필요한 값들. 격자의 크기가 정해져 있지 않으므로 명령에는 주소만 담는다 */
+struct HeightfieldData
+{
+    int columnCount;
+    int rowCount;
+    float cellSize;
+    physics::Vector3 origin;
+    std::vector<float> heights;
+};
+
+struct RayCastQuery;
+
+/* 명령 하나를 값으로 담는 태그된 union. Event 처럼 힙 할당 없이 큐에 그대로 복사된다.
+    id 는 오브젝트에 대한 명령의 대상이며, 실행될 때 이미 제거된 오브젝트라면 명령을 무시한다 */
+struct PhysicsCommand
+{
+    PhysicsCommandType type;
+    unsigned int id;
+
+    union
+    {
+        /* ADD_OBJECT_COMMAND */
+        struct
+        {
+            Geometry geometry;
+            float position[3];
+        } addObject;
+
+        /* SET_GEOMETRIC_DATA_COMMAND, SET_MASS_COMMAND.
+            도형의 속성값에 맞춰 관성 모멘트와 충돌체를 갱신한다. mass 는 SET_MASS_COMMAND 에서만 쓴다 */
+        struct
+        {
+            Geometry geometry;
+            float geometricData[3];
+            float mass;
+        } physicsData;
+
+        /* SET_POSITION_COMMAND, SET_VELOCITY_COMMAND */
+        float vector[3];
+
+        /* SET_ORIENTATION_COMMAND. (w, x, y, z) 순서이다 */
+        float orientation[4];
+
+        /* ROTATE_OBJECT_COMMAND. 월드 좌표계의 축을 중심으로 radian 만큼 회전한다 */
+        struct
+        {
+            float radian;
+            float axis[3];
+        } rotation;
+
+        /* SET_GROUND_RESTITUTION_COMMAND, SET_OBJECT_RESTITUTION_COMMAND, SET_GRAVITY_COMMAND */
+        float value;
+
+        /* SET_HEIGHTFIELD_COMMAND. 보낸 쪽이 new 로 만들고 물리 스레드가 해제한다 */
+        HeightfieldData* heightfield;
+
+        /* CAST_RAY_COMMAND. 보낸 쪽이 실행될 때까지 기다리므로 보낸 쪽의 스택에 있다 */
+        RayCastQuery* rayCast;
+    };
+
+    PhysicsCommand() : type(EMPTY_COMMAND), id(0) {}
+    PhysicsCommand(PhysicsCommandType _type, unsigned int _id = 0) : type(_type), id(_id) {}
+};
+
+/* 시뮬레이터를 소유하고 전용 스레드에서 고정된 타임 스텝으로 진행한다.
+    메인 스레드는 시뮬레이터를 직접 만지지 않고 SPSC 명령 큐로 명령을 보내며,
+    물리 스레드가 삼중 버퍼로 발행하는 스냅샷을 읽어 렌더한다.
+    명령은 물리 스텝 사이에 보낸 순서대로 실행된다 */
+class PhysicsThread
+{
+private:
+    physics::Simulator simulator;
+
+    SPSCQueue<PhysicsCommand> commandQueue;
+    TripleBuffer<PhysicsSnapshot> snapshots;
+
+    std::thread thread;
+    std::atomic<bool> isRunning;
+    std::atomic<bool> isSimulating;
+    std::atomic<float> timeStepMultiplier;
+
+    /* 물리 스텝은 항상 fixedTimeStep 으로 진행한다.
+        흘러간 시간을 accumulator 에 모아 fixedTimeStep 단위로 소모하고,
+        한 번에 maxSubsteps 번을 넘게 스텝해야 한다면 남은 시간은 버린다 */
+    float fixedTimeStep;
+    int maxSubsteps;
+    double accumulator;
+
+    /* 물리 스레드만 사용하는 값들 */
+    typedef std::pair<physics::Vector3, physics::Quaternion> BodyState;
+    std::unordered_map<unsigned int, BodyState> previousStates;
+    std::vector<ContactInfo*> contactInfo;
+
+public:
+    PhysicsThread();
+    ~PhysicsThread();
+
+    /* 물리 스레드를 시작하거나 멈춘다. 소멸자에서도 멈춘다 */
+    void start();
+    void stop();
+
+    /* 명령을 큐에 넣는다. 큐가 가득 찼다면 자리가 날 때까지 기다린다 */
+    void pushCommand(const PhysicsCommand& command);
+
+    /* 반직선과 가장 먼저 만나는 오브젝트를 찾는다. 물리 스텝 사이에 실행되므로 기다린다 */
+    bool castRay(
+        const physics::Vector3& origin,
+        const physics::Vector3& direction,
+        unsigned int& hitID,
+        float& hitDistance
+    );
+
+    /* 새 스냅샷이 발행되었다면 가져오고 true 를 반환한다. 메인 스레드에서 호출한다 */
+    bool updateSnapshot() { return snapshots.update(); }
+    const PhysicsSnapshot& getSnapshot() const { return snapshots.getReadBuffer(); }
+
+    /* 현재 시각에 렌더할 보간 계수 (0 ~ 1) 를 스냅샷으로부터 계산한다 */
+    float calcInterpolationFactor() const;
+
+    void setSimulating(bool value) { isSimulating.store(value); }
+    void setTimeStepMultiplier(float value) { timeStepMultiplier.store(value); }
+    float getFixedTimeStep() const { return fixedTimeStep; }
+
+private:
+    void threadLoop();
+
+    /* 큐에 쌓인 명령을 모두 실행하고 실행한 명령이 있는지 반환한다 */
+    bool applyCommands();
+    void applyCommand(const PhysicsCommand& command);
+
+    /* 도형의 속성값에 따라 강체의 관성 모멘트와 충돌체의 데이터를 갱신한다 */
+    static void updatePhysicsData(
+        Geometry geometry,
+        const float (&geometricData)[3],
+        physics::RigidBody* body,
+        physics::Collider* collider
+    );
+
+    /* 현재 상태를 보간의 시작 상태로 저장한다 */
+    void savePreviousStates();
+
+    /* 명령으로 옮겨진 강체 하나만 현재 상태에서 보간을 다시 시작한다.
+        나머지 강체는 직전 스텝의 보간을 그대로 이어간다 */
+    void resetPreviousState(unsigned int id);
+
+    void clearContactInfo();
+    void publishSnapshot();
+};
+
+#endif // PHYSICS_THREAD_H
@@ -1,7 +1,7 @@
 #ifndef PLAYGROUND_H
 #define PLAYGROUND_H
 
-#include "physics/simulator.h"
+#include "physics_thread.h"
 #include "graphics/renderer.h"
 #include "gui/gui.h"
 #include "object.h"
@@ -15,7 +15,8 @@ public:
     typedef std::unordered_map<unsigned int, Object*> Objects;
 
 private:
-    physics::Simulator simulator;
+    /* 시뮬레이터는 물리 스레드가 소유한다 */
+    PhysicsThread physicsThread;
     graphics::Renderer renderer;
     gui::GUI userInterface;
 
@@ -28,9 +29,12 @@ private:
     std::vector<unsigned int> selectedObjectIDs;
 
     EventQueue eventQueue;
+    /* 매 프레임 큐에서 꺼낸 이벤트를 담는다. 재사용해 할당을 피한다 */
+    std::vector<Event> pendingEvents;
     bool isSimulating;
     bool shouldRenderContactInfo;
-    /* 시뮬레이션 타임 스텝 조정 */
+    /* 시뮬레이션 타임 스텝 조정.
+        프레임 시간에 곱해져 시뮬레이션 시간이 흐르는 속도를 바꾼다 */
     float timeStepMultiplier;
 
 public:
@@ -43,13 +47,25 @@ public:
     unsigned int addObject(Geometry, float posX = 0.0f, float posY = 3.0f, float posZ = 0.0f);
     Objects::iterator removeObject(unsigned int id);
 
-    void handleEvent(Event*);
+    void handleEvent(Event&);
     void handleKeyboardInput();
 
 private:
+    /* 물리 스레드가 발행한 최신 스냅샷을 오브젝트들에 반영한다 */
+    void applySnapshot();
+
+    /* 오브젝트의 도형 속성값을 물리 스레드의 강체와 충돌체에 반영한다 */
+    void updatePhysicsData(Object* object);
+
     void clearSelectedObjectIDs();
     void loadPreset1();
     void loadPreset2();
+    /* 언덕 지형 위에 여러 물체를 떨어뜨린다 */
+    void loadPreset3();
+
+    /* 물리 스레드의 지면과 렌더러의 배경을 지형으로 바꾸거나 평면으로 되돌린다 */
+    void setHeightfield(int columnCount, int rowCount, float cellSize, const physics::Vector3& origin, const std::vector<float>& heights);
+    void removeHeightfield();
 
     void handleObjectAddedEvent(ObjectAddedEvent*);
     void handleObjectSelectedEvent(ObjectSelectedEvent*);
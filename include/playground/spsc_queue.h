@@ -0,0 +1,84 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/* 생산자 스레드 하나와 소비자 스레드 하나가 락 없이 사용하는 고정 크기 링 버퍼.
+    head 는 소비자만, tail 은 생산자만 쓰며 서로의 값은 acquire 로 읽는다.
+    두 인덱스는 계속 증가하고 용량 (2 의 거듭제곱) 으로 나눈 나머지로 칸을 찾는다 */
+template <typename T>
+class SPSCQueue
+{
+private:
+    static const size_t cacheLineSize = 64;
+
+    /* 앞뒤로 캐시 라인 크기 이상을 비워 두어 다른 멤버와 같은 캐시 라인에 놓이지 않는 인덱스.
+        C++11 의 new 는 alignas(64) 를 지키지 않으므로 정렬 대신 채워 넣어 떨어뜨린다 */
+    struct PaddedIndex
+    {
+        char leading[cacheLineSize];
+        std::atomic<size_t> value;
+        char trailing[cacheLineSize - sizeof(std::atomic<size_t>)];
+
+        explicit PaddedIndex(size_t _value) : value(_value) {}
+    };
+
+    std::vector<T> buffer;
+    size_t mask;
+
+    /* 생산자와 소비자가 같은 캐시 라인을 두고 다투지 않도록 떨어뜨려 둔다 */
+    PaddedIndex head;
+    PaddedIndex tail;
+
+public:
+    /* 용량은 capacity 이상의 가장 작은 2 의 거듭제곱이다 */
+    explicit SPSCQueue(size_t capacity) : head(0), tail(0)
+    {
+        size_t size = 1;
+        while (size < capacity)
+            size <<= 1;
+        buffer.resize(size);
+        mask = size - 1;
+    }
+
+    SPSCQueue(const SPSCQueue&) = delete;
+    SPSCQueue& operator=(const SPSCQueue&) = delete;
+
+    /* 생산자 스레드에서 호출한다. 가득 찼다면 false 를 반환한다 */
+    bool push(const T& item)
+    {
+        size_t curTail = tail.value.load(std::memory_order_relaxed);
+        if (curTail - head.value.load(std::memory_order_acquire) == buffer.size())
+            return false;
+
+        buffer[curTail & mask] = item;
+        tail.value.store(curTail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /* 소비자 스레드에서 호출한다. 비어 있다면 false 를 반환한다 */
+    bool pop(T& item)
+    {
+        size_t curHead = head.value.load(std::memory_order_relaxed);
+        if (curHead == tail.value.load(std::memory_order_acquire))
+            return false;
+
+        /* 꺼낸 칸은 비워서 붙잡고 있던 자원을 바로 놓아준다 */
+        item = std::move(buffer[curHead & mask]);
+        buffer[curHead & mask] = T();
+        head.value.store(curHead + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool isEmpty() const
+    {
+        return head.value.load(std::memory_order_acquire) == tail.value.load(std::memory_order_acquire);
+    }
+
+    size_t getCapacity() const { return buffer.size(); }
+};
+
+#endif // SPSC_QUEUE_H
@@ -0,0 +1,52 @@
+#ifndef TRIPLE_BUFFER_H
+#define TRIPLE_BUFFER_H
+
+#include <atomic>
+
+/* 쓰는 스레드 하나와 읽는 스레드 하나가 락 없이 최신 값을 주고받는 삼중 버퍼.
+    쓰는 쪽은 뒤 버퍼를 채운 뒤 가운데 버퍼와 맞바꾸고, 읽는 쪽은 새 값이 있을 때만
+    앞 버퍼를 가운데 버퍼와 맞바꾼다. 어느 쪽도 상대를 기다리지 않으며
+    읽는 쪽이 느리다면 중간의 값들은 건너뛴다 */
+template <typename T>
+class TripleBuffer
+{
+private:
+    /* 가운데 버퍼의 인덱스와, 쓰인 뒤 아직 읽히지 않았음을 나타내는 비트 */
+    static const unsigned int INDEX_MASK = 3;
+    static const unsigned int FRESH_BIT = 4;
+
+    T buffers[3];
+    std::atomic<unsigned int> middle;
+    unsigned int writeIndex;
+    unsigned int readIndex;
+
+public:
+    TripleBuffer() : middle(1), writeIndex(0), readIndex(2) {}
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    /* 쓰는 스레드가 채울 버퍼. 예전에 발행했던 값이 남아 있을 수 있다 */
+    T& getWriteBuffer() { return buffers[writeIndex]; }
+
+    /* 채운 버퍼를 읽는 스레드에게 넘긴다 */
+    void publish()
+    {
+        writeIndex = middle.exchange(writeIndex | FRESH_BIT, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    /* 새로 발행된 값이 있다면 읽기 버퍼로 가져오고 true 를 반환한다 */
+    bool update()
+    {
+        if ((middle.load(std::memory_order_acquire) & FRESH_BIT) == 0)
+            return false;
+
+        readIndex = middle.exchange(readIndex, std::memory_order_acq_rel) & INDEX_MASK;
+        return true;
+    }
+
+    /* 읽는 스레드가 마지막으로 가져온 값 */
+    const T& getReadBuffer() const { return buffers[readIndex]; }
+};
+
+#endif // TRIPLE_BUFFER_H
@@ -6,7 +6,7 @@ using namespace graphics;
 
 Renderer::Renderer()
     : windowWidth(WINDOW_WIDTH), windowHeight(WINDOW_HEIGHT),
-        sceneWidth(SCENE_WIDTH), sceneHeight(SCENE_HEIGHT)
+        sceneWidth(SCENE_WIDTH), sceneHeight(SCENE_HEIGHT), heightfield(nullptr)
 {
     /* GLFW 초기화 */
     glfwInit();
@@ -122,6 +122,7 @@ Renderer::~Renderer()
     {
         delete shape.second;
     }
+    delete heightfield;
 
     glfwTerminate();
 }
@@ -149,6 +150,10 @@ Shape* Renderer::addShape(unsigned int id, Geometry geometry)
         newShape = new Sphere;
     else if (geometry == BOX)
         newShape = new Box;
+    else if (geometry == CAPSULE)
+        newShape = new Capsule;
+    else if (geometry == CYLINDER)
+        newShape = new Cylinder;
 
     shapes[id] = newShape;
     return newShape;
@@ -162,6 +167,25 @@ void Renderer::removeShape(unsigned int id)
     shapes.erase(shapeIter);
 }
 
+void Renderer::setHeightfield(
+    int columnCount,
+    int rowCount,
+    float cellSize,
+    glm::vec3 origin,
+    const std::vector<float>& heights
+)
+{
+    delete heightfield;
+    heightfield = new Heightfield(columnCount, rowCount, cellSize, heights);
+    heightfieldOrigin = origin;
+}
+
+void Renderer::removeHeightfield()
+{
+    delete heightfield;
+    heightfield = nullptr;
+}
+
 void Renderer::renderObject(
     unsigned int id,
     glm::vec3 color,
@@ -220,6 +244,13 @@ void Renderer::renderObject(
             objectShader.setMat4("model", model);
             glDrawElements(GL_LINE_STRIP, objectShape->frameIndices.size(), GL_UNSIGNED_INT, (void*)0);
         }
+        else if (typeid(*objectShape) == typeid(Capsule))
+        {
+            /* xy 평면의 윤곽선을 y 축으로 돌려 yz 평면에도 그린다 */
+            model = glm::rotate(model, glm::radians(90.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+            objectShader.setMat4("model", model);
+            glDrawElements(GL_LINE_STRIP, objectShape->frameIndices.size(), GL_UNSIGNED_INT, (void*)0);
+        }
     }
 
     glBindVertexArray(0);
@@ -243,6 +274,25 @@ void Renderer::renderBackground()
     objectShader.setVec3("objectColor", glm::vec3(0.0f, 0.0f, 0.0f));
     objectShader.setVec3("viewPos", camera.getPosition());
 
+    /* 지형이 있다면 그리드 대신 지형의 표면과 격자선을 한 번씩 그린다 */
+    if (heightfield != nullptr)
+    {
+        glm::mat4 model(1.0f);
+        model = glm::translate(model, heightfieldOrigin);
+        objectShader.setMat4("model", model);
+
+        objectShader.setVec3("objectColor", glm::vec3(0.45f, 0.5f, 0.4f));
+        glBindVertexArray(heightfield->polygonVAO);
+        glDrawElements(GL_TRIANGLES, heightfield->polygonIndices.size(), GL_UNSIGNED_INT, (void*)0);
+
+        objectShader.setVec3("objectColor", glm::vec3(0.2f, 0.2f, 0.2f));
+        glBindVertexArray(heightfield->frameVAO);
+        glDrawElements(GL_LINES, heightfield->frameIndices.size(), GL_UNSIGNED_INT, (void*)0);
+
+        glBindVertexArray(0);
+        return;
+    }
+
     /* 직선을 translate 하며 grid 렌더 */
     glBindVertexArray(backgroundVAO);
     for (float gap = 0.0f; gap < 100.0f; gap += GRID_GAP)
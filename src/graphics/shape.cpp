@@ -185,3 +185,222 @@ void Sphere::generateIndices()
         frameIndices.push_back(k2);
     }
 }
+
+Capsule::Capsule()
+{
+    generateVertices(0.5f, 0.5f);
+    generateIndices();
+    generateVAOs();
+}
+
+void Capsule::generateVertices(double value, ...)
+{
+    float radius = (float)value;
+
+    va_list args;
+    va_start(args, value);
+
+    float halfHeight = (float) va_arg(args, double);
+
+    va_end(args);
+
+    float sectorStep = 2 * PI / SECTOR_CNT;
+    float stackStep = PI / 2 / HALF_STACK_CNT;
+
+    /* 위 반구는 위 극점에서 적도까지, 아래 반구는 적도에서 아래 극점까지 내려간다.
+        위 반구의 적도와 아래 반구의 적도 사이가 원기둥 옆면이 된다 */
+    vertices.clear();
+    for (int hemisphere = 0; hemisphere < 2; ++hemisphere)
+    {
+        float centerY = hemisphere == 0 ? halfHeight : -halfHeight;
+        for (int i = 0; i <= HALF_STACK_CNT; ++i)
+        {
+            float stackAngle = PI / 2 - (hemisphere * HALF_STACK_CNT + i) * stackStep;
+            float xz = radius * cosf(stackAngle);
+            float y = centerY + radius * sinf(stackAngle);
+
+            for (int j = 0; j <= SECTOR_CNT; ++j)
+            {
+                float sectorAngle = j * sectorStep;
+                vertices.push_back(xz * cosf(sectorAngle));
+                vertices.push_back(y);
+                vertices.push_back(xz * sinf(sectorAngle));
+            }
+        }
+    }
+}
+
+void Capsule::generateIndices()
+{
+    const int rowCount = 2 * (HALF_STACK_CNT + 1);
+    for (int i = 0; i < rowCount - 1; ++i)
+    {
+        int k1 = i * (SECTOR_CNT + 1);
+        int k2 = k1 + SECTOR_CNT + 1;
+
+        for (int j = 0; j < SECTOR_CNT; ++j, ++k1, ++k2)
+        {
+            /* 첫 행과 마지막 행은 극점이므로 삼각형 하나씩만 만든다 */
+            if (i != 0)
+            {
+                polygonIndices.push_back(k1);
+                polygonIndices.push_back(k2);
+                polygonIndices.push_back(k1 + 1);
+            }
+            if (i != rowCount - 2)
+            {
+                polygonIndices.push_back(k1 + 1);
+                polygonIndices.push_back(k2);
+                polygonIndices.push_back(k2 + 1);
+            }
+        }
+    }
+
+    /* 테두리는 xy 평면의 윤곽선이다. 한쪽 옆으로 내려갔다가 반대쪽 옆으로 올라온다 */
+    for (int i = 0; i < rowCount; ++i)
+        frameIndices.push_back(i * (SECTOR_CNT + 1));
+    for (int i = rowCount - 1; i >= 0; --i)
+        frameIndices.push_back(i * (SECTOR_CNT + 1) + SECTOR_CNT / 2);
+    frameIndices.push_back(0);
+}
+
+Cylinder::Cylinder()
+{
+    generateVertices(0.5f, 0.5f);
+    generateIndices();
+    generateVAOs();
+}
+
+void Cylinder::generateVertices(double value, ...)
+{
+    float radius = (float)value;
+
+    va_list args;
+    va_start(args, value);
+
+    float halfHeight = (float) va_arg(args, double);
+
+    va_end(args);
+
+    float sectorStep = 2 * PI / SECTOR_CNT;
+
+    /* 밑면 중심, 윗면 중심, 밑면 테두리, 윗면 테두리 순서 */
+    vertices.clear();
+    vertices.push_back(0.0f);
+    vertices.push_back(-halfHeight);
+    vertices.push_back(0.0f);
+    vertices.push_back(0.0f);
+    vertices.push_back(halfHeight);
+    vertices.push_back(0.0f);
+    for (int ring = 0; ring < 2; ++ring)
+    {
+        float y = ring == 0 ? -halfHeight : halfHeight;
+        for (int j = 0; j <= SECTOR_CNT; ++j)
+        {
+            float sectorAngle = j * sectorStep;
+            vertices.push_back(radius * cosf(sectorAngle));
+            vertices.push_back(y);
+            vertices.push_back(radius * sinf(sectorAngle));
+        }
+    }
+}
+
+void Cylinder::generateIndices()
+{
+    const int bottomRing = 2;
+    const int topRing = bottomRing + SECTOR_CNT + 1;
+    for (int j = 0; j < SECTOR_CNT; ++j)
+    {
+        /* 밑면 */
+        polygonIndices.push_back(0);
+        polygonIndices.push_back(bottomRing + j);
+        polygonIndices.push_back(bottomRing + j + 1);
+
+        /* 윗면 */
+        polygonIndices.push_back(1);
+        polygonIndices.push_back(topRing + j + 1);
+        polygonIndices.push_back(topRing + j);
+
+        /* 옆면 */
+        polygonIndices.push_back(bottomRing + j);
+        polygonIndices.push_back(topRing + j);
+        polygonIndices.push_back(bottomRing + j + 1);
+        polygonIndices.push_back(bottomRing + j + 1);
+        polygonIndices.push_back(topRing + j);
+        polygonIndices.push_back(topRing + j + 1);
+    }
+
+    /* 테두리. 밑면 원을 한 바퀴 돈 뒤 옆면을 따라 올라가 윗면 원을 한 바퀴 돈다 */
+    for (int j = 0; j <= SECTOR_CNT; ++j)
+        frameIndices.push_back(bottomRing + j);
+    for (int j = SECTOR_CNT; j >= 0; --j)
+        frameIndices.push_back(topRing + j);
+}
+
+Heightfield::Heightfield(int _columnCount, int _rowCount, float cellSize, const std::vector<float>& _heights)
+    : columnCount(_columnCount), rowCount(_rowCount), heights(_heights)
+{
+    generateVertices(cellSize);
+    generateIndices();
+    generateVAOs();
+}
+
+void Heightfield::generateVertices(double value, ...)
+{
+    float cellSize = (float)value;
+
+    /* 격자점 (0, 0) 이 로컬 원점이다 */
+    vertices.clear();
+    vertices.reserve(columnCount * rowCount * 3);
+    for (int row = 0; row < rowCount; ++row)
+    {
+        for (int column = 0; column < columnCount; ++column)
+        {
+            vertices.push_back(column * cellSize);
+            vertices.push_back(heights[row * columnCount + column]);
+            vertices.push_back(row * cellSize);
+        }
+    }
+}
+
+void Heightfield::generateIndices()
+{
+    /* 칸마다 physics::HeightfieldCollider 와 같은 대각선으로 삼각형 두 개를 만든다 */
+    polygonIndices.clear();
+    frameIndices.clear();
+    for (int row = 0; row < rowCount - 1; ++row)
+    {
+        for (int column = 0; column < columnCount - 1; ++column)
+        {
+            unsigned int k00 = row * columnCount + column;
+            unsigned int k10 = k00 + 1;
+            unsigned int k01 = k00 + columnCount;
+            unsigned int k11 = k01 + 1;
+
+            polygonIndices.push_back(k00);
+            polygonIndices.push_back(k01);
+            polygonIndices.push_back(k11);
+            polygonIndices.push_back(k00);
+            polygonIndices.push_back(k11);
+            polygonIndices.push_back(k10);
+        }
+    }
+
+    /* x 축 방향과 z 축 방향의 격자선 */
+    for (int row = 0; row < rowCount; ++row)
+    {
+        for (int column = 0; column < columnCount - 1; ++column)
+        {
+            frameIndices.push_back(row * columnCount + column);
+            frameIndices.push_back(row * columnCount + column + 1);
+        }
+    }
+    for (int column = 0; column < columnCount; ++column)
+    {
+        for (int row = 0; row < rowCount - 1; ++row)
+        {
+            frameIndices.push_back(row * columnCount + column);
+            frameIndices.push_back((row + 1) * columnCount + column);
+        }
+    }
+}
@@ -82,11 +82,11 @@ void GUI::renderScene(
             {
                 ImVec2 dragDelta = io.MouseDelta;
                 if (dragDelta.x != 0.0f && dragDelta.y != 0.0f)
-                    eventQueue.push(new LeftMouseDraggedOnSceneEvent(dragDelta.x, -dragDelta.y));
+                    eventQueue.push(LeftMouseDraggedOnSceneEvent(dragDelta.x, -dragDelta.y));
             }
             else if (ImGui::IsMouseReleased(0) && io.MouseDownDurationPrev[0] < 0.03f)
             {
-                eventQueue.push(new LeftMouseClickedOnSceneEvent(clickedPos.x, clickedPos.y, io.KeyCtrl));
+                eventQueue.push(LeftMouseClickedOnSceneEvent(clickedPos.x, clickedPos.y, io.KeyCtrl));
             }
         }
 
@@ -97,7 +97,7 @@ void GUI::renderScene(
             ImVec2 dragDelta = io.MouseDelta;
             if (dragDelta.x != 0.0f && dragDelta.y != 0.0f)
             {
-                eventQueue.push(new RightMouseDraggedOnSceneEvent(
+                eventQueue.push(RightMouseDraggedOnSceneEvent(
                     clickedPos.x + dragDelta.x * 10.0f,
                     clickedPos.y + dragDelta.y * 10.0f,
                     clickedPos.x,
@@ -111,7 +111,7 @@ void GUI::renderScene(
         {
             float mouseWheel = io.MouseWheel;
             if (mouseWheel != 0.0f)
-                eventQueue.push(new MouseWheelOnSceneEvent(mouseWheel));
+                eventQueue.push(MouseWheelOnSceneEvent(mouseWheel));
         }
 
         ImGui::EndChild();
@@ -134,12 +134,22 @@ void GUI::renderObjectPalette(ImGuiWindowFlags windowFlags, EventQueue& eventQue
         ImVec2 buttonSize(100, 100);
         if (ImGui::Button("Sphere", buttonSize))
         {
-            eventQueue.push(new ObjectAddedEvent(SPHERE));
+            eventQueue.push(ObjectAddedEvent(SPHERE));
         }
         ImGui::SameLine();
         if (ImGui::Button("Box", buttonSize))
         {
-            eventQueue.push(new ObjectAddedEvent(BOX));
+            eventQueue.push(ObjectAddedEvent(BOX));
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Capsule", buttonSize))
+        {
+            eventQueue.push(ObjectAddedEvent(CAPSULE));
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Cylinder", buttonSize))
+        {
+            eventQueue.push(ObjectAddedEvent(CYLINDER));
         }
         
         ImGui::EndChild();
@@ -164,19 +174,19 @@ void GUI::renderSimulationControl(
         if (!isSimulating)
             label = "Resume Simulation";
         if (ImGui::Button(label.c_str()))
-            eventQueue.push(new SimulationStatusChangedEvent);
+            eventQueue.push(SimulationStatusChangedEvent());
 
         /* 선택된 오브젝트 삭제 버튼 */
         if (ImGui::Button("Remove Selected Objects"))
-            eventQueue.push(new ObjectRemovedEvent);
+            eventQueue.push(ObjectRemovedEvent());
 
         /* 고정되지 않은 오브젝트 삭제 버튼 */
         if (ImGui::Button("Remove Unfixed Objects"))
-            eventQueue.push(new RemoveUnfixedObjectsEvent);
+            eventQueue.push(RemoveUnfixedObjectsEvent());
 
         /* 모든 오브젝트 삭제 버튼 */
         if (ImGui::Button("Remove All Objects"))
-            eventQueue.push(new AllObjectRemovedEvent);
+            eventQueue.push(AllObjectRemovedEvent());
 
         ImGui::EndChild();
     }
@@ -205,9 +215,9 @@ void GUI::renderObjectList(
             {
                 /* ctrl 키를 누른 채로 클릭하면 다중 선택이 가능하다 */
                 if (ImGui::GetIO().KeyCtrl)
-                    eventQueue.push(new ObjectSelectedEvent(object.second->getID(), true));
+                    eventQueue.push(ObjectSelectedEvent(object.second->getID(), true));
                 else
-                    eventQueue.push(new ObjectSelectedEvent(object.second->getID(), false));
+                    eventQueue.push(ObjectSelectedEvent(object.second->getID(), false));
             }
 
             /* 도형 & 색상을 표시한다 */
@@ -234,6 +244,32 @@ void GUI::renderObjectList(
                 selectableMax.y -= padding;
                 drawList->AddRectFilled(selectableMin, selectableMax, color);
             }
+            else if (object.second->getGeometry() == CAPSULE)
+            {
+                /* 세로로 긴 둥근 사각형 */
+                ImVec2 center = selectableMin;
+                center.x += selectableSize.x * 0.5f;
+                center.y += selectableSize.y * 0.5f;
+                drawList->AddRectFilled(
+                    ImVec2(center.x - 12.0f, center.y - 24.0f),
+                    ImVec2(center.x + 12.0f, center.y + 24.0f),
+                    color,
+                    12.0f
+                );
+            }
+            else if (object.second->getGeometry() == CYLINDER)
+            {
+                /* 옆에서 본 원기둥 */
+                ImVec2 center = selectableMin;
+                center.x += selectableSize.x * 0.5f;
+                center.y += selectableSize.y * 0.5f;
+                drawList->AddRectFilled(
+                    ImVec2(center.x - 16.0f, center.y - 20.0f),
+                    ImVec2(center.x + 16.0f, center.y + 20.0f),
+                    color,
+                    4.0f
+                );
+            }
 
             if (i % 4 != 0)
                 ImGui::SameLine();
@@ -297,7 +333,7 @@ void GUI::renderObjectAttribute(
 
         ImGui::Columns(4);
         if (ImGui::Checkbox("Fixed", &isObjectFixed))
-            eventQueue.push(new ObjectPositionFixedEvent(selectedObjectIDs[0], isObjectFixed));
+            eventQueue.push(ObjectPositionFixedEvent(selectedObjectIDs[0], isObjectFixed));
         ImGui::NextColumn(); ImGui::AlignTextToFramePadding();
         ImGui::Text("X"); ImGui::NextColumn(); ImGui::AlignTextToFramePadding();
         ImGui::Text("Y"); ImGui::NextColumn(); ImGui::AlignTextToFramePadding();
@@ -310,19 +346,19 @@ void GUI::renderObjectAttribute(
         ImGui::AlignTextToFramePadding();
         ImGui::Text("Position"); ImGui::NextColumn();
         if (ImGui::DragFloat("##PositionX", &vecBuffer[0], 0.05f))
-            eventQueue.push(new ObjectPositionChangedEvent(selectedObjectIDs[0], vecBuffer));
+            eventQueue.push(ObjectPositionChangedEvent(selectedObjectIDs[0], vecBuffer));
         if (ImGui::IsItemHovered() || ImGui::IsItemActive())
-            eventQueue.push(new ShouldRenderWorldAxis(selectedObjectIDs[0], 0));
+            eventQueue.push(ShouldRenderWorldAxis(selectedObjectIDs[0], 0));
         ImGui::NextColumn();
         if (ImGui::DragFloat("##PositionY", &vecBuffer[1], 0.05f, 0.0f, FLT_MAX))
-            eventQueue.push(new ObjectPositionChangedEvent(selectedObjectIDs[0], vecBuffer));
+            eventQueue.push(ObjectPositionChangedEvent(selectedObjectIDs[0], vecBuffer));
         if (ImGui::IsItemHovered() || ImGui::IsItemActive())
-            eventQueue.push(new ShouldRenderWorldAxis(selectedObjectIDs[0], 1));
+            eventQueue.push(ShouldRenderWorldAxis(selectedObjectIDs[0], 1));
         ImGui::NextColumn();
         if (ImGui::DragFloat("##PositionZ", &vecBuffer[2], 0.05f))
-            eventQueue.push(new ObjectPositionChangedEvent(selectedObjectIDs[0], vecBuffer));
+            eventQueue.push(ObjectPositionChangedEvent(selectedObjectIDs[0], vecBuffer));
         if (ImGui::IsItemHovered() || ImGui::IsItemActive())
-            eventQueue.push(new ShouldRenderWorldAxis(selectedObjectIDs[0], 2));
+            eventQueue.push(ShouldRenderWorldAxis(selectedObjectIDs[0], 2));
         ImGui::NextColumn();
 
         /* 속도 */
@@ -332,26 +368,26 @@ void GUI::renderObjectAttribute(
         if (ImGui::DragFloat("##VelocityX", &vecBuffer[0], 0.1f))
         {
             if (!isSimulating)
-                eventQueue.push(new ObjectVelocityChangedEvent(selectedObjectIDs[0], vecBuffer));
+                eventQueue.push(ObjectVelocityChangedEvent(selectedObjectIDs[0], vecBuffer));
         }
         if (ImGui::IsItemHovered() || ImGui::IsItemActive())
-            eventQueue.push(new ShouldRenderWorldAxis(selectedObjectIDs[0], 0));
+            eventQueue.push(ShouldRenderWorldAxis(selectedObjectIDs[0], 0));
         ImGui::NextColumn();
         if (ImGui::DragFloat("##VelocityY", &vecBuffer[1], 0.1f))
         {
             if (!isSimulating)
-                eventQueue.push(new ObjectVelocityChangedEvent(selectedObjectIDs[0], vecBuffer));
+                eventQueue.push(ObjectVelocityChangedEvent(selectedObjectIDs[0], vecBuffer));
         }
         if (ImGui::IsItemHovered() || ImGui::IsItemActive())
-            eventQueue.push(new ShouldRenderWorldAxis(selectedObjectIDs[0], 1));
+            eventQueue.push(ShouldRenderWorldAxis(selectedObjectIDs[0], 1));
         ImGui::NextColumn();
         if (ImGui::DragFloat("##VelocityZ", &vecBuffer[2], 0.1f))
         {
             if (!isSimulating)
-                eventQueue.push(new ObjectVelocityChangedEvent(selectedObjectIDs[0], vecBuffer));
+                eventQueue.push(ObjectVelocityChangedEvent(selectedObjectIDs[0], vecBuffer));
         }
         if (ImGui::IsItemHovered() || ImGui::IsItemActive())
-            eventQueue.push(new ShouldRenderWorldAxis(selectedObjectIDs[0], 2));
+            eventQueue.push(ShouldRenderWorldAxis(selectedObjectIDs[0], 2));
         ImGui::NextColumn();
         ImGui::Columns(1); ImGui::Separator(); ImGui::Spacing();
         
@@ -360,41 +396,41 @@ void GUI::renderObjectAttribute(
         ImGui::Text("Orientation"); ImGui::SameLine(0.0f, 10.0f);
         if (ImGui::Button("Reset"))
         {
-            eventQueue.push(new OrientationResetEvent(selectedObjectIDs[0]));
+            eventQueue.push(OrientationResetEvent(selectedObjectIDs[0]));
         }
         ImVec2 buttonSize(ImGui::GetColumnWidth(), 0.0f);
         ImGui::Button("X", buttonSize);
         if (ImGui::IsItemActive())
         {
             ImVec2 dragDelta = ImGui::GetIO().MouseDelta;
-            eventQueue.push(new ObjectRotatedEvent(selectedObjectIDs[0], 1.0f, 0.0f, 0.0f, dragDelta.x));
-            eventQueue.push(new ShouldRenderWorldAxis(selectedObjectIDs[0], 0));
+            eventQueue.push(ObjectRotatedEvent(selectedObjectIDs[0], 1.0f, 0.0f, 0.0f, dragDelta.x));
+            eventQueue.push(ShouldRenderWorldAxis(selectedObjectIDs[0], 0));
         }
         if (ImGui::IsItemHovered())
         {
-            eventQueue.push(new ShouldRenderWorldAxis(selectedObjectIDs[0], 0));
+            eventQueue.push(ShouldRenderWorldAxis(selectedObjectIDs[0], 0));
         }
         ImGui::Button("Y", buttonSize);
         if (ImGui::IsItemActive())
         {
             ImVec2 dragDelta = ImGui::GetIO().MouseDelta;
-            eventQueue.push(new ObjectRotatedEvent(selectedObjectIDs[0], 0.0f, 1.0f, 0.0f, dragDelta.x));
-            eventQueue.push(new ShouldRenderWorldAxis(selectedObjectIDs[0], 1));
+            eventQueue.push(ObjectRotatedEvent(selectedObjectIDs[0], 0.0f, 1.0f, 0.0f, dragDelta.x));
+            eventQueue.push(ShouldRenderWorldAxis(selectedObjectIDs[0], 1));
         }
         if (ImGui::IsItemHovered())
         {
-            eventQueue.push(new ShouldRenderWorldAxis(selectedObjectIDs[0], 1));
+            eventQueue.push(ShouldRenderWorldAxis(selectedObjectIDs[0], 1));
         }
         ImGui::Button("Z", buttonSize);
         if (ImGui::IsItemActive())
         {
             ImVec2 dragDelta = ImGui::GetIO().MouseDelta;
-            eventQueue.push(new ObjectRotatedEvent(selectedObjectIDs[0], 0.0f, 0.0f, 1.0f, dragDelta.x));
-            eventQueue.push(new ShouldRenderWorldAxis(selectedObjectIDs[0], 2));
+            eventQueue.push(ObjectRotatedEvent(selectedObjectIDs[0], 0.0f, 0.0f, 1.0f, dragDelta.x));
+            eventQueue.push(ShouldRenderWorldAxis(selectedObjectIDs[0], 2));
         }
         if (ImGui::IsItemHovered())
         {
-            eventQueue.push(new ShouldRenderWorldAxis(selectedObjectIDs[0], 2));
+            eventQueue.push(ShouldRenderWorldAxis(selectedObjectIDs[0], 2));
         }
         ImGui::Spacing(); ImGui::Separator(); ImGui::Spacing();
         /* 질량 */
@@ -402,7 +438,7 @@ void GUI::renderObjectAttribute(
         ImGui::AlignTextToFramePadding();
         ImGui::Text("Mass");
         if (ImGui::DragFloat("##Mass", &vecBuffer[0], 0.1f, 0.1f, FLT_MAX))
-            eventQueue.push(new ObjectMassChangedEvent(selectedObjectIDs[0], vecBuffer[0]));
+            eventQueue.push(ObjectMassChangedEvent(selectedObjectIDs[0], vecBuffer[0]));
         ImGui::Spacing(); ImGui::Separator(); ImGui::Spacing();
         /* 도형 데이터 */
         object->getGeometricDataInArray(vecBuffer);
@@ -416,18 +452,18 @@ void GUI::renderObjectAttribute(
                 vecBuffer[0] = 0.5f;
                 vecBuffer[1] = 0.5f;
                 vecBuffer[2] = 0.5f;
-                eventQueue.push(new ObjectGeometricDataChangedEvent(selectedObjectIDs[0], vecBuffer));
+                eventQueue.push(ObjectGeometricDataChangedEvent(selectedObjectIDs[0], vecBuffer));
             }
             ImGui::AlignTextToFramePadding();
             ImGui::Text("X"); ImGui::SameLine();
             if (ImGui::DragFloat("##Half-X", &vecBuffer[0], 0.01f, 0.1f, FLT_MAX))
-                eventQueue.push(new ObjectGeometricDataChangedEvent(selectedObjectIDs[0], vecBuffer));
+                eventQueue.push(ObjectGeometricDataChangedEvent(selectedObjectIDs[0], vecBuffer));
             ImGui::Text("Y"); ImGui::SameLine();
             if (ImGui::DragFloat("##Half-Y", &vecBuffer[1], 0.01f, 0.1f, FLT_MAX))
-                eventQueue.push(new ObjectGeometricDataChangedEvent(selectedObjectIDs[0], vecBuffer));
+                eventQueue.push(ObjectGeometricDataChangedEvent(selectedObjectIDs[0], vecBuffer));
             ImGui::Text("Z"); ImGui::SameLine();
             if (ImGui::DragFloat("##Half-Z", &vecBuffer[2], 0.01f, 0.1f, FLT_MAX))
-                eventQueue.push(new ObjectGeometricDataChangedEvent(selectedObjectIDs[0], vecBuffer));
+                eventQueue.push(ObjectGeometricDataChangedEvent(selectedObjectIDs[0], vecBuffer));
         }
         else if (geometry == SPHERE)
         {
@@ -436,10 +472,28 @@ void GUI::renderObjectAttribute(
             if (ImGui::Button("Reset##radius"))
             {
                 vecBuffer[0] = 1.0f;
-                eventQueue.push(new ObjectGeometricDataChangedEvent(selectedObjectIDs[0], vecBuffer));
+                eventQueue.push(ObjectGeometricDataChangedEvent(selectedObjectIDs[0], vecBuffer));
+            }
+            if (ImGui::DragFloat("##Radius", &vecBuffer[0], 0.01f, 0.1f, FLT_MAX))
+                eventQueue.push(ObjectGeometricDataChangedEvent(selectedObjectIDs[0], vecBuffer));
+        }
+        else if (geometry == CAPSULE || geometry == CYLINDER)
+        {
+            ImGui::AlignTextToFramePadding();
+            ImGui::Text("Radius & half-height"); ImGui::SameLine(0.0f, 10.0f);
+            if (ImGui::Button("Reset##radiusHalfHeight"))
+            {
+                vecBuffer[0] = 0.5f;
+                vecBuffer[1] = 0.5f;
+                eventQueue.push(ObjectGeometricDataChangedEvent(selectedObjectIDs[0], vecBuffer));
             }
+            ImGui::AlignTextToFramePadding();
+            ImGui::Text("R"); ImGui::SameLine();
             if (ImGui::DragFloat("##Radius", &vecBuffer[0], 0.01f, 0.1f, FLT_MAX))
-                eventQueue.push(new ObjectGeometricDataChangedEvent(selectedObjectIDs[0], vecBuffer));
+                eventQueue.push(ObjectGeometricDataChangedEvent(selectedObjectIDs[0], vecBuffer));
+            ImGui::Text("H"); ImGui::SameLine();
+            if (ImGui::DragFloat("##Half-height", &vecBuffer[1], 0.01f, 0.1f, FLT_MAX))
+                eventQueue.push(ObjectGeometricDataChangedEvent(selectedObjectIDs[0], vecBuffer));
         }
     }
 }
@@ -454,55 +508,55 @@ void GUI::renderGlobalAttribute(EventQueue& eventQueue)
 
     if (ImGui::Checkbox("Render contact info.", &shouldRenderContactInfo))
     {
-        eventQueue.push(new RenderContactInfoFlagChangedEvent(shouldRenderContactInfo));
+        eventQueue.push(RenderContactInfoFlagChangedEvent(shouldRenderContactInfo));
     } ImGui::Spacing();
 
     ImGui::AlignTextToFramePadding();
     ImGui::Text("Time step");
     if (ImGui::SliderFloat("##TimeStep", &timeStep, 0.3f, 1.0f))
     {
-        eventQueue.push(new TimeStepChangedEvent(timeStep));
+        eventQueue.push(TimeStepChangedEvent(timeStep));
     } ImGui::SameLine();
     if (ImGui::Button("Reset##TimeStep"))
     {
         timeStep = 1.0f;
-        eventQueue.push(new TimeStepChangedEvent(timeStep));
+        eventQueue.push(TimeStepChangedEvent(timeStep));
     }
 
     ImGui::AlignTextToFramePadding();
     ImGui::Text("Gravity");
     if (ImGui::SliderFloat("##Gravity", &gravity, 0.0f, 30.0f))
     {
-        eventQueue.push(new GravityChangedEvent(gravity));
+        eventQueue.push(GravityChangedEvent(gravity));
     } ImGui::SameLine();
     if (ImGui::Button("Reset##Gravity"))
     {
         gravity = 9.8f;
-        eventQueue.push(new GravityChangedEvent(gravity));
+        eventQueue.push(GravityChangedEvent(gravity));
     }
 
     ImGui::AlignTextToFramePadding();
     ImGui::Text("Ground Restituion");
     if (ImGui::SliderFloat("##Ground_Restitution", &groundRestitution, 0.0f, 1.0f))
     {
-        eventQueue.push(new GroundRestitutionChangedEvent(groundRestitution));
+        eventQueue.push(GroundRestitutionChangedEvent(groundRestitution));
     } ImGui::SameLine();
     if (ImGui::Button("Reset##GroundRestitution"))
     {
         groundRestitution = 0.2f;
-        eventQueue.push(new GroundRestitutionChangedEvent(groundRestitution));
+        eventQueue.push(GroundRestitutionChangedEvent(groundRestitution));
     }
 
     ImGui::AlignTextToFramePadding();
     ImGui::Text("Object Restituion");
     if (ImGui::SliderFloat("##Object_Restitution", &objectRestitution, 0.0f, 1.0f))
     {
-        eventQueue.push(new ObjectRestitutionChangedEvent(objectRestitution));
+        eventQueue.push(ObjectRestitutionChangedEvent(objectRestitution));
     } ImGui::SameLine();
     if (ImGui::Button("Reset##ObjectRestitution"))
     {
         objectRestitution = 0.3f;
-        eventQueue.push(new ObjectRestitutionChangedEvent(objectRestitution));
+        eventQueue.push(ObjectRestitutionChangedEvent(objectRestitution));
     }
 }
 
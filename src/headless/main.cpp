@@ -0,0 +1,243 @@
+/* 화면 없이 장면을 불러와 고정된 시간 간격으로 시뮬레이션만 반복한다.
+    배치 작업이나 CI 에서 성능과 결정성을 확인하는 용도이며,
+    초당 스텝 수, 스텝당 충돌 수, 마지막 상태의 체크섬을 출력한다.
+    체크섬 hash 는 위치, 방향, 속도의 비트 패턴으로 계산하므로 결과가 조금이라도 다르면 바뀐다 */
+
+#include <headless/scene.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace physics;
+
+namespace
+{
+    struct Options
+    {
+        std::string sceneFile;
+        std::string presetName;
+        unsigned int stepCount;
+        float deltaTime;
+        unsigned int threadCount;
+        BroadPhaseMode broadPhaseMode;
+        SolverMode solverMode;
+        bool isSleepingEnabled;
+        bool isWarmStarting;
+        bool isCCDEnabled;
+        bool isSphereBatchEnabled;
+        bool isHelpRequested;
+
+        Options()
+            : presetName("preset1"), stepCount(1000), deltaTime(1.0f / 60.0f), threadCount(1),
+            broadPhaseMode(SWEEP_AND_PRUNE), solverMode(SERIAL_SOLVER),
+            isSleepingEnabled(true), isWarmStarting(true), isCCDEnabled(true),
+            isSphereBatchEnabled(true), isHelpRequested(false) {}
+    };
+
+    void printUsage(const char* program)
+    {
+        printf("usage: %s [options]\n", program);
+        printf("  --scene <file>          load a scene file (see include/headless/scene.h)\n");
+        printf("  --preset <name>         preset1 | preset2 | piles | stack | rain | heap (default preset1)\n");
+        printf("  --steps <n>             number of steps (default 1000)\n");
+        printf("  --dt <seconds>          fixed time step (default 1/60)\n");
+        printf("  --threads <n>           solver threads (default 1)\n");
+        printf("  --broadphase <mode>     brute | sap | tree | hash (default sap)\n");
+        printf("  --solver <mode>         serial | colored (default serial)\n");
+        printf("  --no-sleep              disable body sleeping\n");
+        printf("  --no-warm-start         disable solver warm starting\n");
+        printf("  --no-ccd                disable continuous collision detection for fast spheres\n");
+        printf("  --no-sphere-batch       test sphere pairs and spheres on the ground one at a time\n");
+        printf("  --help                  print this message\n");
+    }
+
+    bool parseOptions(int argc, char** argv, Options& options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string arg = argv[i];
+            bool isValueOption = arg == "--scene" || arg == "--preset" || arg == "--steps" || arg == "--dt"
+                || arg == "--threads" || arg == "--broadphase" || arg == "--solver";
+
+            if (arg == "--help")
+                options.isHelpRequested = true;
+            else if (arg == "--no-sleep")
+                options.isSleepingEnabled = false;
+            else if (arg == "--no-warm-start")
+                options.isWarmStarting = false;
+            else if (arg == "--no-ccd")
+                options.isCCDEnabled = false;
+            else if (arg == "--no-sphere-batch")
+                options.isSphereBatchEnabled = false;
+            else if (isValueOption && i + 1 >= argc)
+            {
+                printf("ERROR::parseOptions()::missing value for %s\n", arg.c_str());
+                return false;
+            }
+            else if (arg == "--scene")
+                options.sceneFile = argv[++i];
+            else if (arg == "--preset")
+                options.presetName = argv[++i];
+            else if (arg == "--steps")
+                options.stepCount = strtoul(argv[++i], nullptr, 10);
+            else if (arg == "--dt")
+                options.deltaTime = strtof(argv[++i], nullptr);
+            else if (arg == "--threads")
+                options.threadCount = strtoul(argv[++i], nullptr, 10);
+            else if (arg == "--broadphase")
+            {
+                std::string mode = argv[++i];
+                if (mode == "brute")
+                    options.broadPhaseMode = BRUTE_FORCE;
+                else if (mode == "sap")
+                    options.broadPhaseMode = SWEEP_AND_PRUNE;
+                else if (mode == "tree")
+                    options.broadPhaseMode = AABB_TREE;
+                else if (mode == "hash")
+                    options.broadPhaseMode = SPATIAL_HASH;
+                else
+                {
+                    printf("ERROR::parseOptions()::unknown broad phase %s\n", mode.c_str());
+                    return false;
+                }
+            }
+            else if (arg == "--solver")
+            {
+                std::string mode = argv[++i];
+                if (mode == "serial")
+                    options.solverMode = SERIAL_SOLVER;
+                else if (mode == "colored")
+                    options.solverMode = COLORED_SOLVER;
+                else
+                {
+                    printf("ERROR::parseOptions()::unknown solver %s\n", mode.c_str());
+                    return false;
+                }
+            }
+            else
+            {
+                printf("ERROR::parseOptions()::unknown option %s\n", arg.c_str());
+                return false;
+            }
+        }
+
+        if (options.stepCount == 0 || options.deltaTime <= 0.0f || options.threadCount == 0)
+        {
+            printf("ERROR::parseOptions()::steps, dt and threads must be positive\n");
+            return false;
+        }
+
+        return true;
+    }
+
+    /* FNV-1a 로 float 의 비트 패턴을 누적한다 */
+    void hashFloat(uint64_t& hash, float value)
+    {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        for (int i = 0; i < 4; ++i)
+        {
+            hash ^= (bits >> (8 * i)) & 0xff;
+            hash *= 1099511628211ULL;
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!parseOptions(argc, argv, options))
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
+    if (options.isHelpRequested)
+    {
+        printUsage(argv[0]);
+        return 0;
+    }
+
+    Simulator simulator;
+    simulator.setThreadCount(options.threadCount);
+    simulator.setBroadPhaseMode(options.broadPhaseMode);
+    simulator.setSolverMode(options.solverMode);
+    simulator.setSleepingEnabled(options.isSleepingEnabled);
+    simulator.setWarmStarting(options.isWarmStarting);
+    simulator.setCCDEnabled(options.isCCDEnabled);
+    simulator.setSphereBatchEnabled(options.isSphereBatchEnabled);
+
+    Scene scene(simulator);
+    bool isLoaded = options.sceneFile.empty()
+        ? scene.loadPreset(options.presetName)
+        : scene.loadFile(options.sceneFile);
+    if (!isLoaded)
+        return 1;
+
+    const std::vector<RigidBody*>& bodies = scene.getBodies();
+    const char* sceneName = options.sceneFile.empty() ? options.presetName.c_str() : options.sceneFile.c_str();
+    printf("scene           %s (%zu bodies)\n", sceneName, bodies.size());
+    printf("steps           %u x %g s, %u threads\n", options.stepCount, options.deltaTime, options.threadCount);
+
+    std::vector<ContactInfo*> contactInfo;
+    unsigned long long contactSum = 0;
+    unsigned int maxContacts = 0;
+    unsigned long long toiEventSum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned int step = 0; step < options.stepCount; ++step)
+    {
+        simulator.simulate(options.deltaTime, contactInfo);
+
+        contactSum += contactInfo.size();
+        toiEventSum += simulator.getTOIEvents().size();
+        if (contactInfo.size() > maxContacts)
+            maxContacts = contactInfo.size();
+        for (auto& info : contactInfo)
+            delete info;
+        contactInfo.clear();
+    }
+    auto end = std::chrono::steady_clock::now();
+    double elapsed = std::chrono::duration<double>(end - start).count();
+
+    /* 마지막 상태의 체크섬 */
+    double positionSum = 0.0;
+    double orientationSum = 0.0;
+    double velocitySum = 0.0;
+    uint64_t hash = 14695981039346656037ULL;
+    for (const auto& body : bodies)
+    {
+        Vector3 position = body->getPosition();
+        Quaternion orientation = body->getOrientation();
+        Vector3 velocity = body->getVelocity();
+
+        positionSum += position.x + position.y + position.z;
+        orientationSum += orientation.w + orientation.x + orientation.y + orientation.z;
+        velocitySum += velocity.x + velocity.y + velocity.z;
+
+        hashFloat(hash, position.x);
+        hashFloat(hash, position.y);
+        hashFloat(hash, position.z);
+        hashFloat(hash, orientation.w);
+        hashFloat(hash, orientation.x);
+        hashFloat(hash, orientation.y);
+        hashFloat(hash, orientation.z);
+        hashFloat(hash, velocity.x);
+        hashFloat(hash, velocity.y);
+        hashFloat(hash, velocity.z);
+    }
+
+    printf("elapsed         %.3f s\n", elapsed);
+    printf("steps/sec       %.1f\n", options.stepCount / elapsed);
+    printf("contacts/step   %.2f (max %u)\n", (double)contactSum / options.stepCount, maxContacts);
+    printf("toi events      %llu\n", toiEventSum);
+    printf("sleeping        %u\n", simulator.getSleepingBodyCount());
+    printf("checksum pos    %.6f\n", positionSum);
+    printf("checksum orient %.6f\n", orientationSum);
+    printf("checksum vel    %.6f\n", velocitySum);
+    printf("checksum hash   %016llx\n", (unsigned long long)hash);
+
+    return 0;
+}
@@ -0,0 +1,405 @@
+#include <headless/scene.h>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+using namespace physics;
+
+bool Scene::loadFile(const std::string& path)
+{
+    std::ifstream file(path.c_str());
+    if (!file.is_open())
+    {
+        std::cout << "ERROR::Scene::loadFile()::can't open " << path << std::endl;
+        return false;
+    }
+
+    RigidBody* lastBody = nullptr;
+    std::string line;
+    unsigned int lineNumber = 0;
+    while (std::getline(file, line))
+    {
+        ++lineNumber;
+        line = line.substr(0, line.find('#'));
+
+        std::istringstream stream(line);
+        std::string command;
+        if (!(stream >> command))
+            continue;
+
+        bool isValid = true;
+        if (command == "sphere")
+        {
+            float x, y, z, radius;
+            isValid = static_cast<bool>(stream >> x >> y >> z >> radius);
+            if (isValid)
+                lastBody = addSphere(x, y, z, radius);
+        }
+        else if (command == "box")
+        {
+            float x, y, z, halfX, halfY, halfZ;
+            isValid = static_cast<bool>(stream >> x >> y >> z >> halfX >> halfY >> halfZ);
+            if (isValid)
+                lastBody = addBox(x, y, z, halfX, halfY, halfZ);
+        }
+        else if (command == "capsule" || command == "cylinder")
+        {
+            float x, y, z, radius, halfHeight;
+            isValid = static_cast<bool>(stream >> x >> y >> z >> radius >> halfHeight);
+            if (isValid && command == "capsule")
+                lastBody = addCapsule(x, y, z, radius, halfHeight);
+            else if (isValid)
+                lastBody = addCylinder(x, y, z, radius, halfHeight);
+        }
+        else if (command == "velocity" && lastBody != nullptr)
+        {
+            float x, y, z;
+            isValid = static_cast<bool>(stream >> x >> y >> z);
+            if (isValid)
+                lastBody->setVelocity(x, y, z);
+        }
+        else if (command == "orientation" && lastBody != nullptr)
+        {
+            Quaternion orientation;
+            isValid = static_cast<bool>(stream >> orientation.w >> orientation.x >> orientation.y >> orientation.z);
+            if (isValid)
+            {
+                orientation.normalize();
+                lastBody->setOrientation(orientation);
+            }
+        }
+        else if (command == "fixed" && lastBody != nullptr)
+        {
+            fixBody(lastBody);
+        }
+        else if (command == "mesh")
+        {
+            std::string meshPath;
+            Vector3 offset;
+            isValid = static_cast<bool>(stream >> meshPath);
+            if (isValid && !(stream >> offset.x >> offset.y >> offset.z))
+                offset = Vector3();
+            if (isValid)
+                isValid = simulator.addTriangleMesh(resolvePath(path, meshPath), offset) != nullptr;
+        }
+        else if (command == "heightfield")
+        {
+            std::string heightsPath;
+            float cellSize;
+            Vector3 origin;
+            isValid = static_cast<bool>(stream >> heightsPath >> cellSize) && cellSize > 0.0f;
+            if (isValid && !(stream >> origin.x >> origin.y >> origin.z))
+                origin = Vector3();
+
+            int columnCount, rowCount;
+            std::vector<float> heights;
+            if (isValid)
+                isValid = loadHeights(resolvePath(path, heightsPath), columnCount, rowCount, heights);
+            if (isValid)
+                simulator.setHeightfield(columnCount, rowCount, cellSize, origin, heights);
+        }
+        else if (command == "gravity")
+        {
+            float gravity;
+            isValid = static_cast<bool>(stream >> gravity);
+            if (isValid)
+                simulator.setGravity(gravity);
+        }
+        else if (command == "restitution")
+        {
+            float ground, object;
+            isValid = static_cast<bool>(stream >> ground >> object);
+            if (isValid)
+            {
+                simulator.setGroundRestitution(ground);
+                simulator.setObjectRestitution(object);
+            }
+        }
+        else
+            isValid = false;
+
+        if (!isValid)
+        {
+            std::cout << "ERROR::Scene::loadFile()::invalid line " << lineNumber << ": " << line << std::endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool Scene::loadPreset(const std::string& name)
+{
+    if (name == "preset1")
+        loadPreset1();
+    else if (name == "preset2")
+        loadPreset2();
+    else if (name == "piles")
+        loadPiles();
+    else if (name == "stack")
+        loadStack();
+    else if (name == "rain")
+        loadRain();
+    else if (name == "heap")
+        loadHeap();
+    else
+    {
+        std::cout << "ERROR::Scene::loadPreset()::unknown preset " << name << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+RigidBody* Scene::addSphere(float x, float y, float z, float radius)
+{
+    unsigned int id = newObjectID++;
+    RigidBody* body = simulator.addRigidBody(id, SPHERE, x, y, z);
+    simulator.addCollider(id, SPHERE, body)->setGeometricData(radius);
+
+    /* SphereObject::updateDerivedData 와 같은 관성 텐서 */
+    Matrix3 inertiaTensor;
+    inertiaTensor.setDiagonal(0.4f * body->getMass() * radius*radius);
+    body->setInertiaTensor(inertiaTensor);
+
+    bodies.push_back(body);
+    return body;
+}
+
+RigidBody* Scene::addBox(float x, float y, float z, float halfX, float halfY, float halfZ)
+{
+    unsigned int id = newObjectID++;
+    RigidBody* body = simulator.addRigidBody(id, BOX, x, y, z);
+    simulator.addCollider(id, BOX, body)->setGeometricData(halfX, halfY, halfZ);
+
+    /* BoxObject::updateDerivedData 와 같은 관성 텐서 */
+    Matrix3 inertiaTensor;
+    float k = body->getMass() / 12;
+    float sizeX = halfX * 2.0f;
+    float sizeY = halfY * 2.0f;
+    float sizeZ = halfZ * 2.0f;
+    inertiaTensor.entries[0] = k * (sizeY*sizeY + sizeZ*sizeZ);
+    inertiaTensor.entries[4] = k * (sizeX*sizeX + sizeZ*sizeZ);
+    inertiaTensor.entries[8] = k * (sizeY*sizeY + sizeX*sizeX);
+    body->setInertiaTensor(inertiaTensor);
+
+    bodies.push_back(body);
+    return body;
+}
+
+RigidBody* Scene::addCapsule(float x, float y, float z, float radius, float halfHeight)
+{
+    unsigned int id = newObjectID++;
+    RigidBody* body = simulator.addRigidBody(id, CAPSULE, x, y, z);
+    simulator.addCollider(id, CAPSULE, body)->setGeometricData(radius, halfHeight);
+
+    body->setInertiaTensor(CapsuleCollider::calcInertiaTensor(body->getMass(), radius, halfHeight));
+
+    bodies.push_back(body);
+    return body;
+}
+
+RigidBody* Scene::addCylinder(float x, float y, float z, float radius, float halfHeight)
+{
+    unsigned int id = newObjectID++;
+    RigidBody* body = simulator.addRigidBody(id, CYLINDER, x, y, z);
+    simulator.addCollider(id, CYLINDER, body)->setGeometricData(radius, halfHeight);
+
+    body->setInertiaTensor(CylinderCollider::calcInertiaTensor(body->getMass(), radius, halfHeight));
+
+    bodies.push_back(body);
+    return body;
+}
+
+void Scene::fixBody(RigidBody* body)
+{
+    body->setVelocity(0.0f, 0.0f, 0.0f);
+    body->setRotation(0.0f, 0.0f, 0.0f);
+    body->setInverseMass(0.0f);
+    body->setInverseInertiaTensor(Matrix3(0.0f));
+}
+
+void Scene::loadPreset1()
+{
+    RigidBody* sphere = addSphere(0.0f, 1.0f, 7.0f, 0.7f);
+
+    addBox(0.0f, 0.5f, 0.0f, 0.5f, 0.5f, 0.5f);
+    addBox(1.2f, 0.5f, 0.0f, 0.5f, 0.5f, 0.5f);
+    addBox(-1.2f, 0.5f, 0.0f, 0.5f, 0.5f, 0.5f);
+    addBox(0.7f, 1.5f, 0.0f, 0.5f, 0.5f, 0.5f);
+    addBox(-0.7f, 1.5f, 0.0f, 0.5f, 0.5f, 0.5f);
+    addBox(0.0f, 2.5f, 0.0f, 0.5f, 0.5f, 0.5f);
+
+    sphere->setVelocity(0.0f, 0.0f, -30.0f);
+}
+
+void Scene::loadPreset2()
+{
+    const float rotateAngle = 30.0f * 3.141592f / 180.0f;
+
+    RigidBody* board = addBox(0.0f, 5.0f, -2.0f, 3.0f, 0.1f, 3.0f);
+    fixBody(board);
+    board->setOrientation(Quaternion(cosf(rotateAngle * 0.5f), sinf(rotateAngle * 0.5f), 0.0f, 0.0f));
+
+    board = addBox(0.0f, 2.0f, 2.5f, 3.0f, 0.1f, 3.0f);
+    fixBody(board);
+    board->setOrientation(Quaternion(cosf(rotateAngle * -0.5f), sinf(rotateAngle * -0.5f), 0.0f, 0.0f));
+
+    addSphere(-2.0f, 7.0f, -3.0f, 1.0f);
+    addSphere(0.0f, 7.0f, -3.0f, 0.7f);
+    addSphere(1.5f, 7.0f, -3.0f, 0.3f);
+}
+
+void Scene::loadPiles()
+{
+    /* 2x2 개의 구 위에 구 하나를 올린 더미를 32x32 개 늘어놓는다 */
+    const float radius = 0.5f;
+    const float spacing = 3.0f;
+    const float topHeight = radius + sqrtf(2.0f) * radius;
+
+    for (int i = 0; i < 32; ++i)
+    {
+        for (int j = 0; j < 32; ++j)
+        {
+            float x = i * spacing;
+            float z = j * spacing;
+            addSphere(x - radius, radius, z - radius, radius);
+            addSphere(x + radius, radius, z - radius, radius);
+            addSphere(x - radius, radius, z + radius, radius);
+            addSphere(x + radius, radius, z + radius, radius);
+            addSphere(x, topHeight, z, radius);
+        }
+    }
+}
+
+void Scene::loadStack()
+{
+    /* 10x10 개의 기둥을 5 층으로 쌓는다.
+        축이 모두 나란하면 분리축 검사가 퇴화하므로 조금씩 기울인다 */
+    const float spacing = 0.99f;
+
+    unsigned int index = 0;
+    for (int layer = 0; layer < 5; ++layer)
+    {
+        for (int i = 0; i < 10; ++i)
+        {
+            for (int j = 0; j < 10; ++j)
+            {
+                RigidBody* box = addBox(i * spacing, 0.49f + layer * spacing, j * spacing, 0.5f, 0.5f, 0.5f);
+                Quaternion orientation(
+                    1.0f,
+                    0.01f * (index * 7 % 5 - 2.0f),
+                    0.01f * (index * 3 % 5 - 2.0f),
+                    0.01f * (index * 11 % 5 - 2.0f)
+                );
+                orientation.normalize();
+                box->setOrientation(orientation);
+                ++index;
+            }
+        }
+    }
+}
+
+void Scene::loadRain()
+{
+    /* 10x10 개의 기둥마다 구 10 개를 서로 다른 높이에 띄운다.
+        난수 대신 인덱스로 흔들어 항상 같은 장면을 만든다 */
+    const float radius = 0.3f;
+
+    unsigned int index = 0;
+    for (int i = 0; i < 10; ++i)
+    {
+        for (int j = 0; j < 10; ++j)
+        {
+            for (int k = 0; k < 10; ++k)
+            {
+                float offsetX = 0.1f * (index * 7 % 11) - 0.5f;
+                float offsetZ = 0.1f * (index * 13 % 11) - 0.5f;
+                float height = 3.0f + k * 2.0f + 0.15f * (index * 5 % 7);
+                addSphere(i * 1.5f + offsetX, height, j * 1.5f + offsetZ, radius);
+                ++index;
+            }
+        }
+    }
+}
+
+void Scene::loadHeap()
+{
+    /* 20x20 개의 기둥을 25 층으로 조금씩 어긋나게 쌓아 떨어뜨린다 */
+    const float radius = 0.5f;
+    const float spacing = 1.05f;
+
+    unsigned int index = 0;
+    for (int layer = 0; layer < 25; ++layer)
+    {
+        for (int i = 0; i < 20; ++i)
+        {
+            for (int j = 0; j < 20; ++j)
+            {
+                float offset = 0.01f * (index * 7 % 5 - 2.0f);
+                addSphere(i * spacing + offset, radius + 0.05f + layer * spacing, j * spacing - offset, radius);
+                ++index;
+            }
+        }
+    }
+}
+
+std::string Scene::resolvePath(const std::string& scenePath, const std::string& filePath) const
+{
+    /* 상대 경로는 장면 파일이 있는 디렉터리를 기준으로 한다 */
+    if (filePath.empty() || filePath[0] == '/')
+        return filePath;
+
+    std::string::size_type slash = scenePath.find_last_of('/');
+    if (slash == std::string::npos)
+        return filePath;
+    return scenePath.substr(0, slash + 1) + filePath;
+}
+
+bool Scene::loadHeights(const std::string& path, int& columnCount, int& rowCount, std::vector<float>& heights) const
+{
+    std::ifstream file(path.c_str());
+    if (!file.is_open())
+    {
+        std::cout << "ERROR::Scene::loadHeights()::can't open " << path << std::endl;
+        return false;
+    }
+
+    /* 한 줄이 z 축 방향의 한 행이며 모든 행의 길이가 같아야 한다 */
+    columnCount = 0;
+    rowCount = 0;
+    heights.clear();
+    std::string line;
+    while (std::getline(file, line))
+    {
+        line = line.substr(0, line.find('#'));
+
+        std::istringstream stream(line);
+        int count = 0;
+        float height;
+        while (stream >> height)
+        {
+            heights.push_back(height);
+            ++count;
+        }
+        if (count == 0)
+            continue;
+
+        if (rowCount > 0 && count != columnCount)
+        {
+            std::cout << "ERROR::Scene::loadHeights()::row " << rowCount << " has " << count
+                << " heights, expected " << columnCount << std::endl;
+            return false;
+        }
+        columnCount = count;
+        ++rowCount;
+    }
+
+    if (columnCount < 2 || rowCount < 2)
+    {
+        std::cout << "ERROR::Scene::loadHeights()::need at least 2 x 2 heights in " << path << std::endl;
+        return false;
+    }
+    return true;
+}
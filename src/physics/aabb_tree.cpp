@@ -0,0 +1,400 @@
+#include <physics/aabb_tree.h>
+#include <cmath>
+#include <cfloat>
+#include <algorithm>
+#include <iostream>
+
+using namespace physics;
+
+int DynamicAABBTree::createProxy(const AABB& aabb, Collider* collider)
+{
+    int proxyID = allocateNode();
+
+    Vector3 fatMargin(margin, margin, margin);
+    nodes[proxyID].aabb = AABB(aabb.min - fatMargin, aabb.max + fatMargin);
+    nodes[proxyID].tightAABB = aabb;
+    nodes[proxyID].collider = collider;
+    nodes[proxyID].height = 0;
+
+    insertLeaf(proxyID);
+    return proxyID;
+}
+
+void DynamicAABBTree::destroyProxy(int proxyID)
+{
+    if (proxyID < 0 || proxyID >= (int)nodes.size() || !nodes[proxyID].isLeaf())
+    {
+        std::cout << "ERROR::DynamicAABBTree::destroyProxy()::invalid proxy id: " << proxyID << std::endl;
+        return;
+    }
+
+    removeLeaf(proxyID);
+    freeNode(proxyID);
+}
+
+bool DynamicAABBTree::moveProxy(int proxyID, const AABB& aabb)
+{
+    nodes[proxyID].tightAABB = aabb;
+
+    /* 아직 fat AABB 안에 있다면 트리를 고칠 필요가 없다 */
+    if (nodes[proxyID].aabb.contains(aabb))
+        return false;
+
+    removeLeaf(proxyID);
+
+    Vector3 fatMargin(margin, margin, margin);
+    nodes[proxyID].aabb = AABB(aabb.min - fatMargin, aabb.max + fatMargin);
+
+    insertLeaf(proxyID);
+    return true;
+}
+
+void DynamicAABBTree::findPairs(std::vector<ColliderPair>& pairs)
+{
+    if (root == NULL_NODE)
+        return;
+
+    /* 각 리프의 실제 AABB 로 트리를 내려가며 겹치는 리프를 찾는다.
+        같은 쌍이 두 번 저장되지 않도록 인덱스가 더 큰 리프만 짝짓는다 */
+    for (int leaf = 0; leaf < (int)nodes.size(); ++leaf)
+    {
+        if (nodes[leaf].height != 0)
+            continue;
+
+        const AABB& leafAABB = nodes[leaf].tightAABB;
+        stack.clear();
+        stack.push_back(root);
+        while (!stack.empty())
+        {
+            int nodeID = stack.back();
+            stack.pop_back();
+
+            const Node& node = nodes[nodeID];
+            if (!node.aabb.overlaps(leafAABB))
+                continue;
+
+            if (node.isLeaf())
+            {
+                if (nodeID > leaf && node.tightAABB.overlaps(leafAABB))
+                    pairs.push_back(ColliderPair(nodes[leaf].collider, node.collider));
+            }
+            else
+            {
+                stack.push_back(node.child1);
+                stack.push_back(node.child2);
+            }
+        }
+    }
+}
+
+int DynamicAABBTree::allocateNode()
+{
+    int nodeID;
+    if (freeList == NULL_NODE)
+    {
+        nodes.push_back(Node());
+        nodeID = nodes.size() - 1;
+    }
+    else
+    {
+        nodeID = freeList;
+        freeList = nodes[nodeID].parent;
+    }
+
+    Node& node = nodes[nodeID];
+    node.collider = nullptr;
+    node.parent = NULL_NODE;
+    node.child1 = NULL_NODE;
+    node.child2 = NULL_NODE;
+    node.height = 0;
+
+    return nodeID;
+}
+
+void DynamicAABBTree::freeNode(int nodeID)
+{
+    nodes[nodeID].parent = freeList;
+    nodes[nodeID].height = -1;
+    freeList = nodeID;
+}
+
+void DynamicAABBTree::insertLeaf(int leaf)
+{
+    if (root == NULL_NODE)
+    {
+        root = leaf;
+        nodes[root].parent = NULL_NODE;
+        return;
+    }
+
+    /* 겉넓이가 가장 적게 늘어나는 형제 노드를 찾아 내려간다 */
+    AABB leafAABB = nodes[leaf].aabb;
+    int index = root;
+    while (!nodes[index].isLeaf())
+    {
+        int child1 = nodes[index].child1;
+        int child2 = nodes[index].child2;
+
+        float area = nodes[index].aabb.calcSurfaceArea();
+        float combinedArea = nodes[index].aabb.merge(leafAABB).calcSurfaceArea();
+
+        /* 현재 노드와 새 리프를 형제로 묶을 때의 비용 */
+        float cost = 2.0f * combinedArea;
+
+        /* 더 내려갈 때 조상 노드들이 커지는 비용 */
+        float inheritanceCost = 2.0f * (combinedArea - area);
+
+        /* 각 자식 아래로 내려갈 때의 비용 */
+        float cost1 = nodes[child1].aabb.merge(leafAABB).calcSurfaceArea() + inheritanceCost;
+        if (!nodes[child1].isLeaf())
+            cost1 -= nodes[child1].aabb.calcSurfaceArea();
+
+        float cost2 = nodes[child2].aabb.merge(leafAABB).calcSurfaceArea() + inheritanceCost;
+        if (!nodes[child2].isLeaf())
+            cost2 -= nodes[child2].aabb.calcSurfaceArea();
+
+        if (cost < cost1 && cost < cost2)
+            break;
+
+        index = cost1 < cost2 ? child1 : child2;
+    }
+    int sibling = index;
+
+    /* 형제 노드와 새 리프를 자식으로 가지는 부모 노드를 만든다 */
+    int oldParent = nodes[sibling].parent;
+    int newParent = allocateNode();
+    nodes[newParent].parent = oldParent;
+    nodes[newParent].aabb = nodes[sibling].aabb.merge(leafAABB);
+    nodes[newParent].height = nodes[sibling].height + 1;
+    nodes[newParent].child1 = sibling;
+    nodes[newParent].child2 = leaf;
+    nodes[sibling].parent = newParent;
+    nodes[leaf].parent = newParent;
+
+    if (oldParent != NULL_NODE)
+    {
+        if (nodes[oldParent].child1 == sibling)
+            nodes[oldParent].child1 = newParent;
+        else
+            nodes[oldParent].child2 = newParent;
+    }
+    else
+    {
+        root = newParent;
+    }
+
+    /* 루트까지 올라가며 높이와 AABB 를 고치고 균형을 맞춘다 */
+    index = nodes[leaf].parent;
+    while (index != NULL_NODE)
+    {
+        index = balance(index);
+
+        int child1 = nodes[index].child1;
+        int child2 = nodes[index].child2;
+        nodes[index].height = 1 + std::max(nodes[child1].height, nodes[child2].height);
+        nodes[index].aabb = nodes[child1].aabb.merge(nodes[child2].aabb);
+
+        index = nodes[index].parent;
+    }
+}
+
+void DynamicAABBTree::removeLeaf(int leaf)
+{
+    if (leaf == root)
+    {
+        root = NULL_NODE;
+        return;
+    }
+
+    /* 부모 노드를 없애고 형제 노드를 그 자리로 올린다 */
+    int parent = nodes[leaf].parent;
+    int grandParent = nodes[parent].parent;
+    int sibling = nodes[parent].child1 == leaf ? nodes[parent].child2 : nodes[parent].child1;
+
+    if (grandParent != NULL_NODE)
+    {
+        if (nodes[grandParent].child1 == parent)
+            nodes[grandParent].child1 = sibling;
+        else
+            nodes[grandParent].child2 = sibling;
+        nodes[sibling].parent = grandParent;
+        freeNode(parent);
+
+        int index = grandParent;
+        while (index != NULL_NODE)
+        {
+            index = balance(index);
+
+            int child1 = nodes[index].child1;
+            int child2 = nodes[index].child2;
+            nodes[index].aabb = nodes[child1].aabb.merge(nodes[child2].aabb);
+            nodes[index].height = 1 + std::max(nodes[child1].height, nodes[child2].height);
+
+            index = nodes[index].parent;
+        }
+    }
+    else
+    {
+        root = sibling;
+        nodes[sibling].parent = NULL_NODE;
+        freeNode(parent);
+    }
+}
+
+int DynamicAABBTree::balance(int iA)
+{
+    Node& A = nodes[iA];
+    if (A.isLeaf() || A.height < 2)
+        return iA;
+
+    int iB = A.child1;
+    int iC = A.child2;
+    Node& B = nodes[iB];
+    Node& C = nodes[iC];
+
+    int heightDifference = C.height - B.height;
+
+    /* C 가 더 높다면 C 를 위로 올린다 */
+    if (heightDifference > 1)
+    {
+        int iF = C.child1;
+        int iG = C.child2;
+        Node& F = nodes[iF];
+        Node& G = nodes[iG];
+
+        C.child1 = iA;
+        C.parent = A.parent;
+        A.parent = iC;
+
+        if (C.parent != NULL_NODE)
+        {
+            if (nodes[C.parent].child1 == iA)
+                nodes[C.parent].child1 = iC;
+            else
+                nodes[C.parent].child2 = iC;
+        }
+        else
+            root = iC;
+
+        /* F, G 중 높은 쪽을 C 아래에 남기고 낮은 쪽을 A 로 보낸다 */
+        if (F.height > G.height)
+        {
+            C.child2 = iF;
+            A.child2 = iG;
+            G.parent = iA;
+            A.aabb = B.aabb.merge(G.aabb);
+            C.aabb = A.aabb.merge(F.aabb);
+            A.height = 1 + std::max(B.height, G.height);
+            C.height = 1 + std::max(A.height, F.height);
+        }
+        else
+        {
+            C.child2 = iG;
+            A.child2 = iF;
+            F.parent = iA;
+            A.aabb = B.aabb.merge(F.aabb);
+            C.aabb = A.aabb.merge(G.aabb);
+            A.height = 1 + std::max(B.height, F.height);
+            C.height = 1 + std::max(A.height, G.height);
+        }
+
+        return iC;
+    }
+
+    /* B 가 더 높다면 B 를 위로 올린다 */
+    if (heightDifference < -1)
+    {
+        int iD = B.child1;
+        int iE = B.child2;
+        Node& D = nodes[iD];
+        Node& E = nodes[iE];
+
+        B.child1 = iA;
+        B.parent = A.parent;
+        A.parent = iB;
+
+        if (B.parent != NULL_NODE)
+        {
+            if (nodes[B.parent].child1 == iA)
+                nodes[B.parent].child1 = iB;
+            else
+                nodes[B.parent].child2 = iB;
+        }
+        else
+            root = iB;
+
+        if (D.height > E.height)
+        {
+            B.child2 = iD;
+            A.child1 = iE;
+            E.parent = iA;
+            A.aabb = C.aabb.merge(E.aabb);
+            B.aabb = A.aabb.merge(D.aabb);
+            A.height = 1 + std::max(C.height, E.height);
+            B.height = 1 + std::max(A.height, D.height);
+        }
+        else
+        {
+            B.child2 = iE;
+            A.child1 = iD;
+            D.parent = iA;
+            A.aabb = C.aabb.merge(D.aabb);
+            B.aabb = A.aabb.merge(E.aabb);
+            A.height = 1 + std::max(C.height, D.height);
+            B.height = 1 + std::max(A.height, E.height);
+        }
+
+        return iB;
+    }
+
+    return iA;
+}
+
+bool DynamicAABBTree::rayAndAABB(
+    const Vector3& origin,
+    const Vector3& direction,
+    const AABB& aabb,
+    float maxDistance,
+    float& distance
+)
+{
+    /* slab 방법. 각 축의 두 평면 사이에 반직선이 머무는 구간의 교집합을 구한다 */
+    float tNear = 0.0f;
+    float tFar = maxDistance;
+
+    for (int i = 0; i < 3; ++i)
+    {
+        float originComponent = origin[i];
+        float directionComponent = direction[i];
+        float minComponent = aabb.min[i];
+        float maxComponent = aabb.max[i];
+
+        if (fabsf(directionComponent) < FLT_EPSILON)
+        {
+            /* 축과 평행하다면 원점이 두 평면 사이에 있어야 한다 */
+            if (originComponent < minComponent || originComponent > maxComponent)
+                return false;
+        }
+        else
+        {
+            float inverseDirection = 1.0f / directionComponent;
+            float t1 = (minComponent - originComponent) * inverseDirection;
+            float t2 = (maxComponent - originComponent) * inverseDirection;
+            if (t1 > t2)
+            {
+                float temp = t1;
+                t1 = t2;
+                t2 = temp;
+            }
+            if (t1 > tNear)
+                tNear = t1;
+            if (t2 < tFar)
+                tFar = t2;
+            if (tNear > tFar)
+                return false;
+        }
+    }
+
+    distance = tNear;
+    return true;
+}
@@ -6,71 +6,72 @@ using namespace physics;
 
 void RigidBody::integrate(float duration)
 {
-    /* 강체의 질량이 무한대라면 적분을 하지 않는다 */
-    if (inverseMass == 0.0f)
-        return;
-
-    /* 가속도를 계산한다 */
-    prevAcceleration = acceleration;
-    prevAcceleration += force * inverseMass;
-
-    /* 각가속도를 계산한다 */
-    Vector3 angularAcceleration = inverseInertiaTensorWorld * torque;
-
-    /* 속도 & 각속도를 업데이트한다 */
-    velocity += prevAcceleration * duration;
-    rotation += angularAcceleration * duration;
-
-    /* 드래그를 적용한다 */
-    velocity *= powf(linearDamping, duration);
-    rotation *= powf(angularDamping, duration);
-
-    /* 위치 & 방향을 업데이트한다 */
-    position += velocity * duration;
-    orientation += orientation.rotateByScaledVector(rotation, duration / 2.0f);
-
-    /* 사원수를 정규화한다 */
-    orientation.normalize();
-
-    /* 변화된 상태에 따라 변환 행렬을 업데이트한다 */
-    updateTransformMatrix();
-
-    /* 월드 좌표계 기준의 관성 텐서를 업데이트한다 */
-    transformInertiaTensor();
-
-    /* 강체에 적용된 힘과 토크는 제거한다 */
-    force.clear();
-    torque.clear();
+    store->integrateBody(index, duration);
 }
 
 void RigidBody::addForceAt(const Vector3& _force, const Vector3& point)
 {
+    wakeUp();
+
     /* 힘을 업데이트한다 */
-    force += _force;
+    store->force[0][index] += _force.x;
+    store->force[1][index] += _force.y;
+    store->force[2][index] += _force.z;
+
     /* 토크를 업데이트한다 */
-    Vector3 pointFromCenter = point - position;
-    torque += pointFromCenter.cross(_force);
+    Vector3 pointFromCenter = point - getPosition();
+    Vector3 _torque = pointFromCenter.cross(_force);
+    store->torque[0][index] += _torque.x;
+    store->torque[1][index] += _torque.y;
+    store->torque[2][index] += _torque.z;
 }
 
-Vector3 RigidBody::getAxis(int index) const
+Vector3 RigidBody::getAxis(int _index) const
 {
     /* 입력값 검사 */
-    if (index < 0 || index > 3)
+    if (_index < 0 || _index > 3)
     {
         std::cout << "RigidBody::getAxis::Out of index" << std::endl;
         return Vector3();
     }
 
     Vector3 result(
-        transformMatrix.entries[index],
-        transformMatrix.entries[index + 4],
-        transformMatrix.entries[index + 8]
+        store->transform[_index][index],
+        store->transform[_index + 4][index],
+        store->transform[_index + 8][index]
     );
     result.normalize();
 
     return result;
 }
 
+bool RigidBody::isFixed() const
+{
+    return store->inverseMass[index] == 0.0f;
+}
+
+void RigidBody::setAwake(bool value)
+{
+    store->awake[index] = value ? 1.0f : 0.0f;
+    sleepTime = 0.0f;
+
+    if (!value)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            store->velocity[i][index] = 0.0f;
+            store->rotation[i][index] = 0.0f;
+            store->force[i][index] = 0.0f;
+            store->torque[i][index] = 0.0f;
+        }
+    }
+}
+
+bool RigidBody::isAwake() const
+{
+    return store->awake[index] != 0.0f;
+}
+
 void RigidBody::rotateByQuat(const Quaternion& quat)
 {
     Quaternion newOrientation = getOrientation() * quat;
@@ -80,210 +81,266 @@ void RigidBody::rotateByQuat(const Quaternion& quat)
 
 void RigidBody::updateTransformMatrix()
 {
-    transformMatrix.entries[0] = 
-        1.0f - 2.0f * (orientation.y*orientation.y + orientation.z*orientation.z);
-    transformMatrix.entries[1] = 
-        2.0f * (orientation.x*orientation.y - orientation.w*orientation.z);
-    transformMatrix.entries[2] = 
-        2.0f * (orientation.x*orientation.z + orientation.w*orientation.y);
-    transformMatrix.entries[3] = position.x;
-
-    transformMatrix.entries[4] =
-        2.0f * (orientation.x*orientation.y + orientation.w*orientation.z);
-    transformMatrix.entries[5] =
-        1.0f - 2.0f * (orientation.x*orientation.x + orientation.z*orientation.z);
-    transformMatrix.entries[6] =
-        2.0f * (orientation.y*orientation.z - orientation.w*orientation.x);
-    transformMatrix.entries[7] = position.y;
-
-    transformMatrix.entries[8] =
-        2.0f * (orientation.x*orientation.z - orientation.w*orientation.y);
-    transformMatrix.entries[9] =
-        2.0f * (orientation.y*orientation.z + orientation.w*orientation.x);
-    transformMatrix.entries[10] =
-        1.0f - 2.0f * (orientation.x*orientation.x + orientation.y*orientation.y);
-    transformMatrix.entries[11] = position.z;
+    float w = store->orientation[0][index];
+    float x = store->orientation[1][index];
+    float y = store->orientation[2][index];
+    float z = store->orientation[3][index];
+
+    store->transform[0][index] = 1.0f - 2.0f * (y*y + z*z);
+    store->transform[1][index] = 2.0f * (x*y - w*z);
+    store->transform[2][index] = 2.0f * (x*z + w*y);
+    store->transform[3][index] = store->position[0][index];
+
+    store->transform[4][index] = 2.0f * (x*y + w*z);
+    store->transform[5][index] = 1.0f - 2.0f * (x*x + z*z);
+    store->transform[6][index] = 2.0f * (y*z - w*x);
+    store->transform[7][index] = store->position[1][index];
+
+    store->transform[8][index] = 2.0f * (x*z - w*y);
+    store->transform[9][index] = 2.0f * (y*z + w*x);
+    store->transform[10][index] = 1.0f - 2.0f * (x*x + y*y);
+    store->transform[11][index] = store->position[2][index];
+
+    /* 월드 -> 로컬 변환 행렬. 회전 행렬의 전치와 -R^T p 이다 */
+    for (int row = 0; row < 3; ++row)
+    {
+        for (int col = 0; col < 3; ++col)
+            store->inverseTransform[4*row + col][index] = store->transform[4*col + row][index];
+
+        store->inverseTransform[4*row + 3][index] = -(
+            store->transform[row][index] * store->position[0][index]
+            + store->transform[4 + row][index] * store->position[1][index]
+            + store->transform[8 + row][index] * store->position[2][index]
+        );
+    }
 }
 
 void RigidBody::transformInertiaTensor()
 {
-    /* 변환 행렬 중 회전 변환 행렬만 뽑아낸다 */
+    Matrix3 rotationMatrix = getRotationMatrix();
+    Matrix3 inverseInertiaTensorWorld =
+        (rotationMatrix * getInverseInertiaTensor()) * rotationMatrix.transpose();
+
+    for (int i = 0; i < 9; ++i)
+        store->inverseInertiaTensorWorld[i][index] = inverseInertiaTensorWorld.entries[i];
+}
+
+Matrix3 RigidBody::getRotationMatrix() const
+{
     Matrix3 rotationMatrix;
     for (int i = 0; i < 3; ++i)
         for (int j = 0; j < 3; ++j)
-            rotationMatrix.entries[3*i + j] = transformMatrix.entries[4*i + j];
+            rotationMatrix.entries[3*i + j] = store->transform[4*i + j][index];
 
-    inverseInertiaTensorWorld = (rotationMatrix * inverseInertiaTensor) * rotationMatrix.transpose();
+    return rotationMatrix;
 }
 
 void RigidBody::setMass(float value)
 {
-    inverseMass = 1.0f / value;
+    wakeUp();
+    store->inverseMass[index] = 1.0f / value;
 }
 
 void RigidBody::setInverseMass(float value)
 {
-    inverseMass = value;
+    wakeUp();
+    store->inverseMass[index] = value;
 }
 
 void RigidBody::setInertiaTensor(const Matrix3& mat)
 {
-    inverseInertiaTensor = mat.inverse();
+    wakeUp();
+    Matrix3 inverseInertiaTensor = mat.inverse();
+    for (int i = 0; i < 9; ++i)
+        store->inverseInertiaTensor[i][index] = inverseInertiaTensor.entries[i];
     transformInertiaTensor();
 }
 
 void RigidBody::setInverseInertiaTensor(const Matrix3& mat)
 {
-    inverseInertiaTensor = mat;
+    wakeUp();
+    for (int i = 0; i < 9; ++i)
+        store->inverseInertiaTensor[i][index] = mat.entries[i];
     transformInertiaTensor();
 }
 
 void RigidBody::setPosition(const Vector3& vec)
 {
-    position = vec;
-    updateTransformMatrix();
+    setPosition(vec.x, vec.y, vec.z);
 }
 
 void RigidBody::setPosition(float x, float y, float z)
 {
-    position.x = x;
-    position.y = y;
-    position.z = z;
+    wakeUp();
+    store->position[0][index] = x;
+    store->position[1][index] = y;
+    store->position[2][index] = z;
     updateTransformMatrix();
+    ++store->editCount;
 }
 
 void RigidBody::setOrientation(const Quaternion& quat)
 {
-    orientation = quat;
+    wakeUp();
+    store->orientation[0][index] = quat.w;
+    store->orientation[1][index] = quat.x;
+    store->orientation[2][index] = quat.y;
+    store->orientation[3][index] = quat.z;
     updateTransformMatrix();
     transformInertiaTensor();
+    ++store->editCount;
 }
 
 void RigidBody::setVelocity(const Vector3& vec)
 {
-    velocity = vec;
+    setVelocity(vec.x, vec.y, vec.z);
 }
 
 void RigidBody::setVelocity(float x, float y, float z)
 {
-    velocity.x = x;
-    velocity.y = y;
-    velocity.z = z;
+    wakeUp();
+    store->velocity[0][index] = x;
+    store->velocity[1][index] = y;
+    store->velocity[2][index] = z;
 }
 
 void RigidBody::setRotation(const Vector3& vec)
 {
-    Matrix3 rotationMatrix;
-    for (int i = 0; i < 3; ++i)
-        for (int j = 0; j < 3; ++j)
-            rotationMatrix.entries[3*i + j] = transformMatrix.entries[4*i + j];
-
-    rotation = rotationMatrix.transpose() * vec;
+    setRotation(vec.x, vec.y, vec.z);
 }
 
 void RigidBody::setRotation(float x, float y, float z)
 {
-    Matrix3 rotationMatrix;
-    for (int i = 0; i < 3; ++i)
-        for (int j = 0; j < 3; ++j)
-            rotationMatrix.entries[3*i + j] = transformMatrix.entries[4*i + j];
-    
-    Vector3 newRotation = rotationMatrix.transpose() * Vector3(x, y, z);
+    wakeUp();
+
+    /* 각속도는 로컬 좌표계 기준으로 저장한다 */
+    Vector3 newRotation = getRotationMatrix().transpose() * Vector3(x, y, z);
 
-    rotation = newRotation;
+    store->rotation[0][index] = newRotation.x;
+    store->rotation[1][index] = newRotation.y;
+    store->rotation[2][index] = newRotation.z;
 }
 
 void RigidBody::setAcceleration(const Vector3& vec)
 {
-    acceleration = vec;
+    setAcceleration(vec.x, vec.y, vec.z);
 }
 
 void RigidBody::setAcceleration(float x, float y, float z)
 {
-    acceleration.x = x;
-    acceleration.y = y;
-    acceleration.z = z;
+    wakeUp();
+    store->acceleration[0][index] = x;
+    store->acceleration[1][index] = y;
+    store->acceleration[2][index] = z;
 }
 
 void RigidBody::setLinearDamping(float value)
 {
-    linearDamping = value;
+    store->linearDamping[index] = value;
+    store->linearDampingFactor[index] = powf(value, store->dampingDuration);
 }
 
 float RigidBody::getMass() const
 {
-    return 1.0f / inverseMass;
+    return 1.0f / store->inverseMass[index];
 }
 
 float RigidBody::getInverseMass() const
 {
-    return inverseMass;
+    return store->inverseMass[index];
 }
 
 Matrix3 RigidBody::getInverseInertiaTensor() const
 {
-    return inverseInertiaTensor;
+    Matrix3 result;
+    for (int i = 0; i < 9; ++i)
+        result.entries[i] = store->inverseInertiaTensor[i][index];
+
+    return result;
 }
 
 Matrix3 RigidBody::getInverseInertiaTensorWorld() const
 {
-    return inverseInertiaTensorWorld;
+    Matrix3 result;
+    for (int i = 0; i < 9; ++i)
+        result.entries[i] = store->inverseInertiaTensorWorld[i][index];
+
+    return result;
 }
 
 Vector3 RigidBody::getPosition() const
 {
-    return position;
+    return Vector3(store->position[0][index], store->position[1][index], store->position[2][index]);
+}
+
+Quaternion RigidBody::getOrientation() const
+{
+    return Quaternion(
+        store->orientation[0][index],
+        store->orientation[1][index],
+        store->orientation[2][index],
+        store->orientation[3][index]
+    );
 }
 
 Vector3 RigidBody::getVelocity() const
 {
-    return velocity;
+    return Vector3(store->velocity[0][index], store->velocity[1][index], store->velocity[2][index]);
 }
 
 Vector3 RigidBody::getRotation() const
 {
-    Matrix3 rotationMatrix;
-    for (int i = 0; i < 3; ++i)
-        for (int j = 0; j < 3; ++j)
-            rotationMatrix.entries[3*i + j] = transformMatrix.entries[4*i + j];
-
-    return rotationMatrix * rotation;
+    Vector3 rotation(store->rotation[0][index], store->rotation[1][index], store->rotation[2][index]);
+    return getRotationMatrix() * rotation;
 }
 
 Vector3 RigidBody::getAcceleration() const
 {
-    return acceleration;
+    return Vector3(store->acceleration[0][index], store->acceleration[1][index], store->acceleration[2][index]);
 }
 
 float RigidBody::getLinearDamping() const
 {
-    return linearDamping;
+    return store->linearDamping[index];
 }
 
 void RigidBody::getTransformMatrix(float matrix[16]) const
 {
-    matrix[0] = transformMatrix.entries[0];
-    matrix[1] = transformMatrix.entries[4];
-    matrix[2] = transformMatrix.entries[8];
-    matrix[3] = transformMatrix.entries[12];
-
-    matrix[4] = transformMatrix.entries[1];
-    matrix[5] = transformMatrix.entries[5];
-    matrix[6] = transformMatrix.entries[9];
-    matrix[7] = transformMatrix.entries[13];
-
-    matrix[8] = transformMatrix.entries[2];
-    matrix[9] = transformMatrix.entries[6];
-    matrix[10] = transformMatrix.entries[10];
-    matrix[11] = transformMatrix.entries[14];
-
-    matrix[12] = transformMatrix.entries[3];
-    matrix[13] = transformMatrix.entries[7];
-    matrix[14] = transformMatrix.entries[11];
-    matrix[15] = transformMatrix.entries[15];
+    matrix[0] = store->transform[0][index];
+    matrix[1] = store->transform[4][index];
+    matrix[2] = store->transform[8][index];
+    matrix[3] = 0.0f;
+
+    matrix[4] = store->transform[1][index];
+    matrix[5] = store->transform[5][index];
+    matrix[6] = store->transform[9][index];
+    matrix[7] = 0.0f;
+
+    matrix[8] = store->transform[2][index];
+    matrix[9] = store->transform[6][index];
+    matrix[10] = store->transform[10][index];
+    matrix[11] = 0.0f;
+
+    matrix[12] = store->transform[3][index];
+    matrix[13] = store->transform[7][index];
+    matrix[14] = store->transform[11][index];
+    matrix[15] = 1.0f;
 }
 
 Matrix4 RigidBody::getTransformMatrix() const
 {
+    Matrix4 transformMatrix;
+    for (int i = 0; i < 12; ++i)
+        transformMatrix.entries[i] = store->transform[i][index];
+
     return transformMatrix;
 }
+
+Matrix4 RigidBody::getInverseTransformMatrix() const
+{
+    Matrix4 inverseTransformMatrix;
+    for (int i = 0; i < 12; ++i)
+        inverseTransformMatrix.entries[i] = store->inverseTransform[i][index];
+
+    return inverseTransformMatrix;
+}
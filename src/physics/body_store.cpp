@@ -0,0 +1,290 @@
+#include <physics/body_store.h>
+#include <physics/body.h>
+#include <physics/lanes.h>
+#include <cmath>
+
+using namespace physics;
+using namespace physics::simd;
+
+namespace
+{
+    /* 묶음 하나를 읽고 쓰는 도우미 */
+    template <typename Lanes>
+    struct BatchAccess
+    {
+        unsigned int index;
+
+        Lanes load(const std::vector<float>& array) const { return Lanes::load(&array[index]); }
+        void store(std::vector<float>& array, Lanes value) const { value.store(&array[index]); }
+    };
+}
+
+BodyStore::BodyStore()
+    : dampingDuration(0.0f), editCount(0)
+{
+    for (int i = 0; i < 3; ++i)
+    {
+        arrays.push_back(&position[i]);
+        arrays.push_back(&velocity[i]);
+        arrays.push_back(&acceleration[i]);
+        arrays.push_back(&prevAcceleration[i]);
+        arrays.push_back(&force[i]);
+        arrays.push_back(&rotation[i]);
+        arrays.push_back(&torque[i]);
+    }
+    for (int i = 0; i < 4; ++i)
+        arrays.push_back(&orientation[i]);
+    for (int i = 0; i < 9; ++i)
+    {
+        arrays.push_back(&inverseInertiaTensor[i]);
+        arrays.push_back(&inverseInertiaTensorWorld[i]);
+    }
+    for (int i = 0; i < 12; ++i)
+    {
+        arrays.push_back(&transform[i]);
+        arrays.push_back(&inverseTransform[i]);
+    }
+    arrays.push_back(&inverseMass);
+    arrays.push_back(&linearDamping);
+    arrays.push_back(&angularDamping);
+    arrays.push_back(&linearDampingFactor);
+    arrays.push_back(&angularDampingFactor);
+    arrays.push_back(&awake);
+}
+
+BodyStore::~BodyStore()
+{
+    for (auto& handle : handles)
+        delete handle;
+}
+
+RigidBody* BodyStore::createBody()
+{
+    unsigned int index = handles.size();
+    for (auto& array : arrays)
+        array->push_back(0.0f);
+
+    /* 질량 1, 단위 관성 텐서, 원점에서 회전하지 않은 상태로 시작한다 */
+    inverseMass[index] = 1.0f;
+    orientation[0][index] = 1.0f;
+    for (int i = 0; i < 3; ++i)
+    {
+        inverseInertiaTensor[4*i][index] = 1.0f;
+        inverseInertiaTensorWorld[4*i][index] = 1.0f;
+        transform[5*i][index] = 1.0f;
+        inverseTransform[5*i][index] = 1.0f;
+    }
+    linearDamping[index] = 0.99f;
+    angularDamping[index] = 0.99f;
+    linearDampingFactor[index] = powf(0.99f, dampingDuration);
+    angularDampingFactor[index] = powf(0.99f, dampingDuration);
+    awake[index] = 1.0f;
+
+    RigidBody* body = new RigidBody(this, index);
+    handles.push_back(body);
+    return body;
+}
+
+void BodyStore::destroyBody(RigidBody* body)
+{
+    /* 마지막 강체를 제거될 강체의 자리로 옮긴다 */
+    unsigned int index = body->index;
+    unsigned int lastIndex = handles.size() - 1;
+    if (index != lastIndex)
+    {
+        for (auto& array : arrays)
+            (*array)[index] = (*array)[lastIndex];
+        handles[index] = handles[lastIndex];
+        handles[index]->index = index;
+    }
+
+    for (auto& array : arrays)
+        array->pop_back();
+    handles.pop_back();
+    delete body;
+}
+
+void BodyStore::updateDampingFactors(float duration)
+{
+    if (duration == dampingDuration)
+        return;
+
+    dampingDuration = duration;
+    for (unsigned int i = 0; i < handles.size(); ++i)
+    {
+        linearDampingFactor[i] = powf(linearDamping[i], duration);
+        angularDampingFactor[i] = powf(angularDamping[i], duration);
+    }
+}
+
+void BodyStore::integrate(float duration)
+{
+    updateDampingFactors(duration);
+
+    unsigned int bodyCount = handles.size();
+    unsigned int index = 0;
+    for (; index + BatchLanes::width <= bodyCount; index += BatchLanes::width)
+        integrateLanes<BatchLanes>(index, duration);
+    for (; index < bodyCount; ++index)
+        integrateLanes<ScalarLanes>(index, duration);
+}
+
+void BodyStore::integrateBody(unsigned int index, float duration)
+{
+    updateDampingFactors(duration);
+    integrateLanes<ScalarLanes>(index, duration);
+}
+
+unsigned int BodyStore::getBatchWidth()
+{
+    return BatchLanes::width;
+}
+
+template <typename Lanes>
+void BodyStore::integrateLanes(unsigned int index, float duration)
+{
+    BatchAccess<Lanes> batch = {index};
+    const Lanes zero(0.0f);
+    const Lanes one(1.0f);
+    const Lanes two(2.0f);
+    const Lanes dt(duration);
+
+    /* 질량이 무한대이거나 잠든 강체는 적분하지 않는다 */
+    Lanes invMass = batch.load(inverseMass);
+    typename Lanes::Mask active = maskAnd(invMass != zero, batch.load(awake) != zero);
+
+    Lanes p[3], v[3], r[3], a[3], f[3], t[3], q[4];
+    for (int i = 0; i < 3; ++i)
+    {
+        p[i] = batch.load(position[i]);
+        v[i] = batch.load(velocity[i]);
+        r[i] = batch.load(rotation[i]);
+        a[i] = batch.load(acceleration[i]);
+        f[i] = batch.load(force[i]);
+        t[i] = batch.load(torque[i]);
+    }
+    for (int i = 0; i < 4; ++i)
+        q[i] = batch.load(orientation[i]);
+
+    Lanes iw[9];
+    for (int i = 0; i < 9; ++i)
+        iw[i] = batch.load(inverseInertiaTensorWorld[i]);
+
+    /* 가속도를 계산한다 */
+    Lanes pa[3];
+    for (int i = 0; i < 3; ++i)
+        pa[i] = a[i] + f[i] * invMass;
+
+    /* 각가속도를 계산한다 */
+    Lanes angularAcceleration[3];
+    for (int i = 0; i < 3; ++i)
+        angularAcceleration[i] = iw[3*i] * t[0] + iw[3*i + 1] * t[1] + iw[3*i + 2] * t[2];
+
+    /* 속도 & 각속도를 업데이트하고 드래그를 적용한다 */
+    Lanes linearFactor = batch.load(linearDampingFactor);
+    Lanes angularFactor = batch.load(angularDampingFactor);
+    Lanes newV[3], newR[3], newP[3];
+    for (int i = 0; i < 3; ++i)
+    {
+        newV[i] = (v[i] + pa[i] * dt) * linearFactor;
+        newR[i] = (r[i] + angularAcceleration[i] * dt) * angularFactor;
+    }
+
+    /* 위치 & 방향을 업데이트한다 */
+    for (int i = 0; i < 3; ++i)
+        newP[i] = p[i] + newV[i] * dt;
+
+    const Lanes halfDt(duration / 2.0f);
+    Lanes s[3];
+    for (int i = 0; i < 3; ++i)
+        s[i] = newR[i] * halfDt;
+
+    Lanes newQ[4];
+    newQ[0] = q[0] + (q[0] * zero - q[1] * s[0] - q[2] * s[1] - q[3] * s[2]);
+    newQ[1] = q[1] + (q[0] * s[0] + q[1] * zero + q[2] * s[2] - q[3] * s[1]);
+    newQ[2] = q[2] + (q[0] * s[1] - q[1] * s[2] + q[2] * zero + q[3] * s[0]);
+    newQ[3] = q[3] + (q[0] * s[2] + q[1] * s[1] - q[2] * s[0] + q[3] * zero);
+
+    /* 사원수를 정규화한다. 크기가 0 이면 회전각 0 으로 설정한다 */
+    Lanes magnitude = newQ[0] * newQ[0] + newQ[1] * newQ[1] + newQ[2] * newQ[2] + newQ[3] * newQ[3];
+    typename Lanes::Mask isZero = magnitude == zero;
+    Lanes magnitudeInverse = one / sqrt(magnitude);
+    newQ[0] = select(isZero, one, newQ[0] * magnitudeInverse);
+    for (int i = 1; i < 4; ++i)
+        newQ[i] = select(isZero, newQ[i], newQ[i] * magnitudeInverse);
+
+    /* 변화된 상태에 따라 변환 행렬을 업데이트한다 */
+    const Lanes& w = newQ[0];
+    const Lanes& x = newQ[1];
+    const Lanes& y = newQ[2];
+    const Lanes& z = newQ[3];
+    Lanes m[12];
+    m[0] = one - two * (y*y + z*z);
+    m[1] = two * (x*y - w*z);
+    m[2] = two * (x*z + w*y);
+    m[3] = newP[0];
+    m[4] = two * (x*y + w*z);
+    m[5] = one - two * (x*x + z*z);
+    m[6] = two * (y*z - w*x);
+    m[7] = newP[1];
+    m[8] = two * (x*z - w*y);
+    m[9] = two * (y*z + w*x);
+    m[10] = one - two * (x*x + y*y);
+    m[11] = newP[2];
+
+    /* 월드 -> 로컬 변환 행렬. 회전 행렬의 전치와 -R^T p */
+    Lanes inverseM[12];
+    for (int row = 0; row < 3; ++row)
+    {
+        for (int col = 0; col < 3; ++col)
+            inverseM[4*row + col] = m[4*col + row];
+        inverseM[4*row + 3] = zero - (m[row] * newP[0] + m[4 + row] * newP[1] + m[8 + row] * newP[2]);
+    }
+
+    /* 월드 좌표계 기준의 관성 텐서를 업데이트한다. (R * I) * R^T */
+    Lanes rotationMatrix[9] = {m[0], m[1], m[2], m[4], m[5], m[6], m[8], m[9], m[10]};
+    Lanes localTensor[9];
+    for (int i = 0; i < 9; ++i)
+        localTensor[i] = batch.load(inverseInertiaTensor[i]);
+
+    Lanes product[9];
+    for (int row = 0; row < 3; ++row)
+    {
+        for (int col = 0; col < 3; ++col)
+        {
+            product[3*row + col] = rotationMatrix[3*row] * localTensor[col]
+                + rotationMatrix[3*row + 1] * localTensor[3 + col]
+                + rotationMatrix[3*row + 2] * localTensor[6 + col];
+        }
+    }
+    Lanes newIW[9];
+    for (int row = 0; row < 3; ++row)
+    {
+        for (int col = 0; col < 3; ++col)
+        {
+            newIW[3*row + col] = product[3*row] * rotationMatrix[3*col]
+                + product[3*row + 1] * rotationMatrix[3*col + 1]
+                + product[3*row + 2] * rotationMatrix[3*col + 2];
+        }
+    }
+
+    /* 적분한 강체만 결과를 저장하고, 강체에 적용된 힘과 토크는 제거한다 */
+    for (int i = 0; i < 3; ++i)
+    {
+        batch.store(prevAcceleration[i], select(active, pa[i], batch.load(prevAcceleration[i])));
+        batch.store(velocity[i], select(active, newV[i], v[i]));
+        batch.store(rotation[i], select(active, newR[i], r[i]));
+        batch.store(position[i], select(active, newP[i], p[i]));
+        batch.store(force[i], select(active, zero, f[i]));
+        batch.store(torque[i], select(active, zero, t[i]));
+    }
+    for (int i = 0; i < 4; ++i)
+        batch.store(orientation[i], select(active, newQ[i], q[i]));
+    for (int i = 0; i < 12; ++i)
+    {
+        batch.store(transform[i], select(active, m[i], batch.load(transform[i])));
+        batch.store(inverseTransform[i], select(active, inverseM[i], batch.load(inverseTransform[i])));
+    }
+    for (int i = 0; i < 9; ++i)
+        batch.store(inverseInertiaTensorWorld[i], select(active, newIW[i], iw[i]));
+}
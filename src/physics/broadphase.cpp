@@ -0,0 +1,179 @@
+#include <physics/broadphase.h>
+#include <algorithm>
+#include <iostream>
+
+using namespace physics;
+
+namespace
+{
+    /* 끝점의 정렬 기준.
+        좌표가 같다면 시작점을 먼저 두어 맞닿은 구간도 겹친 것으로 본다 */
+    struct EndpointLess
+    {
+        template <typename T>
+        bool operator()(const T& a, const T& b) const
+        {
+            if (a.value != b.value)
+                return a.value < b.value;
+            return a.isMin && !b.isMin;
+        }
+    };
+}
+
+void SweepAndPrune::addCollider(Collider* collider)
+{
+    Proxy newProxy;
+    newProxy.collider = collider;
+    newProxy.aabb = collider->calcAABB();
+    proxies.push_back(newProxy);
+
+    /* 새 끝점은 배열 끝에 추가하고 다음 정렬에서 제자리를 찾아가게 한다 */
+    unsigned int proxyIdx = proxies.size() - 1;
+    Endpoint minPoint = {newProxy.aabb.min[sweepAxis], proxyIdx, true};
+    Endpoint maxPoint = {newProxy.aabb.max[sweepAxis], proxyIdx, false};
+    endpoints.push_back(minPoint);
+    endpoints.push_back(maxPoint);
+}
+
+void SweepAndPrune::removeCollider(Collider* collider)
+{
+    unsigned int proxyIdx = 0;
+    while (proxyIdx < proxies.size() && proxies[proxyIdx].collider != collider)
+        ++proxyIdx;
+
+    if (proxyIdx == proxies.size())
+    {
+        std::cout << "ERROR::SweepAndPrune::removeCollider()::can't find collider" << std::endl;
+        return;
+    }
+
+    /* 제거할 proxy 의 끝점을 지운다. 나머지 끝점의 순서는 유지된다 */
+    std::vector<Endpoint>::iterator newEnd = endpoints.begin();
+    for (std::vector<Endpoint>::iterator it = endpoints.begin(); it != endpoints.end(); ++it)
+    {
+        if (it->proxyIdx != proxyIdx)
+            *newEnd++ = *it;
+    }
+    endpoints.erase(newEnd, endpoints.end());
+
+    /* 마지막 proxy 를 빈 자리로 옮기고 그 끝점들의 인덱스를 고친다 */
+    unsigned int lastIdx = proxies.size() - 1;
+    if (proxyIdx != lastIdx)
+    {
+        proxies[proxyIdx] = proxies[lastIdx];
+        for (auto& endpoint : endpoints)
+        {
+            if (endpoint.proxyIdx == lastIdx)
+                endpoint.proxyIdx = proxyIdx;
+        }
+    }
+    proxies.pop_back();
+}
+
+void SweepAndPrune::findPairs(std::vector<ColliderPair>& pairs)
+{
+    for (auto& proxy : proxies)
+        proxy.aabb = proxy.collider->calcAABB();
+
+    if (chooseSweepAxis())
+    {
+        /* 축이 바뀌면 이전 순서는 의미가 없으므로 새로 정렬한다 */
+        updateEndpoints();
+        std::sort(endpoints.begin(), endpoints.end(), EndpointLess());
+    }
+    else
+    {
+        updateEndpoints();
+        insertionSort();
+    }
+
+    /* 끝점들을 훑으며 구간이 열려 있는 proxy 들과 겹침 검사를 한다 */
+    activeProxies.clear();
+    for (const auto& endpoint : endpoints)
+    {
+        if (endpoint.isMin)
+        {
+            const Proxy& proxy = proxies[endpoint.proxyIdx];
+            for (const auto& activeIdx : activeProxies)
+            {
+                const Proxy& other = proxies[activeIdx];
+                /* 정렬 축에서는 이미 겹치므로 나머지 축도 확인한다 */
+                if (proxy.aabb.overlaps(other.aabb))
+                    pairs.push_back(ColliderPair(other.collider, proxy.collider));
+            }
+            activeProxies.push_back(endpoint.proxyIdx);
+        }
+        else
+        {
+            for (unsigned int i = 0; i < activeProxies.size(); ++i)
+            {
+                if (activeProxies[i] == endpoint.proxyIdx)
+                {
+                    activeProxies[i] = activeProxies.back();
+                    activeProxies.pop_back();
+                    break;
+                }
+            }
+        }
+    }
+}
+
+void SweepAndPrune::updateEndpoints()
+{
+    for (auto& endpoint : endpoints)
+    {
+        const AABB& aabb = proxies[endpoint.proxyIdx].aabb;
+        endpoint.value = endpoint.isMin ? aabb.min[sweepAxis] : aabb.max[sweepAxis];
+    }
+}
+
+bool SweepAndPrune::chooseSweepAxis()
+{
+    if (proxies.size() < 2)
+        return false;
+
+    /* 축 별로 AABB 중심의 분산을 구한다 */
+    Vector3 sum, sumSquared;
+    for (const auto& proxy : proxies)
+    {
+        Vector3 center = (proxy.aabb.min + proxy.aabb.max) * 0.5f;
+        sum += center;
+        sumSquared += Vector3(center.x*center.x, center.y*center.y, center.z*center.z);
+    }
+    float inverseCount = 1.0f / proxies.size();
+    float variance[3];
+    for (int i = 0; i < 3; ++i)
+        variance[i] = sumSquared[i] * inverseCount - sum[i]*sum[i] * inverseCount*inverseCount;
+
+    int bestAxis = sweepAxis;
+    for (int i = 0; i < 3; ++i)
+    {
+        if (variance[i] > variance[bestAxis])
+            bestAxis = i;
+    }
+
+    /* 축을 바꾸면 전체를 다시 정렬해야 하므로
+        현재 축보다 확실히 나을 때만 바꾼다 */
+    if (bestAxis != sweepAxis && variance[bestAxis] > variance[sweepAxis] * 1.5f)
+    {
+        sweepAxis = bestAxis;
+        return true;
+    }
+    return false;
+}
+
+void SweepAndPrune::insertionSort()
+{
+    EndpointLess less;
+    for (unsigned int i = 1; i < endpoints.size(); ++i)
+    {
+        Endpoint key = endpoints[i];
+        int j = i - 1;
+        while (j >= 0 && less(key, endpoints[j]))
+        {
+            endpoints[j + 1] = endpoints[j];
+            --j;
+        }
+        endpoints[j + 1] = key;
+    }
+}
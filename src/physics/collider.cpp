@@ -1,25 +1,55 @@
 #include <physics/collider.h>
 #include <cstdarg>
+#include <cmath>
+#include <algorithm>
+#include <iostream>
 
 using namespace physics;
 
 SphereCollider::SphereCollider(RigidBody* _body, float _radius)
 {
     body = _body;
+    geometry = SPHERE;
     radius = _radius;
 }
 
 void SphereCollider::setGeometricData(double value, ...)
 {
     radius = value;
+    markEdited();
+}
+
+AABB SphereCollider::calcAABB() const
+{
+    Vector3 center = body->getPosition();
+    Vector3 extent(radius, radius, radius);
+    return AABB(center - extent, center + extent);
+}
+
+Vector3 SphereCollider::support(const Vector3& direction) const
+{
+    Vector3 center = body->getPosition();
+    float lengthSquared = direction.magnitudeSquared();
+    if (lengthSquared < 1e-12f)
+        return center + Vector3(radius, 0.0f, 0.0f);
+
+    return center + direction * (radius / sqrtf(lengthSquared));
 }
 
 BoxCollider::BoxCollider(RigidBody* _body, float _halfX, float _halfY, float _halfZ)
 {
     body = _body;
+    geometry = BOX;
     halfSize.x = _halfX;
     halfSize.y = _halfY;
     halfSize.z = _halfZ;
+    updateAxes();
+}
+
+void BoxCollider::updateAxes()
+{
+    for (int i = 0; i < 3; ++i)
+        axes[i] = body->getAxis(i);
 }
 
 void BoxCollider::setGeometricData(double value, ...)
@@ -33,6 +63,175 @@ void BoxCollider::setGeometricData(double value, ...)
     halfSize.z = va_arg(args, double);
 
     va_end(args);
+    markEdited();
+}
+
+AABB BoxCollider::calcAABB() const
+{
+    /* 회전된 직육면체의 각 축 방향 반길이는
+        회전 행렬 성분의 절댓값과 half-size 의 곱의 합이다 */
+    Matrix4 transform = body->getTransformMatrix();
+    Vector3 extent;
+    extent.x = fabsf(transform.entries[0]) * halfSize.x
+        + fabsf(transform.entries[1]) * halfSize.y
+        + fabsf(transform.entries[2]) * halfSize.z;
+    extent.y = fabsf(transform.entries[4]) * halfSize.x
+        + fabsf(transform.entries[5]) * halfSize.y
+        + fabsf(transform.entries[6]) * halfSize.z;
+    extent.z = fabsf(transform.entries[8]) * halfSize.x
+        + fabsf(transform.entries[9]) * halfSize.y
+        + fabsf(transform.entries[10]) * halfSize.z;
+
+    Vector3 center = body->getPosition();
+    return AABB(center - extent, center + extent);
+}
+
+Vector3 BoxCollider::support(const Vector3& direction) const
+{
+    /* 각 로컬 축과 방향의 내적 부호에 따라 꼭짓점을 고른다.
+        변환 행렬의 i 번째 열이 로컬 i 축이다 */
+    Matrix4 transform = body->getTransformMatrix();
+    Vector3 result = body->getPosition();
+    for (int i = 0; i < 3; ++i)
+    {
+        Vector3 axis(transform.entries[i], transform.entries[4 + i], transform.entries[8 + i]);
+        float sign = axis.dot(direction) >= 0.0f ? 1.0f : -1.0f;
+        result += axis * (sign * halfSize[i]);
+    }
+    return result;
+}
+
+CapsuleCollider::CapsuleCollider(RigidBody* _body, float _radius, float _halfHeight)
+{
+    body = _body;
+    geometry = CAPSULE;
+    radius = _radius;
+    halfHeight = _halfHeight;
+}
+
+void CapsuleCollider::setGeometricData(double value, ...)
+{
+    radius = value;
+
+    va_list args;
+    va_start(args, value);
+
+    halfHeight = va_arg(args, double);
+
+    va_end(args);
+    markEdited();
+}
+
+AABB CapsuleCollider::calcAABB() const
+{
+    Vector3 start, end;
+    calcSegment(start, end);
+
+    Vector3 minPoint(fminf(start.x, end.x), fminf(start.y, end.y), fminf(start.z, end.z));
+    Vector3 maxPoint(fmaxf(start.x, end.x), fmaxf(start.y, end.y), fmaxf(start.z, end.z));
+    Vector3 extent(radius, radius, radius);
+    return AABB(minPoint - extent, maxPoint + extent);
+}
+
+Vector3 CapsuleCollider::support(const Vector3& direction) const
+{
+    /* 선분의 support 점에 구의 support 점을 더한다 */
+    Vector3 axis = body->getAxis(1);
+    Vector3 result = body->getPosition();
+    result += axis * (axis.dot(direction) >= 0.0f ? halfHeight : -halfHeight);
+
+    float lengthSquared = direction.magnitudeSquared();
+    if (lengthSquared > 1e-12f)
+        result += direction * (radius / sqrtf(lengthSquared));
+    return result;
+}
+
+void CapsuleCollider::calcSegment(Vector3& start, Vector3& end) const
+{
+    Vector3 center = body->getPosition();
+    Vector3 offset = body->getAxis(1) * halfHeight;
+    start = center - offset;
+    end = center + offset;
+}
+
+Matrix3 CapsuleCollider::calcInertiaTensor(float mass, float radius, float halfHeight)
+{
+    /* 부피 비율로 질량을 원기둥과 양 끝 반구에 나눈다. 두 부피 모두 pi * r^2 을 곱한 값이므로 생략한다 */
+    float height = halfHeight * 2.0f;
+    float cylinderVolume = height;
+    float sphereVolume = 4.0f / 3.0f * radius;
+    float cylinderMass = mass * cylinderVolume / (cylinderVolume + sphereVolume);
+    float sphereMass = mass - cylinderMass;
+    float axial = cylinderMass * radius*radius * 0.5f + sphereMass * radius*radius * 0.4f;
+    float lateral = cylinderMass * (height*height / 12.0f + radius*radius * 0.25f)
+        + sphereMass * (radius*radius * 0.4f + height*height * 0.25f + height*radius * 0.375f);
+
+    Matrix3 inertiaTensor;
+    inertiaTensor.entries[0] = lateral;
+    inertiaTensor.entries[4] = axial;
+    inertiaTensor.entries[8] = lateral;
+    return inertiaTensor;
+}
+
+CylinderCollider::CylinderCollider(RigidBody* _body, float _radius, float _halfHeight)
+{
+    body = _body;
+    geometry = CYLINDER;
+    radius = _radius;
+    halfHeight = _halfHeight;
+}
+
+void CylinderCollider::setGeometricData(double value, ...)
+{
+    radius = value;
+
+    va_list args;
+    va_start(args, value);
+
+    halfHeight = va_arg(args, double);
+
+    va_end(args);
+    markEdited();
+}
+
+AABB CylinderCollider::calcAABB() const
+{
+    /* 축 방향으로는 halfHeight 만큼, 밑면 원은 축과 수직인 정도만큼 퍼져 있다 */
+    Vector3 axis = body->getAxis(1);
+    Vector3 extent;
+    extent.x = fabsf(axis.x) * halfHeight + radius * sqrtf(fmaxf(0.0f, 1.0f - axis.x*axis.x));
+    extent.y = fabsf(axis.y) * halfHeight + radius * sqrtf(fmaxf(0.0f, 1.0f - axis.y*axis.y));
+    extent.z = fabsf(axis.z) * halfHeight + radius * sqrtf(fmaxf(0.0f, 1.0f - axis.z*axis.z));
+
+    Vector3 center = body->getPosition();
+    return AABB(center - extent, center + extent);
+}
+
+Matrix3 CylinderCollider::calcInertiaTensor(float mass, float radius, float halfHeight)
+{
+    float height = halfHeight * 2.0f;
+
+    Matrix3 inertiaTensor;
+    inertiaTensor.entries[0] = mass * (3.0f * radius*radius + height*height) / 12.0f;
+    inertiaTensor.entries[4] = mass * radius*radius * 0.5f;
+    inertiaTensor.entries[8] = inertiaTensor.entries[0];
+    return inertiaTensor;
+}
+
+Vector3 CylinderCollider::support(const Vector3& direction) const
+{
+    /* 방향의 축 성분으로 윗면과 밑면 중 하나를 고르고,
+        축에 수직인 성분 방향으로 그 면의 테두리 위의 점을 고른다 */
+    Vector3 axis = body->getAxis(1);
+    float axisComponent = axis.dot(direction);
+    Vector3 result = body->getPosition();
+    result += axis * (axisComponent >= 0.0f ? halfHeight : -halfHeight);
+
+    Vector3 radial = direction - axis * axisComponent;
+    float radialLengthSquared = radial.magnitudeSquared();
+    if (radialLengthSquared > 1e-12f)
+        result += radial * (radius / sqrtf(radialLengthSquared));
+    return result;
 }
 
 PlaneCollider::PlaneCollider(Vector3 _normal, float _offset)
@@ -40,3 +239,119 @@ PlaneCollider::PlaneCollider(Vector3 _normal, float _offset)
     normal = _normal;
     offset = _offset;
 }
+
+HeightfieldCollider::HeightfieldCollider(
+    int _columnCount,
+    int _rowCount,
+    float _cellSize,
+    const Vector3& _origin,
+    const std::vector<float>& _heights
+) : columnCount(_columnCount), rowCount(_rowCount), cellSize(_cellSize), origin(_origin), heights(_heights)
+{
+    if (columnCount < 2 || rowCount < 2 || (int)heights.size() != columnCount * rowCount)
+    {
+        std::cout << "ERROR::HeightfieldCollider::HeightfieldCollider()::invalid grid "
+            << columnCount << " x " << rowCount << " with " << heights.size() << " heights" << std::endl;
+        columnCount = rowCount = 2;
+        heights.assign(4, 0.0f);
+    }
+
+    minHeight = *std::min_element(heights.begin(), heights.end());
+    maxHeight = *std::max_element(heights.begin(), heights.end());
+}
+
+bool HeightfieldCollider::calcCellRange(
+    const AABB& aabb,
+    int& minColumn,
+    int& minRow,
+    int& maxColumn,
+    int& maxRow
+) const
+{
+    /* 지형 전체보다 위에 있다면 칸을 찾을 필요가 없다 */
+    if (aabb.min.y > origin.y + maxHeight || aabb.max.y < origin.y + minHeight)
+        return false;
+
+    float minX = (aabb.min.x - origin.x) / cellSize;
+    float maxX = (aabb.max.x - origin.x) / cellSize;
+    float minZ = (aabb.min.z - origin.z) / cellSize;
+    float maxZ = (aabb.max.z - origin.z) / cellSize;
+    if (maxX < 0.0f || maxZ < 0.0f || minX > columnCount - 1 || minZ > rowCount - 1)
+        return false;
+
+    minColumn = std::max(0, (int)floorf(minX));
+    minRow = std::max(0, (int)floorf(minZ));
+    maxColumn = std::min(columnCount - 2, (int)floorf(maxX));
+    maxRow = std::min(rowCount - 2, (int)floorf(maxZ));
+    return true;
+}
+
+void HeightfieldCollider::getTriangle(int column, int row, int half, TriangleMesh::Triangle& triangle) const
+{
+    calcTriangleFace(column, row, half, triangle);
+    calcNeighborDirections(column, row, half, triangle);
+}
+
+void HeightfieldCollider::calcTriangleFace(int column, int row, int half, TriangleMesh::Triangle& triangle) const
+{
+    /* 삼각형의 세 정점의 칸 기준 위치 */
+    static const int vertexOffsets[2][3][2] = {
+        {{0, 0}, {0, 1}, {1, 1}},
+        {{0, 0}, {1, 1}, {1, 0}}
+    };
+
+    for (int i = 0; i < 3; ++i)
+        triangle.vertices[i] = getVertex(column + vertexOffsets[half][i][0], row + vertexOffsets[half][i][1]);
+    triangle.normal = (triangle.vertices[1] - triangle.vertices[0]).cross(triangle.vertices[2] - triangle.vertices[0]);
+    triangle.normal.normalize();
+}
+
+void HeightfieldCollider::calcNeighborDirections(int column, int row, int half, TriangleMesh::Triangle& triangle) const
+{
+    /* 변 i 를 공유하는 이웃 삼각형의 세 번째 정점의 칸 기준 위치 */
+    static const int neighborOffsets[2][3][2] = {
+        {{-1, 0}, {1, 2}, {1, 0}},
+        {{0, 1}, {2, 1}, {0, -1}}
+    };
+
+    for (int i = 0; i < 3; ++i)
+    {
+        int neighborColumn = column + neighborOffsets[half][i][0];
+        int neighborRow = row + neighborOffsets[half][i][1];
+        if (neighborColumn < 0 || neighborColumn >= columnCount || neighborRow < 0 || neighborRow >= rowCount)
+        {
+            triangle.neighborDirections[i] = Vector3();
+            continue;
+        }
+
+        /* 이웃의 세 번째 정점에서 변에 수직인 성분이 이웃의 면 위에서 이웃 안쪽을 향하는 방향이다 */
+        const Vector3& edgeStart = triangle.vertices[i];
+        Vector3 edge = triangle.vertices[(i + 1) % 3] - edgeStart;
+        Vector3 toNeighbor = getVertex(neighborColumn, neighborRow) - edgeStart;
+        Vector3 direction = toNeighbor - edge * (toNeighbor.dot(edge) / edge.magnitudeSquared());
+        direction.normalize();
+        triangle.neighborDirections[i] = direction;
+    }
+}
+
+bool HeightfieldCollider::calcHeightAt(float x, float z, float& height, Vector3& normal) const
+{
+    float gridX = (x - origin.x) / cellSize;
+    float gridZ = (z - origin.z) / cellSize;
+    if (gridX < 0.0f || gridZ < 0.0f || gridX > columnCount - 1 || gridZ > rowCount - 1)
+        return false;
+
+    int column = std::min(columnCount - 2, (int)gridX);
+    int row = std::min(rowCount - 2, (int)gridZ);
+
+    /* 칸 안의 위치로 어느 삼각형 위인지 정한다 */
+    Vector3 v00 = getVertex(column, row);
+    Vector3 v11 = getVertex(column + 1, row + 1);
+    Vector3 other = gridX - column <= gridZ - row ? getVertex(column, row + 1) : getVertex(column + 1, row);
+    normal = gridX - column <= gridZ - row ? (other - v00).cross(v11 - v00) : (v11 - v00).cross(other - v00);
+    normal.normalize();
+
+    /* 삼각형이 이루는 평면 위의 높이 */
+    height = v00.y - (normal.x * (x - v00.x) + normal.z * (z - v00.z)) / normal.y;
+    return true;
+}
@@ -1,73 +1,683 @@
 #include <physics/detector.h>
+#include <physics/lanes.h>
 #include <cmath>
 #include <cfloat>
+#include <iterator>
 
 using namespace physics;
 
+struct CollisionDetector::TriangleMeshCallback
+{
+    CollisionDetector* detector;
+    std::vector<Contact>& contacts;
+    Collider* collider;
+    const TriangleMesh::Triangle* firstTriangle;
+    unsigned int shapeTag;
+
+    TriangleMeshCallback(
+        CollisionDetector* _detector,
+        std::vector<Contact>& _contacts,
+        Collider* _collider,
+        TriangleMesh* mesh,
+        unsigned int meshIndex
+    ) : detector(_detector), contacts(_contacts), collider(_collider),
+        firstTriangle(mesh->triangles.data()),
+        shapeTag(triangleMeshTag + meshIndex % (256 - triangleMeshTag)) {}
+
+    bool operator()(const TriangleMesh::Triangle& triangle)
+    {
+        /* 메쉬의 번호와 삼각형의 번호로 다른 도형과 겹치지 않는 featureID 구간을 정한다 */
+        unsigned int featureBase = calcStaticFeatureBase(shapeTag, (unsigned int)(&triangle - firstTriangle));
+
+        if (collider->geometry == SPHERE)
+            detector->sphereAndTriangle(contacts, *static_cast<SphereCollider*>(collider), triangle, featureBase);
+        else if (collider->geometry == BOX)
+            detector->boxAndTriangle(contacts, *static_cast<BoxCollider*>(collider), triangle, featureBase);
+        else if (collider->geometry == CAPSULE)
+            detector->capsuleAndTriangle(contacts, *static_cast<CapsuleCollider*>(collider), triangle, featureBase);
+        else
+            detector->convexAndTriangle(contacts, *collider, triangle, featureBase);
+        return true;
+    }
+};
+
 void CollisionDetector::detectCollision(
-    std::vector<Contact*>& contacts,
+    std::vector<Contact>& contacts,
     std::unordered_map<unsigned int, Collider*>& colliders,
     PlaneCollider& groundCollider
 )
 {
-    for (auto i = colliders.begin(); i != colliders.end(); ++i)
+    ++frameCount;
+
+    /* 적분으로 움직인 물체들을 트리에 반영한다 */
+    updateColliderTree(colliders);
+
+    /* 직육면체의 축은 스텝마다 한 번만 구해 모든 쌍에서 다시 쓴다 */
+    for (auto& collider : colliders)
+    {
+        if (collider.second->geometry == BOX)
+            static_cast<BoxCollider*>(collider.second)->updateAxes();
+    }
+
+    if (broadPhaseMode == BRUTE_FORCE)
     {
-        Collider* colliderPtrI = i->second;
-        for (auto j = std::next(i, 1); j != colliders.end(); ++j)
+        /* 모든 충돌체 쌍을 검사한다 */
+        for (auto i = colliders.begin(); i != colliders.end(); ++i)
         {
-            Collider* colliderPtrJ = j->second;
-            if (typeid(*colliderPtrI) == typeid(SphereCollider))
-            {
-                SphereCollider* collider1 = static_cast<SphereCollider*>(colliderPtrI);
-                if (typeid(*colliderPtrJ) == typeid(SphereCollider)) // 구 - 구 충돌
-                {
-                    SphereCollider* collider2 = static_cast<SphereCollider*>(colliderPtrJ);
-                    sphereAndSphere(contacts, *collider1, *collider2);
-                }
-                else if (typeid(*colliderPtrJ) == typeid(BoxCollider)) // 구 - 직육면체 충돌
-                {
-                    BoxCollider* collider2 = static_cast<BoxCollider*>(colliderPtrJ);
-                    sphereAndBox(contacts, *collider1, *collider2);
-                }
-            }
-            else if (typeid(*colliderPtrI) == typeid(BoxCollider))
+            for (auto j = std::next(i, 1); j != colliders.end(); ++j)
+                detectCollisionPair(contacts, i->second, j->second);
+        }
+        candidatePairCount = colliders.size() * (colliders.size() - 1) / 2;
+    }
+    else
+    {
+        /* AABB 가 겹치는 쌍만 검사한다 */
+        candidatePairs.clear();
+        if (broadPhaseMode == SWEEP_AND_PRUNE)
+            sweepAndPrune.findPairs(candidatePairs);
+        else if (broadPhaseMode == AABB_TREE)
+            colliderTree.findPairs(candidatePairs);
+        else if (broadPhaseMode == SPATIAL_HASH)
+            spatialHash.findPairs(colliders, candidatePairs);
+
+        for (const auto& pair : candidatePairs)
+            detectCollisionPair(contacts, pair.first, pair.second);
+        candidatePairCount = candidatePairs.size();
+    }
+
+    /* 위에서 모아 둔 구 - 구 쌍을 묶음으로 검사한다 */
+    detectSpherePairBatch(contacts);
+
+    /* 지면과의 충돌 검사 */
+    for (auto& collider : colliders)
+    {
+        Collider* colliderPtr = collider.second;
+        if (!isBodyActive(colliderPtr->body))
+            continue;
+
+        /* 지형이 있다면 평면 지면 대신 지형과 검사한다 */
+        if (heightfield != nullptr)
+        {
+            if (colliderPtr->geometry == SPHERE)
+                sphereAndHeightfield(contacts, *static_cast<SphereCollider*>(colliderPtr), *heightfield);
+            else if (colliderPtr->geometry == BOX)
+                boxAndHeightfield(contacts, *static_cast<BoxCollider*>(colliderPtr), *heightfield);
+            else
+                convexAndHeightfield(contacts, *colliderPtr, *heightfield);
+        }
+        else if (colliderPtr->geometry == SPHERE)
+        {
+            SphereCollider* sphereCollider = static_cast<SphereCollider*>(colliderPtr);
+            if (!isSphereBatchEnabled || !spherePlaneBatch.add(*sphereCollider))
+                sphereAndPlane(contacts, *sphereCollider, groundCollider);
+        }
+        else if (colliderPtr->geometry == BOX)
+        {
+            BoxCollider* boxCollider = static_cast<BoxCollider*>(colliderPtr);
+            boxAndPlane(contacts, *boxCollider, groundCollider);
+        }
+        else if (colliderPtr->geometry == CAPSULE)
+        {
+            CapsuleCollider* capsuleCollider = static_cast<CapsuleCollider*>(colliderPtr);
+            capsuleAndPlane(contacts, *capsuleCollider, groundCollider);
+        }
+        else
+            convexAndPlane(contacts, *colliderPtr, groundCollider);
+    }
+    detectSpherePlaneBatch(contacts, groundCollider);
+
+    /* 고정된 삼각형 메쉬와의 충돌 검사. 메쉬의 BVH 로 AABB 가 겹치는 삼각형만 검사한다 */
+    if (!triangleMeshes.empty())
+    {
+        for (auto& collider : colliders)
+        {
+            Collider* colliderPtr = collider.second;
+            if (!isBodyActive(colliderPtr->body))
+                continue;
+
+            AABB aabb = colliderPtr->calcAABB();
+            for (unsigned int i = 0; i < triangleMeshes.size(); ++i)
             {
-                BoxCollider* collider1 = static_cast<BoxCollider*>(colliderPtrI);
-                if (typeid(*colliderPtrJ) == typeid(SphereCollider)) // 구 - 직육면체 충돌
-                {
-                    SphereCollider* collider2 = static_cast<SphereCollider*>(colliderPtrJ);
-                    sphereAndBox(contacts, *collider2, *collider1);
-                }
-                else if (typeid(*colliderPtrJ) == typeid(BoxCollider)) // 직육면체 - 직육면체 충돌
-                {
-                    BoxCollider* collider2 = static_cast<BoxCollider*>(colliderPtrJ);
-                    boxAndBox(contacts, *collider1, *collider2);
-                }
+                TriangleMeshCallback callback(this, contacts, colliderPtr, triangleMeshes[i], i);
+                triangleMeshes[i]->query(aabb, callback);
             }
         }
+    }
+
+    /* 이번 프레임에 검사하지 않은 쌍의 GJK 캐시와 분리축 캐시를 지운다 */
+    for (auto cache = gjkCaches.begin(); cache != gjkCaches.end();)
+    {
+        if (cache->second.lastFrame != frameCount)
+            cache = gjkCaches.erase(cache);
+        else
+            ++cache;
+    }
+    for (auto cache = separatingAxisCaches.begin(); cache != separatingAxisCaches.end();)
+    {
+        if (cache->second.lastFrame != frameCount)
+            cache = separatingAxisCaches.erase(cache);
+        else
+            ++cache;
+    }
+}
+
+void CollisionDetector::addCollider(Collider* collider)
+{
+    sweepAndPrune.addCollider(collider);
+    collider->proxyID = colliderTree.createProxy(collider->calcAABB(), collider);
+}
+
+void CollisionDetector::removeCollider(Collider* collider)
+{
+    sweepAndPrune.removeCollider(collider);
+    colliderTree.destroyProxy(collider->proxyID);
+    collider->proxyID = -1;
+}
+
+struct CollisionDetector::RayCastCallback
+{
+    CollisionDetector* detector;
+    const Vector3& origin;
+    const Vector3& direction;
+    Collider* hitCollider;
+    float hitDistance;
+
+    RayCastCallback(CollisionDetector* _detector, const Vector3& _origin, const Vector3& _direction)
+        : detector(_detector), origin(_origin), direction(_direction),
+        hitCollider(nullptr), hitDistance(FLT_MAX) {}
+
+    /* 더 가까운 충돌체를 찾았다면 탐색 거리를 줄인다 */
+    float operator()(Collider* collider, float maxDistance)
+    {
+        float distance = -1.0f;
+        if (collider->geometry == SPHERE)
+            distance = detector->rayAndSphere(origin, direction, *static_cast<SphereCollider*>(collider));
+        else if (collider->geometry == BOX)
+            distance = detector->rayAndBox(origin, direction, *static_cast<BoxCollider*>(collider));
+        else if (collider->geometry == CAPSULE)
+            distance = detector->rayAndCapsule(origin, direction, *static_cast<CapsuleCollider*>(collider));
+        else if (collider->geometry == CYLINDER)
+            distance = detector->rayAndCylinder(origin, direction, *static_cast<CylinderCollider*>(collider));
+
+        if (distance > 0.0f && distance < maxDistance)
+        {
+            hitCollider = collider;
+            hitDistance = distance;
+            return distance;
+        }
+        return maxDistance;
+    }
+};
+
+bool CollisionDetector::castRay(
+    const Vector3& origin,
+    const Vector3& direction,
+    Collider*& hitCollider,
+    float& hitDistance
+)
+{
+    RayCastCallback callback(this, origin, direction);
+    colliderTree.rayCast(origin, direction, FLT_MAX, callback);
+
+    hitCollider = callback.hitCollider;
+    hitDistance = callback.hitDistance;
+    return hitCollider != nullptr;
+}
 
-        /* 지면과의 충돌 검사 */
-        if (typeid(*colliderPtrI) == typeid(SphereCollider))
+struct CollisionDetector::SweepCallback
+{
+    CollisionDetector* detector;
+    const SphereCollider& sphere;
+    const Vector3& start;
+    const Vector3& motion;
+    float radius;
+    TOIEvent& event;
+    bool isHit;
+
+    SweepCallback(
+        CollisionDetector* _detector,
+        const SphereCollider& _sphere,
+        const Vector3& _start,
+        const Vector3& _motion,
+        float _radius,
+        TOIEvent& _event
+    ) : detector(_detector), sphere(_sphere), start(_start), motion(_motion), radius(_radius),
+        event(_event), isHit(false) {}
+
+    /* 지금까지 찾은 것보다 먼저 부딪힌다면 기록한다 */
+    bool operator()(Collider* collider)
+    {
+        if (collider == &sphere)
+            return true;
+
+        float fraction = -1.0f;
+        Vector3 normal, point;
+        if (collider->geometry == SPHERE)
         {
-            SphereCollider* sphereCollider = static_cast<SphereCollider*>(i->second);
-            sphereAndPlane(contacts, *sphereCollider, groundCollider);
+            const SphereCollider& other = *static_cast<SphereCollider*>(collider);
+            fraction = detector->sweptSphereAndSphere(start, motion, radius, other, normal);
+            point = other.body->getPosition() + normal * other.radius;
         }
-        else if (typeid(*colliderPtrI) == typeid(BoxCollider))
+        else if (collider->geometry == BOX)
         {
-            BoxCollider* boxCollider = static_cast<BoxCollider*>(i->second);
-            boxAndPlane(contacts, *boxCollider, groundCollider);
+            const BoxCollider& other = *static_cast<BoxCollider*>(collider);
+            fraction = detector->sweptSphereAndBox(start, motion, radius, other, normal, point);
+        }
+        else if (collider->geometry == CAPSULE)
+        {
+            const CapsuleCollider& other = *static_cast<CapsuleCollider*>(collider);
+            fraction = detector->sweptSphereAndCapsule(start, motion, radius, other, normal, point);
         }
+
+        if (fraction >= 0.0f && fraction < event.fraction)
+        {
+            event.colliders[1] = collider;
+            event.point = point;
+            event.normal = normal;
+            event.fraction = fraction;
+            isHit = true;
+        }
+        return true;
+    }
+};
+
+void CollisionDetector::detectTimeOfImpact(
+    std::vector<TOIEvent>& events,
+    std::unordered_map<unsigned int, Collider*>& colliders,
+    PlaneCollider& groundCollider,
+    float duration
+)
+{
+    events.clear();
+    if (!isCCDEnabled)
+        return;
+
+    /* 반지름에 비해 빠르게 움직인 구만 검사한다.
+        느린 구는 이산 충돌 검출만으로 충분하다 */
+    ccdSpheres.clear();
+    for (auto& collider : colliders)
+    {
+        Collider* colliderPtr = collider.second;
+        if (colliderPtr->geometry != SPHERE || !isBodyActive(colliderPtr->body))
+            continue;
+
+        SphereCollider* sphere = static_cast<SphereCollider*>(colliderPtr);
+        float travel = sphere->body->getVelocity().magnitude() * duration;
+        if (travel > ccdMotionThreshold * sphere->radius)
+            ccdSpheres.push_back(sphere);
+    }
+
+    if (ccdSpheres.empty())
+        return;
+
+    /* 적분으로 움직인 물체들을 트리에 반영한다 */
+    updateColliderTree(colliders);
+
+    for (auto& sphere : ccdSpheres)
+    {
+        /* 적분은 바뀐 속도로 위치를 옮기므로 스텝 시작 위치를 되짚을 수 있다 */
+        Vector3 motion = sphere->body->getVelocity() * duration;
+        Vector3 end = sphere->body->getPosition();
+        Vector3 start = end - motion;
+
+        TOIEvent event;
+        if (!sweepSphere(*sphere, start, motion, groundCollider, event))
+            continue;
+
+        /* 처음 부딪힌 위치로 되돌린다. 남은 시간은 충돌을 해소한 뒤 이 구만 따로 진행한다 */
+        sphere->body->setPosition(start + motion * event.fraction);
+        colliderTree.moveProxy(sphere->proxyID, sphere->calcAABB());
+
+        event.remainingTime = duration * (1.0f - event.fraction);
+        events.push_back(event);
+    }
+}
+
+void CollisionDetector::advanceTimeOfImpact(const std::vector<TOIEvent>& events, PlaneCollider& groundCollider)
+{
+    for (const auto& event : events)
+    {
+        SphereCollider* sphere = static_cast<SphereCollider*>(event.colliders[0]);
+        Vector3 start = sphere->body->getPosition();
+        Vector3 motion = sphere->body->getVelocity() * event.remainingTime;
+
+        /* 남은 시간 동안 다시 부딪힌다면 그 자리에서 멈춘다.
+            남은 시간은 버리고 다음 스텝의 충돌 해소에 맡긴다 */
+        TOIEvent nextEvent;
+        if (sweepSphere(*sphere, start, motion, groundCollider, nextEvent))
+            sphere->body->setPosition(start + motion * nextEvent.fraction);
+        else
+            sphere->body->setPosition(start + motion);
+    }
+}
+
+bool CollisionDetector::sweepSphere(
+    SphereCollider& sphere,
+    const Vector3& start,
+    const Vector3& motion,
+    PlaneCollider& groundCollider,
+    TOIEvent& event
+)
+{
+    event.colliders[0] = &sphere;
+    event.colliders[1] = nullptr;
+    event.fraction = FLT_MAX;
+    event.remainingTime = 0.0f;
+
+    /* 살짝 파고든 위치에서 멈추도록 작은 반지름으로 검사한다 */
+    float radius = sphere.radius - ccdSlop;
+    if (radius <= 0.0f)
+        return false;
+
+    bool isHit = false;
+
+    /* 지면 또는 지형 */
+    Vector3 normal;
+    float fraction = heightfield != nullptr
+        ? sweptSphereAndHeightfield(start, motion, radius, *heightfield, normal)
+        : sweptSphereAndPlane(start, motion, radius, groundCollider, normal);
+    if (fraction >= 0.0f)
+    {
+        event.point = start + motion * fraction - normal * radius;
+        event.normal = normal;
+        event.fraction = fraction;
+        isHit = true;
+    }
+
+    /* 지나온 경로를 감싸는 AABB 와 겹치는 충돌체들 */
+    Vector3 extent(sphere.radius, sphere.radius, sphere.radius);
+    Vector3 end = start + motion;
+    AABB sweptAABB = AABB(start - extent, start + extent).merge(AABB(end - extent, end + extent));
+
+    SweepCallback callback(this, sphere, start, motion, radius, event);
+    colliderTree.query(sweptAABB, callback);
+
+    return isHit || callback.isHit;
+}
+
+void CollisionDetector::updateColliderTree(std::unordered_map<unsigned int, Collider*>& colliders)
+{
+    for (auto& collider : colliders)
+        colliderTree.moveProxy(collider.second->proxyID, collider.second->calcAABB());
+}
+
+void CollisionDetector::SpherePairBatch::grow()
+{
+    unsigned int capacity = count == 0 ? 64 : count * 2;
+    spheres1.resize(capacity);
+    spheres2.resize(capacity);
+    bodyIndices1.resize(capacity);
+    bodyIndices2.resize(capacity);
+    radiusSums.resize(capacity);
+}
+
+void CollisionDetector::SpherePlaneBatch::grow()
+{
+    unsigned int capacity = count == 0 ? 64 : count * 2;
+    spheres.resize(capacity);
+    bodyIndices.resize(capacity);
+    radii.resize(capacity);
+}
+
+unsigned int CollisionDetector::getSphereBatchWidth()
+{
+    return simd::BatchLanes::width;
+}
+
+template <typename Lanes>
+void CollisionDetector::detectSpherePairLanes(std::vector<Contact>& contacts, unsigned int index)
+{
+    const SpherePairBatch& batch = spherePairBatch;
+    const float* positions[3] = {
+        batch.store->position[0].data(),
+        batch.store->position[1].data(),
+        batch.store->position[2].data()
+    };
+    const int* bodyIndices1 = &batch.bodyIndices1[index];
+    const int* bodyIndices2 = &batch.bodyIndices2[index];
+
+    /* 두 구 사이의 거리가 두 구의 반지름의 합보다 작은 쌍을 찾는다 */
+    Lanes x1 = Lanes::gather(positions[0], bodyIndices1);
+    Lanes y1 = Lanes::gather(positions[1], bodyIndices1);
+    Lanes z1 = Lanes::gather(positions[2], bodyIndices1);
+    Lanes x2 = Lanes::gather(positions[0], bodyIndices2);
+    Lanes y2 = Lanes::gather(positions[1], bodyIndices2);
+    Lanes z2 = Lanes::gather(positions[2], bodyIndices2);
+    Lanes dx = x1 - x2;
+    Lanes dy = y1 - y2;
+    Lanes dz = z1 - z2;
+    Lanes distanceSquared = dx*dx + dy*dy + dz*dz;
+    Lanes radiusSum = Lanes::load(&batch.radiusSums[index]);
+    unsigned int hits = simd::maskBits(distanceSquared < radiusSum*radiusSum);
+    if (hits == 0)
+        return;
+
+    /* 법선과 침투 깊이는 sphereAndSphere 와 같은 순서로 계산해 같은 값을 얻는다.
+        충돌하지 않은 칸의 값은 쓰지 않는다 */
+    Lanes distance = sqrt(distanceSquared);
+    Lanes distanceInverse = Lanes(1.0f) / distance;
+    float centers1[3][Lanes::width];
+    float centers2[3][Lanes::width];
+    float normals[3][Lanes::width];
+    float penetrations[Lanes::width];
+    x1.store(centers1[0]);
+    y1.store(centers1[1]);
+    z1.store(centers1[2]);
+    x2.store(centers2[0]);
+    y2.store(centers2[1]);
+    z2.store(centers2[2]);
+    (dx * distanceInverse).store(normals[0]);
+    (dy * distanceInverse).store(normals[1]);
+    (dz * distanceInverse).store(normals[2]);
+    (radiusSum - distance).store(penetrations);
+
+    for (unsigned int lane = 0; lane < Lanes::width; ++lane)
+    {
+        if ((hits & (1u << lane)) == 0)
+            continue;
+
+        const SphereCollider* sphere1 = batch.spheres1[index + lane];
+        const SphereCollider* sphere2 = batch.spheres2[index + lane];
+        Vector3 center1(centers1[0][lane], centers1[1][lane], centers1[2][lane]);
+        Vector3 center2(centers2[0][lane], centers2[1][lane], centers2[2][lane]);
+        Vector3 centerToCenter(normals[0][lane], normals[1][lane], normals[2][lane]);
+
+        contacts.push_back(Contact());
+        Contact* newContact = &contacts.back();
+        newContact->bodies[0] = sphere1->body;
+        newContact->bodies[1] = sphere2->body;
+        newContact->normal = centerToCenter;
+        newContact->contactPoint[0] = center1 - centerToCenter * sphere1->radius;
+        newContact->contactPoint[1] = center2 + centerToCenter * sphere2->radius;
+        newContact->penetration = penetrations[lane];
+        newContact->restitution = objectRestitution;
+        newContact->friction = friction;
+        newContact->featureID = 0;
+        newContact->normalImpulseSum = 0.0f;
+        newContact->tangentImpulseSum1 = 0.0f;
+        newContact->tangentImpulseSum2 = 0.0f;
+    }
+}
+
+template <typename Lanes>
+void CollisionDetector::detectSpherePlaneLanes(
+    std::vector<Contact>& contacts,
+    unsigned int index,
+    const PlaneCollider& plane
+)
+{
+    const SpherePlaneBatch& batch = spherePlaneBatch;
+    const int* bodyIndices = &batch.bodyIndices[index];
+
+    /* 평면의 법선에 대한 구와 평면의 거리가 구의 반지름보다 작은 구를 찾는다 */
+    Lanes x = Lanes::gather(batch.store->position[0].data(), bodyIndices);
+    Lanes y = Lanes::gather(batch.store->position[1].data(), bodyIndices);
+    Lanes z = Lanes::gather(batch.store->position[2].data(), bodyIndices);
+    Lanes distance = Lanes(plane.normal.x) * x + Lanes(plane.normal.y) * y + Lanes(plane.normal.z) * z;
+    distance = distance - Lanes(plane.offset);
+    unsigned int hits = simd::maskBits(distance < Lanes::load(&batch.radii[index]));
+    if (hits == 0)
+        return;
+
+    /* 충돌점은 모아 둔 중심 좌표로 구한다 */
+    float centers[3][Lanes::width];
+    float distances[Lanes::width];
+    x.store(centers[0]);
+    y.store(centers[1]);
+    z.store(centers[2]);
+    distance.store(distances);
+
+    for (unsigned int lane = 0; lane < Lanes::width; ++lane)
+    {
+        if ((hits & (1u << lane)) == 0)
+            continue;
+
+        const SphereCollider* sphere = batch.spheres[index + lane];
+        Vector3 center(centers[0][lane], centers[1][lane], centers[2][lane]);
+
+        contacts.push_back(Contact());
+        Contact* newContact = &contacts.back();
+        newContact->bodies[0] = sphere->body;
+        newContact->bodies[1] = nullptr;
+        newContact->normal = plane.normal;
+        newContact->contactPoint[0] = center - plane.normal * distances[lane];
+        newContact->penetration = sphere->radius - distances[lane];
+        newContact->restitution = groundRestitution;
+        newContact->friction = friction;
+        newContact->featureID = 0;
+        newContact->normalImpulseSum = 0.0f;
+        newContact->tangentImpulseSum1 = 0.0f;
+        newContact->tangentImpulseSum2 = 0.0f;
+    }
+}
+
+void CollisionDetector::detectSpherePairBatch(std::vector<Contact>& contacts)
+{
+    /* 가장 넓은 묶음으로 검사하고 남은 쌍은 하나씩 검사한다 */
+    unsigned int pairCount = spherePairBatch.count;
+    unsigned int index = 0;
+    for (; index + simd::BatchLanes::width <= pairCount; index += simd::BatchLanes::width)
+        detectSpherePairLanes<simd::BatchLanes>(contacts, index);
+    for (; index < pairCount; ++index)
+        detectSpherePairLanes<simd::ScalarLanes>(contacts, index);
+
+    spherePairBatch.clear();
+}
+
+void CollisionDetector::detectSpherePlaneBatch(std::vector<Contact>& contacts, const PlaneCollider& plane)
+{
+    unsigned int sphereCount = spherePlaneBatch.count;
+    unsigned int index = 0;
+    for (; index + simd::BatchLanes::width <= sphereCount; index += simd::BatchLanes::width)
+        detectSpherePlaneLanes<simd::BatchLanes>(contacts, index, plane);
+    for (; index < sphereCount; ++index)
+        detectSpherePlaneLanes<simd::ScalarLanes>(contacts, index, plane);
+
+    spherePlaneBatch.clear();
+}
+
+void CollisionDetector::detectCollisionPair(
+    std::vector<Contact>& contacts,
+    Collider* colliderPtrI,
+    Collider* colliderPtrJ
+)
+{
+    /* 두 강체 모두 움직이지 않는다면 검사하지 않는다 */
+    if (!isBodyActive(colliderPtrI->body) && !isBodyActive(colliderPtrJ->body))
+        return;
+
+    Geometry geometryI = colliderPtrI->geometry;
+    Geometry geometryJ = colliderPtrJ->geometry;
+    if (geometryI == SPHERE && geometryJ == SPHERE) // 구 - 구 충돌
+    {
+        if (isSphereBatchEnabled && spherePairBatch.add(
+            *static_cast<SphereCollider*>(colliderPtrI),
+            *static_cast<SphereCollider*>(colliderPtrJ)
+        ))
+            return;
+
+        sphereAndSphere(
+            contacts,
+            *static_cast<SphereCollider*>(colliderPtrI),
+            *static_cast<SphereCollider*>(colliderPtrJ)
+        );
+    }
+    else if (geometryI == SPHERE && geometryJ == BOX) // 구 - 직육면체 충돌
+    {
+        sphereAndBox(
+            contacts,
+            *static_cast<SphereCollider*>(colliderPtrI),
+            *static_cast<BoxCollider*>(colliderPtrJ)
+        );
+    }
+    else if (geometryI == BOX && geometryJ == SPHERE) // 구 - 직육면체 충돌
+    {
+        sphereAndBox(
+            contacts,
+            *static_cast<SphereCollider*>(colliderPtrJ),
+            *static_cast<BoxCollider*>(colliderPtrI)
+        );
+    }
+    else if (geometryI == BOX && geometryJ == BOX) // 직육면체 - 직육면체 충돌
+    {
+        boxAndBox(
+            contacts,
+            *static_cast<BoxCollider*>(colliderPtrI),
+            *static_cast<BoxCollider*>(colliderPtrJ)
+        );
+    }
+    else if (geometryI == CAPSULE && geometryJ == CAPSULE) // 캡슐 - 캡슐 충돌
+    {
+        capsuleAndCapsule(
+            contacts,
+            *static_cast<CapsuleCollider*>(colliderPtrI),
+            *static_cast<CapsuleCollider*>(colliderPtrJ)
+        );
+    }
+    else if (geometryI == CAPSULE && geometryJ == SPHERE) // 캡슐 - 구 충돌
+    {
+        capsuleAndSphere(
+            contacts,
+            *static_cast<CapsuleCollider*>(colliderPtrI),
+            *static_cast<SphereCollider*>(colliderPtrJ)
+        );
+    }
+    else if (geometryI == SPHERE && geometryJ == CAPSULE) // 캡슐 - 구 충돌
+    {
+        capsuleAndSphere(
+            contacts,
+            *static_cast<CapsuleCollider*>(colliderPtrJ),
+            *static_cast<SphereCollider*>(colliderPtrI)
+        );
+    }
+    else if (geometryI == CAPSULE && geometryJ == BOX) // 캡슐 - 직육면체 충돌
+    {
+        capsuleAndBox(
+            contacts,
+            *static_cast<CapsuleCollider*>(colliderPtrI),
+            *static_cast<BoxCollider*>(colliderPtrJ)
+        );
+    }
+    else if (geometryI == BOX && geometryJ == CAPSULE) // 캡슐 - 직육면체 충돌
+    {
+        capsuleAndBox(
+            contacts,
+            *static_cast<CapsuleCollider*>(colliderPtrJ),
+            *static_cast<BoxCollider*>(colliderPtrI)
+        );
     }
+    else // 전용 함수가 없는 도형 쌍
+        convexAndConvex(contacts, *colliderPtrI, *colliderPtrJ);
 }
 
 bool CollisionDetector::sphereAndBox(
-    std::vector<Contact*>& contacts,
+    std::vector<Contact>& contacts,
     const SphereCollider& sphere,
     const BoxCollider& box
 )
 {
     /* 구의 중심을 직육면체의 로컬 좌표계로 변환한다 */
-    Matrix4 worldToLocal = box.body->getTransformMatrix().inverse();
+    Matrix4 worldToLocal = box.body->getInverseTransformMatrix();
     Vector3 sphereInBoxLocal = worldToLocal * sphere.body->getPosition();
 
     /* 구의 중심과 가장 가까운 직육면체 위의 점을 찾는다 */
@@ -103,22 +713,22 @@ bool CollisionDetector::sphereAndBox(
         Vector3 closestPointWorld = box.body->getTransformMatrix() * closestPoint;
 
         /* 충돌 정보를 생성한다 */
-        Contact* newContact = new Contact;
+        contacts.push_back(Contact());
+        Contact* newContact = &contacts.back();
         newContact->bodies[0] = sphere.body;
         newContact->bodies[1] = box.body;
         newContact->normal = sphere.body->getPosition() - closestPointWorld;
         newContact->normal.normalize();
-        newContact->contactPoint[0] =
-            new Vector3(sphere.body->getPosition() - newContact->normal * sphere.radius);
-        newContact->contactPoint[1] = new Vector3(closestPointWorld);
+        newContact->contactPoint[0] = sphere.body->getPosition() - newContact->normal * sphere.radius;
+        newContact->contactPoint[1] = closestPointWorld;
         newContact->penetration = sphere.radius - sqrtf(distanceSquared);
         newContact->restitution = objectRestitution;
         newContact->friction = friction;
+        newContact->featureID = 0;
         newContact->normalImpulseSum = 0.0f;
         newContact->tangentImpulseSum1 = 0.0f;
         newContact->tangentImpulseSum2 = 0.0f;
 
-        contacts.push_back(newContact);
         return true;
     }
     else
@@ -126,7 +736,7 @@ bool CollisionDetector::sphereAndBox(
 }
 
 bool CollisionDetector::sphereAndSphere(
-    std::vector<Contact*>& contacts,
+    std::vector<Contact>& contacts,
     const SphereCollider& sphere1,
     const SphereCollider& sphere2
 )
@@ -143,22 +753,21 @@ bool CollisionDetector::sphereAndSphere(
         centerToCenter.normalize();
         
         /* 충돌 정보를 생성한다 */
-        Contact* newContact = new Contact;
+        contacts.push_back(Contact());
+        Contact* newContact = &contacts.back();
         newContact->bodies[0] = sphere1.body;
         newContact->bodies[1] = sphere2.body;
         newContact->normal = centerToCenter;
-        newContact->contactPoint[0] =
-            new Vector3(sphere1.body->getPosition() - centerToCenter * sphere1.radius);
-        newContact->contactPoint[1] =
-            new Vector3(sphere2.body->getPosition() + centerToCenter * sphere2.radius);
+        newContact->contactPoint[0] = sphere1.body->getPosition() - centerToCenter * sphere1.radius;
+        newContact->contactPoint[1] = sphere2.body->getPosition() + centerToCenter * sphere2.radius;
         newContact->penetration = radiusSum - sqrtf(distanceSquared);
         newContact->restitution = objectRestitution;
         newContact->friction = friction;
+        newContact->featureID = 0;
         newContact->normalImpulseSum = 0.0f;
         newContact->tangentImpulseSum1 = 0.0f;
         newContact->tangentImpulseSum2 = 0.0f;
 
-        contacts.push_back(newContact);
         return true;
     }
     else
@@ -166,7 +775,7 @@ bool CollisionDetector::sphereAndSphere(
 }
 
 bool CollisionDetector::sphereAndPlane(
-    std::vector<Contact*>& contacts,
+    std::vector<Contact>& contacts,
     const SphereCollider& sphere,
     const PlaneCollider& plane
 )
@@ -179,20 +788,20 @@ bool CollisionDetector::sphereAndPlane(
     if (distance < sphere.radius)
     {
         /* 충돌 정보를 생성한다 */
-        Contact* newContact = new Contact;
+        contacts.push_back(Contact());
+        Contact* newContact = &contacts.back();
         newContact->bodies[0] = sphere.body;
         newContact->bodies[1] = nullptr;
         newContact->normal = plane.normal;
-        newContact->contactPoint[0] = new Vector3(sphere.body->getPosition() - plane.normal * distance);
-        newContact->contactPoint[1] = nullptr;
+        newContact->contactPoint[0] = sphere.body->getPosition() - plane.normal * distance;
         newContact->penetration = sphere.radius - distance;
         newContact->restitution = groundRestitution;
         newContact->friction = friction;
+        newContact->featureID = 0;
         newContact->normalImpulseSum = 0.0f;
         newContact->tangentImpulseSum1 = 0.0f;
         newContact->tangentImpulseSum2 = 0.0f;
 
-        contacts.push_back(newContact);
         return true;
     }
     else
@@ -200,57 +809,98 @@ bool CollisionDetector::sphereAndPlane(
 }
 
 bool CollisionDetector::boxAndBox(
-    std::vector<Contact*>& contacts,
+    std::vector<Contact>& contacts,
     const BoxCollider& box1,
     const BoxCollider& box2
 )
 {
-    /* 겹침 검사의 기준이 될 축 저장 */
-    std::vector<Vector3> axes;
-
-    /* box1 의 세 축 저장 */
-    for (int i = 0; i < 3; ++i)
-        axes.push_back(box1.body->getAxis(i));
-
-    /* box2 의 세 축 저장 */
-    for (int i = 0; i < 3; ++i)
-        axes.push_back(box2.body->getAxis(i));
-
-    /* 각 축 사이의 외적 저장 */
+    /* 두 직육면체의 축 사이의 내적과 중심 사이 벡터의 사영을 한 번만 구한다.
+        15 개의 축에 대한 겹침은 모두 이 값들로 계산할 수 있다 */
+    BoxPairProjection projection;
+    Vector3 centerToCenter = box2.body->getPosition() - box1.body->getPosition();
     for (int i = 0; i < 3; ++i)
     {
+        projection.halfSize1[i] = box1.halfSize[i];
+        projection.halfSize2[i] = box2.halfSize[i];
+        projection.distance1[i] = centerToCenter.dot(box1.axes[i]);
+        projection.distance2[i] = centerToCenter.dot(box2.axes[i]);
         for (int j = 0; j < 3; ++j)
         {
-            Vector3 crossProduct = axes[i].cross(axes[3 + j]);
-            crossProduct.normalize();
-            axes.push_back(crossProduct);
+            projection.rotation[i][j] = box1.axes[i].dot(box2.axes[j]);
+            projection.absRotation[i][j] = fabsf(projection.rotation[i][j]);
         }
     }
 
+    /* 직전 프레임의 분리축이 아직 분리축이라면 나머지 축은 검사하지 않는다 */
+    SeparatingAxisCache& cache = separatingAxisCaches[BoxPair(&box1, &box2)];
+    cache.lastFrame = frameCount;
+    if (cache.axisIdx != -1 && calcPenetration(projection, cache.axisIdx) <= 0.0f)
+    {
+        cache.contactAxisIdx = -1;
+        return false;
+    }
+
     float minPenetration = FLT_MAX;
+    float minBiasedPenetration = FLT_MAX;
     int minAxisIdx = 0;
 
     /* 모든 축에 대해 겹침 검사 */
-    for (int i = 0; i < axes.size(); ++i)
+    for (int i = 0; i < 15; ++i)
     {
-        float penetration = calcPenetration(box1, box2, axes[i]);
+        float penetration = calcPenetration(projection, i);
 
         /* 한 축이라도 겹치지 않으면 충돌이 발생하지 않은 것이다 */
         if (penetration <= 0.0f)
+        {
+            cache.axisIdx = i;
+            cache.contactAxisIdx = -1;
             return false;
+        }
+
+        /* 가장 적게 겹치는 정도와 그때의 기준 축을 추적한다.
+            겹침이 거의 같다면 앞선 면의 축을 고른다. 프레임마다 축이 바뀌면 충돌점이 바뀌어
+            warm starting 이 끊기고, 모서리 축으로 바뀌면 면 사이의 충돌점이 하나로 줄어든다.
+            평행한 모서리로 만든 축은 FLT_MAX 이므로 골라지지 않는다 */
+        float biasedPenetration = i < 6 ? penetration : penetration * 1.05f + 0.001f;
 
-        /* 가장 적게 겹치는 정도와 그때의 기준 축을 추적한다 */
-        if (penetration <= minPenetration)
+        /* 직전 프레임에 고른 축은 조금 더 깊게 겹쳐도 유지한다. 크기가 같은 직육면체를 쌓으면
+            두 직육면체의 면 축이 거의 같게 겹쳐 기준 면이 프레임마다 바뀔 수 있다 */
+        if (i == cache.contactAxisIdx)
+            biasedPenetration = penetration * 0.95f;
+        if (biasedPenetration < minBiasedPenetration)
         {
+            minBiasedPenetration = biasedPenetration;
             minPenetration = penetration;
             minAxisIdx = i;
         }
     }
+    cache.axisIdx = -1;
+    cache.contactAxisIdx = minAxisIdx;
+
+    /* 충돌 법선을 방향에 유의하여 설정한다 */
+    Vector3 normal;
+    if (minAxisIdx < 3)
+        normal = box1.axes[minAxisIdx];
+    else if (minAxisIdx < 6)
+        normal = box2.axes[minAxisIdx - 3];
+    else
+    {
+        normal = box1.axes[(minAxisIdx - 6) / 3].cross(box2.axes[(minAxisIdx - 6) % 3]);
+        normal.normalize();
+    }
+    if (normal.dot(centerToCenter) > 0)
+        normal *= -1.0f;
+
+    /* 면-면 접촉이라면 맞닿은 면을 잘라 여러 충돌점을 만든다 */
+    if (minAxisIdx < 6 && clipBoxFaces(contacts, box1, box2, minAxisIdx, normal) > 0)
+        return true;
 
     /* 모든 축에 걸쳐 겹침이 감지됐다면 충돌이 발생한 것이다 */
-    Contact* newContact = new Contact;
+    contacts.push_back(Contact());
+    Contact* newContact = &contacts.back();
     newContact->bodies[0] = box1.body;
     newContact->bodies[1] = box2.body;
+    newContact->normal = normal;
     newContact->penetration = minPenetration;
     newContact->restitution = objectRestitution;
     newContact->friction = friction;
@@ -258,13 +908,6 @@ bool CollisionDetector::boxAndBox(
     newContact->tangentImpulseSum1 = 0.0f;
     newContact->tangentImpulseSum2 = 0.0f;
 
-    /* 충돌 법선을 방향에 유의하여 설정한다 */
-    Vector3 centerToCenter = box2.body->getPosition() - box1.body->getPosition();
-    if (axes[minAxisIdx].dot(centerToCenter) > 0)
-        newContact->normal = axes[minAxisIdx] * -1.0f;
-    else
-        newContact->normal = axes[minAxisIdx];
-
     /* 충돌 지점을 찾는다 */
     if (minAxisIdx < 6) // 면-점 접촉일 때
     {
@@ -274,13 +917,12 @@ bool CollisionDetector::boxAndBox(
     {
         calcContactPointOnLine(box1, box2, minAxisIdx, newContact);
     }
-    
-    contacts.push_back(newContact);
+
     return true;
 }
 
 bool CollisionDetector::boxAndPlane(
-    std::vector<Contact*>& contacts,
+    std::vector<Contact>& contacts,
     const BoxCollider& box,
     const PlaneCollider& plane
 )
@@ -313,20 +955,20 @@ bool CollisionDetector::boxAndPlane(
         if (distance < 0)
         {
             /* 충돌을 생성한다 */
-            Contact* newContact = new Contact;
+            contacts.push_back(Contact());
+            Contact* newContact = &contacts.back();
             newContact->bodies[0] = box.body;
             newContact->bodies[1] = nullptr;
             newContact->normal = plane.normal;
-            newContact->contactPoint[0] = new Vector3(vertices[i]);
-            newContact->contactPoint[1] = nullptr;
+            newContact->contactPoint[0] = vertices[i];
             newContact->penetration = -distance;
             newContact->restitution = groundRestitution;
             newContact->friction = friction;
+            newContact->featureID = i;
             newContact->normalImpulseSum = 0.0f;
             newContact->tangentImpulseSum1 = 0.0f;
             newContact->tangentImpulseSum2 = 0.0f;
 
-            contacts.push_back(newContact);
             hasContacted = true;
         }
     }
@@ -334,26 +976,1099 @@ bool CollisionDetector::boxAndPlane(
     return hasContacted;
 }
 
-float CollisionDetector::rayAndSphere(
-    const Vector3& origin,
-    const Vector3& direction,
+bool CollisionDetector::capsuleAndSphere(
+    std::vector<Contact>& contacts,
+    const CapsuleCollider& capsule,
     const SphereCollider& sphere
 )
 {
-    Vector3 originToSphere = sphere.body->getPosition() - origin;
-    float originToSphereProjected = originToSphere.dot(direction);
-    float orthogonalDistanceSquared =
-        originToSphere.magnitudeSquared() - originToSphereProjected * originToSphereProjected;
-    if (orthogonalDistanceSquared > sphere.radius*sphere.radius)
-        return -1.0f;
+    /* 구의 중심과 가장 가까운 선분 위의 점을 구한다 */
+    Vector3 start, end;
+    capsule.calcSegment(start, end);
+    Vector3 sphereCenter = sphere.body->getPosition();
+    Vector3 segmentPoint = start + (end - start) * calcClosestPointOnSegment(sphereCenter, start, end);
 
-    float t1 = sqrtf(sphere.radius*sphere.radius - orthogonalDistanceSquared);
-    float hitPointDistance = originToSphereProjected - t1;
+    /* 그 점을 중심으로 하는 구와 구의 충돌 */
+    Vector3 centerToCenter = segmentPoint - sphereCenter;
+    float distanceSquared = centerToCenter.magnitudeSquared();
+    float radiusSum = capsule.radius + sphere.radius;
+    if (distanceSquared >= radiusSum*radiusSum)
+        return false;
 
-    return hitPointDistance;
+    /* 구의 중심이 선분 위에 있다면 캡슐의 로컬 x 축으로 밀어낸다 */
+    float distance = sqrtf(distanceSquared);
+    if (distance > FLT_EPSILON)
+        centerToCenter *= 1.0f / distance;
+    else
+        centerToCenter = capsule.body->getAxis(0);
+
+    /* 충돌 정보를 생성한다 */
+    contacts.push_back(Contact());
+    Contact* newContact = &contacts.back();
+    newContact->bodies[0] = capsule.body;
+    newContact->bodies[1] = sphere.body;
+    newContact->normal = centerToCenter;
+    newContact->contactPoint[0] = segmentPoint - centerToCenter * capsule.radius;
+    newContact->contactPoint[1] = sphereCenter + centerToCenter * sphere.radius;
+    newContact->penetration = radiusSum - distance;
+    newContact->restitution = objectRestitution;
+    newContact->friction = friction;
+    newContact->featureID = 0;
+    newContact->normalImpulseSum = 0.0f;
+    newContact->tangentImpulseSum1 = 0.0f;
+    newContact->tangentImpulseSum2 = 0.0f;
+
+    return true;
 }
 
-float CollisionDetector::rayAndBox(
+bool CollisionDetector::capsuleAndCapsule(
+    std::vector<Contact>& contacts,
+    const CapsuleCollider& capsule1,
+    const CapsuleCollider& capsule2
+)
+{
+    Vector3 start1, end1, start2, end2;
+    capsule1.calcSegment(start1, end1);
+    capsule2.calcSegment(start2, end2);
+    Vector3 direction1 = end1 - start1;
+    Vector3 direction2 = end2 - start2;
+
+    float s, t;
+    float distanceSquared = calcClosestPointsOfSegments(start1, end1, start2, end2, s, t);
+    float radiusSum = capsule1.radius + capsule2.radius;
+    if (distanceSquared >= radiusSum*radiusSum)
+        return false;
+
+    /* 가장 가까운 점들의 매개변수. 나란한 두 선분이라면 겹치는 구간의 양 끝을 사용한다 */
+    float params[2] = {s, 0.0f};
+    int paramCount = 1;
+    float lengthSquared1 = direction1.magnitudeSquared();
+    float crossSquared = direction1.cross(direction2).magnitudeSquared();
+    if (crossSquared < 1e-4f * lengthSquared1 * direction2.magnitudeSquared() && lengthSquared1 > FLT_EPSILON)
+    {
+        /* 두 번째 선분의 양 끝점을 첫 번째 선분에 투영한 구간 */
+        float param1 = (start2 - start1).dot(direction1) / lengthSquared1;
+        float param2 = (end2 - start1).dot(direction1) / lengthSquared1;
+        float minParam = fmaxf(fminf(param1, param2), 0.0f);
+        float maxParam = fminf(fmaxf(param1, param2), 1.0f);
+        if (maxParam - minParam > 0.01f)
+        {
+            params[0] = minParam;
+            params[1] = maxParam;
+            paramCount = 2;
+        }
+    }
+
+    bool hasContacted = false;
+    for (int i = 0; i < paramCount; ++i)
+    {
+        Vector3 point1 = start1 + direction1 * params[i];
+        float param2 = paramCount == 1 ? t : calcClosestPointOnSegment(point1, start2, end2);
+        Vector3 point2 = start2 + direction2 * param2;
+
+        Vector3 centerToCenter = point1 - point2;
+        float distance = centerToCenter.magnitude();
+        if (distance >= radiusSum)
+            continue;
+
+        /* 두 선분이 만난다면 두 선분에 수직인 방향으로 밀어낸다 */
+        if (distance > FLT_EPSILON)
+            centerToCenter *= 1.0f / distance;
+        else
+        {
+            centerToCenter = direction1.cross(direction2);
+            if (centerToCenter.magnitudeSquared() > FLT_EPSILON)
+                centerToCenter.normalize();
+            else
+                centerToCenter = capsule1.body->getAxis(0);
+        }
+
+        /* 충돌 정보를 생성한다 */
+        contacts.push_back(Contact());
+        Contact* newContact = &contacts.back();
+        newContact->bodies[0] = capsule1.body;
+        newContact->bodies[1] = capsule2.body;
+        newContact->normal = centerToCenter;
+        newContact->contactPoint[0] = point1 - centerToCenter * capsule1.radius;
+        newContact->contactPoint[1] = point2 + centerToCenter * capsule2.radius;
+        newContact->penetration = radiusSum - distance;
+        newContact->restitution = objectRestitution;
+        newContact->friction = friction;
+        newContact->featureID = i;
+        newContact->normalImpulseSum = 0.0f;
+        newContact->tangentImpulseSum1 = 0.0f;
+        newContact->tangentImpulseSum2 = 0.0f;
+
+        hasContacted = true;
+    }
+
+    return hasContacted;
+}
+
+bool CollisionDetector::capsuleAndBox(
+    std::vector<Contact>& contacts,
+    const CapsuleCollider& capsule,
+    const BoxCollider& box
+)
+{
+    /* 캡슐의 선분을 직육면체의 로컬 좌표계로 변환한다 */
+    Vector3 start, end;
+    capsule.calcSegment(start, end);
+    Matrix4 boxTransform = box.body->getTransformMatrix();
+    Matrix4 worldToLocal = box.body->getInverseTransformMatrix();
+    Vector3 segment[2] = {worldToLocal * start, worldToLocal * end};
+    Vector3 direction = segment[1] - segment[0];
+
+    /* 양 끝점과 직육면체 사이의 거리 */
+    float minDistanceSquared = FLT_MAX;
+    float closestParam = 0.0f;
+    Vector3 closestPointOnBox;
+    for (int i = 0; i < 2; ++i)
+    {
+        Vector3 pointOnBox = calcClosestPointOnBox(segment[i], box.halfSize);
+        float distanceSquared = (segment[i] - pointOnBox).magnitudeSquared();
+        if (distanceSquared < minDistanceSquared)
+        {
+            minDistanceSquared = distanceSquared;
+            closestParam = (float)i;
+            closestPointOnBox = pointOnBox;
+        }
+    }
+
+    /* 선분의 중간이 가장 가깝다면 그 점은 직육면체의 모서리와 가장 가깝다.
+        축 i 와 나란한 모서리 4 개는 나머지 두 축의 부호 조합으로 정한다 */
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        int axis1 = (axis + 1) % 3;
+        int axis2 = (axis + 2) % 3;
+        for (int signs = 0; signs < 4; ++signs)
+        {
+            float edgeStart[3], edgeEnd[3];
+            edgeStart[axis] = -box.halfSize[axis];
+            edgeEnd[axis] = box.halfSize[axis];
+            edgeStart[axis1] = edgeEnd[axis1] = (signs & 1) ? box.halfSize[axis1] : -box.halfSize[axis1];
+            edgeStart[axis2] = edgeEnd[axis2] = (signs & 2) ? box.halfSize[axis2] : -box.halfSize[axis2];
+            Vector3 edgeStartPoint(edgeStart[0], edgeStart[1], edgeStart[2]);
+            Vector3 edgeEndPoint(edgeEnd[0], edgeEnd[1], edgeEnd[2]);
+
+            float s, t;
+            float distanceSquared = calcClosestPointsOfSegments(
+                segment[0], segment[1], edgeStartPoint, edgeEndPoint, s, t
+            );
+            if (distanceSquared < minDistanceSquared)
+            {
+                minDistanceSquared = distanceSquared;
+                closestParam = s;
+                closestPointOnBox = edgeStartPoint + (edgeEndPoint - edgeStartPoint) * t;
+            }
+        }
+    }
+
+    if (minDistanceSquared >= capsule.radius*capsule.radius)
+        return false;
+
+    /* 양 끝점이 밖에 있어도 선분이 직육면체를 관통할 수 있다. 각 축의 두 평면 사이 구간을 겹쳐 본다 */
+    float tNear = 0.0f;
+    float tFar = 1.0f;
+    for (int i = 0; i < 3 && tNear <= tFar; ++i)
+    {
+        if (fabsf(direction[i]) < FLT_EPSILON)
+        {
+            if (fabsf(segment[0][i]) > box.halfSize[i])
+                tNear = FLT_MAX;
+            continue;
+        }
+        float t1 = (-box.halfSize[i] - segment[0][i]) / direction[i];
+        float t2 = (box.halfSize[i] - segment[0][i]) / direction[i];
+        tNear = fmaxf(tNear, fminf(t1, t2));
+        tFar = fminf(tFar, fmaxf(t1, t2));
+    }
+
+    /* 선분이 직육면체에 닿거나 뚫고 들어갔다면 가장 가까운 점으로 법선을 정할 수 없다 */
+    if (minDistanceSquared < 1e-8f || tNear <= tFar)
+        return convexAndConvex(contacts, capsule, box);
+
+    /* 가장 가까운 점의 충돌점과, 그 점과 떨어진 끝점도 직육면체에 닿아 있다면 그 끝점의 충돌점을 만든다.
+        직육면체 위에 눕힌 캡슐이 충돌점 하나를 축으로 흔들리지 않는다 */
+    float params[3] = {closestParam, 0.0f, 1.0f};
+    Vector3 pointsOnBox[3] = {closestPointOnBox};
+    int paramCount = 1;
+    for (int i = 0; i < 2; ++i)
+    {
+        if (fabsf(closestParam - (float)i) < 0.01f)
+            continue;
+
+        Vector3 pointOnBox = calcClosestPointOnBox(segment[i], box.halfSize);
+        float distanceSquared = (segment[i] - pointOnBox).magnitudeSquared();
+        if (distanceSquared < capsule.radius*capsule.radius && distanceSquared > 1e-8f)
+        {
+            params[paramCount] = (float)i;
+            pointsOnBox[paramCount] = pointOnBox;
+            ++paramCount;
+        }
+    }
+
+    for (int i = 0; i < paramCount; ++i)
+    {
+        Vector3 segmentPoint = boxTransform * (segment[0] + direction * params[i]);
+        Vector3 pointOnBox = boxTransform * pointsOnBox[i];
+        Vector3 normal = segmentPoint - pointOnBox;
+        float distance = normal.magnitude();
+        normal *= 1.0f / distance;
+
+        /* 충돌 정보를 생성한다 */
+        contacts.push_back(Contact());
+        Contact* newContact = &contacts.back();
+        newContact->bodies[0] = capsule.body;
+        newContact->bodies[1] = box.body;
+        newContact->normal = normal;
+        newContact->contactPoint[0] = segmentPoint - normal * capsule.radius;
+        newContact->contactPoint[1] = pointOnBox;
+        newContact->penetration = capsule.radius - distance;
+        newContact->restitution = objectRestitution;
+        newContact->friction = friction;
+        newContact->featureID = i;
+        newContact->normalImpulseSum = 0.0f;
+        newContact->tangentImpulseSum1 = 0.0f;
+        newContact->tangentImpulseSum2 = 0.0f;
+    }
+
+    return true;
+}
+
+bool CollisionDetector::capsuleAndPlane(
+    std::vector<Contact>& contacts,
+    const CapsuleCollider& capsule,
+    const PlaneCollider& plane
+)
+{
+    /* 선분의 양 끝점을 중심으로 하는 구와 평면의 충돌 */
+    Vector3 endpoints[2];
+    capsule.calcSegment(endpoints[0], endpoints[1]);
+
+    bool hasContacted = false;
+    for (int i = 0; i < 2; ++i)
+    {
+        float distance = plane.normal.dot(endpoints[i]) - plane.offset;
+        if (distance >= capsule.radius)
+            continue;
+
+        /* 충돌을 생성한다 */
+        contacts.push_back(Contact());
+        Contact* newContact = &contacts.back();
+        newContact->bodies[0] = capsule.body;
+        newContact->bodies[1] = nullptr;
+        newContact->normal = plane.normal;
+        newContact->contactPoint[0] = endpoints[i] - plane.normal * capsule.radius;
+        newContact->penetration = capsule.radius - distance;
+        newContact->restitution = groundRestitution;
+        newContact->friction = friction;
+        newContact->featureID = i;
+        newContact->normalImpulseSum = 0.0f;
+        newContact->tangentImpulseSum1 = 0.0f;
+        newContact->tangentImpulseSum2 = 0.0f;
+
+        hasContacted = true;
+    }
+
+    return hasContacted;
+}
+
+bool CollisionDetector::convexAndConvex(
+    std::vector<Contact>& contacts,
+    const Collider& collider1,
+    const Collider& collider2
+)
+{
+    /* 이 쌍의 직전 단체에서 시작한다 */
+    unsigned long long key = ((unsigned long long)collider1.id << 32) | collider2.id;
+    GJKCache& cache = gjkCaches[key];
+    cache.lastFrame = frameCount;
+
+    if (!gjkSolver.intersect(collider1, collider2, cache))
+        return false;
+
+    Vector3 normal, point1, point2;
+    float depth;
+    if (!gjkSolver.calcPenetration(collider1, collider2, normal, depth, point1, point2))
+        return false;
+
+    /* 충돌 정보를 생성한다 */
+    contacts.push_back(Contact());
+    Contact* newContact = &contacts.back();
+    newContact->bodies[0] = collider1.body;
+    newContact->bodies[1] = collider2.body;
+    newContact->normal = normal;
+    newContact->contactPoint[0] = point1;
+    newContact->contactPoint[1] = point2;
+    newContact->penetration = depth;
+    newContact->restitution = objectRestitution;
+    newContact->friction = friction;
+    newContact->featureID = 0;
+    newContact->normalImpulseSum = 0.0f;
+    newContact->tangentImpulseSum1 = 0.0f;
+    newContact->tangentImpulseSum2 = 0.0f;
+
+    return true;
+}
+
+bool CollisionDetector::convexAndPlane(
+    std::vector<Contact>& contacts,
+    const Collider& collider,
+    const PlaneCollider& plane
+)
+{
+    /* 평면 안쪽으로 가장 깊은 점과, 그 방향을 네 방향으로 조금씩 기울여 찾은 점들을 검사한다.
+        평평한 면이 평면에 닿아 있다면 기울인 방향의 점들이 그 면의 가장자리가 되어 물체가 흔들리지 않는다 */
+    Vector3 tangent1, tangent2;
+    Contact basis;
+    basis.normal = plane.normal;
+    basis.calcTangents(tangent1, tangent2);
+    tangent1.normalize();
+    tangent2.normalize();
+
+    const float tilt = 0.2f;
+    Vector3 down = plane.normal * -1.0f;
+    Vector3 directions[5] = {
+        down,
+        down + tangent1 * tilt,
+        down - tangent1 * tilt,
+        down + tangent2 * tilt,
+        down - tangent2 * tilt
+    };
+
+    Vector3 points[5];
+    int pointCount = 0;
+    bool hasContacted = false;
+    for (int i = 0; i < 5; ++i)
+    {
+        Vector3 point = collider.support(directions[i]);
+        float distance = plane.normal.dot(point) - plane.offset;
+        if (distance >= 0.0f)
+        {
+            /* 가장 깊은 점도 평면 위에 있다면 충돌이 없다 */
+            if (i == 0)
+                return false;
+            continue;
+        }
+
+        /* 같은 점을 두 번 넣지 않는다 */
+        bool isDuplicate = false;
+        for (int j = 0; j < pointCount; ++j)
+        {
+            if ((points[j] - point).magnitudeSquared() < 1e-6f)
+                isDuplicate = true;
+        }
+        if (isDuplicate)
+            continue;
+        points[pointCount++] = point;
+
+        /* 충돌을 생성한다 */
+        contacts.push_back(Contact());
+        Contact* newContact = &contacts.back();
+        newContact->bodies[0] = collider.body;
+        newContact->bodies[1] = nullptr;
+        newContact->normal = plane.normal;
+        newContact->contactPoint[0] = point;
+        newContact->penetration = -distance;
+        newContact->restitution = groundRestitution;
+        newContact->friction = friction;
+        newContact->featureID = i;
+        newContact->normalImpulseSum = 0.0f;
+        newContact->tangentImpulseSum1 = 0.0f;
+        newContact->tangentImpulseSum2 = 0.0f;
+
+        hasContacted = true;
+    }
+
+    return hasContacted;
+}
+
+bool CollisionDetector::sphereAndTriangle(
+    std::vector<Contact>& contacts,
+    const SphereCollider& sphere,
+    const TriangleMesh::Triangle& triangle,
+    unsigned int featureBase
+)
+{
+    /* 구의 중심과 가장 가까운 삼각형 위의 점을 찾는다 */
+    Vector3 center = sphere.body->getPosition();
+    Vector3 closestPoint = calcClosestPointOnTriangle(center, triangle.vertices);
+    Vector3 normal = center - closestPoint;
+    float distanceSquared = normal.magnitudeSquared();
+    if (distanceSquared >= sphere.radius*sphere.radius)
+        return false;
+
+    /* 중심이 삼각형 위에 놓였다면 면의 법선 방향으로 밀어낸다 */
+    float distance = sqrtf(distanceSquared);
+    if (distance > 1e-6f)
+        normal *= 1.0f / distance;
+    else
+        normal = triangle.normal;
+    if (isCoveredByNeighbor(triangle, normal))
+        return false;
+
+    /* 충돌 정보를 생성한다 */
+    contacts.push_back(Contact());
+    Contact* newContact = &contacts.back();
+    newContact->bodies[0] = sphere.body;
+    newContact->bodies[1] = nullptr;
+    newContact->normal = normal;
+    newContact->contactPoint[0] = center - normal * sphere.radius;
+    newContact->penetration = sphere.radius - distance;
+    newContact->restitution = groundRestitution;
+    newContact->friction = friction;
+    newContact->featureID = featureBase;
+    newContact->normalImpulseSum = 0.0f;
+    newContact->tangentImpulseSum1 = 0.0f;
+    newContact->tangentImpulseSum2 = 0.0f;
+
+    return true;
+}
+
+bool CollisionDetector::boxAndTriangle(
+    std::vector<Contact>& contacts,
+    const BoxCollider& box,
+    const TriangleMesh::Triangle& triangle,
+    unsigned int featureBase
+)
+{
+    /* 삼각형을 직육면체의 로컬 좌표계로 변환한다 */
+    Matrix4 boxTransform = box.body->getTransformMatrix();
+    Matrix4 worldToLocal = box.body->getInverseTransformMatrix();
+    Vector3 vertices[3];
+    for (int i = 0; i < 3; ++i)
+        vertices[i] = worldToLocal * triangle.vertices[i];
+    Vector3 edges[3] = {vertices[1] - vertices[0], vertices[2] - vertices[1], vertices[0] - vertices[2]};
+    Vector3 faceNormal = edges[0].cross(edges[1]);
+    faceNormal.normalize();
+    const Vector3& halfSize = box.halfSize;
+
+    /* 직육면체의 세 축, 삼각형의 법선, 직육면체와 삼각형의 모서리끼리의 외적 9 개를 검사한다.
+        겹침이 가장 작은 축과 그 축을 따라 직육면체를 밀어낼 방향 (로컬 좌표계) 을 찾는다 */
+    float minPenetration = FLT_MAX;
+    float minBiasedPenetration = FLT_MAX;
+    int minAxisIdx = -1;
+    Vector3 normal;
+    float facePenetration = 0.0f;
+    Vector3 faceDirection;
+    for (int axisIdx = 0; axisIdx < 13; ++axisIdx)
+    {
+        Vector3 axis;
+        if (axisIdx < 3)
+            axis = Vector3(axisIdx == 0 ? 1.0f : 0.0f, axisIdx == 1 ? 1.0f : 0.0f, axisIdx == 2 ? 1.0f : 0.0f);
+        else if (axisIdx == 3)
+            axis = faceNormal;
+        else
+        {
+            int boxAxis = (axisIdx - 4) / 3;
+            const Vector3& edge = edges[(axisIdx - 4) % 3];
+            axis = Vector3(boxAxis == 0 ? 1.0f : 0.0f, boxAxis == 1 ? 1.0f : 0.0f, boxAxis == 2 ? 1.0f : 0.0f).cross(edge);
+
+            /* 나란한 모서리의 외적은 축이 될 수 없다 */
+            float length = axis.magnitude();
+            if (length < 1e-4f * edge.magnitude())
+                continue;
+            axis *= 1.0f / length;
+        }
+
+        float radius = halfSize.x * fabsf(axis.x) + halfSize.y * fabsf(axis.y) + halfSize.z * fabsf(axis.z);
+        float projection0 = axis.dot(vertices[0]);
+        float projection1 = axis.dot(vertices[1]);
+        float projection2 = axis.dot(vertices[2]);
+        float triangleMin = fminf(projection0, fminf(projection1, projection2));
+        float triangleMax = fmaxf(projection0, fmaxf(projection1, projection2));
+
+        /* 분리축이 있다면 충돌이 없다 */
+        if (triangleMin > radius || triangleMax < -radius)
+            return false;
+
+        /* 축의 양의 방향과 음의 방향 중 덜 밀어내도 되는 쪽을 고른다 */
+        float penetration = triangleMax + radius;
+        Vector3 direction = axis;
+        if (radius - triangleMin < penetration)
+        {
+            penetration = radius - triangleMin;
+            direction = axis * -1.0f;
+        }
+
+        if (axisIdx == 3)
+        {
+            facePenetration = penetration;
+            faceDirection = direction;
+        }
+
+        /* 겹침이 거의 같다면 모서리 축보다 면 축을 고른다.
+            충돌점이 프레임마다 면과 모서리 사이를 오가지 않는다 */
+        float biasedPenetration = axisIdx < 4 ? penetration : penetration * 1.05f + 0.001f;
+        if (biasedPenetration < minBiasedPenetration)
+        {
+            minBiasedPenetration = biasedPenetration;
+            minPenetration = penetration;
+            minAxisIdx = axisIdx;
+            normal = direction;
+        }
+    }
+
+    if (minAxisIdx == -1)
+        return false;
+
+    /* 이웃 삼각형 쪽으로 밀어내는 축이라면 삼각형의 면 법선으로 밀어낸다 */
+    Vector3 worldNormal =
+        box.body->getAxis(0) * normal.x + box.body->getAxis(1) * normal.y + box.body->getAxis(2) * normal.z;
+    if (minAxisIdx != 3 && isCoveredByNeighbor(triangle, worldNormal))
+    {
+        minAxisIdx = 3;
+        minPenetration = facePenetration;
+        normal = faceDirection;
+        worldNormal =
+            box.body->getAxis(0) * normal.x + box.body->getAxis(1) * normal.y + box.body->getAxis(2) * normal.z;
+    }
+
+    /* 충돌점들 (로컬 좌표계) 과 각각의 깊이 */
+    Vector3 points[8];
+    float depths[8];
+    int pointCount = 0;
+    Vector3 polygon[8];
+    Vector3 clipped[8];
+    static const float faceSigns[4][2] = {{-1.0f, -1.0f}, {1.0f, -1.0f}, {1.0f, 1.0f}, {-1.0f, 1.0f}};
+
+    if (minAxisIdx == 3)
+    {
+        /* 삼각형이 기준면이다. 삼각형을 향한 직육면체의 면을 삼각형의 세 변으로 자른다 */
+        int faceAxis = 0;
+        for (int i = 1; i < 3; ++i)
+        {
+            if (fabsf(normal[i]) > fabsf(normal[faceAxis]))
+                faceAxis = i;
+        }
+        int axis1 = (faceAxis + 1) % 3;
+        int axis2 = (faceAxis + 2) % 3;
+        float faceSign = normal[faceAxis] > 0.0f ? -1.0f : 1.0f;
+        for (int i = 0; i < 4; ++i)
+        {
+            float vertex[3];
+            vertex[faceAxis] = faceSign * halfSize[faceAxis];
+            vertex[axis1] = faceSigns[i][0] * halfSize[axis1];
+            vertex[axis2] = faceSigns[i][1] * halfSize[axis2];
+            polygon[i] = Vector3(vertex[0], vertex[1], vertex[2]);
+        }
+
+        int count = 4;
+        for (int i = 0; i < 3 && count > 0; ++i)
+        {
+            Vector3 sideNormal = edges[i].cross(faceNormal);
+            count = clipPolygon(polygon, count, sideNormal, sideNormal.dot(vertices[i]), clipped);
+            for (int j = 0; j < count; ++j)
+                polygon[j] = clipped[j];
+        }
+
+        /* 삼각형 면 아래로 내려간 점만 남긴다 */
+        for (int i = 0; i < count; ++i)
+        {
+            float depth = normal.dot(vertices[0] - polygon[i]);
+            if (depth > 0.0f)
+            {
+                points[pointCount] = polygon[i];
+                depths[pointCount] = depth;
+                ++pointCount;
+            }
+        }
+    }
+    else if (minAxisIdx < 3)
+    {
+        /* 직육면체의 면이 기준면이다. 삼각형을 그 면의 네 변으로 자른다 */
+        int faceAxis = minAxisIdx;
+        float faceSign = normal[faceAxis] > 0.0f ? -1.0f : 1.0f;
+        for (int i = 0; i < 3; ++i)
+            polygon[i] = vertices[i];
+
+        int count = 3;
+        for (int i = 1; i < 3 && count > 0; ++i)
+        {
+            int sideAxis = (faceAxis + i) % 3;
+            for (int sign = -1; sign <= 1 && count > 0; sign += 2)
+            {
+                Vector3 sideNormal(
+                    sideAxis == 0 ? (float)sign : 0.0f,
+                    sideAxis == 1 ? (float)sign : 0.0f,
+                    sideAxis == 2 ? (float)sign : 0.0f
+                );
+                count = clipPolygon(polygon, count, sideNormal, halfSize[sideAxis], clipped);
+                for (int j = 0; j < count; ++j)
+                    polygon[j] = clipped[j];
+            }
+        }
+
+        /* 기준면 안쪽으로 들어온 점을 기준면 위로 옮겨 충돌점으로 삼는다 */
+        for (int i = 0; i < count; ++i)
+        {
+            float depth = halfSize[faceAxis] - faceSign * polygon[i][faceAxis];
+            if (depth > 0.0f)
+            {
+                float point[3] = {polygon[i].x, polygon[i].y, polygon[i].z};
+                point[faceAxis] = faceSign * halfSize[faceAxis];
+                points[pointCount] = Vector3(point[0], point[1], point[2]);
+                depths[pointCount] = depth;
+                ++pointCount;
+            }
+        }
+    }
+    else
+    {
+        /* 모서리끼리 닿았다. 삼각형 쪽을 향한 직육면체의 모서리와 삼각형의 모서리 사이의 가장 가까운 점 */
+        int boxAxis = (minAxisIdx - 4) / 3;
+        int edgeIdx = (minAxisIdx - 4) % 3;
+        float edgeStart[3], edgeEnd[3];
+        for (int i = 0; i < 3; ++i)
+        {
+            if (i == boxAxis)
+            {
+                edgeStart[i] = -halfSize[i];
+                edgeEnd[i] = halfSize[i];
+            }
+            else
+                edgeStart[i] = edgeEnd[i] = normal[i] > 0.0f ? -halfSize[i] : halfSize[i];
+        }
+        Vector3 edgeStartPoint(edgeStart[0], edgeStart[1], edgeStart[2]);
+        Vector3 edgeEndPoint(edgeEnd[0], edgeEnd[1], edgeEnd[2]);
+
+        float s, t;
+        calcClosestPointsOfSegments(
+            edgeStartPoint, edgeEndPoint, vertices[edgeIdx], vertices[(edgeIdx + 1) % 3], s, t
+        );
+        points[0] = edgeStartPoint + (edgeEndPoint - edgeStartPoint) * s;
+        depths[0] = minPenetration;
+        pointCount = 1;
+    }
+
+    /* 수치 오차로 잘라낸 뒤 남은 점이 없다면 삼각형 쪽으로 가장 깊은 꼭짓점을 사용한다 */
+    if (pointCount == 0)
+    {
+        points[0] = Vector3(
+            normal.x > 0.0f ? -halfSize.x : halfSize.x,
+            normal.y > 0.0f ? -halfSize.y : halfSize.y,
+            normal.z > 0.0f ? -halfSize.z : halfSize.z
+        );
+        depths[0] = minPenetration;
+        pointCount = 1;
+    }
+
+    for (int i = 0; i < pointCount; ++i)
+    {
+        /* 충돌 정보를 생성한다 */
+        contacts.push_back(Contact());
+        Contact* newContact = &contacts.back();
+        newContact->bodies[0] = box.body;
+        newContact->bodies[1] = nullptr;
+        newContact->normal = worldNormal;
+        newContact->contactPoint[0] = boxTransform * points[i];
+        newContact->penetration = depths[i];
+        newContact->restitution = groundRestitution;
+        newContact->friction = friction;
+        newContact->featureID = featureBase + i;
+        newContact->normalImpulseSum = 0.0f;
+        newContact->tangentImpulseSum1 = 0.0f;
+        newContact->tangentImpulseSum2 = 0.0f;
+    }
+
+    return true;
+}
+
+bool CollisionDetector::capsuleAndTriangle(
+    std::vector<Contact>& contacts,
+    const CapsuleCollider& capsule,
+    const TriangleMesh::Triangle& triangle,
+    unsigned int featureBase
+)
+{
+    Vector3 endpoints[2];
+    capsule.calcSegment(endpoints[0], endpoints[1]);
+    float radiusSquared = capsule.radius * capsule.radius;
+
+    /* 삼각형의 법선을 캡슐의 중심 쪽으로 돌린다 */
+    Vector3 faceNormal = triangle.normal;
+    if (faceNormal.dot(capsule.body->getPosition() - triangle.vertices[0]) < 0.0f)
+        faceNormal *= -1.0f;
+
+    /* 선분이 삼각형을 뚫고 지나갔다면 가장 가까운 점으로 법선을 정할 수 없다.
+        삼각형 뒤로 넘어간 끝점을 면의 법선 방향으로 밀어낸다 */
+    float distances[2] = {
+        faceNormal.dot(endpoints[0] - triangle.vertices[0]),
+        faceNormal.dot(endpoints[1] - triangle.vertices[0])
+    };
+    if ((distances[0] < 0.0f) != (distances[1] < 0.0f))
+    {
+        Vector3 crossing = endpoints[0] + (endpoints[1] - endpoints[0]) * (distances[0] / (distances[0] - distances[1]));
+        if ((calcClosestPointOnTriangle(crossing, triangle.vertices) - crossing).magnitudeSquared() < 1e-8f)
+        {
+            int deepIdx = distances[0] < 0.0f ? 0 : 1;
+
+            /* 충돌 정보를 생성한다 */
+            contacts.push_back(Contact());
+            Contact* newContact = &contacts.back();
+            newContact->bodies[0] = capsule.body;
+            newContact->bodies[1] = nullptr;
+            newContact->normal = faceNormal;
+            newContact->contactPoint[0] = endpoints[deepIdx] - faceNormal * capsule.radius;
+            newContact->penetration = capsule.radius - distances[deepIdx];
+            newContact->restitution = groundRestitution;
+            newContact->friction = friction;
+            newContact->featureID = featureBase;
+            newContact->normalImpulseSum = 0.0f;
+            newContact->tangentImpulseSum1 = 0.0f;
+            newContact->tangentImpulseSum2 = 0.0f;
+
+            return true;
+        }
+    }
+
+    /* 삼각형에 닿은 양 끝점과, 선분의 중간이 삼각형의 모서리에 가장 가깝다면 그 점을 충돌점으로 삼는다 */
+    Vector3 segmentPoints[3];
+    Vector3 trianglePoints[3];
+    int pointCount = 0;
+    for (int i = 0; i < 2; ++i)
+    {
+        Vector3 pointOnTriangle = calcClosestPointOnTriangle(endpoints[i], triangle.vertices);
+        if ((endpoints[i] - pointOnTriangle).magnitudeSquared() < radiusSquared)
+        {
+            segmentPoints[pointCount] = endpoints[i];
+            trianglePoints[pointCount] = pointOnTriangle;
+            ++pointCount;
+        }
+    }
+
+    float minDistanceSquared = FLT_MAX;
+    float closestParam = 0.0f;
+    Vector3 closestPointOnTriangle;
+    for (int i = 0; i < 3; ++i)
+    {
+        const Vector3& edgeStart = triangle.vertices[i];
+        const Vector3& edgeEnd = triangle.vertices[(i + 1) % 3];
+
+        float s, t;
+        float distanceSquared = calcClosestPointsOfSegments(endpoints[0], endpoints[1], edgeStart, edgeEnd, s, t);
+        if (distanceSquared < minDistanceSquared)
+        {
+            minDistanceSquared = distanceSquared;
+            closestParam = s;
+            closestPointOnTriangle = edgeStart + (edgeEnd - edgeStart) * t;
+        }
+    }
+    if (minDistanceSquared < radiusSquared && closestParam > 0.01f && closestParam < 0.99f)
+    {
+        segmentPoints[pointCount] = endpoints[0] + (endpoints[1] - endpoints[0]) * closestParam;
+        trianglePoints[pointCount] = closestPointOnTriangle;
+        ++pointCount;
+    }
+
+    bool hasContacted = false;
+    for (int i = 0; i < pointCount; ++i)
+    {
+        Vector3 normal = segmentPoints[i] - trianglePoints[i];
+        float distance = normal.magnitude();
+        if (distance > 1e-6f)
+            normal *= 1.0f / distance;
+        else
+            normal = faceNormal;
+        if (isCoveredByNeighbor(triangle, normal))
+            continue;
+
+        /* 충돌 정보를 생성한다 */
+        contacts.push_back(Contact());
+        Contact* newContact = &contacts.back();
+        newContact->bodies[0] = capsule.body;
+        newContact->bodies[1] = nullptr;
+        newContact->normal = normal;
+        newContact->contactPoint[0] = segmentPoints[i] - normal * capsule.radius;
+        newContact->penetration = capsule.radius - distance;
+        newContact->restitution = groundRestitution;
+        newContact->friction = friction;
+        newContact->featureID = featureBase + i;
+        newContact->normalImpulseSum = 0.0f;
+        newContact->tangentImpulseSum1 = 0.0f;
+        newContact->tangentImpulseSum2 = 0.0f;
+
+        hasContacted = true;
+    }
+
+    return hasContacted;
+}
+
+bool CollisionDetector::convexAndTriangle(
+    std::vector<Contact>& contacts,
+    const Collider& collider,
+    const TriangleMesh::Triangle& triangle,
+    unsigned int featureBase
+)
+{
+    /* 삼각형의 법선을 물체의 중심 쪽으로 돌린다 */
+    Vector3 faceNormal = triangle.normal;
+    if (faceNormal.dot(collider.body->getPosition() - triangle.vertices[0]) < 0.0f)
+        faceNormal *= -1.0f;
+
+    /* convexAndPlane 과 같이 면 안쪽으로 가장 깊은 점과 기울인 방향의 점들을 검사한다 */
+    Vector3 tangent1, tangent2;
+    Contact basis;
+    basis.normal = faceNormal;
+    basis.calcTangents(tangent1, tangent2);
+    tangent1.normalize();
+    tangent2.normalize();
+
+    const float tilt = 0.2f;
+    Vector3 down = faceNormal * -1.0f;
+    Vector3 directions[5] = {
+        down,
+        down + tangent1 * tilt,
+        down - tangent1 * tilt,
+        down + tangent2 * tilt,
+        down - tangent2 * tilt
+    };
+
+    Vector3 points[5];
+    int pointCount = 0;
+    for (int i = 0; i < 5; ++i)
+    {
+        Vector3 point = collider.support(directions[i]);
+        float distance = faceNormal.dot(point - triangle.vertices[0]);
+        if (distance >= 0.0f)
+        {
+            /* 가장 깊은 점도 면 위에 있다면 충돌이 없다 */
+            if (i == 0)
+                return false;
+            continue;
+        }
+
+        /* 면으로 사영한 점이 삼각형 밖이라면 이 삼각형에 닿은 점이 아니다 */
+        Vector3 projected = point - faceNormal * distance;
+        if ((calcClosestPointOnTriangle(projected, triangle.vertices) - projected).magnitudeSquared() > 1e-8f)
+            continue;
+
+        /* 같은 점을 두 번 넣지 않는다 */
+        bool isDuplicate = false;
+        for (int j = 0; j < pointCount; ++j)
+        {
+            if ((points[j] - point).magnitudeSquared() < 1e-6f)
+                isDuplicate = true;
+        }
+        if (isDuplicate)
+            continue;
+        points[pointCount++] = point;
+
+        /* 충돌 정보를 생성한다 */
+        contacts.push_back(Contact());
+        Contact* newContact = &contacts.back();
+        newContact->bodies[0] = collider.body;
+        newContact->bodies[1] = nullptr;
+        newContact->normal = faceNormal;
+        newContact->contactPoint[0] = point;
+        newContact->penetration = -distance;
+        newContact->restitution = groundRestitution;
+        newContact->friction = friction;
+        newContact->featureID = featureBase + i;
+        newContact->normalImpulseSum = 0.0f;
+        newContact->tangentImpulseSum1 = 0.0f;
+        newContact->tangentImpulseSum2 = 0.0f;
+    }
+
+    return pointCount > 0;
+}
+
+bool CollisionDetector::sphereAndHeightfield(
+    std::vector<Contact>& contacts,
+    const SphereCollider& sphere,
+    const HeightfieldCollider& heightfield
+)
+{
+    int minColumn, minRow, maxColumn, maxRow;
+    if (!heightfield.calcCellRange(sphere.calcAABB(), minColumn, minRow, maxColumn, maxRow))
+        return false;
+
+    /* 칸의 두 삼각형마다 충돌점 8 개 분량의 featureID 를 쓴다 */
+    Vector3 center = sphere.body->getPosition();
+    bool hasContacted = false;
+    TriangleMesh::Triangle triangle;
+    for (int row = minRow; row <= maxRow; ++row)
+    {
+        for (int column = minColumn; column <= maxColumn; ++column)
+        {
+            unsigned int cellIndex = row * (heightfield.columnCount - 1) + column;
+            for (int half = 0; half < 2; ++half)
+            {
+                /* 삼각형의 평면에서 반지름 이상 떨어져 있다면 이웃의 방향을 구하기 전에 걸러낸다 */
+                heightfield.calcTriangleFace(column, row, half, triangle);
+                if (fabsf(triangle.normal.dot(center - triangle.vertices[0])) >= sphere.radius)
+                    continue;
+
+                heightfield.calcNeighborDirections(column, row, half, triangle);
+                unsigned int featureBase = calcStaticFeatureBase(heightfieldCellTag, cellIndex * 2 + half);
+                if (sphereAndTriangle(contacts, sphere, triangle, featureBase))
+                    hasContacted = true;
+            }
+        }
+    }
+
+    return hasContacted;
+}
+
+bool CollisionDetector::boxAndHeightfield(
+    std::vector<Contact>& contacts,
+    const BoxCollider& box,
+    const HeightfieldCollider& heightfield
+)
+{
+    int minColumn, minRow, maxColumn, maxRow;
+    if (!heightfield.calcCellRange(box.calcAABB(), minColumn, minRow, maxColumn, maxRow))
+        return false;
+
+    /* 직육면체를 이루는 로컬 좌표계의 정점들 */
+    const Vector3& halfSize = box.halfSize;
+    Matrix4 boxTransform = box.body->getTransformMatrix();
+    bool hasContacted = false;
+    for (int i = 0; i < 8; ++i)
+    {
+        Vector3 vertex(
+            i & 1 ? halfSize.x : -halfSize.x,
+            i & 2 ? halfSize.y : -halfSize.y,
+            i & 4 ? halfSize.z : -halfSize.z
+        );
+        vertex = boxTransform * vertex;
+
+        /* 정점 바로 아래 삼각형의 평면과의 거리로 침투 깊이를 구한다 */
+        float height;
+        Vector3 normal;
+        if (!heightfield.calcHeightAt(vertex.x, vertex.z, height, normal) || vertex.y >= height)
+            continue;
+
+        /* 충돌을 생성한다. 꼭짓점은 칸에 속하지 않으므로 지형의 비워 둔 0 번 구간을 쓴다 */
+        contacts.push_back(Contact());
+        Contact* newContact = &contacts.back();
+        newContact->bodies[0] = box.body;
+        newContact->bodies[1] = nullptr;
+        newContact->normal = normal;
+        newContact->contactPoint[0] = vertex;
+        newContact->penetration = (height - vertex.y) * normal.y;
+        newContact->restitution = groundRestitution;
+        newContact->friction = friction;
+        newContact->featureID = (heightfieldCellTag << 24) | i;
+        newContact->normalImpulseSum = 0.0f;
+        newContact->tangentImpulseSum1 = 0.0f;
+        newContact->tangentImpulseSum2 = 0.0f;
+
+        hasContacted = true;
+    }
+
+    /* 봉우리처럼 직육면체 안으로 파고든 격자점은 가장 가까운 면의 바깥으로 밀어낸다 */
+    Matrix4 worldToLocal = box.body->getInverseTransformMatrix();
+    for (int row = minRow; row <= maxRow + 1; ++row)
+    {
+        for (int column = minColumn; column <= maxColumn + 1; ++column)
+        {
+            Vector3 point = heightfield.getVertex(column, row);
+            Vector3 local = worldToLocal * point;
+
+            int faceAxis = -1;
+            float penetration = FLT_MAX;
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                float depth = halfSize[axis] - fabsf(local[axis]);
+                if (depth <= 0.0f)
+                {
+                    faceAxis = -1;
+                    break;
+                }
+                if (depth < penetration)
+                {
+                    penetration = depth;
+                    faceAxis = axis;
+                }
+            }
+            if (faceAxis == -1)
+                continue;
+
+            /* 격자점이 가까운 면 쪽에서 반대쪽으로 직육면체를 민다 */
+            float sign = local[faceAxis] > 0.0f ? 1.0f : -1.0f;
+            Vector3 normal = box.body->getAxis(faceAxis) * -sign;
+            Vector3 pointOnFace(
+                faceAxis == 0 ? sign * halfSize.x : local.x,
+                faceAxis == 1 ? sign * halfSize.y : local.y,
+                faceAxis == 2 ? sign * halfSize.z : local.z
+            );
+
+            contacts.push_back(Contact());
+            Contact* newContact = &contacts.back();
+            newContact->bodies[0] = box.body;
+            newContact->bodies[1] = nullptr;
+            newContact->normal = normal;
+            newContact->contactPoint[0] = boxTransform * pointOnFace;
+            newContact->penetration = penetration;
+            newContact->restitution = groundRestitution;
+            newContact->friction = friction;
+            newContact->featureID = calcStaticFeatureBase(heightfieldPointTag, row * heightfield.columnCount + column);
+            newContact->normalImpulseSum = 0.0f;
+            newContact->tangentImpulseSum1 = 0.0f;
+            newContact->tangentImpulseSum2 = 0.0f;
+
+            hasContacted = true;
+        }
+    }
+
+    return hasContacted;
+}
+
+bool CollisionDetector::convexAndHeightfield(
+    std::vector<Contact>& contacts,
+    const Collider& collider,
+    const HeightfieldCollider& heightfield
+)
+{
+    int minColumn, minRow, maxColumn, maxRow;
+    if (!heightfield.calcCellRange(collider.calcAABB(), minColumn, minRow, maxColumn, maxRow))
+        return false;
+
+    bool hasContacted = false;
+    TriangleMesh::Triangle triangle;
+    for (int row = minRow; row <= maxRow; ++row)
+    {
+        for (int column = minColumn; column <= maxColumn; ++column)
+        {
+            unsigned int cellIndex = row * (heightfield.columnCount - 1) + column;
+            for (int half = 0; half < 2; ++half)
+            {
+                heightfield.getTriangle(column, row, half, triangle);
+                unsigned int featureBase = calcStaticFeatureBase(heightfieldCellTag, cellIndex * 2 + half);
+                bool isContacted = collider.geometry == CAPSULE
+                    ? capsuleAndTriangle(contacts, static_cast<const CapsuleCollider&>(collider), triangle, featureBase)
+                    : convexAndTriangle(contacts, collider, triangle, featureBase);
+                if (isContacted)
+                    hasContacted = true;
+            }
+        }
+    }
+
+    return hasContacted;
+}
+
+float CollisionDetector::rayAndSphere(
+    const Vector3& origin,
+    const Vector3& direction,
+    const SphereCollider& sphere
+)
+{
+    Vector3 originToSphere = sphere.body->getPosition() - origin;
+    float originToSphereProjected = originToSphere.dot(direction);
+    float orthogonalDistanceSquared =
+        originToSphere.magnitudeSquared() - originToSphereProjected * originToSphereProjected;
+    if (orthogonalDistanceSquared > sphere.radius*sphere.radius)
+        return -1.0f;
+
+    float t1 = sqrtf(sphere.radius*sphere.radius - orthogonalDistanceSquared);
+    float hitPointDistance = originToSphereProjected - t1;
+
+    return hitPointDistance;
+}
+
+float CollisionDetector::rayAndBox(
     const Vector3& origin,
     const Vector3& direction,
     const BoxCollider& box
@@ -362,10 +2077,12 @@ float CollisionDetector::rayAndBox(
     Vector3 originToBox = box.body->getPosition() - origin;
     float tNearMax = 0.0f;     // 가까운 평면과 ray 의 원점 사이의 거리 최댓값
     float tFarMin = FLT_MAX;  // 먼 평면과 ray 의 원점 사이의 거리 최솟값
-    
+
+    /* 월드 -> 로컬 변환 행렬의 회전 부분의 각 행이 직육면체의 축이다 */
+    Matrix4 worldToLocal = box.body->getInverseTransformMatrix();
     for (int i = 0; i < 3; ++i)
     {
-        Vector3 axis = box.body->getAxis(i);
+        Vector3 axis(worldToLocal.entries[4*i], worldToLocal.entries[4*i + 1], worldToLocal.entries[4*i + 2]);
         float originToBoxProjected = axis.dot(originToBox);
         float rayDirectionProjected = axis.dot(direction);
 
@@ -399,22 +2116,461 @@ float CollisionDetector::rayAndBox(
     return tNearMax;
 }
 
-float CollisionDetector::calcPenetration(const BoxCollider& box1, const BoxCollider& box2, const Vector3& axis)
+float CollisionDetector::rayAndCapsule(
+    const Vector3& origin,
+    const Vector3& direction,
+    const CapsuleCollider& capsule
+)
+{
+    Vector3 start, end;
+    capsule.calcSegment(start, end);
+    return calcRayAndCapsule(origin, direction, start, end, capsule.radius);
+}
+
+float CollisionDetector::rayAndCylinder(
+    const Vector3& origin,
+    const Vector3& direction,
+    const CylinderCollider& cylinder
+)
 {
-    /* 두 박스의 중심 간 거리를 계산한다 */
-    Vector3 centerToCenter = box2.body->getPosition() - box1.body->getPosition();
-    float projectedCenterToCenter = abs(centerToCenter.dot(axis));
+    /* 축 방향의 두 평면 사이 구간과 무한히 긴 원기둥 안의 구간이 겹치는 부분을 찾는다 */
+    Vector3 axis = cylinder.body->getAxis(1);
+    Vector3 originToCylinder = origin - cylinder.body->getPosition();
+    float originProjected = axis.dot(originToCylinder);
+    float directionProjected = axis.dot(direction);
+    float tNear = 0.0f;
+    float tFar = FLT_MAX;
+
+    /* 윗면과 밑면 사이 */
+    if (fabsf(directionProjected) > 0.001f)
+    {
+        float t1 = (-cylinder.halfHeight - originProjected) / directionProjected;
+        float t2 = (cylinder.halfHeight - originProjected) / directionProjected;
+        if (t1 > t2)
+        {
+            float temp = t1;
+            t1 = t2;
+            t2 = temp;
+        }
+        tNear = fmaxf(tNear, t1);
+        tFar = fminf(tFar, t2);
+    }
+    else if (fabsf(originProjected) > cylinder.halfHeight)
+        return -1.0f;
+
+    /* 옆면 안쪽. 축에 수직인 성분만으로 이차방정식을 푼다 */
+    Vector3 originRadial = originToCylinder - axis * originProjected;
+    Vector3 directionRadial = direction - axis * directionProjected;
+    float a = directionRadial.magnitudeSquared();
+    float b = originRadial.dot(directionRadial);
+    float c = originRadial.magnitudeSquared() - cylinder.radius*cylinder.radius;
+    if (a > 1e-6f)
+    {
+        float discriminant = b*b - a*c;
+        if (discriminant < 0.0f)
+            return -1.0f;
+
+        float root = sqrtf(discriminant);
+        tNear = fmaxf(tNear, (-b - root) / a);
+        tFar = fminf(tFar, (-b + root) / a);
+    }
+    else if (c > 0.0f)
+        return -1.0f;
+
+    if (tFar < tNear)
+        return -1.0f;
+
+    return tNear;
+}
+
+float CollisionDetector::sweptSphereAndCapsule(
+    const Vector3& start,
+    const Vector3& motion,
+    float radius,
+    const CapsuleCollider& capsule,
+    Vector3& normal,
+    Vector3& point
+)
+{
+    Vector3 segmentStart, segmentEnd;
+    capsule.calcSegment(segmentStart, segmentEnd);
+
+    float fraction = calcRayAndCapsule(start, motion, segmentStart, segmentEnd, radius + capsule.radius);
+    if (fraction < 0.0f || fraction > 1.0f)
+        return -1.0f;
+
+    /* 부딪힌 순간의 구의 중심에서 가장 가까운 선분 위의 점으로 법선과 충돌점을 구한다 */
+    Vector3 center = start + motion * fraction;
+    Vector3 segmentPoint = segmentStart + (segmentEnd - segmentStart)
+        * calcClosestPointOnSegment(center, segmentStart, segmentEnd);
+    normal = center - segmentPoint;
+    normal.normalize();
+    point = segmentPoint + normal * capsule.radius;
+    return fraction;
+}
+
+float CollisionDetector::sweptSphereAndPlane(
+    const Vector3& start,
+    const Vector3& motion,
+    float radius,
+    const PlaneCollider& plane,
+    Vector3& normal
+)
+{
+    /* 시작과 끝 위치에서 구의 표면이 평면으로부터 떨어진 거리 */
+    float startDistance = plane.normal.dot(start) - plane.offset - radius;
+    float endDistance = plane.normal.dot(start + motion) - plane.offset - radius;
+    if (startDistance < 0.0f || endDistance >= 0.0f)
+        return -1.0f;
+
+    normal = plane.normal;
+    return startDistance / (startDistance - endDistance);
+}
+
+float CollisionDetector::sweptSphereAndHeightfield(
+    const Vector3& start,
+    const Vector3& motion,
+    float radius,
+    const HeightfieldCollider& heightfield,
+    Vector3& normal
+)
+{
+    /* 비율 t 에서 구의 표면이 중심 아래 삼각형의 평면으로부터 떨어진 거리. 격자 밖이라면 FLT_MAX 이다 */
+    auto calcGap = [&](float t, Vector3& gapNormal) {
+        Vector3 center = start + motion * t;
+        float height;
+        if (!heightfield.calcHeightAt(center.x, center.z, height, gapNormal))
+            return FLT_MAX;
+        return (center.y - height) * gapNormal.y - radius;
+    };
+
+    /* 이미 닿아 있다면 이산 충돌 검사에 맡긴다 */
+    Vector3 gapNormal;
+    if (calcGap(0.0f, gapNormal) < 0.0f)
+        return -1.0f;
+
+    /* 반지름의 절반 간격으로 경로를 따라가며 처음으로 파고드는 구간을 찾는다 */
+    int stepCount = (int)ceilf(motion.magnitude() / (radius * 0.5f));
+    stepCount = stepCount < 1 ? 1 : (stepCount > 64 ? 64 : stepCount);
+    float prevT = 0.0f;
+    for (int step = 1; step <= stepCount; ++step)
+    {
+        float t = (float)step / stepCount;
+        if (calcGap(t, gapNormal) >= 0.0f)
+        {
+            prevT = t;
+            continue;
+        }
+
+        /* 구간을 이분법으로 좁히고 아직 닿지 않은 쪽의 비율을 반환한다 */
+        for (int i = 0; i < 10; ++i)
+        {
+            float middle = (prevT + t) * 0.5f;
+            if (calcGap(middle, gapNormal) >= 0.0f)
+                prevT = middle;
+            else
+                t = middle;
+        }
+        calcGap(t, normal);
+        return prevT;
+    }
+
+    return -1.0f;
+}
+
+float CollisionDetector::sweptSphereAndSphere(
+    const Vector3& start,
+    const Vector3& motion,
+    float radius,
+    const SphereCollider& sphere,
+    Vector3& normal
+)
+{
+    /* |start + motion * t - center| = radiusSum 을 만족하는 가장 작은 t 를 구한다 */
+    Vector3 centerToStart = start - sphere.body->getPosition();
+    float radiusSum = radius + sphere.radius;
+
+    float a = motion.magnitudeSquared();
+    float b = centerToStart.dot(motion);
+    float c = centerToStart.magnitudeSquared() - radiusSum*radiusSum;
+    /* 처음부터 겹쳐 있거나 멀어지는 중이라면 이산 충돌 검출에 맡긴다 */
+    if (c < 0.0f || b >= 0.0f || a < FLT_EPSILON)
+        return -1.0f;
+
+    float discriminant = b*b - a*c;
+    if (discriminant < 0.0f)
+        return -1.0f;
+
+    float fraction = (-b - sqrtf(discriminant)) / a;
+    if (fraction > 1.0f)
+        return -1.0f;
+
+    normal = centerToStart + motion * fraction;
+    normal.normalize();
+    return fraction;
+}
+
+float CollisionDetector::sweptSphereAndBox(
+    const Vector3& start,
+    const Vector3& motion,
+    float radius,
+    const BoxCollider& box,
+    Vector3& normal,
+    Vector3& point
+)
+{
+    /* 경로를 직육면체의 로컬 좌표계로 변환한다 */
+    Matrix4 localToWorld = box.body->getTransformMatrix();
+    Matrix4 worldToLocal = box.body->getInverseTransformMatrix();
+    Vector3 startLocal = worldToLocal * start;
+    Vector3 motionLocal = worldToLocal * (start + motion) - startLocal;
+
+    /* 처음부터 겹쳐 있다면 이산 충돌 검출에 맡긴다 */
+    Vector3 closestPoint = calcClosestPointOnBox(startLocal, box.halfSize);
+    if ((startLocal - closestPoint).magnitudeSquared() < radius*radius)
+        return -1.0f;
+
+    /* 반지름만큼 부풀린 직육면체는 구가 닿을 수 있는 영역을 모두 포함하므로
+        선분이 그 안에 들어가는 시각이 충돌 시각의 하한이 된다 (slab 방법) */
+    float tNear = 0.0f;
+    float tFar = 1.0f;
+    for (int i = 0; i < 3; ++i)
+    {
+        float expandedHalfSize = box.halfSize[i] + radius;
+        if (fabsf(motionLocal[i]) < FLT_EPSILON)
+        {
+            if (fabsf(startLocal[i]) > expandedHalfSize)
+                return -1.0f;
+            continue;
+        }
+
+        float t1 = (-expandedHalfSize - startLocal[i]) / motionLocal[i];
+        float t2 = (expandedHalfSize - startLocal[i]) / motionLocal[i];
+        if (t1 > t2)
+        {
+            float temp = t1;
+            t1 = t2;
+            t2 = temp;
+        }
+        if (t1 > tNear)
+            tNear = t1;
+        if (t2 < tFar)
+            tFar = t2;
+        if (tNear > tFar)
+            return -1.0f;
+    }
+
+    /* 면 근처에서는 하한이 곧 충돌 시각이지만 모서리와 꼭짓점 근처에서는 조금 이르다.
+        구와 직육면체 사이의 거리만큼씩 전진하며 실제로 닿는 시각을 찾는다 */
+    float motionLength = motionLocal.magnitude();
+    float fraction = tNear;
+    for (int iteration = 0; iteration < 16; ++iteration)
+    {
+        Vector3 center = startLocal + motionLocal * fraction;
+        closestPoint = calcClosestPointOnBox(center, box.halfSize);
+        float distance = (center - closestPoint).magnitude() - radius;
+        if (distance < 1e-4f)
+            break;
+
+        fraction += distance / motionLength;
+        if (fraction > tFar)
+            return -1.0f;
+    }
+
+    Vector3 center = startLocal + motionLocal * fraction;
+    Vector3 normalLocal = center - closestPoint;
+    normalLocal.normalize();
 
-    /* 두 박스를 주어진 축에 사영시킨 길이의 합을 계산한다 */
-    float projectedSum = abs((box1.body->getAxis(0) * box1.halfSize.x).dot(axis))
-        + abs((box1.body->getAxis(1) * box1.halfSize.y).dot(axis))
-        + abs((box1.body->getAxis(2) * box1.halfSize.z).dot(axis))
-        + abs((box2.body->getAxis(0) * box2.halfSize.x).dot(axis))
-        + abs((box2.body->getAxis(1) * box2.halfSize.y).dot(axis))
-        + abs((box2.body->getAxis(2) * box2.halfSize.z).dot(axis));
+    /* 법선과 충돌점을 월드 좌표계로 변환한다 */
+    point = localToWorld * closestPoint;
+    normal = localToWorld * (closestPoint + normalLocal) - point;
+    return fraction;
+}
+
+float CollisionDetector::calcPenetration(const BoxPairProjection& projection, int axisIdx)
+{
+    const float (&halfSize1)[3] = projection.halfSize1;
+    const float (&halfSize2)[3] = projection.halfSize2;
+    const float (&rotation)[3][3] = projection.rotation;
+    const float (&absRotation)[3][3] = projection.absRotation;
 
     /* "사영시킨 길이의 합 - 중심 간 거리" 가 겹친 정도이다 */
-    return projectedSum - projectedCenterToCenter;
+    if (axisIdx < 3) // box1 의 축
+    {
+        int i = axisIdx;
+        float projectedSum = halfSize1[i]
+            + halfSize2[0] * absRotation[i][0] + halfSize2[1] * absRotation[i][1] + halfSize2[2] * absRotation[i][2];
+        return projectedSum - fabsf(projection.distance1[i]);
+    }
+    if (axisIdx < 6) // box2 의 축
+    {
+        int j = axisIdx - 3;
+        float projectedSum = halfSize2[j]
+            + halfSize1[0] * absRotation[0][j] + halfSize1[1] * absRotation[1][j] + halfSize1[2] * absRotation[2][j];
+        return projectedSum - fabsf(projection.distance2[j]);
+    }
+
+    /* box1 의 i 축과 box2 의 j 축의 외적. 두 축이 평행하면 길이가 0 이 되어 방향을 정할 수 없다 */
+    int i = (axisIdx - 6) / 3;
+    int j = (axisIdx - 6) % 3;
+    float lengthSquared = 1.0f - rotation[i][j] * rotation[i][j];
+    if (lengthSquared < 1e-6f)
+        return FLT_MAX;
+
+    /* 외적 축에 사영한 값들을 box1 의 좌표계에서 구한다. 축의 길이로 나눠 정규화한 축의 값으로 바꾼다 */
+    int i1 = (i + 1) % 3, i2 = (i + 2) % 3;
+    int j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+    float projectedSum = halfSize1[i1] * absRotation[i2][j] + halfSize1[i2] * absRotation[i1][j]
+        + halfSize2[j1] * absRotation[i][j2] + halfSize2[j2] * absRotation[i][j1];
+    float distance = fabsf(projection.distance1[i2] * rotation[i1][j] - projection.distance1[i1] * rotation[i2][j]);
+    return (projectedSum - distance) / sqrtf(lengthSquared);
+}
+
+int CollisionDetector::clipBoxFaces(
+    std::vector<Contact>& contacts,
+    const BoxCollider& box1,
+    const BoxCollider& box2,
+    int minAxisIdx,
+    const Vector3& normal
+)
+{
+    /* 기준 면을 가진 직육면체와 그 면에 닿은 직육면체 */
+    const BoxCollider& reference = minAxisIdx < 3 ? box1 : box2;
+    const BoxCollider& incident = minAxisIdx < 3 ? box2 : box1;
+    int referenceAxis = minAxisIdx % 3;
+
+    /* 기준 면의 바깥 법선. normal 은 box2 에서 box1 을 향한다 */
+    Vector3 faceNormal = minAxisIdx < 3 ? normal * -1.0f : normal;
+    Vector3 referenceCenter = reference.body->getPosition();
+    float faceOffset = faceNormal.dot(referenceCenter) + reference.halfSize[referenceAxis];
+
+    /* 기준 면의 법선과 가장 반대를 향하는 면을 incident face 로 고른다 */
+    int incidentAxis = 0;
+    float incidentSign = 1.0f;
+    float maxAlignment = -1.0f;
+    for (int i = 0; i < 3; ++i)
+    {
+        float alignment = incident.axes[i].dot(faceNormal);
+        if (fabsf(alignment) > maxAlignment)
+        {
+            maxAlignment = fabsf(alignment);
+            incidentAxis = i;
+            incidentSign = alignment > 0.0f ? -1.0f : 1.0f;
+        }
+    }
+
+    /* incident face 의 네 정점을 둘레를 따라 만든다 */
+    static const float cornerSigns[4][2] = {{1.0f, 1.0f}, {-1.0f, 1.0f}, {-1.0f, -1.0f}, {1.0f, -1.0f}};
+    Matrix4 incidentTransform = incident.body->getTransformMatrix();
+    Vector3 faceVertices[4];
+    unsigned int vertexSignBits[4];
+    for (int i = 0; i < 4; ++i)
+    {
+        /* 면의 법선 방향 성분과 면 위의 두 성분. (incidentAxis + 1) % 3, (incidentAxis + 2) % 3 축 순서이다 */
+        float normalCoordinate = incidentSign * incident.halfSize[incidentAxis];
+        float coordinate1 = cornerSigns[i][0] * incident.halfSize[(incidentAxis + 1) % 3];
+        float coordinate2 = cornerSigns[i][1] * incident.halfSize[(incidentAxis + 2) % 3];
+        Vector3 vertex;
+        switch (incidentAxis)
+        {
+        case 0:
+            vertex = Vector3(normalCoordinate, coordinate1, coordinate2);
+            break;
+
+        case 1:
+            vertex = Vector3(coordinate2, normalCoordinate, coordinate1);
+            break;
+
+        default:
+            vertex = Vector3(coordinate1, coordinate2, normalCoordinate);
+            break;
+        }
+        vertexSignBits[i] = calcVertexSignBits(vertex);
+        faceVertices[i] = incidentTransform * vertex;
+    }
+
+    /* 기준 면의 네 옆면으로 자른다. 사각형을 네 번 자르면 정점은 8 개를 넘지 않는다.
+        incident face 의 정점은 부호 비트 (0 ~ 7) 를, 옆면 안으로 들어오며 생긴 점은 8 + 옆면 번호를 특징 번호로 갖는다 */
+    Vector3 polygon[9];
+    Vector3 clipped[9];
+    unsigned int polygonFeatures[9];
+    unsigned int clippedFeatures[9];
+    int count = 4;
+    for (int i = 0; i < 4; ++i)
+    {
+        polygon[i] = faceVertices[i];
+        polygonFeatures[i] = vertexSignBits[i];
+    }
+
+    int sideAxes[2] = {(referenceAxis + 1) % 3, (referenceAxis + 2) % 3};
+    for (int i = 0; i < 4 && count > 0; ++i)
+    {
+        int sideAxis = sideAxes[i / 2];
+        Vector3 sideNormal = reference.axes[sideAxis] * (i % 2 == 0 ? 1.0f : -1.0f);
+        float sideOffset = sideNormal.dot(referenceCenter) + reference.halfSize[sideAxis];
+
+        count = clipPolygon(polygon, polygonFeatures, count, sideNormal, sideOffset, 8 + i, clipped, clippedFeatures);
+        for (int j = 0; j < count; ++j)
+        {
+            polygon[j] = clipped[j];
+            polygonFeatures[j] = clippedFeatures[j];
+        }
+    }
+
+    /* 기준 면 아래로 들어간 점만 남긴다 */
+    Vector3 points[8];
+    float depths[8];
+    unsigned int pointFeatures[8];
+    int pointCount = 0;
+    for (int i = 0; i < count; ++i)
+    {
+        float depth = faceOffset - faceNormal.dot(polygon[i]);
+        if (depth > 0.0f)
+        {
+            points[pointCount] = polygon[i];
+            depths[pointCount] = depth;
+            pointFeatures[pointCount] = polygonFeatures[i];
+            ++pointCount;
+        }
+    }
+    if (pointCount == 0)
+        return 0;
+
+    int selected[4] = {0, 1, 2, 3};
+    if (pointCount > 4)
+    {
+        pointCount = reduceContactPoints(
+            points, pointCount, reference.axes[sideAxes[0]], reference.axes[sideAxes[1]], selected
+        );
+    }
+
+    /* 기준 면과 incident face 로 충돌점의 특징을 구분한다 */
+    unsigned int faceFeature = minAxisIdx | ((incidentAxis * 2 + (incidentSign < 0.0f ? 1 : 0)) << 4);
+    for (int i = 0; i < pointCount; ++i)
+    {
+        const Vector3& point = points[selected[i]];
+        float depth = depths[selected[i]];
+        unsigned int pointFeature = pointFeatures[selected[i]];
+
+        /* 충돌 정보를 생성한다. 기준 면 위의 점은 incident face 의 점을 기준 면으로 올린 것이다 */
+        Vector3 pointOnReference = point + faceNormal * depth;
+        contacts.push_back(Contact());
+        Contact* newContact = &contacts.back();
+        newContact->bodies[0] = box1.body;
+        newContact->bodies[1] = box2.body;
+        newContact->normal = normal;
+        newContact->contactPoint[0] = minAxisIdx < 3 ? pointOnReference : point;
+        newContact->contactPoint[1] = minAxisIdx < 3 ? point : pointOnReference;
+        newContact->penetration = depth;
+        newContact->restitution = objectRestitution;
+        newContact->friction = friction;
+        newContact->featureID = faceFeature | (pointFeature << 8);
+        newContact->normalImpulseSum = 0.0f;
+        newContact->tangentImpulseSum1 = 0.0f;
+        newContact->tangentImpulseSum2 = 0.0f;
+    }
+
+    return pointCount;
 }
 
 void CollisionDetector::calcContactPointOnPlane(
@@ -425,44 +2581,47 @@ void CollisionDetector::calcContactPointOnPlane(
 )
 {
     /* 충돌 정점 */
-    Vector3* contactPoint1;
-    Vector3* contactPoint2;
+    Vector3& contactPoint1 = contact->contactPoint[0];
+    Vector3& contactPoint2 = contact->contactPoint[1];
 
     if (minAxisIdx < 3) // 충돌면이 box1 의 면일 때
     {
-        contactPoint2 = new Vector3(box2.halfSize.x, box2.halfSize.y, box2.halfSize.z);
+        contactPoint2 = Vector3(box2.halfSize.x, box2.halfSize.y, box2.halfSize.z);
+
+        if (box2.axes[0].dot(contact->normal) < 0)
+            contactPoint2.x *= -1.0f;
+        if (box2.axes[1].dot(contact->normal) < 0)
+            contactPoint2.y *= -1.0f;
+        if (box2.axes[2].dot(contact->normal) < 0)
+            contactPoint2.z *= -1.0f;
 
-        if (box2.body->getAxis(0).dot(contact->normal) < 0)
-            contactPoint2->x *= -1.0f;
-        if (box2.body->getAxis(1).dot(contact->normal) < 0)
-            contactPoint2->y *= -1.0f;
-        if (box2.body->getAxis(2).dot(contact->normal) < 0)
-            contactPoint2->z *= -1.0f;
+        /* 충돌면의 축과 box2 의 정점으로 특징을 구분한다 */
+        contact->featureID = minAxisIdx | (calcVertexSignBits(contactPoint2) << 4);
 
         /* 월드 좌표로 변환한다 */
-        *contactPoint2 = box2.body->getTransformMatrix() * (*contactPoint2);
+        contactPoint2 = box2.body->getTransformMatrix() * contactPoint2;
 
-        contactPoint1 = new Vector3(*contactPoint2 - contact->normal * contact->penetration);
+        contactPoint1 = contactPoint2 - contact->normal * contact->penetration;
     }
     else // 충돌면이 box2 의 면일 때
     {
-        contactPoint1 = new Vector3(box1.halfSize.x, box1.halfSize.y, box1.halfSize.z);
+        contactPoint1 = Vector3(box1.halfSize.x, box1.halfSize.y, box1.halfSize.z);
 
-        if (box1.body->getAxis(0).dot(contact->normal) > 0)
-            contactPoint1->x *= -1.0f;
-        if (box1.body->getAxis(1).dot(contact->normal) > 0)
-            contactPoint1->y *= -1.0f;
-        if (box1.body->getAxis(2).dot(contact->normal) > 0)
-            contactPoint1->z *= -1.0f;
+        if (box1.axes[0].dot(contact->normal) > 0)
+            contactPoint1.x *= -1.0f;
+        if (box1.axes[1].dot(contact->normal) > 0)
+            contactPoint1.y *= -1.0f;
+        if (box1.axes[2].dot(contact->normal) > 0)
+            contactPoint1.z *= -1.0f;
+
+        /* 충돌면의 축과 box1 의 정점으로 특징을 구분한다 */
+        contact->featureID = minAxisIdx | (calcVertexSignBits(contactPoint1) << 4);
 
         /* 월드 좌표로 변환한다 */
-        *contactPoint1 = box1.body->getTransformMatrix() * (*contactPoint1);
+        contactPoint1 = box1.body->getTransformMatrix() * contactPoint1;
 
-        contactPoint2 = new Vector3(*contactPoint1 - contact->normal * contact->penetration);
+        contactPoint2 = contactPoint1 - contact->normal * contact->penetration;
     }
-
-    contact->contactPoint[0] = contactPoint1;
-    contact->contactPoint[1] = contactPoint2;
 }
 
 void CollisionDetector::calcContactPointOnLine(
@@ -476,18 +2635,18 @@ void CollisionDetector::calcContactPointOnLine(
     Vector3 vertexOne(box1.halfSize.x, box1.halfSize.y, box1.halfSize.z);
     Vector3 vertexTwo(box2.halfSize.x, box2.halfSize.y, box2.halfSize.z);
 
-    if (box1.body->getAxis(0).dot(contact->normal) > 0)
+    if (box1.axes[0].dot(contact->normal) > 0)
         vertexOne.x *= -1.0f;
-    if (box1.body->getAxis(1).dot(contact->normal) > 0)
+    if (box1.axes[1].dot(contact->normal) > 0)
         vertexOne.y *= -1.0f;
-    if (box1.body->getAxis(2).dot(contact->normal) > 0)
+    if (box1.axes[2].dot(contact->normal) > 0)
         vertexOne.z *= -1.0f;
 
-    if (box2.body->getAxis(0).dot(contact->normal) < 0)
+    if (box2.axes[0].dot(contact->normal) < 0)
         vertexTwo.x *= -1.0f;
-    if (box2.body->getAxis(1).dot(contact->normal) < 0)
+    if (box2.axes[1].dot(contact->normal) < 0)
         vertexTwo.y *= -1.0f;
-    if (box2.body->getAxis(2).dot(contact->normal) < 0)
+    if (box2.axes[2].dot(contact->normal) < 0)
         vertexTwo.z *= -1.0f;
 
     /* 변의 방향을 찾는다 */
@@ -496,65 +2655,65 @@ void CollisionDetector::calcContactPointOnLine(
     switch (minAxisIdx)
     {
     case 6: // box1 의 x 축 X box2 의 x 축
-        directionOne = box1.body->getAxis(0);
+        directionOne = box1.axes[0];
         if (vertexOne.x > 0) directionOne *= -1.0f;
-        directionTwo = box2.body->getAxis(0);
+        directionTwo = box2.axes[0];
         if (vertexTwo.x > 0) directionTwo *= -1.0f;
         break;
 
     case 7: // box1 의 x 축 X box2 의 y 축
-        directionOne = box1.body->getAxis(0);
+        directionOne = box1.axes[0];
         if (vertexOne.x > 0) directionOne *= -1.0f;
-        directionTwo = box2.body->getAxis(1);
+        directionTwo = box2.axes[1];
         if (vertexTwo.y > 0) directionTwo *= -1.0f;
         break;
 
     case 8: // box1 의 x 축 X box2 의 z 축
-        directionOne = box1.body->getAxis(0);
+        directionOne = box1.axes[0];
         if (vertexOne.x > 0) directionOne *= -1.0f;
-        directionTwo = box2.body->getAxis(2);
+        directionTwo = box2.axes[2];
         if (vertexTwo.z > 0) directionTwo *= -1.0f;
         break;
 
     case 9: // box1 의 y 축 X box2 의 x 축
-        directionOne = box1.body->getAxis(1);
+        directionOne = box1.axes[1];
         if (vertexOne.y > 0) directionOne *= -1.0f;
-        directionTwo = box2.body->getAxis(0);
+        directionTwo = box2.axes[0];
         if (vertexTwo.x > 0) directionTwo *= -1.0f;
         break;
 
     case 10: // box1 의 y 축 X box2 의 y 축
-        directionOne = box1.body->getAxis(1);
+        directionOne = box1.axes[1];
         if (vertexOne.y > 0) directionOne *= -1.0f;
-        directionTwo = box2.body->getAxis(1);
+        directionTwo = box2.axes[1];
         if (vertexTwo.y > 0) directionTwo *= -1.0f;
         break;
     
     case 11: // box1 의 y 축 X box2 의 z 축
-        directionOne = box1.body->getAxis(1);
+        directionOne = box1.axes[1];
         if (vertexOne.y > 0) directionOne *= -1.0f;
-        directionTwo = box2.body->getAxis(2);
+        directionTwo = box2.axes[2];
         if (vertexTwo.z > 0) directionTwo *= -1.0f;
         break;
     
     case 12: // box1 의 z 축 X box2 의 x 축
-        directionOne = box1.body->getAxis(2);
+        directionOne = box1.axes[2];
         if (vertexOne.z > 0) directionOne *= -1.0f;
-        directionTwo = box2.body->getAxis(0);
+        directionTwo = box2.axes[0];
         if (vertexTwo.x > 0) directionTwo *= -1.0f;
         break;
     
     case 13: // box1 의 z 축 X box2 의 y 축
-        directionOne = box1.body->getAxis(2);
+        directionOne = box1.axes[2];
         if (vertexOne.z > 0) directionOne *= -1.0f;
-        directionTwo = box2.body->getAxis(1);
+        directionTwo = box2.axes[1];
         if (vertexTwo.y > 0) directionTwo *= -1.0f;
         break;
     
     case 14: // box1 의 z 축 X box2 의 z 축
-        directionOne = box1.body->getAxis(2);
+        directionOne = box1.axes[2];
         if (vertexOne.z > 0) directionOne *= -1.0f;
-        directionTwo = box2.body->getAxis(2);
+        directionTwo = box2.axes[2];
         if (vertexTwo.z > 0) directionTwo *= -1.0f;
         break;
     
@@ -562,19 +2721,344 @@ void CollisionDetector::calcContactPointOnLine(
         break;
     }
 
+    /* 두 변의 방향 축과 변 위의 정점으로 특징을 구분한다 */
+    contact->featureID = minAxisIdx
+        | (calcVertexSignBits(vertexOne) << 4)
+        | (calcVertexSignBits(vertexTwo) << 7);
+
     /* 정점을 월드 좌표계로 변환한다 */
     vertexOne = box1.body->getTransformMatrix() * vertexOne;
     vertexTwo = box2.body->getTransformMatrix() * vertexTwo;
 
     /* box2 의 변과 가장 가까운 box1 위의 점을 찾는다 */
     float k = directionOne.dot(directionTwo);
-    Vector3* closestPointOne =
-        new Vector3(vertexOne + directionOne * ((vertexTwo-vertexOne).dot(directionOne-directionTwo*k)/(1-k*k)));
+    Vector3& closestPointOne = contact->contactPoint[0];
+    closestPointOne = vertexOne + directionOne * ((vertexTwo-vertexOne).dot(directionOne-directionTwo*k)/(1-k*k));
     
     /* box1 의 변과 가장 가까운 box2 위의 점을 찾는다 */
-    Vector3* closestPointTwo =
-        new Vector3(vertexTwo + directionTwo * ((*closestPointOne-vertexTwo).dot(directionTwo)));
+    Vector3& closestPointTwo = contact->contactPoint[1];
+    closestPointTwo = vertexTwo + directionTwo * ((closestPointOne-vertexTwo).dot(directionTwo));
+}
+
+unsigned int CollisionDetector::calcVertexSignBits(const Vector3& vertex)
+{
+    unsigned int bits = 0;
+    if (vertex.x < 0.0f) bits |= 1;
+    if (vertex.y < 0.0f) bits |= 2;
+    if (vertex.z < 0.0f) bits |= 4;
+    return bits;
+}
+
+Vector3 CollisionDetector::calcClosestPointOnBox(const Vector3& pointInBoxLocal, const Vector3& halfSize)
+{
+    float closestPoint[3];
+    for (int i = 0; i < 3; ++i)
+    {
+        if (pointInBoxLocal[i] > halfSize[i])
+            closestPoint[i] = halfSize[i];
+        else if (pointInBoxLocal[i] < -halfSize[i])
+            closestPoint[i] = -halfSize[i];
+        else
+            closestPoint[i] = pointInBoxLocal[i];
+    }
+    return Vector3(closestPoint[0], closestPoint[1], closestPoint[2]);
+}
+
+Vector3 CollisionDetector::calcClosestPointOnTriangle(const Vector3& point, const Vector3 (&vertices)[3])
+{
+    /* 점이 삼각형의 어느 보로노이 영역에 있는지 차례로 검사한다 (Ericson, Real-Time Collision Detection 5.1.5) */
+    const Vector3& a = vertices[0];
+    const Vector3& b = vertices[1];
+    const Vector3& c = vertices[2];
+    Vector3 ab = b - a;
+    Vector3 ac = c - a;
+
+    /* 꼭짓점 a */
+    Vector3 ap = point - a;
+    float d1 = ab.dot(ap);
+    float d2 = ac.dot(ap);
+    if (d1 <= 0.0f && d2 <= 0.0f)
+        return a;
+
+    /* 꼭짓점 b */
+    Vector3 bp = point - b;
+    float d3 = ab.dot(bp);
+    float d4 = ac.dot(bp);
+    if (d3 >= 0.0f && d4 <= d3)
+        return b;
+
+    /* 모서리 ab */
+    float vc = d1*d4 - d3*d2;
+    if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
+        return a + ab * (d1 / (d1 - d3));
+
+    /* 꼭짓점 c */
+    Vector3 cp = point - c;
+    float d5 = ab.dot(cp);
+    float d6 = ac.dot(cp);
+    if (d6 >= 0.0f && d5 <= d6)
+        return c;
+
+    /* 모서리 ac */
+    float vb = d5*d2 - d1*d6;
+    if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
+        return a + ac * (d2 / (d2 - d6));
+
+    /* 모서리 bc */
+    float va = d3*d6 - d5*d4;
+    if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f)
+        return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+
+    /* 면 안쪽 */
+    float denominator = 1.0f / (va + vb + vc);
+    return a + ab * (vb * denominator) + ac * (vc * denominator);
+}
+
+bool CollisionDetector::isCoveredByNeighbor(const TriangleMesh::Triangle& triangle, const Vector3& normal)
+{
+    for (int i = 0; i < 3; ++i)
+    {
+        /* 법선이 이 변의 바깥쪽으로 기울었고, 이웃 삼각형의 면 안쪽으로도 기울었다면
+            이 변은 평평하거나 오목하게 이어진 변이다 */
+        Vector3 edge = triangle.vertices[(i + 1) % 3] - triangle.vertices[i];
+        Vector3 outward = edge.cross(triangle.normal);
+        if (normal.dot(outward) > 1e-3f * edge.magnitude() && normal.dot(triangle.neighborDirections[i]) > 1e-3f)
+            return true;
+    }
+    return false;
+}
+
+int CollisionDetector::clipPolygon(
+    const Vector3* polygon,
+    int count,
+    const Vector3& planeNormal,
+    float planeOffset,
+    Vector3* out
+)
+{
+    int outCount = 0;
+    for (int i = 0; i < count; ++i)
+    {
+        const Vector3& current = polygon[i];
+        const Vector3& next = polygon[(i + 1) % count];
+        float currentDistance = planeNormal.dot(current) - planeOffset;
+        float nextDistance = planeNormal.dot(next) - planeOffset;
+
+        /* 안쪽의 정점은 남기고, 변이 평면을 지난다면 교차점을 추가한다 */
+        if (currentDistance <= 0.0f)
+            out[outCount++] = current;
+        if ((currentDistance <= 0.0f) != (nextDistance <= 0.0f))
+            out[outCount++] = current + (next - current) * (currentDistance / (currentDistance - nextDistance));
+    }
+    return outCount;
+}
+
+int CollisionDetector::clipPolygon(
+    const Vector3* polygon,
+    const unsigned int* features,
+    int count,
+    const Vector3& planeNormal,
+    float planeOffset,
+    unsigned int planeFeature,
+    Vector3* out,
+    unsigned int* outFeatures
+)
+{
+    int outCount = 0;
+    for (int i = 0; i < count; ++i)
+    {
+        int nextIdx = (i + 1) % count;
+        const Vector3& current = polygon[i];
+        const Vector3& next = polygon[nextIdx];
+        float currentDistance = planeNormal.dot(current) - planeOffset;
+        float nextDistance = planeNormal.dot(next) - planeOffset;
+
+        if (currentDistance <= 0.0f)
+        {
+            out[outCount] = current;
+            outFeatures[outCount++] = features[i];
+        }
+        if ((currentDistance <= 0.0f) != (nextDistance <= 0.0f))
+        {
+            /* 나가는 변의 교차점은 잘려 나가는 정점을, 들어오는 변의 교차점은 평면을 특징으로 삼는다.
+                볼록 다각형은 평면을 두 번만 지나므로 번호가 겹치지 않는다 */
+            out[outCount] = current + (next - current) * (currentDistance / (currentDistance - nextDistance));
+            outFeatures[outCount++] = currentDistance <= 0.0f ? features[nextIdx] : planeFeature;
+        }
+    }
+    return outCount;
+}
+
+int CollisionDetector::reduceContactPoints(
+    const Vector3* points,
+    int count,
+    const Vector3& axis1,
+    const Vector3& axis2,
+    int (&selected)[4]
+)
+{
+    /* 네 대각선 방향마다 가장 멀리 있는 점. 값이 같다면 앞선 점을 고른다 */
+    Vector3 directions[4] = {axis1 + axis2, axis1 - axis2, axis1 * -1.0f - axis2, axis2 - axis1};
+    int selectedCount = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        int farthest = 0;
+        float maxDistance = directions[i].dot(points[0]);
+        for (int j = 1; j < count; ++j)
+        {
+            float distance = directions[i].dot(points[j]);
+            if (distance > maxDistance)
+            {
+                maxDistance = distance;
+                farthest = j;
+            }
+        }
+
+        /* 두 방향에서 같은 점이 골라졌다면 한 번만 남긴다 */
+        bool isSelected = false;
+        for (int j = 0; j < selectedCount; ++j)
+        {
+            if (selected[j] == farthest)
+                isSelected = true;
+        }
+        if (!isSelected)
+            selected[selectedCount++] = farthest;
+    }
+    return selectedCount;
+}
+
+float CollisionDetector::calcClosestPointOnSegment(const Vector3& point, const Vector3& start, const Vector3& end)
+{
+    Vector3 direction = end - start;
+    float lengthSquared = direction.magnitudeSquared();
+    if (lengthSquared < FLT_EPSILON)
+        return 0.0f;
+
+    float t = (point - start).dot(direction) / lengthSquared;
+    return fminf(fmaxf(t, 0.0f), 1.0f);
+}
+
+float CollisionDetector::calcClosestPointsOfSegments(
+    const Vector3& start1,
+    const Vector3& end1,
+    const Vector3& start2,
+    const Vector3& end2,
+    float& s,
+    float& t
+)
+{
+    /* Real-Time Collision Detection 5.1.9 의 방법 */
+    Vector3 direction1 = end1 - start1;
+    Vector3 direction2 = end2 - start2;
+    Vector3 startToStart = start1 - start2;
+    float a = direction1.magnitudeSquared();
+    float e = direction2.magnitudeSquared();
+    float f = direction2.dot(startToStart);
+
+    if (a < FLT_EPSILON && e < FLT_EPSILON)
+    {
+        /* 두 선분 모두 점이다 */
+        s = t = 0.0f;
+    }
+    else if (a < FLT_EPSILON)
+    {
+        /* 첫 번째 선분이 점이다 */
+        s = 0.0f;
+        t = fminf(fmaxf(f / e, 0.0f), 1.0f);
+    }
+    else
+    {
+        float c = direction1.dot(startToStart);
+        if (e < FLT_EPSILON)
+        {
+            /* 두 번째 선분이 점이다 */
+            t = 0.0f;
+            s = fminf(fmaxf(-c / a, 0.0f), 1.0f);
+        }
+        else
+        {
+            float b = direction1.dot(direction2);
+            float denominator = a*e - b*b;
+
+            /* 나란하지 않다면 두 직선의 가장 가까운 점을 첫 번째 선분으로 자른다.
+                나란하다면 아무 점이나 고른다 */
+            s = denominator > FLT_EPSILON ? fminf(fmaxf((b*f - c*e) / denominator, 0.0f), 1.0f) : 0.0f;
+
+            /* s 에 대해 두 번째 선분에서 가장 가까운 점을 구하고, 잘렸다면 s 를 다시 구한다 */
+            t = (b*s + f) / e;
+            if (t < 0.0f)
+            {
+                t = 0.0f;
+                s = fminf(fmaxf(-c / a, 0.0f), 1.0f);
+            }
+            else if (t > 1.0f)
+            {
+                t = 1.0f;
+                s = fminf(fmaxf((b - c) / a, 0.0f), 1.0f);
+            }
+        }
+    }
+
+    Vector3 point1 = start1 + direction1 * s;
+    Vector3 point2 = start2 + direction2 * t;
+    return (point1 - point2).magnitudeSquared();
+}
+
+float CollisionDetector::calcRayAndCapsule(
+    const Vector3& origin,
+    const Vector3& direction,
+    const Vector3& start,
+    const Vector3& end,
+    float radius
+)
+{
+    Vector3 axis = end - start;
+    Vector3 startToOrigin = origin - start;
+
+    /* 이미 캡슐 안에 있다 */
+    Vector3 closestPoint = start + axis * calcClosestPointOnSegment(origin, start, end);
+    if ((origin - closestPoint).magnitudeSquared() < radius*radius)
+        return -1.0f;
+
+    float hitT = -1.0f;
+
+    /* 선분을 축으로 하는 무한히 긴 원기둥의 옆면. 축 방향 위치가 선분 안일 때만 캡슐의 옆면이다 */
+    float axisLengthSquared = axis.magnitudeSquared();
+    float originAxial = startToOrigin.dot(axis);
+    float directionAxial = direction.dot(axis);
+    float a = axisLengthSquared * direction.magnitudeSquared() - directionAxial*directionAxial;
+    float b = axisLengthSquared * startToOrigin.dot(direction) - originAxial * directionAxial;
+    float c = axisLengthSquared * (startToOrigin.magnitudeSquared() - radius*radius) - originAxial*originAxial;
+    if (axisLengthSquared > FLT_EPSILON && a > FLT_EPSILON)
+    {
+        float discriminant = b*b - a*c;
+        if (discriminant < 0.0f)
+            return -1.0f;
+
+        float t = (-b - sqrtf(discriminant)) / a;
+        float axial = originAxial + t * directionAxial;
+        if (t >= 0.0f && axial >= 0.0f && axial <= axisLengthSquared)
+            return t;
+    }
+
+    /* 옆면에 닿지 않았다면 양 끝의 반구에 닿는다 */
+    const Vector3* centers[2] = {&start, &end};
+    float directionLengthSquared = direction.magnitudeSquared();
+    if (directionLengthSquared < FLT_EPSILON)
+        return -1.0f;
+    for (int i = 0; i < 2; ++i)
+    {
+        Vector3 centerToOrigin = origin - *centers[i];
+        float sphereB = centerToOrigin.dot(direction);
+        float sphereC = centerToOrigin.magnitudeSquared() - radius*radius;
+        float discriminant = sphereB*sphereB - directionLengthSquared * sphereC;
+        if (discriminant < 0.0f)
+            continue;
+
+        float t = (-sphereB - sqrtf(discriminant)) / directionLengthSquared;
+        if (t >= 0.0f && (hitT < 0.0f || t < hitT))
+            hitT = t;
+    }
 
-    contact->contactPoint[0] = closestPointOne;
-    contact->contactPoint[1] = closestPointTwo;
+    return hitT;
 }
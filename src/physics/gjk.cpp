@@ -0,0 +1,485 @@
+#include <physics/gjk.h>
+#include <cmath>
+#include <cfloat>
+
+using namespace physics;
+
+namespace
+{
+    /* 같은 점으로 볼 거리의 제곱 */
+    const float DUPLICATE_DISTANCE_SQUARED = 1e-10f;
+}
+
+bool GJKSolver::intersect(const Collider& a, const Collider& b, GJKCache& cache)
+{
+    simplexCount = 0;
+    lastIterationCount = 0;
+
+    /* 직전 프레임의 단체를 지금의 위치에서 다시 만든다 */
+    for (int i = 0; i < cache.count; ++i)
+        addSupportPoint(calcSupport(a, b, cache.directions[i]));
+    if (simplexCount == 0)
+        addSupportPoint(calcSupport(a, b, Vector3(1.0f, 0.0f, 0.0f)));
+
+    bool isIntersecting = false;
+    for (int iteration = 0; iteration < gjkIterationLimit; ++iteration)
+    {
+        ++lastIterationCount;
+
+        Vector3 closestPoint;
+        if (reduceSimplex(closestPoint))
+        {
+            isIntersecting = true;
+            break;
+        }
+
+        /* 원점이 단체 위에 있다. 닿아 있거나 겹쳐 있다 */
+        float distanceSquared = closestPoint.magnitudeSquared();
+        if (distanceSquared < DUPLICATE_DISTANCE_SQUARED)
+        {
+            isIntersecting = true;
+            break;
+        }
+
+        /* 원점을 향하는 방향으로 가장 먼 점을 찾는다 */
+        Vector3 direction = closestPoint * -1.0f;
+        SupportPoint supportPoint = calcSupport(a, b, direction);
+
+        /* 그 점도 원점에 닿지 못한다면 direction 이 분리축이다 */
+        if (supportPoint.point.dot(direction) < 0.0f)
+            break;
+
+        /* 더 이상 원점에 가까워지지 않는다면 떨어져 있는 것이다 */
+        if (distanceSquared - closestPoint.dot(supportPoint.point) <= 1e-6f * distanceSquared)
+            break;
+        if (!addSupportPoint(supportPoint))
+            break;
+    }
+
+    /* 다음 프레임을 위해 단체를 저장한다 */
+    cache.count = simplexCount;
+    for (int i = 0; i < simplexCount; ++i)
+        cache.directions[i] = simplex[i].direction;
+
+    return isIntersecting;
+}
+
+bool GJKSolver::calcPenetration(
+    const Collider& a,
+    const Collider& b,
+    Vector3& normal,
+    float& depth,
+    Vector3& pointA,
+    Vector3& pointB
+)
+{
+    if (!expandSimplex(a, b))
+        return false;
+
+    /* 사면체로 다면체를 만든다. 모든 면이 바깥을 향하도록 네 번째 꼭짓점이
+        첫 번째 면의 뒤쪽에 오게 꼭짓점 순서를 맞춘다 */
+    Vector3 firstNormal = (simplex[1].point - simplex[0].point).cross(simplex[2].point - simplex[0].point);
+    if (firstNormal.dot(simplex[3].point - simplex[0].point) > 0.0f)
+    {
+        SupportPoint temp = simplex[1];
+        simplex[1] = simplex[2];
+        simplex[2] = temp;
+    }
+
+    polytope.clear();
+    faces.clear();
+    for (int i = 0; i < 4; ++i)
+        polytope.push_back(simplex[i]);
+
+    if (!addFace(0, 1, 2) || !addFace(0, 2, 3) || !addFace(0, 3, 1) || !addFace(1, 3, 2))
+        return false;
+
+    int closestFaceIndex = -1;
+    for (int iteration = 0; iteration < epaIterationLimit; ++iteration)
+    {
+        /* 원점과 가장 가까운 면을 찾는다 */
+        closestFaceIndex = -1;
+        float minDistance = FLT_MAX;
+        for (unsigned int i = 0; i < faces.size(); ++i)
+        {
+            if (!faces[i].isObsolete && faces[i].distance < minDistance)
+            {
+                minDistance = faces[i].distance;
+                closestFaceIndex = i;
+            }
+        }
+        if (closestFaceIndex == -1)
+            return false;
+
+        /* 그 면의 법선 방향으로 다면체를 더 키울 수 없다면 그 면이 Minkowski 차의 경계이다 */
+        Face closestFace = faces[closestFaceIndex];
+        SupportPoint supportPoint = calcSupport(a, b, closestFace.normal);
+        if (supportPoint.point.dot(closestFace.normal) - closestFace.distance < epaTolerance)
+            break;
+
+        /* 새 점에서 보이는 면들을 지우고, 그 경계의 변들과 새 점으로 면을 만든다 */
+        int newIndex = polytope.size();
+        polytope.push_back(supportPoint);
+        horizon.clear();
+        for (auto& face : faces)
+        {
+            if (face.isObsolete)
+                continue;
+
+            const Vector3& vertex = polytope[face.vertices[0]].point;
+            if (face.normal.dot(supportPoint.point - vertex) > 0.0f)
+            {
+                face.isObsolete = true;
+                addHorizonEdge(face.vertices[0], face.vertices[1]);
+                addHorizonEdge(face.vertices[1], face.vertices[2]);
+                addHorizonEdge(face.vertices[2], face.vertices[0]);
+            }
+        }
+
+        for (const auto& edge : horizon)
+            addFace(edge.vertices[0], edge.vertices[1], newIndex);
+    }
+
+    /* 원점을 가장 가까운 면에 투영한 점의 무게중심 좌표로 두 충돌체 위의 충돌점을 구한다 */
+    const Face& face = faces[closestFaceIndex];
+    const SupportPoint& p1 = polytope[face.vertices[0]];
+    const SupportPoint& p2 = polytope[face.vertices[1]];
+    const SupportPoint& p3 = polytope[face.vertices[2]];
+
+    Vector3 projected = face.normal * face.distance;
+    Vector3 edge1 = p2.point - p1.point;
+    Vector3 edge2 = p3.point - p1.point;
+    Vector3 toProjected = projected - p1.point;
+    float d11 = edge1.dot(edge1);
+    float d12 = edge1.dot(edge2);
+    float d22 = edge2.dot(edge2);
+    float d31 = toProjected.dot(edge1);
+    float d32 = toProjected.dot(edge2);
+    float denominator = d11 * d22 - d12 * d12;
+
+    float u = 1.0f / 3.0f, v = 1.0f / 3.0f, w = 1.0f / 3.0f;
+    if (fabsf(denominator) > FLT_EPSILON)
+    {
+        v = (d22 * d31 - d12 * d32) / denominator;
+        w = (d11 * d32 - d12 * d31) / denominator;
+        u = 1.0f - v - w;
+    }
+
+    pointA = p1.pointA * u + p2.pointA * v + p3.pointA * w;
+    pointB = p1.pointB * u + p2.pointB * v + p3.pointB * w;
+    normal = face.normal * -1.0f;
+    depth = face.distance;
+    return true;
+}
+
+GJKSolver::SupportPoint GJKSolver::calcSupport(const Collider& a, const Collider& b, const Vector3& direction)
+{
+    SupportPoint result;
+    result.pointA = a.support(direction);
+    result.pointB = b.support(direction * -1.0f);
+    result.point = result.pointA - result.pointB;
+    result.direction = direction;
+    return result;
+}
+
+bool GJKSolver::addSupportPoint(const SupportPoint& supportPoint)
+{
+    for (int i = 0; i < simplexCount; ++i)
+    {
+        if ((simplex[i].point - supportPoint.point).magnitudeSquared() < DUPLICATE_DISTANCE_SQUARED)
+            return false;
+    }
+
+    simplex[simplexCount++] = supportPoint;
+    return true;
+}
+
+bool GJKSolver::reduceSimplex(Vector3& closestPoint)
+{
+    switch (simplexCount)
+    {
+    case 1:
+        closestPoint = simplex[0].point;
+        return false;
+    case 2:
+        reduceSegment(closestPoint);
+        return false;
+    case 3:
+        reduceTriangle(closestPoint);
+        return false;
+    default:
+        return reduceTetrahedron(closestPoint);
+    }
+}
+
+void GJKSolver::reduceSegment(Vector3& closestPoint)
+{
+    const Vector3& a = simplex[0].point;
+    Vector3 ab = simplex[1].point - a;
+
+    float lengthSquared = ab.magnitudeSquared();
+    float t = lengthSquared > FLT_EPSILON ? -a.dot(ab) / lengthSquared : 0.0f;
+    if (t <= 0.0f)
+    {
+        simplexCount = 1;
+        closestPoint = a;
+    }
+    else if (t >= 1.0f)
+    {
+        simplex[0] = simplex[1];
+        simplexCount = 1;
+        closestPoint = simplex[0].point;
+    }
+    else
+        closestPoint = a + ab * t;
+}
+
+void GJKSolver::reduceTriangle(Vector3& closestPoint)
+{
+    const SupportPoint* points[3] = {&simplex[0], &simplex[1], &simplex[2]};
+    int indices[3];
+    int indexCount;
+    closestPoint = calcClosestPointOnTriangle(points, indices, indexCount);
+
+    SupportPoint reduced[3];
+    for (int i = 0; i < indexCount; ++i)
+        reduced[i] = simplex[indices[i]];
+    for (int i = 0; i < indexCount; ++i)
+        simplex[i] = reduced[i];
+    simplexCount = indexCount;
+}
+
+bool GJKSolver::reduceTetrahedron(Vector3& closestPoint)
+{
+    /* 각 면과 그 면의 맞은편 꼭짓점 */
+    static const int faceIndices[4][4] = {
+        {0, 1, 2, 3},
+        {0, 2, 3, 1},
+        {0, 3, 1, 2},
+        {1, 3, 2, 0}
+    };
+
+    bool isInside = true;
+    float minDistanceSquared = FLT_MAX;
+    SupportPoint best[3];
+    int bestCount = 0;
+
+    for (int i = 0; i < 4; ++i)
+    {
+        const SupportPoint& a = simplex[faceIndices[i][0]];
+        const SupportPoint& b = simplex[faceIndices[i][1]];
+        const SupportPoint& c = simplex[faceIndices[i][2]];
+        const SupportPoint& d = simplex[faceIndices[i][3]];
+
+        /* 원점과 맞은편 꼭짓점이 면의 같은 쪽에 있다면 이 면은 볼 필요가 없다.
+            사면체가 납작하다면 모든 면을 본다 */
+        Vector3 normal = (b.point - a.point).cross(c.point - a.point);
+        float signOrigin = -normal.dot(a.point);
+        float signOpposite = normal.dot(d.point - a.point);
+        if (fabsf(signOpposite) > FLT_EPSILON && signOrigin * signOpposite > 0.0f)
+            continue;
+
+        isInside = false;
+
+        const SupportPoint* points[3] = {&a, &b, &c};
+        int indices[3];
+        int indexCount;
+        Vector3 point = calcClosestPointOnTriangle(points, indices, indexCount);
+        float distanceSquared = point.magnitudeSquared();
+        if (distanceSquared < minDistanceSquared)
+        {
+            minDistanceSquared = distanceSquared;
+            closestPoint = point;
+            for (int j = 0; j < indexCount; ++j)
+                best[j] = *points[indices[j]];
+            bestCount = indexCount;
+        }
+    }
+
+    if (isInside)
+        return true;
+
+    for (int i = 0; i < bestCount; ++i)
+        simplex[i] = best[i];
+    simplexCount = bestCount;
+    return false;
+}
+
+Vector3 GJKSolver::calcClosestPointOnTriangle(const SupportPoint* points[3], int indices[3], int& indexCount)
+{
+    /* Real-Time Collision Detection 5.1.5 의 방법. 원점이 삼각형의 어느 영역에 있는지 판정한다 */
+    const Vector3& a = points[0]->point;
+    const Vector3& b = points[1]->point;
+    const Vector3& c = points[2]->point;
+    Vector3 ab = b - a;
+    Vector3 ac = c - a;
+
+    /* 꼭짓점 a 영역 */
+    float d1 = -ab.dot(a);
+    float d2 = -ac.dot(a);
+    if (d1 <= 0.0f && d2 <= 0.0f)
+    {
+        indices[0] = 0;
+        indexCount = 1;
+        return a;
+    }
+
+    /* 꼭짓점 b 영역 */
+    float d3 = -ab.dot(b);
+    float d4 = -ac.dot(b);
+    if (d3 >= 0.0f && d4 <= d3)
+    {
+        indices[0] = 1;
+        indexCount = 1;
+        return b;
+    }
+
+    /* 변 ab 영역 */
+    float vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
+    {
+        indices[0] = 0;
+        indices[1] = 1;
+        indexCount = 2;
+        return a + ab * (d1 / (d1 - d3));
+    }
+
+    /* 꼭짓점 c 영역 */
+    float d5 = -ab.dot(c);
+    float d6 = -ac.dot(c);
+    if (d6 >= 0.0f && d5 <= d6)
+    {
+        indices[0] = 2;
+        indexCount = 1;
+        return c;
+    }
+
+    /* 변 ac 영역 */
+    float vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
+    {
+        indices[0] = 0;
+        indices[1] = 2;
+        indexCount = 2;
+        return a + ac * (d2 / (d2 - d6));
+    }
+
+    /* 변 bc 영역 */
+    float va = d3 * d6 - d5 * d4;
+    if (va <= 0.0f && d4 - d3 >= 0.0f && d5 - d6 >= 0.0f)
+    {
+        indices[0] = 1;
+        indices[1] = 2;
+        indexCount = 2;
+        return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+    }
+
+    /* 면 영역. 삼각형이 퇴화했다면 가장 가까운 꼭짓점을 쓴다 */
+    float sum = va + vb + vc;
+    if (fabsf(sum) < FLT_EPSILON)
+    {
+        int closestIndex = 0;
+        for (int i = 1; i < 3; ++i)
+        {
+            if (points[i]->point.magnitudeSquared() < points[closestIndex]->point.magnitudeSquared())
+                closestIndex = i;
+        }
+        indices[0] = closestIndex;
+        indexCount = 1;
+        return points[closestIndex]->point;
+    }
+
+    indices[0] = 0;
+    indices[1] = 1;
+    indices[2] = 2;
+    indexCount = 3;
+    return a + ab * (vb / sum) + ac * (vc / sum);
+}
+
+bool GJKSolver::expandSimplex(const Collider& a, const Collider& b)
+{
+    static const Vector3 axes[6] = {
+        Vector3(1.0f, 0.0f, 0.0f), Vector3(-1.0f, 0.0f, 0.0f),
+        Vector3(0.0f, 1.0f, 0.0f), Vector3(0.0f, -1.0f, 0.0f),
+        Vector3(0.0f, 0.0f, 1.0f), Vector3(0.0f, 0.0f, -1.0f)
+    };
+
+    /* 점 하나라면 좌표축 방향으로 두 번째 점을 찾는다 */
+    for (int i = 0; i < 6 && simplexCount == 1; ++i)
+        addSupportPoint(calcSupport(a, b, axes[i]));
+
+    /* 선분이라면 선분에 수직인 방향으로 세 번째 점을 찾는다 */
+    if (simplexCount == 2)
+    {
+        Vector3 direction = simplex[1].point - simplex[0].point;
+        direction.normalize();
+        for (int i = 0; i < 6 && simplexCount == 2; ++i)
+        {
+            Vector3 perpendicular = direction.cross(axes[i]);
+            if (perpendicular.magnitudeSquared() < 1e-6f)
+                continue;
+
+            SupportPoint supportPoint = calcSupport(a, b, perpendicular);
+            /* 선분 위의 점이라면 삼각형을 만들 수 없다 */
+            Vector3 offset = supportPoint.point - simplex[0].point;
+            if (offset.cross(direction).magnitudeSquared() > 1e-8f)
+                addSupportPoint(supportPoint);
+        }
+    }
+
+    /* 삼각형이라면 법선 방향으로 네 번째 점을 찾는다 */
+    if (simplexCount == 3)
+    {
+        Vector3 normal = (simplex[1].point - simplex[0].point).cross(simplex[2].point - simplex[0].point);
+        for (int sign = 0; sign < 2 && simplexCount == 3; ++sign)
+        {
+            SupportPoint supportPoint = calcSupport(a, b, sign == 0 ? normal : normal * -1.0f);
+            if (fabsf(normal.dot(supportPoint.point - simplex[0].point)) > 1e-8f)
+                addSupportPoint(supportPoint);
+        }
+    }
+
+    return simplexCount == 4;
+}
+
+bool GJKSolver::addFace(int index1, int index2, int index3)
+{
+    const Vector3& a = polytope[index1].point;
+    const Vector3& b = polytope[index2].point;
+    const Vector3& c = polytope[index3].point;
+
+    Face face;
+    face.normal = (b - a).cross(c - a);
+    if (face.normal.magnitudeSquared() < 1e-12f)
+        return false;
+    face.normal.normalize();
+    face.isObsolete = false;
+
+    /* 꼭짓점 순서로 정한 방향을 그대로 쓴다. 원점이 면에 거의 닿아 있을 때
+        distance 의 부호로 법선을 뒤집으면 이웃한 면과 감긴 방향이 어긋나 경계 변을 찾지 못한다 */
+    face.distance = face.normal.dot(a);
+    face.vertices[0] = index1;
+    face.vertices[1] = index2;
+    face.vertices[2] = index3;
+
+    faces.push_back(face);
+    return true;
+}
+
+void GJKSolver::addHorizonEdge(int index1, int index2)
+{
+    for (unsigned int i = 0; i < horizon.size(); ++i)
+    {
+        if (horizon[i].vertices[0] == index2 && horizon[i].vertices[1] == index1)
+        {
+            horizon[i] = horizon.back();
+            horizon.pop_back();
+            return;
+        }
+    }
+
+    Edge edge;
+    edge.vertices[0] = index1;
+    edge.vertices[1] = index2;
+    horizon.push_back(edge);
+}
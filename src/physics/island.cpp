@@ -0,0 +1,225 @@
+#include <physics/island.h>
+
+using namespace physics;
+
+void IslandManager::updateSleepTime(RigidBody* body, float duration) const
+{
+    if (body->getVelocity().magnitudeSquared() > linearSleepThreshold * linearSleepThreshold
+        || body->getRotation().magnitudeSquared() > angularSleepThreshold * angularSleepThreshold)
+    {
+        body->sleepTime = 0.0f;
+    }
+    else
+        body->sleepTime += duration;
+}
+
+void IslandManager::buildIslands(const std::vector<RigidBody*>& awakeBodies, const std::vector<Contact>& contacts)
+{
+    /* 움직일 수 있는 강체들에 union-find 인덱스를 부여한다 */
+    islandBodies.clear();
+    parents.clear();
+    for (auto& body : awakeBodies)
+    {
+        if (body->isFixed())
+        {
+            body->islandIndex = -1;
+            continue;
+        }
+        body->islandIndex = islandBodies.size();
+        parents.push_back(islandBodies.size());
+        islandBodies.push_back(body);
+    }
+
+    /* 깨어 있는 강체와 충돌한 잠든 강체는 island 를 깨우고 인덱스를 부여한다.
+        서로 다른 island 가 같은 강체를 건드리지 않아야 island 들을 병렬로 해소할 수 있다 */
+    for (const auto& contact : contacts)
+    {
+        for (int i = 0; i < 2; ++i)
+        {
+            RigidBody* body = contact.bodies[i];
+            if (body == nullptr || body->isFixed() || getIslandIndex(body) >= 0)
+                continue;
+
+            if (!body->isAwake() || body->sleepingIslandID != -1)
+                wakeIsland(body);
+            body->islandIndex = islandBodies.size();
+            parents.push_back(islandBodies.size());
+            islandBodies.push_back(body);
+        }
+    }
+
+    /* 충돌로 이어진 강체들을 합친다 */
+    for (const auto& contact : contacts)
+    {
+        if (contact.bodies[1] == nullptr)
+            continue;
+        int index1 = getIslandIndex(contact.bodies[0]);
+        int index2 = getIslandIndex(contact.bodies[1]);
+        if (index1 >= 0 && index2 >= 0)
+            unite(index1, index2);
+    }
+
+    /* 루트가 같은 강체들을 한 island 로 모은다 */
+    islands.clear();
+    std::vector<int> rootToIsland(islandBodies.size(), -1);
+    for (unsigned int i = 0; i < islandBodies.size(); ++i)
+    {
+        int root = findRoot(i);
+        if (rootToIsland[root] == -1)
+        {
+            rootToIsland[root] = islands.size();
+            islands.push_back(Island());
+        }
+        islands[rootToIsland[root]].bodies.push_back(islandBodies[i]);
+    }
+
+    /* 충돌 정보는 움직일 수 있는 쪽 강체의 island 에 넣는다 */
+    for (unsigned int i = 0; i < contacts.size(); ++i)
+    {
+        int index = getIslandIndex(contacts[i].bodies[0]);
+        if (index < 0 && contacts[i].bodies[1] != nullptr)
+            index = getIslandIndex(contacts[i].bodies[1]);
+        if (index < 0)
+            continue;
+
+        islands[rootToIsland[findRoot(index)]].contactIndices.push_back(i);
+    }
+}
+
+void IslandManager::updateSleeping()
+{
+    if (!isSleepingEnabled)
+        return;
+
+    for (const auto& island : islands)
+    {
+        bool canSleep = true;
+        for (const auto& body : island.bodies)
+        {
+            if (body->sleepTime < timeToSleep)
+            {
+                canSleep = false;
+                break;
+            }
+        }
+        if (!canSleep)
+            continue;
+
+        int sleepingIslandID = nextSleepingIslandID++;
+        for (auto& body : island.bodies)
+        {
+            body->setAwake(false);
+            body->sleepingIslandID = sleepingIslandID;
+        }
+        sleepingIslands[sleepingIslandID] = island.bodies;
+        sleepingBodyCount += island.bodies.size();
+    }
+}
+
+void IslandManager::wakeIsland(RigidBody* body)
+{
+    auto sleepingIsland = sleepingIslands.find(body->sleepingIslandID);
+    if (sleepingIsland == sleepingIslands.end())
+    {
+        body->sleepingIslandID = -1;
+        body->setAwake(true);
+        return;
+    }
+
+    for (auto& member : sleepingIsland->second)
+    {
+        member->sleepingIslandID = -1;
+        member->setAwake(true);
+    }
+    sleepingBodyCount -= sleepingIsland->second.size();
+    sleepingIslands.erase(sleepingIsland);
+}
+
+void IslandManager::removeBody(RigidBody* body)
+{
+    if (body->sleepingIslandID == -1)
+        return;
+
+    /* 제거될 강체는 island 에서 빼고 나머지를 깨운다 */
+    auto sleepingIsland = sleepingIslands.find(body->sleepingIslandID);
+    if (sleepingIsland != sleepingIslands.end())
+    {
+        std::vector<RigidBody*>& members = sleepingIsland->second;
+        for (unsigned int i = 0; i < members.size(); ++i)
+        {
+            if (members[i] == body)
+            {
+                members[i] = members.back();
+                members.pop_back();
+                --sleepingBodyCount;
+                break;
+            }
+        }
+    }
+    body->sleepingIslandID = -1;
+
+    if (sleepingIsland != sleepingIslands.end() && !sleepingIsland->second.empty())
+        wakeIsland(sleepingIsland->second[0]);
+    else if (sleepingIsland != sleepingIslands.end())
+        sleepingIslands.erase(sleepingIsland);
+}
+
+void IslandManager::wakeAll()
+{
+    for (auto& sleepingIsland : sleepingIslands)
+    {
+        for (auto& member : sleepingIsland.second)
+        {
+            member->sleepingIslandID = -1;
+            member->setAwake(true);
+        }
+    }
+    sleepingIslands.clear();
+    sleepingBodyCount = 0;
+}
+
+void IslandManager::setSleepingEnabled(bool value)
+{
+    isSleepingEnabled = value;
+    if (!isSleepingEnabled)
+        wakeAll();
+}
+
+void IslandManager::setSleepThresholds(float linear, float angular)
+{
+    linearSleepThreshold = linear;
+    angularSleepThreshold = angular;
+}
+
+int IslandManager::getIslandIndex(const RigidBody* body) const
+{
+    int index = body->islandIndex;
+    if (index < 0 || index >= (int)islandBodies.size() || islandBodies[index] != body)
+        return -1;
+    return index;
+}
+
+int IslandManager::findRoot(int index)
+{
+    /* 경로 압축 */
+    while (parents[index] != index)
+    {
+        parents[index] = parents[parents[index]];
+        index = parents[index];
+    }
+    return index;
+}
+
+void IslandManager::unite(int index1, int index2)
+{
+    int root1 = findRoot(index1);
+    int root2 = findRoot(index2);
+    if (root1 == root2)
+        return;
+
+    /* 인덱스가 작은 쪽을 루트로 삼아 결과가 입력 순서에만 의존하게 한다 */
+    if (root1 < root2)
+        parents[root2] = root1;
+    else
+        parents[root1] = root2;
+}
@@ -0,0 +1,86 @@
+#include <physics/manifold.h>
+
+using namespace physics;
+
+unsigned int ManifoldCache::restore(std::vector<Contact>& contacts) const
+{
+    unsigned int matchedCount = 0;
+
+    for (auto& contact : contacts)
+    {
+        BodyPair key = {contact.bodies[0], contact.bodies[1]};
+        auto manifold = manifolds.find(key);
+        if (manifold == manifolds.end())
+            continue;
+
+        for (const auto& point : manifold->second.points)
+        {
+            if (point.featureID != contact.featureID)
+                continue;
+            /* 법선이 nan 인 퇴화된 충돌점도 여기서 걸러진다 */
+            if (!(point.normal.dot(contact.normal) >= normalTolerance))
+                continue;
+
+            /* 접선 충격량을 현재 법선의 접선 벡터들에 사영한다 */
+            Vector3 tangent1, tangent2;
+            contact.calcTangents(tangent1, tangent2);
+            float tangentLengthSquared = tangent1.magnitudeSquared();
+
+            contact.normalImpulseSum = point.normalImpulseSum;
+            contact.tangentImpulseSum1 = point.tangentImpulse.dot(tangent1) / tangentLengthSquared;
+            contact.tangentImpulseSum2 = point.tangentImpulse.dot(tangent2) / tangentLengthSquared;
+            ++matchedCount;
+            break;
+        }
+    }
+
+    return matchedCount;
+}
+
+void ManifoldCache::store(const std::vector<Contact>& contacts)
+{
+    ++frame;
+
+    for (const auto& contact : contacts)
+    {
+        BodyPair key = {contact.bodies[0], contact.bodies[1]};
+        ContactManifold& manifold = manifolds[key];
+
+        /* 이번 프레임에 처음 갱신되는 쌍이라면 직전 프레임의 충돌점을 지운다 */
+        if (manifold.frame != frame)
+        {
+            manifold.points.clear();
+            manifold.frame = frame;
+        }
+
+        Vector3 tangent1, tangent2;
+        contact.calcTangents(tangent1, tangent2);
+
+        ManifoldPoint point;
+        point.featureID = contact.featureID;
+        point.normal = contact.normal;
+        point.normalImpulseSum = contact.normalImpulseSum;
+        point.tangentImpulse = tangent1 * contact.tangentImpulseSum1 + tangent2 * contact.tangentImpulseSum2;
+        manifold.points.push_back(point);
+    }
+
+    /* 이번 프레임에 충돌하지 않은 쌍을 제거한다 */
+    for (auto manifold = manifolds.begin(); manifold != manifolds.end();)
+    {
+        if (manifold->second.frame != frame)
+            manifold = manifolds.erase(manifold);
+        else
+            ++manifold;
+    }
+}
+
+void ManifoldCache::removeBody(const RigidBody* body)
+{
+    for (auto manifold = manifolds.begin(); manifold != manifolds.end();)
+    {
+        if (manifold->first.body1 == body || manifold->first.body2 == body)
+            manifold = manifolds.erase(manifold);
+        else
+            ++manifold;
+    }
+}
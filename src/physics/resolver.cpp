@@ -4,18 +4,272 @@
 
 using namespace physics;
 
-void CollisionResolver::resolveCollision(std::vector<Contact*>& contacts, float deltaTime)
+namespace
 {
+    /* 색의 수. 마지막 색은 색이 모자란 충돌들을 모아 순서대로 해소한다 */
+    const unsigned int colorCount = 65;
+    const unsigned int overflowColor = colorCount - 1;
+
+    /* 한 색의 충돌들을 이 개수씩 묶어 스레드에 나눠준다 */
+    const unsigned int contactBatchSize = 64;
+}
+
+void CollisionResolver::resolveCollision(
+    std::vector<Contact>& contacts,
+    const std::vector<Island>& islands,
+    float deltaTime
+)
+{
+    /* 직전 프레임의 누적 충격량을 이어받는다 */
+    lastWarmStartedCount = 0;
+    if (isWarmStarting)
+        lastWarmStartedCount = manifolds.restore(contacts);
+
+    /* 충돌이 많은 island 는 색칠해서 해소한다 */
+    parallelIslandIndices.clear();
+    coloredIslandIndices.clear();
+    for (unsigned int i = 0; i < islands.size(); ++i)
+    {
+        if (solverMode == COLORED_SOLVER && islands[i].contactIndices.size() >= coloringThreshold)
+            coloredIslandIndices.push_back(i);
+        else
+            parallelIslandIndices.push_back(i);
+    }
+
+    /* 나머지 island 들을 병렬로 해소한다 */
+    islandIterationCounts.assign(islands.size(), 0);
+    threadPool.parallelFor(parallelIslandIndices.size(), [&](unsigned int i) {
+        unsigned int islandIndex = parallelIslandIndices[i];
+        islandIterationCounts[islandIndex] = resolveIsland(contacts, islands[islandIndex], deltaTime);
+    });
+
+    lastColorCount = 0;
+    for (const auto& islandIndex : coloredIslandIndices)
+        islandIterationCounts[islandIndex] = resolveColoredIsland(contacts, islands[islandIndex], deltaTime);
+
+    lastIterationCount = 0;
+    for (const auto& iterationCount : islandIterationCounts)
+    {
+        if (iterationCount > lastIterationCount)
+            lastIterationCount = iterationCount;
+    }
+
+    if (isWarmStarting)
+        manifolds.store(contacts);
+}
+
+int CollisionResolver::resolveIsland(std::vector<Contact>& contacts, const Island& island, float deltaTime)
+{
+    if (isWarmStarting)
+    {
+        for (const auto& index : island.contactIndices)
+            warmStart(&contacts[index]);
+    }
+
+    int iterationCount = 0;
     for (int i = 0; i < iterationLimit; ++i)
     {
-        for (auto& contact : contacts)
+        float maxImpulse = 0.0f;
+        for (const auto& index : island.contactIndices)
         {
-            sequentialImpulse(contact, deltaTime);
+            float impulse = sequentialImpulse(&contacts[index], deltaTime);
+            if (impulse > maxImpulse)
+                maxImpulse = impulse;
         }
+        ++iterationCount;
+
+        if (maxImpulse < convergenceTolerance)
+            break;
     }
+
+    return iterationCount;
 }
 
-void CollisionResolver::sequentialImpulse(Contact* contact, float deltaTime)
+int CollisionResolver::resolveColoredIsland(std::vector<Contact>& contacts, const Island& island, float deltaTime)
+{
+    colorIsland(contacts, island);
+
+    if (isWarmStarting)
+    {
+        for (const auto& index : island.contactIndices)
+            warmStart(&contacts[index]);
+    }
+
+    int iterationCount = 0;
+    for (int i = 0; i < iterationLimit; ++i)
+    {
+        float maxImpulse = 0.0f;
+        for (unsigned int color = 0; color < colorCount; ++color)
+        {
+            unsigned int begin = colorOffsets[color];
+            unsigned int end = colorOffsets[color + 1];
+            if (begin == end)
+                continue;
+
+            /* 같은 색의 충돌들은 강체를 공유하지 않으므로 묶음으로 나눠 병렬로 해소한다.
+                색이 모자라 모인 충돌들은 한 묶음으로 순서대로 해소한다 */
+            unsigned int batchCount = (end - begin + contactBatchSize - 1) / contactBatchSize;
+            if (color == overflowColor)
+                batchCount = 1;
+            batchMaxImpulses.assign(batchCount, 0.0f);
+
+            threadPool.parallelFor(batchCount, [&](unsigned int batch) {
+                unsigned int batchBegin = begin + batch * contactBatchSize;
+                unsigned int batchEnd = batchBegin + contactBatchSize;
+                if (batchEnd > end || color == overflowColor)
+                    batchEnd = end;
+
+                float batchMaxImpulse = 0.0f;
+                for (unsigned int j = batchBegin; j < batchEnd; ++j)
+                {
+                    float impulse = sequentialImpulse(&contacts[coloredContactIndices[j]], deltaTime);
+                    if (impulse > batchMaxImpulse)
+                        batchMaxImpulse = impulse;
+                }
+                batchMaxImpulses[batch] = batchMaxImpulse;
+            });
+
+            for (const auto& batchMaxImpulse : batchMaxImpulses)
+            {
+                if (batchMaxImpulse > maxImpulse)
+                    maxImpulse = batchMaxImpulse;
+            }
+        }
+        ++iterationCount;
+
+        if (maxImpulse < convergenceTolerance)
+            break;
+    }
+
+    return iterationCount;
+}
+
+void CollisionResolver::colorIsland(const std::vector<Contact>& contacts, const Island& island)
+{
+    /* island 에 속한 강체들의 색 정보를 초기화한다 */
+    for (const auto& index : island.contactIndices)
+    {
+        for (int i = 0; i < 2; ++i)
+        {
+            RigidBody* body = contacts[index].bodies[i];
+            if (body == nullptr || body->isFixed())
+                continue;
+            if (body->islandIndex >= (int)bodyColorMasks.size())
+                bodyColorMasks.resize(body->islandIndex + 1);
+            bodyColorMasks[body->islandIndex] = 0;
+        }
+    }
+
+    /* 두 강체 모두 아직 사용하지 않은 가장 작은 색을 칠한다 */
+    unsigned int colorSizes[colorCount] = {0};
+    contactColors.resize(island.contactIndices.size());
+    for (unsigned int i = 0; i < island.contactIndices.size(); ++i)
+    {
+        const Contact& contact = contacts[island.contactIndices[i]];
+
+        uint64_t usedColors = 0;
+        for (int j = 0; j < 2; ++j)
+        {
+            if (contact.bodies[j] != nullptr && !contact.bodies[j]->isFixed())
+                usedColors |= bodyColorMasks[contact.bodies[j]->islandIndex];
+        }
+
+        unsigned int color = 0;
+        while (color < overflowColor && (usedColors & ((uint64_t)1 << color)) != 0)
+            ++color;
+
+        if (color != overflowColor)
+        {
+            for (int j = 0; j < 2; ++j)
+            {
+                if (contact.bodies[j] != nullptr && !contact.bodies[j]->isFixed())
+                    bodyColorMasks[contact.bodies[j]->islandIndex] |= (uint64_t)1 << color;
+            }
+        }
+        contactColors[i] = color;
+        ++colorSizes[color];
+    }
+
+    /* 충돌 인덱스를 색 순서로 정렬한다.
+        같은 색 안에서는 island 의 충돌 순서를 유지한다 */
+    colorOffsets.assign(colorCount + 1, 0);
+    unsigned int usedColorCount = 0;
+    for (unsigned int color = 0; color < colorCount; ++color)
+    {
+        colorOffsets[color + 1] = colorOffsets[color] + colorSizes[color];
+        if (colorSizes[color] > 0)
+            ++usedColorCount;
+    }
+    if (usedColorCount > lastColorCount)
+        lastColorCount = usedColorCount;
+
+    /* colorSizes 는 이제 색마다 다음에 채울 위치로 사용한다 */
+    for (unsigned int color = 0; color < colorCount; ++color)
+        colorSizes[color] = colorOffsets[color];
+
+    coloredContactIndices.resize(island.contactIndices.size());
+    for (unsigned int i = 0; i < island.contactIndices.size(); ++i)
+        coloredContactIndices[colorSizes[contactColors[i]]++] = island.contactIndices[i];
+}
+
+void CollisionResolver::setWarmStarting(bool value)
+{
+    isWarmStarting = value;
+    if (!isWarmStarting)
+        manifolds.clear();
+}
+
+void CollisionResolver::warmStart(Contact* contact)
+{
+    if (contact->normalImpulseSum == 0.0f)
+        return;
+
+    Vector3 tangent1, tangent2;
+    contact->calcTangents(tangent1, tangent2);
+
+    Vector3 contactPointFromCenter1 = contact->contactPoint[0] - contact->bodies[0]->getPosition();
+    Vector3 contactPointFromCenter2;
+    if (contact->bodies[1] != nullptr)
+        contactPointFromCenter2 = contact->contactPoint[1] - contact->bodies[1]->getPosition();
+
+    /* 충돌점이 nan 인 퇴화된 충돌은 이어받지 않는다 */
+    if (std::isnan(contactPointFromCenter1.magnitudeSquared()) || std::isnan(contactPointFromCenter2.magnitudeSquared()))
+    {
+        contact->normalImpulseSum = 0.0f;
+        contact->tangentImpulseSum1 = 0.0f;
+        contact->tangentImpulseSum2 = 0.0f;
+        return;
+    }
+
+    Vector3 linearImpulse = contact->normal * contact->normalImpulseSum
+        + tangent1 * contact->tangentImpulseSum1
+        + tangent2 * contact->tangentImpulseSum2;
+
+    if (!contact->bodies[0]->isFixed())
+    {
+        contact->bodies[0]->setVelocity(
+            contact->bodies[0]->getVelocity() + linearImpulse * contact->bodies[0]->getInverseMass()
+        );
+        contact->bodies[0]->setRotation(
+            contact->bodies[0]->getRotation()
+                + contact->bodies[0]->getInverseInertiaTensorWorld() * contactPointFromCenter1.cross(linearImpulse)
+        );
+    }
+    if (contact->bodies[1] != nullptr && !contact->bodies[1]->isFixed())
+    {
+        contact->bodies[1]->setVelocity(
+            contact->bodies[1]->getVelocity() - linearImpulse * contact->bodies[1]->getInverseMass()
+        );
+        contact->bodies[1]->setRotation(
+            contact->bodies[1]->getRotation()
+                - contact->bodies[1]->getInverseInertiaTensorWorld() * contactPointFromCenter2.cross(linearImpulse)
+        );
+    }
+}
+
+/* 고정된 강체는 여러 island 가 공유하므로 속도 & 각속도를 쓰지 않는다.
+    고정된 강체의 질량과 관성 텐서의 역수는 0 이라 결과는 같다 */
+float CollisionResolver::sequentialImpulse(Contact* contact, float deltaTime)
 {
     float effectiveMass;
 
@@ -23,12 +277,12 @@ void CollisionResolver::sequentialImpulse(Contact* contact, float deltaTime)
     if (contact->bodies[1] != nullptr)
         totalInvMass += contact->bodies[1]->getInverseMass();
     if (totalInvMass == 0.0f)
-        return;
+        return 0.0f;
 
-    Vector3 contactPointFromCenter1 = *contact->contactPoint[0] - contact->bodies[0]->getPosition();
+    Vector3 contactPointFromCenter1 = contact->contactPoint[0] - contact->bodies[0]->getPosition();
     Vector3 contactPointFromCenter2;
     if (contact->bodies[1] != nullptr)
-        contactPointFromCenter2 = *contact->contactPoint[1] - contact->bodies[1]->getPosition();
+        contactPointFromCenter2 = contact->contactPoint[1] - contact->bodies[1]->getPosition();
 
     Vector3 termInDenominator1 = (contact->bodies[0]->getInverseInertiaTensorWorld() * (contactPointFromCenter1.cross(contact->normal)))
         .cross(contactPointFromCenter1);
@@ -40,7 +294,7 @@ void CollisionResolver::sequentialImpulse(Contact* contact, float deltaTime)
     }
     effectiveMass = totalInvMass + (termInDenominator1 + termInDenominator2).dot(contact->normal);
     if (effectiveMass == 0.0f)
-        return;
+        return 0.0f;
 
     float closingSpeed = contact->normal.dot(contact->bodies[0]->getVelocity())
         + contact->bodies[0]->getRotation().dot(contactPointFromCenter1.cross(contact->normal));
@@ -65,10 +319,10 @@ void CollisionResolver::sequentialImpulse(Contact* contact, float deltaTime)
     bias -= restitutionTerm;
 
     float impulse = -(closingSpeed + bias) / effectiveMass;
-    if (isnan(impulse) != 0)
+    if (std::isnan(impulse) != 0)
     {
         std::cout << "ERROR::CollisionResolver::sequentialImpulse()::impulse is nan" << std::endl;
-        return;
+        return 0.0f;
     }
 
     /* 충격량의 누적값을 clamp */
@@ -78,18 +332,24 @@ void CollisionResolver::sequentialImpulse(Contact* contact, float deltaTime)
         contact->normalImpulseSum = 0.0f;
     impulse = contact->normalImpulseSum - prevImpulseSum;
 
+    /* 법선과 두 접선 방향 중 가장 크게 변한 충격량. 마찰이 아직 수렴하지 않았다면 반복을 멈추지 않는다 */
+    float maxImpulse = fabsf(impulse);
+
     /* 속도 & 각속도 변화 */
     Vector3 linearImpulse = contact->normal * impulse;
     Vector3 angularImpulse1 = contactPointFromCenter1.cross(contact->normal) * impulse;
     Vector3 angularImpulse2 = contactPointFromCenter2.cross(contact->normal) * impulse;
 
-    contact->bodies[0]->setVelocity(
-        contact->bodies[0]->getVelocity() + linearImpulse * contact->bodies[0]->getInverseMass()
-    );
-    contact->bodies[0]->setRotation(
-        contact->bodies[0]->getRotation() + contact->bodies[0]->getInverseInertiaTensorWorld() * angularImpulse1
-    );
-    if (contact->bodies[1] != nullptr)
+    if (!contact->bodies[0]->isFixed())
+    {
+        contact->bodies[0]->setVelocity(
+            contact->bodies[0]->getVelocity() + linearImpulse * contact->bodies[0]->getInverseMass()
+        );
+        contact->bodies[0]->setRotation(
+            contact->bodies[0]->getRotation() + contact->bodies[0]->getInverseInertiaTensorWorld() * angularImpulse1
+        );
+    }
+    if (contact->bodies[1] != nullptr && !contact->bodies[1]->isFixed())
     {
         contact->bodies[1]->setVelocity(
             contact->bodies[1]->getVelocity() - linearImpulse * contact->bodies[1]->getInverseMass()
@@ -99,13 +359,9 @@ void CollisionResolver::sequentialImpulse(Contact* contact, float deltaTime)
         );
     }
 
-    /* 충돌 법선에 수직하는 벡터 찾기(erin catto 방법) */
+    /* 충돌 법선에 수직하는 벡터 찾기 */
     Vector3 tangent1, tangent2;
-    if (contact->normal.x >= 0.57735f)
-        tangent1 = Vector3(contact->normal.y, -contact->normal.x, 0.0f);
-    else
-        tangent1 = Vector3(0.0f, contact->normal.z, -contact->normal.y);
-    tangent2 = contact->normal.cross(tangent1);
+    contact->calcTangents(tangent1, tangent2);
 
     /* tangent1 벡터에 대한 마찰 계산 */
     termInDenominator1 = (contact->bodies[0]->getInverseInertiaTensorWorld() * (contactPointFromCenter1.cross(tangent1)))
@@ -125,10 +381,10 @@ void CollisionResolver::sequentialImpulse(Contact* contact, float deltaTime)
             + contact->bodies[1]->getRotation().dot(contactPointFromCenter2.cross(tangent1));
     }
     impulse = -closingSpeed / effectiveMass;
-    if (isnan(impulse) != 0)
+    if (std::isnan(impulse) != 0)
     {
         std::cout << "ERROR::CollisionResolver::sequentialImpulse()::tangential impulse1 is nan" << std::endl;
-        return;
+        return maxImpulse;
     }
 
     /* 충격량의 누적값을 clamp */
@@ -139,19 +395,23 @@ void CollisionResolver::sequentialImpulse(Contact* contact, float deltaTime)
     else if (contact->tangentImpulseSum1 > (contact->friction * contact->normalImpulseSum))
         contact->tangentImpulseSum1 = contact->friction * contact->normalImpulseSum;
     impulse = contact->tangentImpulseSum1 - prevImpulseSum;
+    maxImpulse = fmaxf(maxImpulse, fabsf(impulse));
 
     /* 속도 & 각속도 변화 */
     linearImpulse = tangent1 * impulse;
     angularImpulse1 = contactPointFromCenter1.cross(tangent1) * impulse;
     angularImpulse2 = contactPointFromCenter2.cross(tangent1) * impulse;
 
-    contact->bodies[0]->setVelocity(
-        contact->bodies[0]->getVelocity() + linearImpulse * contact->bodies[0]->getInverseMass()
-    );
-    contact->bodies[0]->setRotation(
-        contact->bodies[0]->getRotation() + contact->bodies[0]->getInverseInertiaTensorWorld() * angularImpulse1
-    );
-    if (contact->bodies[1] != nullptr)
+    if (!contact->bodies[0]->isFixed())
+    {
+        contact->bodies[0]->setVelocity(
+            contact->bodies[0]->getVelocity() + linearImpulse * contact->bodies[0]->getInverseMass()
+        );
+        contact->bodies[0]->setRotation(
+            contact->bodies[0]->getRotation() + contact->bodies[0]->getInverseInertiaTensorWorld() * angularImpulse1
+        );
+    }
+    if (contact->bodies[1] != nullptr && !contact->bodies[1]->isFixed())
     {
         contact->bodies[1]->setVelocity(
             contact->bodies[1]->getVelocity() - linearImpulse * contact->bodies[1]->getInverseMass()
@@ -179,10 +439,10 @@ void CollisionResolver::sequentialImpulse(Contact* contact, float deltaTime)
             + contact->bodies[1]->getRotation().dot(contactPointFromCenter2.cross(tangent2));
     }
     impulse = -closingSpeed / effectiveMass;
-    if (isnan(impulse) != 0)
+    if (std::isnan(impulse) != 0)
     {
         std::cout << "ERROR::CollisionResolver::sequentialImpulse()::tangential impulse2 is nan" << std::endl;
-        return;
+        return maxImpulse;
     }
 
     /* 충격량의 누적값을 clamp */
@@ -193,19 +453,23 @@ void CollisionResolver::sequentialImpulse(Contact* contact, float deltaTime)
     else if (contact->tangentImpulseSum2 > (contact->friction * contact->normalImpulseSum))
         contact->tangentImpulseSum2 = contact->friction * contact->normalImpulseSum;
     impulse = contact->tangentImpulseSum2 - prevImpulseSum;
+    maxImpulse = fmaxf(maxImpulse, fabsf(impulse));
 
     /* 속도 & 각속도 변화 */
     linearImpulse = tangent2 * impulse;
     angularImpulse1 = contactPointFromCenter1.cross(tangent2) * impulse;
     angularImpulse2 = contactPointFromCenter2.cross(tangent2) * impulse;
 
-    contact->bodies[0]->setVelocity(
-        contact->bodies[0]->getVelocity() + linearImpulse * contact->bodies[0]->getInverseMass()
-    );
-    contact->bodies[0]->setRotation(
-        contact->bodies[0]->getRotation() + contact->bodies[0]->getInverseInertiaTensorWorld() * angularImpulse1
-    );
-    if (contact->bodies[1] != nullptr)
+    if (!contact->bodies[0]->isFixed())
+    {
+        contact->bodies[0]->setVelocity(
+            contact->bodies[0]->getVelocity() + linearImpulse * contact->bodies[0]->getInverseMass()
+        );
+        contact->bodies[0]->setRotation(
+            contact->bodies[0]->getRotation() + contact->bodies[0]->getInverseInertiaTensorWorld() * angularImpulse1
+        );
+    }
+    if (contact->bodies[1] != nullptr && !contact->bodies[1]->isFixed())
     {
         contact->bodies[1]->setVelocity(
             contact->bodies[1]->getVelocity() - linearImpulse * contact->bodies[1]->getInverseMass()
@@ -214,4 +478,6 @@ void CollisionResolver::sequentialImpulse(Contact* contact, float deltaTime)
             contact->bodies[1]->getRotation() - contact->bodies[1]->getInverseInertiaTensorWorld() * angularImpulse2
         );
     }
+
+    return maxImpulse;
 }
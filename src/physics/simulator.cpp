@@ -1,6 +1,5 @@
 #include <physics/simulator.h>
 #include <iterator>
-#include <typeinfo>
 #include <cmath>
 #include <iostream>
 
@@ -8,48 +7,69 @@ using namespace physics;
 
 Simulator::~Simulator()
 {
-    /* 충돌 정보 해제 */
-    for (auto& contact : contacts)
-        delete contact;
-    
-    /* 충돌체 해제 */
+    /* 충돌체 해제. 강체는 bodyStore 가 해제한다 */
     for (auto& collider : colliders)
         delete collider.second;
-    
-    /* 강체 해제 */
-    for (auto& body : bodies)
-        delete body.second;
+    for (TriangleMesh* mesh : triangleMeshes)
+        delete mesh;
+    delete heightfield;
 }
 
 void Simulator::simulate(float duration, std::vector<ContactInfo*>& contactInfo)
 {
-    /* 물체들을 적분한다 */
+    /* 이벤트나 직전 프레임의 충돌로 깨어난 강체가 있다면
+        그 강체가 속해 있던 잠든 island 를 모두 깨운다 */
+    for (auto& body : bodies)
+    {
+        if (body.second->isAwake() && body.second->sleepingIslandID != -1)
+            islandManager.wakeIsland(body.second);
+    }
+
+    /* 깨어 있는 물체들을 SIMD 폭만큼씩 묶어 적분한다 */
+    bodyStore.integrate(duration);
+
+    awakeBodies.clear();
     for (auto& body : bodies)
     {
-        body.second->integrate(duration);
+        if (!body.second->isAwake())
+            continue;
+
+        islandManager.updateSleepTime(body.second, duration);
+        awakeBodies.push_back(body.second);
     }
 
-    /* 물체 간 충돌을 검출한다 */
+    /* 빠르게 움직인 구가 스텝 도중 다른 물체를 뚫고 지나가지 않도록
+        처음 부딪힌 시각의 위치로 되돌린다 */
+    detector.detectTimeOfImpact(toiEvents, colliders, groundCollider, duration);
+
+    /* 물체 간 충돌을 검출한다. 이때 충돌체 트리도 갱신된다 */
     detector.detectCollision(contacts, colliders, groundCollider);
+    colliderTreeEditCount = bodyStore.getEditCount();
 
     /* 충돌 정보를 복사한다 */
     getContactInfo(contactInfo);
 
-    /* 충돌들을 처리한다 */
-    resolver.resolveCollision(contacts, duration);
-    for (auto& c : contacts)
-    {
-        for (auto& cp : c->contactPoint)
-            delete cp;
-        delete c;
-    }
+    /* 충돌로 이어진 island 들을 구한다.
+        잠든 강체와 충돌한 강체가 있다면 그 강체의 island 는 여기서 깨어난다 */
+    islandManager.buildIslands(awakeBodies, contacts);
+
+    /* island 별로 충돌들을 처리한다 */
+    resolver.resolveCollision(contacts, islandManager.getIslands(), duration);
+
+    /* 되돌린 구들만 해소된 속도로 남은 시간을 진행한다 */
+    detector.advanceTimeOfImpact(toiEvents, groundCollider);
+
+    /* 충분히 오래 멈춰 있던 island 를 재운다 */
+    islandManager.updateSleeping();
+
+    /* 할당된 공간은 다음 프레임에 재사용한다 */
     contacts.clear();
 }
 
 RigidBody* Simulator::addRigidBody(unsigned int id, Geometry geometry, float posX, float posY, float posZ)
 {
     /* 강체를 생성한다 */
-    RigidBody* newBody = new RigidBody;
+    RigidBody* newBody = bodyStore.createBody();
     newBody->setMass(5.0f);
     newBody->setPosition(posX, posY, posZ);
     newBody->setAcceleration(0.0f, -gravity, 0.0f);
@@ -66,6 +86,16 @@ RigidBody* Simulator::addRigidBody(unsigned int id, Geometry geometry, float pos
         float value = newBody->getMass() / 6.0f;
         inertiaTensor.setDiagonal(value);
     }
+    else if (geometry == CAPSULE)
+    {
+        /* 반지름 0.5, 원기둥 부분의 높이 1 인 캡슐 */
+        inertiaTensor = CapsuleCollider::calcInertiaTensor(newBody->getMass(), 0.5f, 0.5f);
+    }
+    else if (geometry == CYLINDER)
+    {
+        /* 반지름 0.5, 높이 1 인 원기둥 */
+        inertiaTensor = CylinderCollider::calcInertiaTensor(newBody->getMass(), 0.5f, 0.5f);
+    }
     newBody->setInertiaTensor(inertiaTensor);
 
     bodies[id] = newBody;
@@ -80,11 +110,53 @@ Collider* Simulator::addCollider(unsigned int id, Geometry geometry, RigidBody*
         newCollider = new SphereCollider(body, 1.0f);
     else if (geometry == BOX)
         newCollider = new BoxCollider(body, 0.5f, 0.5f, 0.5f);
+    else if (geometry == CAPSULE)
+        newCollider = new CapsuleCollider(body, 0.5f, 0.5f);
+    else // CYLINDER
+        newCollider = new CylinderCollider(body, 0.5f, 0.5f);
     
+    newCollider->id = id;
     colliders[id] = newCollider;
+    detector.addCollider(newCollider);
     return newCollider;
 }
 
+TriangleMesh* Simulator::addTriangleMesh(const std::string& path, const Vector3& offset)
+{
+    TriangleMesh* newMesh = new TriangleMesh;
+    if (!newMesh->loadOBJ(path, offset))
+    {
+        delete newMesh;
+        return nullptr;
+    }
+
+    triangleMeshes.push_back(newMesh);
+    detector.addTriangleMesh(newMesh);
+    return newMesh;
+}
+
+HeightfieldCollider* Simulator::setHeightfield(
+    int columnCount,
+    int rowCount,
+    float cellSize,
+    const Vector3& origin,
+    const std::vector<float>& heights
+)
+{
+    removeHeightfield();
+
+    heightfield = new HeightfieldCollider(columnCount, rowCount, cellSize, origin, heights);
+    detector.setHeightfield(heightfield);
+    return heightfield;
+}
+
+void Simulator::removeHeightfield()
+{
+    detector.setHeightfield(nullptr);
+    delete heightfield;
+    heightfield = nullptr;
+}
+
 void Simulator::removePhysicsObject(unsigned int id)
 {
     RigidBodies::iterator bodyIter = bodies.find(id);
@@ -92,7 +164,9 @@ void Simulator::removePhysicsObject(unsigned int id)
 
     if (bodyIter != bodies.end())
     {
-        delete bodyIter->second;
+        resolver.removeBody(bodyIter->second);
+        islandManager.removeBody(bodyIter->second);
+        bodyStore.destroyBody(bodyIter->second);
         bodies.erase(bodyIter);
     }
     else
@@ -100,6 +174,7 @@ void Simulator::removePhysicsObject(unsigned int id)
     
     if (colliderIter != colliders.end())
     {
+        detector.removeCollider(colliderIter->second);
         delete colliderIter->second;
         colliders.erase(colliderIter);
     }
@@ -107,45 +182,97 @@ void Simulator::removePhysicsObject(unsigned int id)
         std::cout << "ERROR::Simulator::removePhysicsObject()::can't find Collider id: " << id << std::endl;
 }
 
+RigidBody* Simulator::getRigidBody(unsigned int id) const
+{
+    RigidBodies::const_iterator bodyIter = bodies.find(id);
+    return bodyIter != bodies.end() ? bodyIter->second : nullptr;
+}
+
+Collider* Simulator::getCollider(unsigned int id) const
+{
+    Colliders::const_iterator colliderIter = colliders.find(id);
+    return colliderIter != colliders.end() ? colliderIter->second : nullptr;
+}
+
 float Simulator::calcDistanceBetweenRayAndObject(
     const Vector3& rayOrigin,
     const Vector3& rayDirection,
     const unsigned int id
 )
 {
-    float distance;
-    Collider* collider = colliders.find(id)->second;
+    float distance = -1.0f;
+    Colliders::iterator colliderIter = colliders.find(id);
+    if (colliderIter == colliders.end())
+    {
+        std::cout << "ERROR::Simulator::calcDistanceBetweenRayAndObject()::can't find Collider id: " << id << std::endl;
+        return distance;
+    }
 
-    if (typeid(*collider) == typeid(SphereCollider))
+    Collider* collider = colliderIter->second;
+    if (collider->geometry == SPHERE)
     {
         SphereCollider* sphere = static_cast<SphereCollider*>(collider);
         distance = detector.rayAndSphere(rayOrigin, rayDirection, *sphere);
     }
-    else if (typeid(*collider) == typeid(BoxCollider))
+    else if (collider->geometry == BOX)
     {
         BoxCollider* box = static_cast<BoxCollider*>(collider);
         distance = detector.rayAndBox(rayOrigin, rayDirection, *box);
     }
+    else if (collider->geometry == CAPSULE)
+    {
+        CapsuleCollider* capsule = static_cast<CapsuleCollider*>(collider);
+        distance = detector.rayAndCapsule(rayOrigin, rayDirection, *capsule);
+    }
+    else if (collider->geometry == CYLINDER)
+    {
+        CylinderCollider* cylinder = static_cast<CylinderCollider*>(collider);
+        distance = detector.rayAndCylinder(rayOrigin, rayDirection, *cylinder);
+    }
 
     return distance;
 }
 
+bool Simulator::castRay(
+    const Vector3& rayOrigin,
+    const Vector3& rayDirection,
+    unsigned int& hitID,
+    float& hitDistance
+)
+{
+    /* 마지막 스텝 이후 옮겨지거나 크기가 바뀐 물체가 있을 때만 트리를 갱신한다.
+        그렇지 않다면 스텝에서 갱신한 트리를 그대로 쓴다 */
+    if (bodyStore.getEditCount() != colliderTreeEditCount)
+    {
+        detector.updateColliderTree(colliders);
+        colliderTreeEditCount = bodyStore.getEditCount();
+    }
+
+    Collider* hitCollider;
+    if (!detector.castRay(rayOrigin, rayDirection, hitCollider, hitDistance))
+        return false;
+
+    hitID = hitCollider->id;
+    return true;
+}
+
 void Simulator::getContactInfo(std::vector<ContactInfo*>& contactInfo) const
 {
     for (const auto& contact : contacts)
     {
-        for (const auto& cp : contact->contactPoint)
+        /* 지면과의 충돌은 충돌점이 하나이다 */
+        int contactPointCount = contact.bodies[1] == nullptr ? 1 : 2;
+        for (int i = 0; i < contactPointCount; ++i)
         {
-            if (cp == nullptr)
-                continue;
-                
+            const Vector3& cp = contact.contactPoint[i];
+
             ContactInfo* newContactInfo = new ContactInfo;
-            newContactInfo->pointX = cp->x;
-            newContactInfo->pointY = cp->y;
-            newContactInfo->pointZ = cp->z;
-            newContactInfo->normalX = contact->normal.x;
-            newContactInfo->normalY = contact->normal.y;
-            newContactInfo->normalZ = contact->normal.z;
+            newContactInfo->pointX = cp.x;
+            newContactInfo->pointY = cp.y;
+            newContactInfo->pointZ = cp.z;
+            newContactInfo->normalX = contact.normal.x;
+            newContactInfo->normalY = contact.normal.y;
+            newContactInfo->normalZ = contact.normal.z;
             contactInfo.push_back(newContactInfo);
         }
     }
@@ -161,6 +288,61 @@ void Simulator::setObjectRestitution(float value)
     detector.objectRestitution = value;
 }
 
+void Simulator::setBroadPhaseMode(BroadPhaseMode mode)
+{
+    detector.setBroadPhaseMode(mode);
+}
+
+void Simulator::setSpatialHashCellSize(float value)
+{
+    detector.setSpatialHashCellSize(value);
+}
+
+void Simulator::setWarmStarting(bool value)
+{
+    resolver.setWarmStarting(value);
+}
+
+void Simulator::setCCDEnabled(bool value)
+{
+    detector.setCCDEnabled(value);
+}
+
+void Simulator::setCCDMotionThreshold(float threshold)
+{
+    detector.setCCDMotionThreshold(threshold);
+}
+
+void Simulator::setSphereBatchEnabled(bool value)
+{
+    detector.setSphereBatchEnabled(value);
+}
+
+void Simulator::setThreadCount(unsigned int count)
+{
+    resolver.setThreadCount(count);
+}
+
+void Simulator::setSolverMode(SolverMode mode)
+{
+    resolver.setSolverMode(mode);
+}
+
+void Simulator::setSleepingEnabled(bool value)
+{
+    islandManager.setSleepingEnabled(value);
+}
+
+void Simulator::setSleepThresholds(float linear, float angular)
+{
+    islandManager.setSleepThresholds(linear, angular);
+}
+
+void Simulator::setTimeToSleep(float value)
+{
+    islandManager.setTimeToSleep(value);
+}
+
 void Simulator::setGravity(float value)
 {
     gravity = value;
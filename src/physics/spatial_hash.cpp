@@ -0,0 +1,151 @@
+#include <physics/spatial_hash.h>
+#include <cmath>
+#include <iostream>
+
+using namespace physics;
+
+void SpatialHashGrid::setCellSize(float value)
+{
+    /* 0 이하이거나 유한하지 않은 크기로는 셀 인덱스를 구할 수 없다 */
+    if (!(value > 0.0f) || !std::isfinite(value))
+    {
+        std::cout << "ERROR::SpatialHashGrid::setCellSize()::invalid cell size: " << value << std::endl;
+        return;
+    }
+    cellSize = value;
+}
+
+void SpatialHashGrid::findPairs(
+    std::unordered_map<unsigned int, Collider*>& colliders,
+    std::vector<ColliderPair>& pairs
+)
+{
+    /* 충돌체들의 AABB 를 계산한다 */
+    proxies.clear();
+    for (auto& collider : colliders)
+    {
+        Proxy proxy;
+        proxy.collider = collider.second;
+        proxy.aabb = collider.second->calcAABB();
+        proxies.push_back(proxy);
+    }
+
+    /* AABB 가 걸치는 모든 셀에 충돌체를 등록한다.
+        너무 많은 셀에 걸치는 충돌체는 격자 대신 largeProxies 에 모은다 */
+    entries.clear();
+    largeProxies.clear();
+    for (unsigned int i = 0; i < proxies.size(); ++i)
+    {
+        const AABB& aabb = proxies[i].aabb;
+        int minX, maxX, minY, maxY, minZ, maxZ;
+        if (!calcCellRange(aabb.min.x, aabb.max.x, minX, maxX)
+            || !calcCellRange(aabb.min.y, aabb.max.y, minY, maxY)
+            || !calcCellRange(aabb.min.z, aabb.max.z, minZ, maxZ)
+            || (maxX - minX + 1) * (maxY - minY + 1) * (maxZ - minZ + 1) > maxCellsPerProxy)
+        {
+            largeProxies.push_back(i);
+            continue;
+        }
+
+        for (int x = minX; x <= maxX; ++x)
+            for (int y = minY; y <= maxY; ++y)
+                for (int z = minZ; z <= maxZ; ++z)
+                {
+                    CellEntry entry = {x, y, z, i, -1};
+                    entries.push_back(entry);
+                }
+    }
+
+    /* 항목 수의 두 배 이상인 2 의 거듭제곱 크기로 해시 테이블을 만든다 */
+    unsigned int bucketCount = 16;
+    while (bucketCount < entries.size() * 2)
+        bucketCount <<= 1;
+    buckets.assign(bucketCount, -1);
+
+    for (unsigned int i = 0; i < entries.size(); ++i)
+    {
+        CellEntry& entry = entries[i];
+        unsigned int bucketIdx = calcBucketIndex(entry.cellX, entry.cellY, entry.cellZ);
+        entry.next = buckets[bucketIdx];
+        buckets[bucketIdx] = i;
+    }
+
+    /* 각 항목을 같은 버킷 안의 뒤따르는 항목들과 비교한다 */
+    for (unsigned int i = 0; i < entries.size(); ++i)
+    {
+        const CellEntry& entry = entries[i];
+        for (int j = entry.next; j != -1; j = entries[j].next)
+        {
+            const CellEntry& other = entries[j];
+
+            /* 해시 충돌로 같은 버킷에 들어온 다른 셀은 건너뛴다 */
+            if (entry.cellX != other.cellX || entry.cellY != other.cellY || entry.cellZ != other.cellZ)
+                continue;
+            if (entry.proxyIdx == other.proxyIdx)
+                continue;
+
+            const AABB& aabb1 = proxies[entry.proxyIdx].aabb;
+            const AABB& aabb2 = proxies[other.proxyIdx].aabb;
+            if (!aabb1.overlaps(aabb2))
+                continue;
+
+            /* 두 AABB 의 교집합의 최소 꼭짓점이 들어 있는 셀에서만 쌍을 저장한다.
+                여러 셀을 공유하는 쌍이 중복 저장되지 않는다 */
+            int ownerX = calcCellIndex(aabb1.min.x > aabb2.min.x ? aabb1.min.x : aabb2.min.x);
+            int ownerY = calcCellIndex(aabb1.min.y > aabb2.min.y ? aabb1.min.y : aabb2.min.y);
+            int ownerZ = calcCellIndex(aabb1.min.z > aabb2.min.z ? aabb1.min.z : aabb2.min.z);
+            if (ownerX != entry.cellX || ownerY != entry.cellY || ownerZ != entry.cellZ)
+                continue;
+
+            pairs.push_back(ColliderPair(proxies[entry.proxyIdx].collider, proxies[other.proxyIdx].collider));
+        }
+    }
+
+    /* 격자에 등록하지 않은 충돌체는 다른 모든 충돌체와 비교한다.
+        둘 다 largeProxies 에 있는 쌍은 한 번만 비교하도록 앞쪽의 것은 건너뛴다 */
+    for (unsigned int i = 0; i < largeProxies.size(); ++i)
+    {
+        const Proxy& large = proxies[largeProxies[i]];
+        unsigned int nextLarge = 0;
+        for (unsigned int j = 0; j < proxies.size(); ++j)
+        {
+            if (nextLarge < largeProxies.size() && largeProxies[nextLarge] == j)
+            {
+                ++nextLarge;
+                if (nextLarge <= i + 1)
+                    continue;
+            }
+
+            if (large.aabb.overlaps(proxies[j].aabb))
+                pairs.push_back(ColliderPair(large.collider, proxies[j].collider));
+        }
+    }
+}
+
+int SpatialHashGrid::calcCellIndex(float value) const
+{
+    return (int)floorf(value / cellSize);
+}
+
+bool SpatialHashGrid::calcCellRange(float minValue, float maxValue, int& minCell, int& maxCell) const
+{
+    /* 유한하지 않은 좌표는 차이가 무한대나 nan 이 되어 아래 비교에서 걸러진다 */
+    float minIndex = floorf(minValue / cellSize);
+    float maxIndex = floorf(maxValue / cellSize);
+    if (!(maxIndex - minIndex < (float)maxCellsPerProxy))
+        return false;
+    if (!(fabsf(minIndex) < 1.0e9f && fabsf(maxIndex) < 1.0e9f))
+        return false;
+
+    minCell = (int)minIndex;
+    maxCell = (int)maxIndex;
+    return true;
+}
+
+unsigned int SpatialHashGrid::calcBucketIndex(int cellX, int cellY, int cellZ) const
+{
+    unsigned int hash = ((unsigned int)cellX * 73856093u)
+        ^ ((unsigned int)cellY * 19349663u)
+        ^ ((unsigned int)cellZ * 83492791u);
+    return hash & (buckets.size() - 1);
+}
@@ -0,0 +1,89 @@
+#include <physics/thread_pool.h>
+
+using namespace physics;
+
+ThreadPool::~ThreadPool()
+{
+    stopWorkers();
+}
+
+void ThreadPool::setThreadCount(unsigned int count)
+{
+    if (count == 0)
+        count = 1;
+    if (count == getThreadCount())
+        return;
+
+    stopWorkers();
+    for (unsigned int i = 1; i < count; ++i)
+        workers.push_back(std::thread(&ThreadPool::workerLoop, this, generation));
+}
+
+void ThreadPool::parallelFor(unsigned int count, const std::function<void(unsigned int)>& _task)
+{
+    /* 스레드가 없거나 작업이 하나뿐이라면 그냥 실행한다 */
+    if (workers.empty() || count <= 1)
+    {
+        for (unsigned int i = 0; i < count; ++i)
+            _task(i);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        task = &_task;
+        taskCount = count;
+        nextTaskIndex = 0;
+        busyWorkerCount = workers.size();
+        ++generation;
+    }
+    taskCondition.notify_all();
+
+    runTasks();
+
+    /* 모든 worker 가 작업을 마칠 때까지 기다린다 */
+    std::unique_lock<std::mutex> lock(mutex);
+    doneCondition.wait(lock, [this]{ return busyWorkerCount == 0; });
+    task = nullptr;
+}
+
+void ThreadPool::stopWorkers()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        isStopping = true;
+    }
+    taskCondition.notify_all();
+
+    for (auto& worker : workers)
+        worker.join();
+    workers.clear();
+    isStopping = false;
+}
+
+void ThreadPool::workerLoop(unsigned int localGeneration)
+{
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            taskCondition.wait(lock, [&]{ return isStopping || generation != localGeneration; });
+            if (isStopping)
+                return;
+            localGeneration = generation;
+        }
+
+        runTasks();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--busyWorkerCount == 0)
+            doneCondition.notify_one();
+    }
+}
+
+void ThreadPool::runTasks()
+{
+    unsigned int index;
+    while ((index = nextTaskIndex.fetch_add(1)) < taskCount)
+        (*task)(index);
+}
@@ -0,0 +1,253 @@
+#include <physics/triangle_mesh.h>
+#include <algorithm>
+#include <cmath>
+#include <cfloat>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+using namespace physics;
+
+bool TriangleMesh::loadOBJ(const std::string& path, const Vector3& offset)
+{
+    std::ifstream file(path.c_str());
+    if (!file.is_open())
+    {
+        std::cout << "ERROR::TriangleMesh::loadOBJ()::can't open " << path << std::endl;
+        return false;
+    }
+
+    std::vector<Vector3> vertices;
+    std::vector<int> face;
+    std::string line;
+    unsigned int lineNumber = 0;
+    while (std::getline(file, line))
+    {
+        ++lineNumber;
+        line = line.substr(0, line.find('#'));
+
+        std::istringstream stream(line);
+        std::string command;
+        if (!(stream >> command))
+            continue;
+
+        if (command == "v")
+        {
+            Vector3 vertex;
+            if (!(stream >> vertex.x >> vertex.y >> vertex.z))
+            {
+                std::cout << "ERROR::TriangleMesh::loadOBJ()::invalid vertex at line " << lineNumber << std::endl;
+                return false;
+            }
+            vertices.push_back(vertex + offset);
+        }
+        else if (command == "f")
+        {
+            /* 정점은 v, v/vt, v//vn, v/vt/vn 형식이며 위치 인덱스만 사용한다.
+                음수 인덱스는 지금까지 읽은 정점의 끝에서부터 센다 */
+            face.clear();
+            std::string token;
+            while (stream >> token)
+            {
+                int index = atoi(token.substr(0, token.find('/')).c_str());
+                if (index < 0)
+                    index += vertices.size();
+                else
+                    index -= 1;
+
+                if (index < 0 || index >= (int)vertices.size())
+                {
+                    std::cout << "ERROR::TriangleMesh::loadOBJ()::invalid index at line " << lineNumber << std::endl;
+                    return false;
+                }
+                face.push_back(index);
+            }
+
+            for (int i = 1; i + 1 < (int)face.size(); ++i)
+                addTriangle(vertices[face[0]], vertices[face[i]], vertices[face[i + 1]]);
+        }
+    }
+
+    if (triangles.empty())
+    {
+        std::cout << "ERROR::TriangleMesh::loadOBJ()::no faces in " << path << std::endl;
+        return false;
+    }
+
+    build();
+    return true;
+}
+
+void TriangleMesh::addTriangle(const Vector3& v0, const Vector3& v1, const Vector3& v2)
+{
+    Vector3 normal = (v1 - v0).cross(v2 - v0);
+    /* 넓이가 없는 삼각형은 법선을 정할 수 없으므로 버린다 */
+    if (normal.magnitudeSquared() < 1e-12f)
+        return;
+    normal.normalize();
+
+    Triangle triangle;
+    triangle.vertices[0] = v0;
+    triangle.vertices[1] = v1;
+    triangle.vertices[2] = v2;
+    triangle.normal = normal;
+    triangles.push_back(triangle);
+}
+
+void TriangleMesh::build()
+{
+    nodes.clear();
+    if (triangles.empty())
+        return;
+
+    /* 노드 수는 리프 수의 두 배를 넘지 않는다 */
+    nodes.reserve(2 * (triangles.size() / (maxLeafSize / 2) + 1));
+    buildNode(0, triangles.size());
+
+    /* 트리를 만들며 삼각형의 순서가 바뀌므로 그 뒤에 찾는다 */
+    findNeighbors();
+}
+
+int TriangleMesh::buildNode(int first, int count)
+{
+    int nodeID = nodes.size();
+    nodes.push_back(Node());
+
+    /* 삼각형들과 그 중심들을 감싸는 AABB */
+    Vector3 boundsMin(FLT_MAX, FLT_MAX, FLT_MAX);
+    Vector3 boundsMax(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+    Vector3 centroidMin = boundsMin;
+    Vector3 centroidMax = boundsMax;
+    for (int i = first; i < first + count; ++i)
+    {
+        const Triangle& triangle = triangles[i];
+        Vector3 centroid;
+        for (int j = 0; j < 3; ++j)
+        {
+            const Vector3& vertex = triangle.vertices[j];
+            boundsMin = Vector3(fminf(boundsMin.x, vertex.x), fminf(boundsMin.y, vertex.y), fminf(boundsMin.z, vertex.z));
+            boundsMax = Vector3(fmaxf(boundsMax.x, vertex.x), fmaxf(boundsMax.y, vertex.y), fmaxf(boundsMax.z, vertex.z));
+            centroid += vertex;
+        }
+        centroid *= 1.0f / 3.0f;
+        centroidMin = Vector3(fminf(centroidMin.x, centroid.x), fminf(centroidMin.y, centroid.y), fminf(centroidMin.z, centroid.z));
+        centroidMax = Vector3(fmaxf(centroidMax.x, centroid.x), fmaxf(centroidMax.y, centroid.y), fmaxf(centroidMax.z, centroid.z));
+    }
+    nodes[nodeID].aabb = AABB(boundsMin, boundsMax);
+
+    if (count <= maxLeafSize)
+    {
+        nodes[nodeID].child2 = -1;
+        nodes[nodeID].firstTriangle = first;
+        nodes[nodeID].triangleCount = count;
+        return nodeID;
+    }
+
+    /* 중심들이 가장 넓게 퍼진 축을 따라 중앙값으로 나눈다 */
+    Vector3 extent = centroidMax - centroidMin;
+    int axis = 0;
+    if (extent.y > extent[axis])
+        axis = 1;
+    if (extent.z > extent[axis])
+        axis = 2;
+
+    int half = count / 2;
+    std::nth_element(
+        triangles.begin() + first,
+        triangles.begin() + first + half,
+        triangles.begin() + first + count,
+        [axis](const Triangle& a, const Triangle& b) {
+            return a.vertices[0][axis] + a.vertices[1][axis] + a.vertices[2][axis]
+                < b.vertices[0][axis] + b.vertices[1][axis] + b.vertices[2][axis];
+        }
+    );
+
+    /* 왼쪽 자식을 먼저 만들어 바로 다음 인덱스에 둔다 */
+    buildNode(first, half);
+    int child2 = buildNode(first + half, count - half);
+
+    nodes[nodeID].child2 = child2;
+    nodes[nodeID].firstTriangle = 0;
+    nodes[nodeID].triangleCount = 0;
+    return nodeID;
+}
+
+namespace
+{
+    /* 두 정점을 좌표 순서로 정렬해 저장한 변 */
+    struct EdgeKey
+    {
+        float coordinates[6];
+        int triangle;
+        int edge;
+
+        bool operator<(const EdgeKey& other) const
+        {
+            return std::lexicographical_compare(coordinates, coordinates + 6, other.coordinates, other.coordinates + 6);
+        }
+        bool isSameEdge(const EdgeKey& other) const
+        {
+            return std::equal(coordinates, coordinates + 6, other.coordinates);
+        }
+    };
+
+    bool isLess(const Vector3& a, const Vector3& b)
+    {
+        if (a.x != b.x)
+            return a.x < b.x;
+        if (a.y != b.y)
+            return a.y < b.y;
+        return a.z < b.z;
+    }
+}
+
+void TriangleMesh::findNeighbors()
+{
+    std::vector<EdgeKey> edges;
+    edges.reserve(triangles.size() * 3);
+    for (int i = 0; i < (int)triangles.size(); ++i)
+    {
+        for (int j = 0; j < 3; ++j)
+        {
+            const Vector3* a = &triangles[i].vertices[j];
+            const Vector3* b = &triangles[i].vertices[(j + 1) % 3];
+            if (isLess(*b, *a))
+                std::swap(a, b);
+
+            EdgeKey key = {{a->x, a->y, a->z, b->x, b->y, b->z}, i, j};
+            edges.push_back(key);
+            triangles[i].neighborDirections[j] = Vector3();
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+
+    for (int first = 0; first < (int)edges.size();)
+    {
+        int last = first + 1;
+        while (last < (int)edges.size() && edges[last].isSameEdge(edges[first]))
+            ++last;
+
+        /* 정확히 두 삼각형이 공유하는 변만 이웃으로 본다 */
+        if (last - first == 2)
+        {
+            for (int k = 0; k < 2; ++k)
+            {
+                Triangle& triangle = triangles[edges[first + k].triangle];
+                const Triangle& neighbor = triangles[edges[first + 1 - k].triangle];
+                int neighborEdge = edges[first + 1 - k].edge;
+
+                /* 이웃의 면 위에서 변과 수직이고 이웃의 세 번째 정점 쪽을 향하는 방향 */
+                const Vector3& edgeStart = neighbor.vertices[neighborEdge];
+                Vector3 edgeDirection = neighbor.vertices[(neighborEdge + 1) % 3] - edgeStart;
+                Vector3 direction = neighbor.normal.cross(edgeDirection);
+                if (direction.dot(neighbor.vertices[(neighborEdge + 2) % 3] - edgeStart) < 0.0f)
+                    direction *= -1.0f;
+                direction.normalize();
+
+                triangle.neighborDirections[edges[first + k].edge] = direction;
+            }
+        }
+        first = last;
+    }
+}
@@ -1,57 +1,215 @@
 #include <playground/event_queue.h>
 
-EventQueue::EventQueue(int _size)
+EventQueue::EventQueue(int _blockCapacity)
 {
-    size = _size;
-    elements = new Event*[_size];
-    front = rear = 0;
+    blockCapacity = _blockCapacity;
+
+    /* 블록 하나가 자기 자신을 가리키는 원형 리스트로 시작한다 */
+    Block* block = new Block(blockCapacity);
+    block->next.store(block);
+    headBlock.store(block);
+    tailBlock.store(block);
 }
 
 EventQueue::~EventQueue()
 {
-    while (!isEmpty())
-        delete pop();
-    delete[] elements;
+    Block* first = headBlock.load();
+    Block* block = first;
+    do
+    {
+        Block* next = block->next.load();
+        delete block;
+        block = next;
+    } while (block != first);
+}
+
+void EventQueue::push(const Event& event)
+{
+    Block* block = tailBlock.load(std::memory_order_relaxed);
+    if (block->events.push(event))
+        return;
+
+    /* 현재 블록이 가득 찼다. 다음 블록은 소비자가 이미 비우고 지나간 블록이거나
+        소비자가 읽고 있는 블록이다. 후자라면 그 사이에 새 블록을 끼워 넣는다 */
+    Block* next = block->next.load(std::memory_order_relaxed);
+    if (next == headBlock.load(std::memory_order_acquire))
+    {
+        Block* newBlock = new Block(blockCapacity);
+        newBlock->next.store(next, std::memory_order_relaxed);
+        block->next.store(newBlock, std::memory_order_release);
+        next = newBlock;
+    }
+
+    next->events.push(event);
+    tailBlock.store(next, std::memory_order_release);
+}
+
+bool EventQueue::pop(Event& event)
+{
+    Block* block = headBlock.load(std::memory_order_relaxed);
+    while (true)
+    {
+        if (block->events.pop(event))
+            return true;
+
+        /* 생산자가 아직 이 블록에 쓰고 있다면 정말로 비어 있는 것이다 */
+        if (tailBlock.load(std::memory_order_acquire) == block)
+            return false;
+
+        /* 생산자가 떠난 블록이다. 떠나기 직전에 넣은 이벤트가 남아 있을 수 있으므로 한 번 더 확인한다 */
+        if (block->events.pop(event))
+            return true;
+
+        block = block->next.load(std::memory_order_acquire);
+        headBlock.store(block, std::memory_order_release);
+    }
 }
 
 bool EventQueue::isEmpty() const
 {
-    if (front == rear)
-        return true;
-    else
-        return false;
+    Block* block = headBlock.load(std::memory_order_relaxed);
+    return block->events.isEmpty() && tailBlock.load(std::memory_order_acquire) == block;
 }
 
-bool EventQueue::isFull() const
+void EventQueue::popAll(std::vector<Event>& events)
 {
-    if (front == (rear+1) % size)
-        return true;
-    else
-        return false;
+    events.clear();
+
+    Event event;
+    while (pop(event))
+        events.push_back(event);
+
+    coalesce(events);
 }
 
-void EventQueue::push(Event* newElement)
+void EventQueue::coalesce(std::vector<Event>& events)
 {
-    if (isFull())
+    /* 마지막 경계 이벤트 다음부터가 지금 합칠 수 있는 구간이다 */
+    size_t segmentBegin = 0;
+    for (size_t i = 0; i < events.size(); ++i)
     {
-        std::cout << "EventQueue::push()::Queue is already full" << std::endl;
-        return;
+        if (isBarrier(events[i]))
+        {
+            segmentBegin = i + 1;
+            continue;
+        }
+
+        /* 가장 가까운 앞선 이벤트부터 거슬러 올라간다 */
+        for (size_t j = i; j-- > segmentBegin;)
+        {
+            if (events[j].type != events[i].type)
+                continue;
+
+            if (events[i].type == OBJECT_ROTATED)
+            {
+                /* 회전은 순서를 바꿀 수 없으므로 같은 물체의 바로 앞 회전이 같은 축일 때만 합친다.
+                    다른 축 회전이 끼어 있다면 합치지 않고 그대로 둔다 */
+                if (events[j].objectRotated.id != events[i].objectRotated.id)
+                    continue;
+                if (!hasSameTarget(events[j], events[i]))
+                    break;
+            }
+            else if (!hasSameTarget(events[j], events[i]))
+                continue;
+
+            if (isAccumulative(events[i]))
+            {
+                /* 앞선 이벤트에 값을 더하고 지금 이벤트를 버린다 */
+                accumulate(events[j], events[i]);
+                events[i].type = EMPTY_EVENT;
+            }
+            else
+            {
+                /* 나중 값이 앞선 값을 덮어쓰므로 앞선 이벤트를 버린다 */
+                events[j].type = EMPTY_EVENT;
+            }
+            break;
+        }
     }
 
-    elements[rear] = newElement;
-    rear = (rear+1) % size;
+    /* 버린 이벤트를 빼고 순서대로 당겨 담는다 */
+    size_t count = 0;
+    for (size_t i = 0; i < events.size(); ++i)
+    {
+        if (events[i].type != EMPTY_EVENT)
+            events[count++] = events[i];
+    }
+    events.resize(count);
+}
+
+bool EventQueue::isBarrier(const Event& event)
+{
+    switch (event.type)
+    {
+    case EMPTY_EVENT:
+    case OBJECT_POSITION_CHANGED:
+    case OBJECT_VELOCITY_CHANGED:
+    case OBJECT_GEOMETRIC_DATA_CHANGED:
+    case OBJECT_MASS_CHANGED:
+    case GROUND_RESTITUTION_CHANGED:
+    case OBJECT_RESTITUTION_CHANGED:
+    case GRAVITY_CHANGED:
+    case TIME_STEP_CHANGED:
+    case RENDER_CONTACT_INFO_FLAG_CHANGED:
+    case SHOULD_RENDER_WORLD_AXIS:
+    case LEFT_MOUSE_DRAGGED_ON_SCENE:
+    case MOUSE_WHEEL_ON_SCENE:
+    case OBJECT_ROTATED:
+        return false;
+    default:
+        return true;
+    }
 }
 
-Event* EventQueue::pop()
+bool EventQueue::hasSameTarget(const Event& a, const Event& b)
 {
-    if (isEmpty())
+    switch (a.type)
     {
-        std::cout << "EventQueue::pop()::Queue is already empty" << std::endl;
-        return nullptr;
+    case OBJECT_POSITION_CHANGED:
+        return a.objectPositionChanged.id == b.objectPositionChanged.id;
+    case OBJECT_VELOCITY_CHANGED:
+        return a.objectVelocityChanged.id == b.objectVelocityChanged.id;
+    case OBJECT_GEOMETRIC_DATA_CHANGED:
+        return a.objectGeometricDataChanged.id == b.objectGeometricDataChanged.id;
+    case OBJECT_MASS_CHANGED:
+        return a.objectMassChanged.id == b.objectMassChanged.id;
+    case SHOULD_RENDER_WORLD_AXIS:
+        return a.shouldRenderWorldAxis.id == b.shouldRenderWorldAxis.id
+            && a.shouldRenderWorldAxis.axisIdx == b.shouldRenderWorldAxis.axisIdx;
+    case OBJECT_ROTATED:
+        /* 같은 축에 대한 회전만 각도를 더해 합칠 수 있다 */
+        return a.objectRotated.id == b.objectRotated.id
+            && a.objectRotated.axisX == b.objectRotated.axisX
+            && a.objectRotated.axisY == b.objectRotated.axisY
+            && a.objectRotated.axisZ == b.objectRotated.axisZ;
+    default:
+        /* 대상이 없는 전역 설정과 카메라 이벤트 */
+        return true;
     }
+}
 
-    Event* result = elements[front];
-    front = (front+1) % size;
+bool EventQueue::isAccumulative(const Event& event)
+{
+    return event.type == LEFT_MOUSE_DRAGGED_ON_SCENE
+        || event.type == MOUSE_WHEEL_ON_SCENE
+        || event.type == OBJECT_ROTATED;
+}
 
-    return result;
+void EventQueue::accumulate(Event& to, const Event& from)
+{
+    switch (to.type)
+    {
+    case LEFT_MOUSE_DRAGGED_ON_SCENE:
+        to.leftMouseDraggedOnScene.xOffset += from.leftMouseDraggedOnScene.xOffset;
+        to.leftMouseDraggedOnScene.yOffset += from.leftMouseDraggedOnScene.yOffset;
+        break;
+    case MOUSE_WHEEL_ON_SCENE:
+        to.mouseWheelOnScene.value += from.mouseWheelOnScene.value;
+        break;
+    case OBJECT_ROTATED:
+        to.objectRotated.degree += from.objectRotated.degree;
+        break;
+    default:
+        break;
+    }
 }
@@ -3,15 +3,13 @@
 
 void Object::getPositionInArray(float (&array)[3]) const
 {
-    physics::Vector3 position = body->getPosition();
-    array[0] = position.x;
-    array[1] = position.y;
-    array[2] = position.z;
+    array[0] = curPosition.x;
+    array[1] = curPosition.y;
+    array[2] = curPosition.z;
 }
 
 void Object::getVelocityInArray(float (&array)[3]) const
 {
-    physics::Vector3 velocity = body->getVelocity();
     array[0] = velocity.x;
     array[1] = velocity.y;
     array[2] = velocity.z;
@@ -19,7 +17,6 @@ void Object::getVelocityInArray(float (&array)[3]) const
 
 void Object::getRotationInArray(float (&array)[3]) const
 {
-    physics::Vector3 rotation = body->getRotation();
     array[0] = rotation.x;
     array[1] = rotation.y;
     array[2] = rotation.z;
@@ -27,7 +24,6 @@ void Object::getRotationInArray(float (&array)[3]) const
 
 void Object::getAccelerationInArray(float (&array)[3]) const
 {
-    physics::Vector3 acceleration = body->getAcceleration();
     array[0] = acceleration.x;
     array[1] = acceleration.y;
     array[2] = acceleration.z;
@@ -35,10 +31,52 @@ void Object::getAccelerationInArray(float (&array)[3]) const
 
 void Object::getMassInArray(float (&array)[3]) const
 {
-    float mass = body->getMass();
     array[0] = mass;
 }
 
+void Object::updateState(const BodySnapshot& snapshot)
+{
+    prevPosition = snapshot.prevPosition;
+    curPosition = snapshot.position;
+    prevOrientation = snapshot.prevOrientation;
+    curOrientation = snapshot.orientation;
+    velocity = snapshot.velocity;
+    rotation = snapshot.rotation;
+    acceleration = snapshot.acceleration;
+    mass = snapshot.mass;
+}
+
+void Object::getInterpolatedTransformMatrix(float alpha, float matrix[16]) const
+{
+    physics::Vector3 position = prevPosition + (curPosition - prevPosition) * alpha;
+    physics::Quaternion orientation = physics::Quaternion::nlerp(prevOrientation, curOrientation, alpha);
+
+    float w = orientation.w;
+    float x = orientation.x;
+    float y = orientation.y;
+    float z = orientation.z;
+
+    matrix[0] = 1.0f - 2.0f * (y*y + z*z);
+    matrix[1] = 2.0f * (x*y + w*z);
+    matrix[2] = 2.0f * (x*z - w*y);
+    matrix[3] = 0.0f;
+
+    matrix[4] = 2.0f * (x*y - w*z);
+    matrix[5] = 1.0f - 2.0f * (x*x + z*z);
+    matrix[6] = 2.0f * (y*z + w*x);
+    matrix[7] = 0.0f;
+
+    matrix[8] = 2.0f * (x*z + w*y);
+    matrix[9] = 2.0f * (y*z - w*x);
+    matrix[10] = 1.0f - 2.0f * (x*x + y*y);
+    matrix[11] = 0.0f;
+
+    matrix[12] = position.x;
+    matrix[13] = position.y;
+    matrix[14] = position.z;
+    matrix[15] = 1.0f;
+}
+
 void SphereObject::getGeometricDataInArray(float (&array)[3]) const
 {
     array[0] = radius;
@@ -51,17 +89,6 @@ void SphereObject::setGeometricData(double value, ...)
 
 void SphereObject::updateDerivedData()
 {
-    /* 강체의 데이터를 갱신한다 */
-    if (body->getInverseMass() != 0.0f)
-    {
-        physics::Matrix3 inertiaTensor;
-        inertiaTensor.setDiagonal(0.4f * body->getMass() * radius*radius);
-        body->setInertiaTensor(inertiaTensor);
-    }
-
-    /* 충돌체의 데이터를 갱신한다 */
-    collider->setGeometricData(radius);
-
     /* Shape 의 데이터를 갱신한다 */
     shape->generateVertices(radius);
     shape->generateVAOs();
@@ -89,23 +116,57 @@ void BoxObject::setGeometricData(double value, ...)
 
 void BoxObject::updateDerivedData()
 {
-    /* 강체의 데이터를 갱신한다 */
-    if (body->getInverseMass() != 0.0f)
-    {
-        physics::Matrix3 inertiaTensor;
-        float k = body->getMass() / 12;
-        float x = halfX * 2.0f;
-        float y = halfY * 2.0f;
-        float z = halfZ * 2.0f;
-        inertiaTensor.entries[0] = k * (y*y + z*z);
-        inertiaTensor.entries[4] = k * (x*x + z*z);
-        inertiaTensor.entries[8] = k * (y*y + x*x);
-        body->setInertiaTensor(inertiaTensor);
-    }
-    /* 충돌체의 데이터를 갱신한다 */
-    collider->setGeometricData(halfX, halfY, halfZ);
-
     /* Shape 의 데이터를 갱신한다 */
     shape->generateVertices(halfX, halfY, halfZ);
     shape->generateVAOs();
 }
+
+void CapsuleObject::getGeometricDataInArray(float (&array)[3]) const
+{
+    array[0] = radius;
+    array[1] = halfHeight;
+}
+
+void CapsuleObject::setGeometricData(double value, ...)
+{
+    radius = value;
+
+    va_list args;
+    va_start(args, value);
+
+    halfHeight = va_arg(args, double);
+
+    va_end(args);
+}
+
+void CapsuleObject::updateDerivedData()
+{
+    /* Shape 의 데이터를 갱신한다 */
+    shape->generateVertices(radius, halfHeight);
+    shape->generateVAOs();
+}
+
+void CylinderObject::getGeometricDataInArray(float (&array)[3]) const
+{
+    array[0] = radius;
+    array[1] = halfHeight;
+}
+
+void CylinderObject::setGeometricData(double value, ...)
+{
+    radius = value;
+
+    va_list args;
+    va_start(args, value);
+
+    halfHeight = va_arg(args, double);
+
+    va_end(args);
+}
+
+void CylinderObject::updateDerivedData()
+{
+    /* Shape 의 데이터를 갱신한다 */
+    shape->generateVertices(radius, halfHeight);
+    shape->generateVAOs();
+}
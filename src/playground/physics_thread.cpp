@@ -0,0 +1,417 @@
+#include <playground/physics_thread.h>
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <iostream>
+
+/* castRay 가 물리 스레드에 넘기는 반직선과 그 결과. 물리 스레드가 결과를 채운 뒤 done 으로 알린다 */
+struct RayCastQuery
+{
+    physics::Vector3 origin;
+    physics::Vector3 direction;
+    unsigned int hitID;
+    float hitDistance;
+    bool isHit;
+    std::promise<void> done;
+};
+
+PhysicsThread::PhysicsThread()
+    : commandQueue(1024), isRunning(false), isSimulating(true), timeStepMultiplier(1.0f)
+{
+    /* 물리는 화면 주사율과 관계없이 120 Hz 로 진행한다 */
+    fixedTimeStep = 1.0f / 120.0f;
+    maxSubsteps = 8;
+    accumulator = 0.0;
+
+    /* 렌더링에 메인 스레드 하나를 남기고, 나머지 코어로 충돌을 해소한다 */
+    unsigned int coreCount = std::thread::hardware_concurrency();
+    simulator.setThreadCount(coreCount > 1 ? coreCount - 1 : 1);
+}
+
+PhysicsThread::~PhysicsThread()
+{
+    stop();
+    clearContactInfo();
+
+    /* 실행되지 못한 명령이 가진 지형 데이터를 해제한다 */
+    PhysicsCommand command;
+    while (commandQueue.pop(command))
+    {
+        if (command.type == SET_HEIGHTFIELD_COMMAND)
+            delete command.heightfield;
+    }
+}
+
+void PhysicsThread::start()
+{
+    if (isRunning.load())
+        return;
+
+    isRunning.store(true);
+    thread = std::thread(&PhysicsThread::threadLoop, this);
+}
+
+void PhysicsThread::stop()
+{
+    if (!isRunning.load())
+        return;
+
+    isRunning.store(false);
+    thread.join();
+}
+
+void PhysicsThread::pushCommand(const PhysicsCommand& command)
+{
+    while (!commandQueue.push(command))
+        std::this_thread::yield();
+}
+
+bool PhysicsThread::castRay(
+    const physics::Vector3& origin,
+    const physics::Vector3& direction,
+    unsigned int& hitID,
+    float& hitDistance
+)
+{
+    if (!isRunning.load())
+    {
+        std::cout << "ERROR::PhysicsThread::castRay()::physics thread is not running" << std::endl;
+        return false;
+    }
+
+    RayCastQuery query;
+    query.origin = origin;
+    query.direction = direction;
+    query.isHit = false;
+
+    PhysicsCommand command(CAST_RAY_COMMAND);
+    command.rayCast = &query;
+    pushCommand(command);
+    query.done.get_future().wait();
+
+    if (query.isHit)
+    {
+        hitID = query.hitID;
+        hitDistance = query.hitDistance;
+    }
+    return query.isHit;
+}
+
+float PhysicsThread::calcInterpolationFactor() const
+{
+    if (!isSimulating.load())
+        return 1.0f;
+
+    const PhysicsSnapshot& snapshot = getSnapshot();
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - snapshot.publishTime).count();
+    double alpha = (snapshot.accumulator + elapsed * timeStepMultiplier.load()) / fixedTimeStep;
+    return (float)std::min(std::max(alpha, 0.0), 1.0);
+}
+
+void PhysicsThread::threadLoop()
+{
+    auto prevTime = std::chrono::steady_clock::now();
+
+    while (isRunning.load())
+    {
+        bool hasCommand = applyCommands();
+
+        auto curTime = std::chrono::steady_clock::now();
+        double frameTime = std::chrono::duration<double>(curTime - prevTime).count();
+        prevTime = curTime;
+
+        int substepCount = 0;
+        if (isSimulating.load())
+        {
+            accumulator += frameTime * timeStepMultiplier.load();
+            while (accumulator >= fixedTimeStep)
+            {
+                if (substepCount == maxSubsteps)
+                {
+                    /* 따라잡지 못한 시간은 버린다. 시뮬레이션이 잠시 느려질 뿐 스텝이 커지지는 않는다 */
+                    accumulator = 0.0;
+                    break;
+                }
+
+                savePreviousStates();
+
+                /* 마지막 스텝의 충돌 정보만 남긴다 */
+                clearContactInfo();
+                simulator.simulate(fixedTimeStep, contactInfo);
+
+                accumulator -= fixedTimeStep;
+                ++substepCount;
+            }
+        }
+        else
+            accumulator = 0.0;
+
+        if (hasCommand || substepCount > 0)
+            publishSnapshot();
+
+        /* 다음 스텝까지 쉰다. 명령에 빨리 응답하도록 한 번에 1 ms 이상 쉬지 않는다 */
+        double waitTime = 0.001;
+        if (isSimulating.load() && timeStepMultiplier.load() > 0.0f)
+            waitTime = std::min(waitTime, (fixedTimeStep - accumulator) / timeStepMultiplier.load());
+        if (waitTime > 0.0)
+            std::this_thread::sleep_for(std::chrono::duration<double>(waitTime));
+    }
+}
+
+bool PhysicsThread::applyCommands()
+{
+    bool hasCommand = false;
+    PhysicsCommand command;
+    while (commandQueue.pop(command))
+    {
+        applyCommand(command);
+        hasCommand = true;
+    }
+
+    return hasCommand;
+}
+
+void PhysicsThread::applyCommand(const PhysicsCommand& command)
+{
+    /* 오브젝트를 대상으로 하지 않는 명령 */
+    switch (command.type)
+    {
+    case EMPTY_COMMAND:
+        return;
+
+    case ADD_OBJECT_COMMAND:
+    {
+        const float (&position)[3] = command.addObject.position;
+        physics::RigidBody* body = simulator.addRigidBody(
+            command.id, command.addObject.geometry, position[0], position[1], position[2]
+        );
+        simulator.addCollider(command.id, command.addObject.geometry, body);
+        return;
+    }
+
+    case REMOVE_OBJECT_COMMAND:
+        simulator.removePhysicsObject(command.id);
+        previousStates.erase(command.id);
+        /* 제거된 오브젝트의 충돌점이 남지 않도록 한다 */
+        clearContactInfo();
+        return;
+
+    case SET_HEIGHTFIELD_COMMAND:
+    {
+        HeightfieldData* data = command.heightfield;
+        simulator.setHeightfield(data->columnCount, data->rowCount, data->cellSize, data->origin, data->heights);
+        delete data;
+        return;
+    }
+
+    case REMOVE_HEIGHTFIELD_COMMAND:
+        simulator.removeHeightfield();
+        return;
+
+    case SET_GROUND_RESTITUTION_COMMAND:
+        simulator.setGroundRestitution(command.value);
+        return;
+
+    case SET_OBJECT_RESTITUTION_COMMAND:
+        simulator.setObjectRestitution(command.value);
+        return;
+
+    case SET_GRAVITY_COMMAND:
+        simulator.setGravity(command.value);
+        return;
+
+    case CAST_RAY_COMMAND:
+    {
+        RayCastQuery* query = command.rayCast;
+        query->isHit = simulator.castRay(query->origin, query->direction, query->hitID, query->hitDistance);
+        query->done.set_value();
+        return;
+    }
+
+    default:
+        break;
+    }
+
+    /* 오브젝트에 대한 명령. 이미 제거된 오브젝트라면 무시한다 */
+    physics::RigidBody* body = simulator.getRigidBody(command.id);
+    physics::Collider* collider = simulator.getCollider(command.id);
+    if (body == nullptr || collider == nullptr)
+        return;
+
+    bool isMoved = false;
+    switch (command.type)
+    {
+    case SET_GEOMETRIC_DATA_COMMAND:
+        updatePhysicsData(command.physicsData.geometry, command.physicsData.geometricData, body, collider);
+        break;
+
+    case SET_MASS_COMMAND:
+        /* 질량이 바뀌면 관성 모멘트도 다시 계산한다 */
+        body->setMass(command.physicsData.mass);
+        updatePhysicsData(command.physicsData.geometry, command.physicsData.geometricData, body, collider);
+        break;
+
+    case SET_POSITION_COMMAND:
+        body->setPosition(command.vector[0], command.vector[1], command.vector[2]);
+        body->setVelocity(0.0f, 0.0f, 0.0f);
+        body->setRotation(0.0f, 0.0f, 0.0f);
+        isMoved = true;
+        break;
+
+    case SET_VELOCITY_COMMAND:
+        body->setVelocity(command.vector[0], command.vector[1], command.vector[2]);
+        break;
+
+    case SET_ORIENTATION_COMMAND:
+        body->setOrientation(physics::Quaternion(
+            command.orientation[0], command.orientation[1], command.orientation[2], command.orientation[3]
+        ));
+        isMoved = true;
+        break;
+
+    case ROTATE_OBJECT_COMMAND:
+    {
+        /* 회전축을 오브젝트의 로컬 좌표계로 변환한다 */
+        physics::Matrix4 transformMat = body->getTransformMatrix();
+        physics::Matrix3 rotationMat;
+        for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 3; ++j)
+                rotationMat.entries[3*i + j] = transformMat.entries[4*i + j];
+
+        const float (&axis)[3] = command.rotation.axis;
+        physics::Vector3 axisLocal = rotationMat.transpose() * physics::Vector3(axis[0], axis[1], axis[2]);
+        axisLocal.normalize();
+        /* 회전각과 축을 토대로 회전 사원수를 계산한다 */
+        float radian = command.rotation.radian;
+        physics::Quaternion quat(
+            cosf(radian * 0.5f),
+            sinf(radian * 0.5f) * axisLocal.x,
+            sinf(radian * 0.5f) * axisLocal.y,
+            sinf(radian * 0.5f) * axisLocal.z
+        );
+        body->rotateByQuat(quat);
+        isMoved = true;
+        break;
+    }
+
+    case FIX_OBJECT_COMMAND:
+        body->setInverseMass(0.0f);
+        body->setInverseInertiaTensor(physics::Matrix3(0.0f));
+        body->setVelocity(0.0f, 0.0f, 0.0f);
+        body->setRotation(0.0f, 0.0f, 0.0f);
+        break;
+
+    default:
+        break;
+    }
+
+    /* 옮겨진 강체가 직전 위치에서 보간되어 미끄러지지 않도록 그 강체만 명령 직후의 상태에서 다시 시작한다 */
+    if (isMoved)
+        resetPreviousState(command.id);
+}
+
+void PhysicsThread::updatePhysicsData(
+    Geometry geometry,
+    const float (&geometricData)[3],
+    physics::RigidBody* body,
+    physics::Collider* collider
+)
+{
+    /* 강체의 데이터를 갱신한다. 고정된 강체는 관성 모멘트가 무한대이므로 그대로 둔다 */
+    if (body->getInverseMass() != 0.0f)
+    {
+        physics::Matrix3 inertiaTensor;
+        if (geometry == SPHERE)
+        {
+            float radius = geometricData[0];
+            inertiaTensor.setDiagonal(0.4f * body->getMass() * radius*radius);
+        }
+        else if (geometry == BOX)
+        {
+            float k = body->getMass() / 12;
+            float x = geometricData[0] * 2.0f;
+            float y = geometricData[1] * 2.0f;
+            float z = geometricData[2] * 2.0f;
+            inertiaTensor.entries[0] = k * (y*y + z*z);
+            inertiaTensor.entries[4] = k * (x*x + z*z);
+            inertiaTensor.entries[8] = k * (y*y + x*x);
+        }
+        else if (geometry == CAPSULE)
+            inertiaTensor = physics::CapsuleCollider::calcInertiaTensor(body->getMass(), geometricData[0], geometricData[1]);
+        else if (geometry == CYLINDER)
+            inertiaTensor = physics::CylinderCollider::calcInertiaTensor(body->getMass(), geometricData[0], geometricData[1]);
+        body->setInertiaTensor(inertiaTensor);
+    }
+
+    /* 충돌체의 데이터를 갱신한다 */
+    if (geometry == SPHERE)
+        collider->setGeometricData(geometricData[0]);
+    else if (geometry == BOX)
+        collider->setGeometricData(geometricData[0], geometricData[1], geometricData[2]);
+    else if (geometry == CAPSULE || geometry == CYLINDER)
+        collider->setGeometricData(geometricData[0], geometricData[1]);
+}
+
+void PhysicsThread::savePreviousStates()
+{
+    previousStates.clear();
+    for (const auto& body : simulator.getRigidBodies())
+        previousStates[body.first] = BodyState(body.second->getPosition(), body.second->getOrientation());
+}
+
+void PhysicsThread::resetPreviousState(unsigned int id)
+{
+    physics::RigidBody* body = simulator.getRigidBody(id);
+    if (body != nullptr)
+        previousStates[id] = BodyState(body->getPosition(), body->getOrientation());
+}
+
+void PhysicsThread::clearContactInfo()
+{
+    for (auto& info : contactInfo)
+        delete info;
+    contactInfo.clear();
+}
+
+void PhysicsThread::publishSnapshot()
+{
+    PhysicsSnapshot& snapshot = snapshots.getWriteBuffer();
+    snapshot.bodies.clear();
+    snapshot.contacts.clear();
+
+    for (const auto& entry : simulator.getRigidBodies())
+    {
+        const physics::RigidBody* body = entry.second;
+
+        BodySnapshot bodySnapshot;
+        bodySnapshot.id = entry.first;
+        bodySnapshot.position = body->getPosition();
+        bodySnapshot.orientation = body->getOrientation();
+        bodySnapshot.velocity = body->getVelocity();
+        bodySnapshot.rotation = body->getRotation();
+        bodySnapshot.acceleration = body->getAcceleration();
+        bodySnapshot.mass = body->getMass();
+
+        /* 직전 상태가 없다면 방금 추가된 강체이므로 보간하지 않는다 */
+        auto previousState = previousStates.find(entry.first);
+        if (previousState != previousStates.end())
+        {
+            bodySnapshot.prevPosition = previousState->second.first;
+            bodySnapshot.prevOrientation = previousState->second.second;
+        }
+        else
+        {
+            bodySnapshot.prevPosition = bodySnapshot.position;
+            bodySnapshot.prevOrientation = bodySnapshot.orientation;
+        }
+
+        snapshot.bodies.push_back(bodySnapshot);
+    }
+
+    for (const auto& info : contactInfo)
+        snapshot.contacts.push_back(*info);
+
+    snapshot.publishTime = std::chrono::steady_clock::now();
+    snapshot.accumulator = accumulator;
+    snapshots.publish();
+}
@@ -1,38 +1,35 @@
 #include <playground/playground.h>
-#include <typeinfo>
 #include <cmath>
+#include <iostream>
+#include <thread>
 
 const float PI = 3.141592f;
 
 Playground::Playground()
-    : eventQueue(50), userInterface(renderer.getWindow(), renderer.getTextureBufferID())
+    : eventQueue(64), userInterface(renderer.getWindow(), renderer.getTextureBufferID())
 {
     newObjectID = 1;
     isSimulating = true;
     shouldRenderContactInfo = false;
     timeStepMultiplier = 1.0f;
+
+    /* 물리는 전용 스레드에서 고정된 타임 스텝으로 진행한다 */
+    physicsThread.start();
 }
 
 void Playground::run()
 {
-    /* 프레임 간 시간 측정 */
-    double prevTime = glfwGetTime();
-    double curTime, deltaTime;
-
     while (!glfwWindowShouldClose(renderer.getWindow()))
     {
         /* 키보드 입력 처리 */
         handleKeyboardInput();
-        
-        /* 시간 계산 */
-        curTime = glfwGetTime();
-        deltaTime = curTime - prevTime;
-        prevTime = curTime;
+        physicsThread.setSimulating(isSimulating);
 
-        /* 물리 시뮬레이션 */
-        std::vector<ContactInfo*> contactInfo;
-        if (isSimulating)
-            simulator.simulate(deltaTime * timeStepMultiplier, contactInfo);
+        /* 물리 스레드가 발행한 최신 상태를 가져온다.
+            물리 스텝 사이의 시점은 직전 두 상태를 보간해 렌더한다 */
+        if (physicsThread.updateSnapshot())
+            applySnapshot();
+        float alpha = physicsThread.calcInterpolationFactor();
 
         renderer.updateWindowSize();
         renderer.bindSceneFrameBuffer();
@@ -45,7 +42,7 @@ void Playground::run()
         for (auto& object : objects)
         {
             float modelMatrix[16];
-            object.second->body->getTransformMatrix(modelMatrix);
+            object.second->getInterpolatedTransformMatrix(alpha, modelMatrix);
             renderer.renderObject(
                 object.second->id,
                 object.second->color,
@@ -59,26 +56,26 @@ void Playground::run()
         if (selectedObjectIDs.size() == 1)
         {
             float modelMatrix[16];
-            objects.find(selectedObjectIDs[0])->second->body->getTransformMatrix(modelMatrix);
+            objects.find(selectedObjectIDs[0])->second->getInterpolatedTransformMatrix(alpha, modelMatrix);
             renderer.renderObjectAxis(0, modelMatrix);
             renderer.renderObjectAxis(1, modelMatrix);
             renderer.renderObjectAxis(2, modelMatrix);
         }
 
         /* 충돌점 렌더 */
-        for (auto& info : contactInfo)
+        if (shouldRenderContactInfo)
         {
-            if (shouldRenderContactInfo)
-                renderer.renderContactInfo(info);
-            delete info;
+            for (const auto& info : physicsThread.getSnapshot().contacts)
+            {
+                ContactInfo contactInfo = info;
+                renderer.renderContactInfo(&contactInfo);
+            }
         }
-        contactInfo.clear();
 
-        /* GUI 이벤트 처리 */
-        while (!eventQueue.isEmpty())
-        {
-            handleEvent(eventQueue.pop());
-        }
+        /* GUI 이벤트 처리. 한 프레임 동안 쌓인 이벤트를 한꺼번에 꺼내 중복을 합친 뒤 처리한다 */
+        eventQueue.popAll(pendingEvents);
+        for (auto& event : pendingEvents)
+            handleEvent(event);
 
         renderer.bindDefaultFrameBuffer();
         renderer.setWindowViewport();
@@ -90,6 +87,25 @@ void Playground::run()
     }
 }
 
+void Playground::applySnapshot()
+{
+    for (const auto& body : physicsThread.getSnapshot().bodies)
+    {
+        /* 제거 명령이 아직 처리되지 않은 강체는 건너뛴다 */
+        Objects::iterator objectIter = objects.find(body.id);
+        if (objectIter != objects.end())
+            objectIter->second->updateState(body);
+    }
+}
+
+void Playground::updatePhysicsData(Object* object)
+{
+    PhysicsCommand command(SET_GEOMETRIC_DATA_COMMAND, object->id);
+    command.physicsData.geometry = object->geometry;
+    object->getGeometricDataInArray(command.physicsData.geometricData);
+    physicsThread.pushCommand(command);
+}
+
 unsigned int Playground::addObject(Geometry geometry, float posX, float posY, float posZ)
 {
     Object* newObject;
@@ -107,13 +123,30 @@ unsigned int Playground::addObject(Geometry geometry, float posX, float posY, fl
         newObject->geometry = BOX;
         std::cout << "DEBUG::Playground::add box object id: " << newObjectID << std::endl;
     }
+    else if (geometry == CAPSULE)
+    {
+        newObject = new CapsuleObject;
+        newObject->geometry = CAPSULE;
+        std::cout << "DEBUG::Playground::add capsule object id: " << newObjectID << std::endl;
+    }
+    else if (geometry == CYLINDER)
+    {
+        newObject = new CylinderObject;
+        newObject->geometry = CYLINDER;
+        std::cout << "DEBUG::Playground::add cylinder object id: " << newObjectID << std::endl;
+    }
 
     /* id 를 부여한다 */
     newObject->id = newObjectID;
     
-    /* 강체와 충돌체를 추가한다 */
-    newObject->body = simulator.addRigidBody(newObjectID, geometry, posX, posY, posZ);
-    newObject->collider = simulator.addCollider(newObjectID, geometry, newObject->body);
+    /* 강체와 충돌체를 추가한다. 물리 스레드가 상태를 발행하기 전까지는 주어진 위치에 그린다 */
+    PhysicsCommand command(ADD_OBJECT_COMMAND, newObjectID);
+    command.addObject.geometry = geometry;
+    command.addObject.position[0] = posX;
+    command.addObject.position[1] = posY;
+    command.addObject.position[2] = posZ;
+    physicsThread.pushCommand(command);
+    newObject->prevPosition = newObject->curPosition = physics::Vector3(posX, posY, posZ);
 
     /* 색상은 무작위로 설정한다 */
     newObject->color = glm::vec3(
@@ -133,7 +166,7 @@ Playground::Objects::iterator Playground::removeObject(unsigned int id)
 {
     std::cout << "DEBUG::Playground::remove object id: " << id << std::endl;
     /* 물리 데이터를 제거한다 */
-    simulator.removePhysicsObject(id);
+    physicsThread.pushCommand(PhysicsCommand(REMOVE_OBJECT_COMMAND, id));
     /* 그래픽 데이터를 제거한다 */
     renderer.removeShape(id);
 
@@ -146,78 +179,82 @@ Playground::Objects::iterator Playground::removeObject(unsigned int id)
     return objects.erase(objectIter);
 }
 
-void Playground::handleEvent(Event* event)
-{    
-    if (typeid(*event) == typeid(ObjectSelectedEvent))
-        handleObjectSelectedEvent(static_cast<ObjectSelectedEvent*>(event));
-
-    else if (typeid(*event) == typeid(ObjectAddedEvent))
-        handleObjectAddedEvent(static_cast<ObjectAddedEvent*>(event));
-
-    else if (typeid(*event) == typeid(ObjectPositionChangedEvent))
-        handleObjectPositionChangedEvent(static_cast<ObjectPositionChangedEvent*>(event));
-
-    else if (typeid(*event) == typeid(ObjectVelocityChangedEvent))
-        handleObjectVelocityChangedEvent(static_cast<ObjectVelocityChangedEvent*>(event));
-
-    else if (typeid(*event) == typeid(SimulationStatusChangedEvent))
-        handleSimulationStatusChangedEvent(static_cast<SimulationStatusChangedEvent*>(event));
-
-    else if (typeid(*event) == typeid(ObjectGeometricDataChangedEvent))
-        handleObjectGeometricDataChangedEvent(static_cast<ObjectGeometricDataChangedEvent*>(event));
-
-    else if (typeid(*event) == typeid(ObjectRemovedEvent))
-        handleObjectRemovedEvent(static_cast<ObjectRemovedEvent*>(event));
-
-    else if (typeid(*event) == typeid(ObjectMassChangedEvent))
-        handleObjectMassChangedEvent(static_cast<ObjectMassChangedEvent*>(event));
-
-    else if (typeid(*event) == typeid(LeftMouseDraggedOnSceneEvent))
-        handleLeftMouseDraggedOnSceneEvent(static_cast<LeftMouseDraggedOnSceneEvent*>(event));
-
-    else if (typeid(*event) == typeid(RightMouseDraggedOnSceneEvent))
-        handleRightMouseDraggedOnSceneEvent(static_cast<RightMouseDraggedOnSceneEvent*>(event));
-
-    else if (typeid(*event) == typeid(MouseWheelOnSceneEvent))
-        handleMouseWheelOnSceneEvent(static_cast<MouseWheelOnSceneEvent*>(event));
-
-    else if (typeid(*event) == typeid(LeftMouseClickedOnSceneEvent))
-        handleLeftMouseClickedOnSceneEvent(static_cast<LeftMouseClickedOnSceneEvent*>(event));
-
-    else if (typeid(*event) == typeid(ObjectPositionFixedEvent))
-        handleObjectPositionFixedEvent(static_cast<ObjectPositionFixedEvent*>(event));
-
-    else if (typeid(*event) == typeid(RenderContactInfoFlagChangedEvent))
-        handleRenderContactInfoFlagChangedEvent(static_cast<RenderContactInfoFlagChangedEvent*>(event));
-
-    else if (typeid(*event) == typeid(AllObjectRemovedEvent))
-        handleAllObjectRemovedEvent(static_cast<AllObjectRemovedEvent*>(event));
-
-    else if (typeid(*event) == typeid(GroundRestitutionChangedEvent))
-        handleGroundRestitutionChangedEvent(static_cast<GroundRestitutionChangedEvent*>(event));
-
-    else if (typeid(*event) == typeid(ObjectRestitutionChangedEvent))
-        handleObjectRestitutionChangedEvent(static_cast<ObjectRestitutionChangedEvent*>(event));
-
-    else if (typeid(*event) == typeid(GravityChangedEvent))
-        handleGravityChangedEvent(static_cast<GravityChangedEvent*>(event));
-
-    else if (typeid(*event) == typeid(ObjectRotatedEvent))
-        handleObjectRotatedEvent(static_cast<ObjectRotatedEvent*>(event));
-
-    else if (typeid(*event) == typeid(OrientationResetEvent))
-        handleOrientationResetEvent(static_cast<OrientationResetEvent*>(event));
-
-    else if (typeid(*event) == typeid(ShouldRenderWorldAxis))
-        handleShouldRenderWorldAxis(static_cast<ShouldRenderWorldAxis*>(event));
-
-    else if (typeid(*event) == typeid(RemoveUnfixedObjectsEvent))
-        handleRemoveUnfixedObjectsEvent(static_cast<RemoveUnfixedObjectsEvent*>(event));
-
-    else if (typeid(*event) == typeid(TimeStepChangedEvent))
-        handleTimeStepChangedEvent(static_cast<TimeStepChangedEvent*>(event));
-
-    delete event;
+void Playground::handleEvent(Event& event)
+{
+    switch (event.type)
+    {
+    case OBJECT_SELECTED:
+        handleObjectSelectedEvent(&event.objectSelected);
+        break;
+    case OBJECT_ADDED:
+        handleObjectAddedEvent(&event.objectAdded);
+        break;
+    case OBJECT_POSITION_CHANGED:
+        handleObjectPositionChangedEvent(&event.objectPositionChanged);
+        break;
+    case OBJECT_VELOCITY_CHANGED:
+        handleObjectVelocityChangedEvent(&event.objectVelocityChanged);
+        break;
+    case SIMULATION_STATUS_CHANGED:
+        handleSimulationStatusChangedEvent(&event.simulationStatusChanged);
+        break;
+    case OBJECT_GEOMETRIC_DATA_CHANGED:
+        handleObjectGeometricDataChangedEvent(&event.objectGeometricDataChanged);
+        break;
+    case OBJECT_REMOVED:
+        handleObjectRemovedEvent(&event.objectRemoved);
+        break;
+    case OBJECT_MASS_CHANGED:
+        handleObjectMassChangedEvent(&event.objectMassChanged);
+        break;
+    case LEFT_MOUSE_DRAGGED_ON_SCENE:
+        handleLeftMouseDraggedOnSceneEvent(&event.leftMouseDraggedOnScene);
+        break;
+    case RIGHT_MOUSE_DRAGGED_ON_SCENE:
+        handleRightMouseDraggedOnSceneEvent(&event.rightMouseDraggedOnScene);
+        break;
+    case MOUSE_WHEEL_ON_SCENE:
+        handleMouseWheelOnSceneEvent(&event.mouseWheelOnScene);
+        break;
+    case LEFT_MOUSE_CLICKED_ON_SCENE:
+        handleLeftMouseClickedOnSceneEvent(&event.leftMouseClickedOnScene);
+        break;
+    case OBJECT_POSITION_FIXED:
+        handleObjectPositionFixedEvent(&event.objectPositionFixed);
+        break;
+    case RENDER_CONTACT_INFO_FLAG_CHANGED:
+        handleRenderContactInfoFlagChangedEvent(&event.renderContactInfoFlagChanged);
+        break;
+    case ALL_OBJECT_REMOVED:
+        handleAllObjectRemovedEvent(&event.allObjectRemoved);
+        break;
+    case GROUND_RESTITUTION_CHANGED:
+        handleGroundRestitutionChangedEvent(&event.groundRestitutionChanged);
+        break;
+    case OBJECT_RESTITUTION_CHANGED:
+        handleObjectRestitutionChangedEvent(&event.objectRestitutionChanged);
+        break;
+    case GRAVITY_CHANGED:
+        handleGravityChangedEvent(&event.gravityChanged);
+        break;
+    case OBJECT_ROTATED:
+        handleObjectRotatedEvent(&event.objectRotated);
+        break;
+    case ORIENTATION_RESET:
+        handleOrientationResetEvent(&event.orientationReset);
+        break;
+    case SHOULD_RENDER_WORLD_AXIS:
+        handleShouldRenderWorldAxis(&event.shouldRenderWorldAxis);
+        break;
+    case REMOVE_UNFIXED_OBJECTS:
+        handleRemoveUnfixedObjectsEvent(&event.removeUnfixedObjects);
+        break;
+    case TIME_STEP_CHANGED:
+        handleTimeStepChangedEvent(&event.timeStepChanged);
+        break;
+    default:
+        break;
+    }
 }
 
 void Playground::handleKeyboardInput()
@@ -279,6 +316,18 @@ void Playground::handleKeyboardInput()
     }
     else if (glfwGetKey(renderer.getWindow(), GLFW_KEY_F2) == GLFW_RELEASE)
         isTwoRepeated = false;
+
+    static bool isThreeRepeated = false;
+    if (glfwGetKey(renderer.getWindow(), GLFW_KEY_F3) == GLFW_PRESS)
+    {
+        if (!isThreeRepeated)
+        {
+            loadPreset3();
+            isThreeRepeated = true;
+        }
+    }
+    else if (glfwGetKey(renderer.getWindow(), GLFW_KEY_F3) == GLFW_RELEASE)
+        isThreeRepeated = false;
 }
 
 void Playground::clearSelectedObjectIDs()
@@ -292,11 +341,14 @@ void Playground::clearSelectedObjectIDs()
 void Playground::loadPreset1()
 {
     isSimulating = false;
+    physicsThread.setSimulating(false);
     handleAllObjectRemovedEvent(nullptr);
+    removeHeightfield();
 
     unsigned int sphereID = addObject(SPHERE, 0.0f, 1.0f, 7.0f);
     objects.find(sphereID)->second->setGeometricData(0.7f);
     objects.find(sphereID)->second->updateDerivedData();
+    updatePhysicsData(objects.find(sphereID)->second);
 
     addObject(BOX, 0.0f, 0.5f, 0.0f);
     addObject(BOX, 1.2f, 0.5f, 0.0f);
@@ -305,44 +357,114 @@ void Playground::loadPreset1()
     addObject(BOX, -0.7f, 1.5f, 0.0f);
     addObject(BOX, 0.0f, 2.5f, 0.0f);
 
-    objects.find(sphereID)->second->body->setVelocity(0.0f, 0.0f, -30.0f);
+    PhysicsCommand command(SET_VELOCITY_COMMAND, sphereID);
+    command.vector[0] = 0.0f;
+    command.vector[1] = 0.0f;
+    command.vector[2] = -30.0f;
+    physicsThread.pushCommand(command);
 }
 
 void Playground::loadPreset2()
 {
     isSimulating = false;
+    physicsThread.setSimulating(false);
     handleAllObjectRemovedEvent(nullptr);
+    removeHeightfield();
 
     unsigned int id = addObject(BOX, 0.0f, 5.0f, -2.0f);
     float rotateAngle = 30.0f * PI / 180.0f;
-    ObjectPositionFixedEvent* event = new ObjectPositionFixedEvent(id, true);
-    handleObjectPositionFixedEvent(event);
-    delete event;
-    objects.find(id)->second->body->setOrientation(
-        physics::Quaternion(cos(rotateAngle * 0.5f), sin(rotateAngle * 0.5f), 0.0f, 0.0f)
-    );
+    ObjectPositionFixedEvent event(id, true);
+    handleObjectPositionFixedEvent(&event);
+    PhysicsCommand command(SET_ORIENTATION_COMMAND, id);
+    command.orientation[0] = cos(rotateAngle * 0.5f);
+    command.orientation[1] = sin(rotateAngle * 0.5f);
+    command.orientation[2] = 0.0f;
+    command.orientation[3] = 0.0f;
+    physicsThread.pushCommand(command);
     objects.find(id)->second->setGeometricData(3.0f, 0.1f, 3.0f);
     objects.find(id)->second->updateDerivedData();
+    updatePhysicsData(objects.find(id)->second);
 
     id = addObject(BOX, 0.0f, 2.0f, 2.5f);
-    event = new ObjectPositionFixedEvent(id, true);
-    handleObjectPositionFixedEvent(event);
-    delete event;
-    objects.find(id)->second->body->setOrientation(
-        physics::Quaternion(cos(rotateAngle * -0.5f), sin(rotateAngle * -0.5f), 0.0f, 0.0f)
-    );
+    event = ObjectPositionFixedEvent(id, true);
+    handleObjectPositionFixedEvent(&event);
+    command = PhysicsCommand(SET_ORIENTATION_COMMAND, id);
+    command.orientation[0] = cos(rotateAngle * -0.5f);
+    command.orientation[1] = sin(rotateAngle * -0.5f);
+    command.orientation[2] = 0.0f;
+    command.orientation[3] = 0.0f;
+    physicsThread.pushCommand(command);
     objects.find(id)->second->setGeometricData(3.0f, 0.1f, 3.0f);
     objects.find(id)->second->updateDerivedData();
+    updatePhysicsData(objects.find(id)->second);
 
     addObject(SPHERE, -2.0f, 7.0f, -3.0f);
 
     id = addObject(SPHERE, 0.0f, 7.0f, -3.0f);
     objects.find(id)->second->setGeometricData(0.7f);
     objects.find(id)->second->updateDerivedData();
+    updatePhysicsData(objects.find(id)->second);
 
     id = addObject(SPHERE, 1.5f, 7.0f, -3.0f);
     objects.find(id)->second->setGeometricData(0.3f);
     objects.find(id)->second->updateDerivedData();
+    updatePhysicsData(objects.find(id)->second);
+}
+
+void Playground::loadPreset3()
+{
+    isSimulating = false;
+    physicsThread.setSimulating(false);
+    handleAllObjectRemovedEvent(nullptr);
+
+    /* 0.5 간격의 41 x 41 격자에 물결 모양 언덕을 만든다 */
+    const int gridSize = 41;
+    const float cellSize = 0.5f;
+    physics::Vector3 origin(-10.0f, 0.0f, -10.0f);
+    std::vector<float> heights(gridSize * gridSize);
+    for (int row = 0; row < gridSize; ++row)
+    {
+        for (int column = 0; column < gridSize; ++column)
+        {
+            float x = origin.x + column * cellSize;
+            float z = origin.z + row * cellSize;
+            heights[row * gridSize + column] = 1.0f + sinf(x * 0.5f) * cosf(z * 0.4f) + 0.02f * (x * x + z * z);
+        }
+    }
+    setHeightfield(gridSize, gridSize, cellSize, origin, heights);
+
+    Geometry geometries[3] = {SPHERE, BOX, CAPSULE};
+    for (int i = 0; i < 5; ++i)
+    {
+        for (int j = 0; j < 5; ++j)
+            addObject(geometries[(i + j) % 3], -6.0f + j * 3.0f, 7.0f, -6.0f + i * 3.0f);
+    }
+}
+
+void Playground::setHeightfield(
+    int columnCount,
+    int rowCount,
+    float cellSize,
+    const physics::Vector3& origin,
+    const std::vector<float>& heights
+)
+{
+    /* 지형 데이터는 물리 스레드가 적용한 뒤 해제한다 */
+    PhysicsCommand command(SET_HEIGHTFIELD_COMMAND);
+    command.heightfield = new HeightfieldData;
+    command.heightfield->columnCount = columnCount;
+    command.heightfield->rowCount = rowCount;
+    command.heightfield->cellSize = cellSize;
+    command.heightfield->origin = origin;
+    command.heightfield->heights = heights;
+    physicsThread.pushCommand(command);
+    renderer.setHeightfield(columnCount, rowCount, cellSize, glm::vec3(origin.x, origin.y, origin.z), heights);
+}
+
+void Playground::removeHeightfield()
+{
+    physicsThread.pushCommand(PhysicsCommand(REMOVE_HEIGHTFIELD_COMMAND));
+    renderer.removeHeightfield();
 }
 
 void Playground::handleObjectAddedEvent(ObjectAddedEvent* event)
@@ -397,17 +519,18 @@ void Playground::handleSimulationStatusChangedEvent(SimulationStatusChangedEvent
 
 void Playground::handleObjectPositionChangedEvent(ObjectPositionChangedEvent* event)
 {
-    float (&position)[3] = event->position;
-    physics::RigidBody* body = objects.find(event->id)->second->body;
-    body->setPosition(position[0], position[1], position[2]);
-    body->setVelocity(0.0f, 0.0f, 0.0f);
-    body->setRotation(0.0f, 0.0f, 0.0f);
+    PhysicsCommand command(SET_POSITION_COMMAND, event->id);
+    for (int i = 0; i < 3; ++i)
+        command.vector[i] = event->position[i];
+    physicsThread.pushCommand(command);
 }
 
 void Playground::handleObjectVelocityChangedEvent(ObjectVelocityChangedEvent* event)
 {
-    float (&velocity)[3] = event->velocity;
-    objects.find(event->id)->second->body->setVelocity(velocity[0], velocity[1], velocity[2]);
+    PhysicsCommand command(SET_VELOCITY_COMMAND, event->id);
+    for (int i = 0; i < 3; ++i)
+        command.vector[i] = event->velocity[i];
+    physicsThread.pushCommand(command);
 }
 
 void Playground::handleObjectGeometricDataChangedEvent(ObjectGeometricDataChangedEvent* event)
@@ -417,13 +540,19 @@ void Playground::handleObjectGeometricDataChangedEvent(ObjectGeometricDataChange
 
     object->setGeometricData(data[0], data[1], data[2]);
     object->updateDerivedData();
+    updatePhysicsData(object);
 }
 
 void Playground::handleObjectMassChangedEvent(ObjectMassChangedEvent* event)
 {
     Object* object = objects.find(event->id)->second;
-    object->body->setMass(event->value);
-    object->updateDerivedData();
+
+    /* 질량이 바뀌면 관성 모멘트도 다시 계산하므로 도형의 속성값을 함께 보낸다 */
+    PhysicsCommand command(SET_MASS_COMMAND, event->id);
+    command.physicsData.geometry = object->geometry;
+    object->getGeometricDataInArray(command.physicsData.geometricData);
+    command.physicsData.mass = event->value;
+    physicsThread.pushCommand(command);
 }
 
 void Playground::handleLeftMouseDraggedOnSceneEvent(LeftMouseDraggedOnSceneEvent* event)
@@ -472,25 +601,10 @@ void Playground::handleLeftMouseClickedOnSceneEvent(LeftMouseClickedOnSceneEvent
     physics::Vector3 direction(rayDirection.x, rayDirection.y, rayDirection.z);
     
     /* Ray 와 부딪히는 오브젝트를 찾는다 */
-    float minDistance = FLT_MAX;
-    int minDistanceObjectID = -1;
-    for (const auto& object : objects)
-    {
-        float distance = simulator.calcDistanceBetweenRayAndObject(
-            origin,
-            direction,
-            object.second->id
-        );
-
-        if (distance > 0.0f && distance < minDistance)
-        {
-            minDistance = distance;
-            minDistanceObjectID = object.second->id;
-        }
-    }
-
-    if (minDistanceObjectID >= 0)
-        eventQueue.push(new ObjectSelectedEvent(minDistanceObjectID, event->isCtrlPressed));
+    unsigned int hitID;
+    float hitDistance;
+    if (physicsThread.castRay(origin, direction, hitID, hitDistance))
+        eventQueue.push(ObjectSelectedEvent(hitID, event->isCtrlPressed));
     else
         clearSelectedObjectIDs();
 }
@@ -498,39 +612,20 @@ void Playground::handleLeftMouseClickedOnSceneEvent(LeftMouseClickedOnSceneEvent
 void Playground::handleObjectPositionFixedEvent(ObjectPositionFixedEvent* event)
 {
     Object* target = objects.find(event->id)->second;
+    target->isFixed = event->shouldBeFixed;
+
     if (event->shouldBeFixed)
     {
-        target->isFixed = true;
-        target->body->setInverseMass(0.0f);
-        target->body->setInverseInertiaTensor(physics::Matrix3(0.0f));
-        target->body->setVelocity(0.0f, 0.0f, 0.0f);
-        target->body->setRotation(0.0f, 0.0f, 0.0f);
+        physicsThread.pushCommand(PhysicsCommand(FIX_OBJECT_COMMAND, event->id));
     }
     else
     {
-        target->isFixed = false;
-        target->body->setMass(5.0f);
-
-        physics::Matrix3 inertiaTensor;
-        float geometricData[3] = {0};
-        target->getGeometricDataInArray(geometricData);
-        if (typeid(*target) == typeid(SphereObject))
-        {
-            SphereObject* sphere = static_cast<SphereObject*>(target);
-            inertiaTensor.setDiagonal(0.4f * sphere->body->getMass() * geometricData[0]*geometricData[0]);
-        }
-        else if (typeid(*target) == typeid(BoxObject))
-        {
-            BoxObject* box = static_cast<BoxObject*>(target);
-            float k = box->body->getMass() / 12;
-            float x = geometricData[0] * 2.0f;
-            float y = geometricData[1] * 2.0f;
-            float z = geometricData[2] * 2.0f;
-            inertiaTensor.entries[0] = k * (y*y + z*z);
-            inertiaTensor.entries[4] = k * (x*x + z*z);
-            inertiaTensor.entries[8] = k * (y*y + x*x);
-        }
-        target->body->setInertiaTensor(inertiaTensor);
+        /* 질량을 되돌린 뒤 도형에 맞는 관성 모멘트를 다시 계산한다 */
+        PhysicsCommand command(SET_MASS_COMMAND, event->id);
+        command.physicsData.geometry = target->geometry;
+        target->getGeometricDataInArray(command.physicsData.geometricData);
+        command.physicsData.mass = 5.0f;
+        physicsThread.pushCommand(command);
     }
 }
 
@@ -551,54 +646,50 @@ void Playground::handleAllObjectRemovedEvent(AllObjectRemovedEvent* event)
 
 void Playground::handleGroundRestitutionChangedEvent(GroundRestitutionChangedEvent* event)
 {
-    simulator.setGroundRestitution(event->value);
+    PhysicsCommand command(SET_GROUND_RESTITUTION_COMMAND);
+    command.value = event->value;
+    physicsThread.pushCommand(command);
 }
 
 void Playground::handleObjectRestitutionChangedEvent(ObjectRestitutionChangedEvent* event)
 {
-    simulator.setObjectRestitution(event->value);
+    PhysicsCommand command(SET_OBJECT_RESTITUTION_COMMAND);
+    command.value = event->value;
+    physicsThread.pushCommand(command);
 }
 
 void Playground::handleGravityChangedEvent(GravityChangedEvent* event)
 {
-    simulator.setGravity(event->value);
+    PhysicsCommand command(SET_GRAVITY_COMMAND);
+    command.value = event->value;
+    physicsThread.pushCommand(command);
 }
 
 void Playground::handleObjectRotatedEvent(ObjectRotatedEvent* event)
 {
-    Object* target = objects.find(event->id)->second;
-    /* 회전각을 라디안으로 변환한다 */
-    float radian = event->degree * PI / 180.0f;
-    /* 회전축을 오브젝트의 로컬 좌표계로 변환한다 */
-    physics::Matrix4 transformMat = target->body->getTransformMatrix();
-    physics::Matrix3 rotationMat;
-    for (int i = 0; i < 3; ++i)
-        for (int j = 0; j < 3; ++j)
-            rotationMat.entries[3*i + j] = transformMat.entries[4*i + j];
-
-    physics::Vector3 axisWorld(event->axisX, event->axisY, event->axisZ);
-    physics::Vector3 axisLocal = rotationMat.transpose() * axisWorld;
-    axisLocal.normalize();
-    /* 앞서 계산한 회전각과 축을 토대로 회전 사원수를 계산한다 */
-    physics::Quaternion quat(
-        cosf(radian * 0.5f),
-        sinf(radian * 0.5f) * axisLocal.x,
-        sinf(radian * 0.5f) * axisLocal.y,
-        sinf(radian * 0.5f) * axisLocal.z
-    );
-    target->body->rotateByQuat(quat);
+    /* 회전각을 라디안으로 변환한다. 회전축은 물리 스레드가 오브젝트의 로컬 좌표계로 변환한다 */
+    PhysicsCommand command(ROTATE_OBJECT_COMMAND, event->id);
+    command.rotation.radian = event->degree * PI / 180.0f;
+    command.rotation.axis[0] = event->axisX;
+    command.rotation.axis[1] = event->axisY;
+    command.rotation.axis[2] = event->axisZ;
+    physicsThread.pushCommand(command);
 }
 
 void Playground::handleOrientationResetEvent(OrientationResetEvent* event)
 {
-    Object* target = objects.find(event->id)->second;
-    target->body->setOrientation(physics::Quaternion(1.0f, 0.0f, 0.0f, 0.0f));
+    PhysicsCommand command(SET_ORIENTATION_COMMAND, event->id);
+    command.orientation[0] = 1.0f;
+    command.orientation[1] = 0.0f;
+    command.orientation[2] = 0.0f;
+    command.orientation[3] = 0.0f;
+    physicsThread.pushCommand(command);
 }
 
 void Playground::handleShouldRenderWorldAxis(ShouldRenderWorldAxis* event)
 {
     Object* target = objects.find(event->id)->second;
-    physics::Vector3 pos = target->body->getPosition();
+    physics::Vector3 pos = target->getPosition();
     renderer.renderWorldAxisAt(event->axisIdx, pos.x, pos.y, pos.z);
 }
 
@@ -626,4 +717,5 @@ void Playground::handleRemoveUnfixedObjectsEvent(RemoveUnfixedObjectsEvent* even
 void Playground::handleTimeStepChangedEvent(TimeStepChangedEvent* event)
 {
     timeStepMultiplier = event->value;
+    physicsThread.setTimeStepMultiplier(timeStepMultiplier);
 }